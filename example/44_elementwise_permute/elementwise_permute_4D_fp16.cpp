@@ -30,14 +30,16 @@ using DeviceElementwisePermuteInstance =
 template <typename HostTensorA, typename HostTensorB, typename Functor>
 void host_elementwise4D(HostTensorB& B_nhwc, const HostTensorA& A_nchw, Functor functor)
 {
-    for(std::size_t n = 0; n < A_nchw.mDesc.GetLengths()[0]; ++n)
-        for(std::size_t c = 0; c < A_nchw.mDesc.GetLengths()[1]; ++c)
-            for(std::size_t h = 0; h < A_nchw.mDesc.GetLengths()[2]; ++h)
-                for(std::size_t w = 0; w < A_nchw.mDesc.GetLengths()[3]; ++w)
-                {
-                    auto a_val = A_nchw(n, c, h, w);
-                    functor(B_nhwc(n, h, w, c), a_val);
-                }
+    // view B as NCHW so both tensors share the logical index space
+    const auto b_nchw_desc = transpose_host_tensor_descriptor_given_new2old(
+        B_nhwc.mDesc, std::array<std::size_t, 4>{0, 3, 1, 2});
+
+    make_host_tensor_traversal(b_nchw_desc, A_nchw.mDesc)(
+        [&](const auto& offsets) {
+            auto a_val = A_nchw.mData[offsets[1]];
+            functor(B_nhwc.mData[offsets[0]], a_val);
+        },
+        std::thread::hardware_concurrency());
 }
 
 int main()
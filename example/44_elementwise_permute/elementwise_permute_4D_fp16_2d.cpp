@@ -28,19 +28,18 @@ using DeviceElementwisePermuteInstance =
                                                           ck::Sequence<8>>;
 
 template <typename HostTensorA, typename HostTensorB, typename Functor>
-void host_elementwise4D(HostTensorB& B_nhwc,
-                        const HostTensorA& A_nchw,
-                        const std::vector<std::size_t>& shape_nchw,
-                        Functor functor)
+void host_elementwise4D(HostTensorB& B_nhwc, const HostTensorA& A_nchw, Functor functor)
 {
-    for(std::size_t n = 0; n < shape_nchw[0]; ++n)
-        for(std::size_t c = 0; c < shape_nchw[1]; ++c)
-            for(std::size_t h = 0; h < shape_nchw[2]; ++h)
-                for(std::size_t w = 0; w < shape_nchw[3]; ++w)
-                {
-                    auto a_val = A_nchw(n, c, h, w);
-                    functor(B_nhwc(n, h, w, c), a_val);
-                }
+    // view B as NCHW so both tensors share the logical index space
+    const auto b_nchw_desc = transpose_host_tensor_descriptor_given_new2old(
+        B_nhwc.mDesc, std::array<std::size_t, 4>{0, 3, 1, 2});
+
+    make_host_tensor_traversal(b_nchw_desc, A_nchw.mDesc)(
+        [&](const auto& offsets) {
+            auto a_val = A_nchw.mData[offsets[1]];
+            functor(B_nhwc.mData[offsets[0]], a_val);
+        },
+        std::thread::hardware_concurrency());
 }
 
 int main()
@@ -119,7 +118,7 @@ int main()
 
         Tensor<BDataType> host_b(nhwc);
         host_elementwise4D<Tensor<ADataType>, Tensor<BDataType>, PassThrough>(
-            host_b, a, nchw, PassThrough{});
+            host_b, a, PassThrough{});
 
         // LogRangeAsType<float>(std::cout << "Host b  : ", host_b.mData, ",") << std::endl;
         pass &=
@@ -58,23 +58,19 @@ using DeviceInstance = ck::tensor_operation::device::DeviceElementwiseNormalizat
     8>;  // OutScalarPerVector
 
 template <typename HostTensorA, typename HostTensorB, typename HostTensorC, typename Functor>
-void host_elementwise2D(HostTensorC& C,
-                        const HostTensorA& A,
-                        const HostTensorB& B,
-                        const std::vector<std::size_t>& shape,
-                        Functor functor)
+void host_elementwise2D(HostTensorC& C, const HostTensorA& A, const HostTensorB& B, Functor functor)
 {
     using ctype = ck::remove_reference_t<decltype(C(0, 0))>;
 
-    for(std::size_t m = 0; m < shape[0]; ++m)
-        for(std::size_t n = 0; n < shape[1]; ++n)
-        {
-            auto a_val  = A(m, n);
-            auto b_val  = B(m, n);
+    make_host_tensor_traversal(C.mDesc, A.mDesc, B.mDesc)(
+        [&](const auto& offsets) {
+            auto a_val  = A.mData[offsets[1]];
+            auto b_val  = B.mData[offsets[2]];
             ctype c_val = 0;
             functor(c_val, a_val, b_val);
-            C(m, n) = c_val;
-        }
+            C.mData[offsets[0]] = c_val;
+        },
+        std::thread::hardware_concurrency());
 }
 
 int main()
@@ -158,13 +154,11 @@ int main()
 
     bool pass = true;
     {
-        std::vector<std::size_t> mn = {static_cast<unsigned long>(M),
-                                       static_cast<unsigned long>(N)};
         Tensor<XDataType> x(f_host_tensor_descriptor2d(M, N, Stride));
         host_elementwise2D<Tensor<ADataType>,
                            Tensor<BDataType>,
                            Tensor<XDataType>,
-                           XElementwiseOperation>(x, a, b, mn, XElementwiseOperation{});
+                           XElementwiseOperation>(x, a, b, XElementwiseOperation{});
 
         Tensor<YDataType> host_y(f_host_tensor_descriptor2d(M, N, Stride));
         using ReferenceInstance =
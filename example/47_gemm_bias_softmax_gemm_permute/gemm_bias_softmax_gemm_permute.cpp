@@ -15,8 +15,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm_softmax_gemm.hpp"
 
 using PassThrough = ck::tensor_operation::element_wise::PassThrough;
 
@@ -124,27 +123,22 @@ using DeviceOpInstance =
         MaskingSpec,    // MaskingSpecialization
         1>;
 
-// Ref Gemm0: fp16 in, fp32 out
-using ReferenceGemm0Instance = ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B0DataType,
-                                                                                AccDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B0ElementOp,
-                                                                                Acc0ElementOp>;
-
-// Ref Softmax: fp32 in, fp16 out
-using ReferenceSoftmaxInstance =
-    ck::tensor_operation::host::ReferenceSoftmax<AccDataType, ADataType, AccDataType>;
-
-// Ref Gemm1: fp16 in, fp16 out
-using ReferenceGemm1Instance = ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B1DataType,
-                                                                                CDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B1ElementOp,
-                                                                                CElementOp>;
+// Ref Gemm0 -> bias -> Softmax -> Gemm1, fused
+using ReferenceInstance =
+    ck::tensor_operation::host::ReferenceBatchedGemmSoftmaxGemm<ADataType,
+                                                                B0DataType,
+                                                                B1DataType,
+                                                                CDataType,
+                                                                AccDataType,
+                                                                AElementOp,
+                                                                B0ElementOp,
+                                                                Acc0ElementOp,
+                                                                B1ElementOp,
+                                                                CElementOp,
+                                                                MaskingSpec,
+                                                                D0DataType,
+                                                                C0DEElementOp>;
+
 int main(int argc, char* argv[])
 {
     bool do_verification = true;
@@ -327,70 +321,29 @@ int main(int argc, char* argv[])
     {
         c_device_buf.FromDevice(c_gs_ms_os_device_result.mData.data());
 
-        Tensor<ADataType> a_g_m_k({BatchCount, M, K});
-        Tensor<B0DataType> b0_g_k_n({BatchCount, K, N});
-        Tensor<B1DataType> b1_g_n_o({BatchCount, N, O});
-        Tensor<AccDataType> acc0_g_m_n({BatchCount, M, N});        // scratch object after gemm0
-        Tensor<ADataType> a1_g_m_n({BatchCount, M, N});            // scratch object after softmax
-        Tensor<CDataType> c_g_m_o_host_result({BatchCount, M, O}); // scratch object after gemm1
-        Tensor<D0DataType> d0_g_m_n({BatchCount, M, N});
-
-        // permute
-        a_gs_ms_ks.ForEach([&](auto& self, auto idx) {
-            a_g_m_k(idx[0] * G1 + idx[1], idx[2], idx[3]) = self(idx);
-        });
-        b0_gs_ns_ks.ForEach([&](auto& self, auto idx) {
-            b0_g_k_n(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
-        });
-        b1_gs_os_ns.ForEach([&](auto& self, auto idx) {
-            b1_g_n_o(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
-        });
-        d0_gs_ms_ns.ForEach([&](auto& self, auto idx) {
-            d0_g_m_n(idx[0] * G1 + idx[1], idx[2], idx[3]) = self(idx);
-        });
-
-        // gemm 0
-        auto ref_gemm0          = ReferenceGemm0Instance{};
-        auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
-        auto ref_gemm0_argument = ref_gemm0.MakeArgument(
-            a_g_m_k, b0_g_k_n, acc0_g_m_n, a_element_op, b0_element_op, acc0_element_op);
-
-        ref_gemm0_invoker.Run(ref_gemm0_argument);
-
-        acc0_g_m_n.ForEach([&](auto&, auto idx) {
-            c0de_element_op(acc0_g_m_n(idx), acc0_g_m_n(idx), d0_g_m_n(idx));
-        });
-        // masking
-        const auto mask = DeviceOpInstance::C0MatrixMask(N);
-        acc0_g_m_n.ForEach([&](auto& self, auto idx) {
-            if(mask.IsMaskedElement(idx[1], idx[2]))
-                self(idx) = -ck::NumericLimits<float>::Infinity();
-        });
-
-        // softmax
-        auto ref_softmax          = ReferenceSoftmaxInstance{};
-        auto ref_softmax_invoker  = ref_softmax.MakeInvoker();
-        auto ref_softmax_argument = ref_softmax.MakeArgument(acc0_g_m_n, a1_g_m_n, 1, 0, {2});
-
-        ref_softmax_invoker.Run(ref_softmax_argument);
-
-        // gemm1
-        auto ref_gemm1          = ReferenceGemm1Instance{};
-        auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
-        auto ref_gemm1_argument = ref_gemm1.MakeArgument(
-            a1_g_m_n, b1_g_n_o, c_g_m_o_host_result, PassThrough{}, b1_element_op, c_element_op);
-
-        ref_gemm1_invoker.Run(ref_gemm1_argument);
-
-        // permute
-        c_gs_ms_os_host_result.ForEach([&](auto& self, auto idx) {
-            const size_t& g0 = idx[0];
-            const size_t& g1 = idx[1];
-
-            const size_t g = g0 * G1 + g1;
-
-            self(idx) = c_g_m_o_host_result(g, idx[2], idx[3]);
-        });
+        // [G0, G1, K, N] and [G0, G1, N, O] views over the storage of B0 and B1, not copies;
+        // A, D0 and C are used as they are
+        const auto b0_gs_ks_ns =
+            TensorView(b0_gs_ns_ks).Transpose(std::vector<std::size_t>{0, 1, 3, 2});
+        const auto b1_gs_ns_os =
+            TensorView(b1_gs_os_ns).Transpose(std::vector<std::size_t>{0, 1, 3, 2});
+
+        // gemm 0, bias, masking, softmax and gemm 1
+        auto ref          = ReferenceInstance{};
+        auto ref_invoker  = ref.MakeInvoker();
+        auto ref_argument = ref.MakeArgument(a_gs_ms_ks,
+                                             b0_gs_ks_ns,
+                                             b1_gs_ns_os,
+                                             c_gs_ms_os_host_result,
+                                             d0_gs_ms_ns,
+                                             a_element_op,
+                                             b0_element_op,
+                                             acc0_element_op,
+                                             c0de_element_op,
+                                             b1_element_op,
+                                             c_element_op);
+
+        ref_invoker.Run(ref_argument);
 
         // default absolute error and relative error is 0.001
         double rtol = 1e-3;
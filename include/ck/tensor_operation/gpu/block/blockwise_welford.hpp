@@ -5,6 +5,7 @@
 
 #include "ck/tensor_description/cluster_descriptor.hpp"
 #include "ck/utility/get_shift.hpp"
+#include "ck/tensor_operation/gpu/device/welford_helper.hpp"
 
 namespace ck {
 
@@ -39,12 +40,7 @@ struct BlockwiseWelford
     __device__ static inline void
     Merge(T& mean_a, T& var_a, CountDataType& count_a, T mean_b, T var_b, CountDataType count_b)
     {
-        CountDataType count  = count_a + count_b;
-        T count_b_over_count = count == 0 ? type_convert<T>(0) : type_convert<T>(count_b) / count;
-        T delta              = mean_b - mean_a;
-        mean_a += delta * count_b_over_count;
-        var_a += var_b + delta * delta * count_a * count_b_over_count;
-        count_a = count;
+        tensor_operation::device::welford_merge(mean_a, var_a, count_a, mean_b, var_b, count_b);
     }
 
     template <typename CountDataType>
@@ -3,10 +3,48 @@
 
 #pragma once
 
+#include "ck/utility/math_v2.hpp"
+#include "ck/utility/type_convert.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
 
+// Adds x to a running mean and sum of squared deviations (var), where count already includes x.
+// A NaN input poisons both mean and var.
+template <typename T, typename CountType>
+__host__ __device__ inline void welford_update(T& mean, T& var, CountType count, T x)
+{
+    using ck::math::isnan;
+
+    if(isnan(x))
+    {
+        mean = x;
+        var  = x;
+    }
+    else
+    {
+        T delta = x - mean;
+        mean += delta / type_convert<T>(count);
+        T delta2 = x - mean;
+        var += delta * delta2;
+    }
+}
+
+// Chan's formula: folds the partial state (mean_b, var_b, count_b) into (mean_a, var_a, count_a)
+template <typename T, typename CountType>
+__host__ __device__ inline void
+welford_merge(T& mean_a, T& var_a, CountType& count_a, T mean_b, T var_b, CountType count_b)
+{
+    CountType count = count_a + count_b;
+    T count_b_over_count =
+        count == 0 ? type_convert<T>(0) : type_convert<T>(count_b) / type_convert<T>(count);
+    T delta = mean_b - mean_a;
+    mean_a += delta * count_b_over_count;
+    var_a += var_b + delta * delta * type_convert<T>(count_a) * count_b_over_count;
+    count_a = count;
+}
+
 template <index_t K_BlockTileSize, index_t KThreadSliceSize>
 struct GetReduceCountPerThreadForBlockwiseWelford
 {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ck/utility/math_v2.hpp"
+#include "ck/tensor_operation/gpu/device/welford_helper.hpp"
 
 namespace ck {
 
@@ -30,20 +31,7 @@ struct ThreadwiseWelford
 
     __device__ inline void Update(T& mean, T& var, T x)
     {
-        using ck::math::isnan;
-
-        if(isnan(x))
-        {
-            mean = x;
-            var  = x;
-        }
-        else
-        {
-            T delta = x - mean;
-            mean += delta / cur_count_;
-            T delta2 = x - mean;
-            var += delta * delta2;
-        }
+        tensor_operation::device::welford_update(mean, var, cur_count_, x);
     }
 
     template <typename XBufferType, typename MeanBufferType, typename VarBufferType>
@@ -93,12 +81,7 @@ struct ThreadwiseWelfordMerge
     __device__ static void
     Merge(T& mean_a, T& var_a, int32_t& count_a, T mean_b, T var_b, int32_t count_b)
     {
-        int count            = count_a + count_b;
-        T count_b_over_count = count == 0 ? type_convert<T>(0) : type_convert<T>(count_b) / count;
-        T delta              = mean_b - mean_a;
-        mean_a += delta * count_b_over_count;
-        var_a += var_b + delta * delta * count_a * count_b_over_count;
-        count_a = count;
+        tensor_operation::device::welford_merge(mean_a, var_a, count_a, mean_b, var_b, count_b);
     }
 
     template <typename SrcMeanBufferType,
@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_pool.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -58,8 +60,6 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
     {
         using Argument = ReferenceAvgPoolBwd::Argument;
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 1, bool>::type = false>
         float RunAvgPoolBwd(const Argument& arg)
         {
             // Let input = x, outpu = y
@@ -85,198 +85,65 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
             // ...
             // dx9 = 1/5 * (dy5 + dy6 + dy7 + dy8 + dy9)
 
-            auto f_ncw = [&](auto n, auto c, auto wi) {
-                std::size_t X  = arg.window_spatial_lengths_[0];
-                std::size_t Wo = arg.doutput_.GetLengths()[2];
-
-                float v_acc = 0;
-
-                for(std::size_t x = 0; x < X; ++x)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(x * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(w_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                  static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
-                        {
-                            v_acc += ck::type_convert<float>(arg.doutput_(n, c, wo));
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(X);
-                arg.dinput_(n, c, wi) = ck::type_convert<DInDataType>(v_acc);
-            };
+            // dx is the transpose of the window sum, reduced by separable per-axis passes: along an
+            // axis, the inputs of a residue modulo the stride sum a dilated window of dy, see
+            // host_common::get_host_pool_bwd_windows(), so that a pixel costs O(NDimSpatial)
+            // whatever the window size
+            const auto& din_lengths  = arg.dinput_.GetLengths();
+            const auto& din_strides  = arg.dinput_.GetStrides();
+            const auto& dout_lengths = arg.doutput_.GetLengths();
+            const auto& dout_strides = arg.doutput_.GetStrides();
 
-            make_ParallelTensorFunctor(f_ncw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2])(
-                std::thread::hardware_concurrency());
+            const std::size_t C = din_lengths[1];
 
-            return 0;
-        }
+            std::array<std::size_t, NDimSpatial> din_spatial_lengths;
+            std::array<std::size_t, NDimSpatial> dout_spatial_lengths;
+            std::array<std::vector<host_common::HostPoolWindows>, NDimSpatial> windows;
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 2, bool>::type = false>
-        float RunAvgPoolBwd(const Argument& arg)
-        {
-            auto f_nchw = [&](auto n, auto c, auto hi, auto wi) {
-                std::size_t Y = arg.window_spatial_lengths_[0];
-                std::size_t X = arg.window_spatial_lengths_[1];
-
-                std::size_t Ho = arg.doutput_.GetLengths()[2];
-                std::size_t Wo = arg.doutput_.GetLengths()[3];
-
-                float v_acc = 0;
-
-                for(std::size_t y = 0; y < Y; ++y)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto h_tmp = static_cast<ck::long_index_t>(hi) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(y * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(h_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto ho = static_cast<ck::long_index_t>(h_tmp) /
-                                  static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
-                        {
-                            for(std::size_t x = 0; x < X; ++x)
-                            {
-                                auto w_tmp =
-                                    static_cast<ck::long_index_t>(wi) +
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                    static_cast<ck::long_index_t>(x * arg.window_dilations_[1]);
-                                if(w_tmp % arg.window_strides_[1] == 0)
-                                {
-                                    auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                              static_cast<ck::long_index_t>(arg.window_strides_[1]);
-                                    if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
-                                    {
-                                        v_acc +=
-                                            ck::type_convert<float>(arg.doutput_(n, c, ho, wo));
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(Y * X);
-                arg.dinput_(n, c, hi, wi) = ck::type_convert<DInDataType>(v_acc);
-            };
+            std::size_t window_size = 1;
 
-            make_ParallelTensorFunctor(f_nchw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2],
-                                       arg.dinput_.GetLengths()[3])(
-                std::thread::hardware_concurrency());
+            for(std::size_t d = 0; d < NDimSpatial; ++d)
+            {
+                din_spatial_lengths[d]  = din_lengths[d + 2];
+                dout_spatial_lengths[d] = dout_lengths[d + 2];
+                windows[d]              = host_common::get_host_pool_bwd_windows(
+                    din_spatial_lengths[d],
+                    arg.window_spatial_lengths_[d],
+                    arg.window_strides_[d],
+                    arg.window_dilations_[d],
+                    arg.in_left_pads_[d]);
+
+                window_size *= arg.window_spatial_lengths_[d];
+            }
 
-            return 0;
-        }
+            auto get_offset = [C](std::size_t nc,
+                                  const std::array<std::size_t, NDimSpatial>& idx,
+                                  const std::vector<std::size_t>& strides) {
+                std::size_t offset = nc / C * strides[0] + nc % C * strides[1];
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 3, bool>::type = false>
-        float RunAvgPoolBwd(const Argument& arg)
-        {
-            auto f_ncdhw = [&](auto n, auto c, auto di, auto hi, auto wi) {
-                std::size_t Z = arg.window_spatial_lengths_[0];
-                std::size_t Y = arg.window_spatial_lengths_[1];
-                std::size_t X = arg.window_spatial_lengths_[2];
-
-                std::size_t Do = arg.doutput_.GetLengths()[2];
-                std::size_t Ho = arg.doutput_.GetLengths()[3];
-                std::size_t Wo = arg.doutput_.GetLengths()[4];
-
-                float v_acc = 0;
-
-                for(std::size_t z = 0; z < Z; ++z)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto d_tmp = static_cast<ck::long_index_t>(di) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(z * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(d_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto do_ = static_cast<ck::long_index_t>(d_tmp) /
-                                   static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(do_ >= 0 && ck::type_convert<std::size_t>(do_) < Do)
-                        {
-                            for(std::size_t y = 0; y < Y; ++y)
-                            {
-                                auto h_tmp =
-                                    static_cast<ck::long_index_t>(hi) +
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                    static_cast<ck::long_index_t>(y * arg.window_dilations_[1]);
-                                if(h_tmp % arg.window_strides_[1] == 0)
-                                {
-                                    auto ho = static_cast<ck::long_index_t>(h_tmp) /
-                                              static_cast<ck::long_index_t>(arg.window_strides_[1]);
-                                    if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
-                                    {
-                                        for(std::size_t x = 0; x < X; ++x)
-                                        {
-                                            auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                                         static_cast<ck::long_index_t>(
-                                                             arg.in_left_pads_[2]) -
-                                                         static_cast<ck::long_index_t>(
-                                                             x * arg.window_dilations_[2]);
-
-                                            if(w_tmp % arg.window_strides_[2] == 0)
-                                            {
-                                                auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                                          static_cast<ck::long_index_t>(
-                                                              arg.window_strides_[2]);
-                                                if(wo >= 0 &&
-                                                   ck::type_convert<std::size_t>(wo) < Wo)
-                                                {
-                                                    v_acc += ck::type_convert<float>(
-                                                        arg.doutput_(n, c, do_, ho, wo));
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(Z * Y * X);
-                arg.dinput_(n, c, di, hi, wi) = ck::type_convert<DInDataType>(v_acc);
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                    offset += idx[d] * strides[d + 2];
+
+                return offset;
             };
 
-            make_ParallelTensorFunctor(f_ncdhw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2],
-                                       arg.dinput_.GetLengths()[3],
-                                       arg.dinput_.GetLengths()[4])(
-                std::thread::hardware_concurrency());
+            host_common::host_pool_separable(
+                din_lengths[0] * C,
+                dout_spatial_lengths,
+                din_spatial_lengths,
+                windows,
+                0.f,
+                [&](std::size_t nc, const auto& idx) {
+                    return ck::type_convert<float>(
+                        arg.doutput_.mData[get_offset(nc, idx, dout_strides)]);
+                },
+                [](float& v_acc, float v) { v_acc += v; },
+                [&](std::size_t nc, const auto& idx, float v_acc) {
+                    v_acc /= ck::type_convert<float>(window_size);
+
+                    arg.dinput_.mData[get_offset(nc, idx, din_strides)] =
+                        ck::type_convert<DInDataType>(v_acc);
+                });
 
             return 0;
         }
@@ -289,7 +156,7 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            return RunAvgPoolBwd<NDimSpatial>(arg);
+            return RunAvgPoolBwd(arg);
         }
 
         float Run(const device::BaseArgument* p_arg,
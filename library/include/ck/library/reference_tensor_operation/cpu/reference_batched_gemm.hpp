@@ -8,6 +8,7 @@
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -25,9 +26,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_g_m_k,
-                 const Tensor<BDataType>& b_g_k_n,
-                 Tensor<CDataType>& c_g_m_n,
+        Argument(TensorView<const ADataType> a_g_m_k,
+                 TensorView<const BDataType> b_g_k_n,
+                 TensorView<CDataType> c_g_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -40,9 +41,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_g_m_k_;
-        const Tensor<BDataType>& b_g_k_n_;
-        Tensor<CDataType>& c_g_m_n_;
+        TensorView<const ADataType> a_g_m_k_;
+        TensorView<const BDataType> b_g_k_n_;
+        TensorView<CDataType> c_g_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -54,37 +55,76 @@ struct ReferenceBatchedGemm : public device::BaseOperator
     {
         using Argument = ReferenceBatchedGemm::Argument;
 
-        float Run(const Argument& arg)
+        static AccDataType ConvertA(const Argument& arg, const ADataType& a)
+        {
+            ADataType v_a;
+
+            arg.a_element_op_(v_a, a);
+
+            return ck::type_convert<AccDataType>(v_a);
+        }
+
+        static AccDataType ConvertB(const Argument& arg, const BDataType& b)
         {
-            auto f_gmk_gkn_gmn = [&](auto g, auto m, auto n) {
-                const int K = arg.a_g_m_k_.mDesc.GetLengths()[2];
+            BDataType v_b;
 
-                AccDataType v_acc = 0;
+            arg.b_element_op_(v_b, b);
 
-                for(int k = 0; k < K; ++k)
-                {
-                    ADataType v_a;
-                    BDataType v_b;
+            return ck::type_convert<AccDataType>(v_b);
+        }
 
-                    arg.a_element_op_(v_a, arg.a_g_m_k_(g, m, k));
-                    arg.b_element_op_(v_b, arg.b_g_k_n_(g, k, n));
+        static CDataType ConvertC(const Argument& arg, AccDataType v_acc)
+        {
+            AccDataType v_c;
 
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
+            arg.c_element_op_(v_c, v_acc);
 
-                AccDataType v_c;
+            return ck::type_convert<CDataType>(v_c);
+        }
 
-                arg.c_element_op_(v_c, v_acc);
+        // Element idx = [g, m, n] of C, computed on its own; point-wise evaluator of sampled
+        // verification
+        template <typename Index>
+        static CDataType ComputeElement(const Argument& arg, const Index& idx)
+        {
+            const std::size_t K = arg.a_g_m_k_.mDesc.GetLengths()[2];
 
-                arg.c_g_m_n_(g, m, n) = ck::type_convert<CDataType>(v_c);
+            AccDataType v_acc{0};
+
+            for(std::size_t k = 0; k < K; ++k)
+            {
+                v_acc += ConvertA(arg, arg.a_g_m_k_(idx[0], idx[1], k)) *
+                         ConvertB(arg, arg.b_g_k_n_(idx[0], k, idx[2]));
+            }
+
+            return ConvertC(arg, v_acc);
+        }
+
+        float Run(const Argument& arg)
+        {
+            const auto& a_strides = arg.a_g_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_g_k_n_.mDesc.GetStrides();
+
+            auto a_convert = [&](const ADataType& a) { return ConvertA(arg, a); };
+            auto b_convert = [&](const BDataType& b) { return ConvertB(arg, b); };
+
+            auto c_store = [&](auto g, auto m, auto n, AccDataType v_acc) {
+                arg.c_g_m_n_(g, m, n) = ConvertC(arg, v_acc);
             };
 
-            make_ParallelTensorFunctor(f_gmk_gkn_gmn,
-                                       arg.c_g_m_n_.mDesc.GetLengths()[0],
-                                       arg.c_g_m_n_.mDesc.GetLengths()[1],
-                                       arg.c_g_m_n_.mDesc.GetLengths()[2])(
-                std::thread::hardware_concurrency());
+            ck::host_common::host_gemm_packed<AccDataType>(
+                arg.c_g_m_n_.mDesc.GetLengths()[0],
+                arg.c_g_m_n_.mDesc.GetLengths()[1],
+                arg.c_g_m_n_.mDesc.GetLengths()[2],
+                arg.a_g_m_k_.mDesc.GetLengths()[2],
+                arg.a_g_m_k_.data(),
+                {a_strides[0], a_strides[1], a_strides[2]},
+                arg.b_g_k_n_.data(),
+                {b_strides[0], b_strides[1], b_strides[2]},
+                a_convert,
+                b_convert,
+                c_store);
+
             return 0;
         }
 
@@ -103,9 +143,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_g_m_k,
-                             const Tensor<BDataType>& b_g_k_n,
-                             Tensor<CDataType>& c_g_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const BDataType> b_g_k_n,
+                             TensorView<CDataType> c_g_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -0,0 +1,438 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/tensor_operation/gpu/device/masking_specialization.hpp"
+#include "ck/tensor_operation/gpu/element/binary_element_wise_operation.hpp"
+#include "ck/library/utility/host_gemm.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+// Fused host reference of batched attention:
+//   S = acc0_element_op(A * B0), then S = d0_element_op(S, D0) if a bias is given
+//   S[m, n] = -inf where the mask of MaskingSpec applies
+//   P = softmax(S) along N, rounded to ADataType
+//   C = c_element_op(P * b1_element_op(B1))
+// A is [G..., M, K], B0 [G..., K, N], B1 [G..., N, O], C [G..., M, O] and D0 [G..., M, N]. Any
+// number of leading batch dimensions and arbitrary strides are accepted, so permuted layouts are
+// read in place: the operands are TensorViews, a transposed view such as
+// TensorView(b0_g_n_k).Transpose(...) is passed without copying the tensor.
+//
+// S and P are never materialized. Each (batch, M tile) task walks N in tiles twice: the first
+// pass keeps the online-softmax row max and sum, the second recomputes S, normalizes it and
+// accumulates P * B1. Host memory on top of the operands stays at O(M x O). The row sum is
+// rescaled whenever the row max grows and the GEMMs accumulate K and N in their own order, so the
+// result matches ReferenceBatchedGemm -> ReferenceSoftmax -> ReferenceBatchedGemm only to within
+// rounding and is compared with it under a tolerance.
+template <typename ADataType,
+          typename B0DataType,
+          typename B1DataType,
+          typename CDataType,
+          typename AccDataType,
+          typename AElementwiseOperation,
+          typename B0ElementwiseOperation,
+          typename Acc0ElementwiseOperation,
+          typename B1ElementwiseOperation,
+          typename CElementwiseOperation,
+          device::MaskingSpecialization MaskingSpec = device::MaskingSpecialization::MaskDisabled,
+          typename D0DataType                       = AccDataType,
+          typename D0ElementwiseOperation           = element_wise::Add>
+struct ReferenceBatchedGemmSoftmaxGemm : public device::BaseOperator
+{
+    static constexpr std::size_t MPerTile = 64;
+    static constexpr std::size_t NPerTile = 256;
+
+    using MaskOutPredicate =
+        std::conditional_t<MaskingSpec == device::MaskingSpecialization::MaskOutUpperTriangle,
+                           device::MaskOutUpperTrianglePredicate,
+                           device::MaskDisabledPredicate>;
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(TensorView<const ADataType> a_g_m_k,
+                 TensorView<const B0DataType> b0_g_k_n,
+                 TensorView<const B1DataType> b1_g_n_o,
+                 TensorView<CDataType> c_g_m_o,
+                 std::optional<TensorView<const D0DataType>> d0_g_m_n,
+                 AElementwiseOperation a_element_op,
+                 B0ElementwiseOperation b0_element_op,
+                 Acc0ElementwiseOperation acc0_element_op,
+                 D0ElementwiseOperation d0_element_op,
+                 B1ElementwiseOperation b1_element_op,
+                 CElementwiseOperation c_element_op)
+            : a_g_m_k_{a_g_m_k},
+              b0_g_k_n_{b0_g_k_n},
+              b1_g_n_o_{b1_g_n_o},
+              c_g_m_o_{c_g_m_o},
+              d0_g_m_n_{d0_g_m_n},
+              a_element_op_{a_element_op},
+              b0_element_op_{b0_element_op},
+              acc0_element_op_{acc0_element_op},
+              d0_element_op_{d0_element_op},
+              b1_element_op_{b1_element_op},
+              c_element_op_{c_element_op}
+        {
+        }
+
+        TensorView<const ADataType> a_g_m_k_;
+        TensorView<const B0DataType> b0_g_k_n_;
+        TensorView<const B1DataType> b1_g_n_o_;
+        TensorView<CDataType> c_g_m_o_;
+        std::optional<TensorView<const D0DataType>> d0_g_m_n_; // empty if there is no bias
+
+        AElementwiseOperation a_element_op_;
+        B0ElementwiseOperation b0_element_op_;
+        Acc0ElementwiseOperation acc0_element_op_;
+        D0ElementwiseOperation d0_element_op_;
+        B1ElementwiseOperation b1_element_op_;
+        CElementwiseOperation c_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferenceBatchedGemmSoftmaxGemm::Argument;
+
+        float Run(const Argument& arg)
+        {
+            const auto& c_lengths           = arg.c_g_m_o_.mDesc.GetLengths();
+            const std::size_t num_batch_dim = c_lengths.size() - 2;
+
+            const std::size_t M = c_lengths[num_batch_dim];
+            const std::size_t N = arg.b0_g_k_n_.mDesc.GetLengths()[num_batch_dim + 1];
+            const std::size_t K = arg.a_g_m_k_.mDesc.GetLengths()[num_batch_dim + 1];
+            const std::size_t O = c_lengths[num_batch_dim + 1];
+
+            std::size_t num_batch = 1;
+
+            for(std::size_t d = 0; d < num_batch_dim; ++d)
+                num_batch *= c_lengths[d];
+
+            // offset of one batch and the (0, row stride, column stride) of its matrix
+            auto batch_offset = [&](const HostTensorDescriptor& desc, std::size_t batch) {
+                std::size_t offset = 0;
+
+                for(std::size_t d = num_batch_dim; d-- > 0;)
+                {
+                    offset += batch % c_lengths[d] * desc.GetStrides()[d];
+                    batch /= c_lengths[d];
+                }
+
+                return offset;
+            };
+
+            auto matrix_strides = [&](const HostTensorDescriptor& desc) {
+                return std::array<std::size_t, 3>{
+                    0, desc.GetStrides()[num_batch_dim], desc.GetStrides()[num_batch_dim + 1]};
+            };
+
+            const auto a_strides  = matrix_strides(arg.a_g_m_k_.mDesc);
+            const auto b0_strides = matrix_strides(arg.b0_g_k_n_.mDesc);
+            const auto b1_strides = matrix_strides(arg.b1_g_n_o_.mDesc);
+            const auto c_strides  = matrix_strides(arg.c_g_m_o_.mDesc);
+            const auto d0_strides = arg.d0_g_m_n_ ? matrix_strides(arg.d0_g_m_n_->mDesc)
+                                                  : std::array<std::size_t, 3>{0, 0, 0};
+
+            auto a_convert = [&](const ADataType& a) {
+                ADataType v_a;
+
+                arg.a_element_op_(v_a, a);
+
+                return ck::type_convert<AccDataType>(v_a);
+            };
+
+            auto b0_convert = [&](const B0DataType& b0) {
+                B0DataType v_b0;
+
+                arg.b0_element_op_(v_b0, b0);
+
+                return ck::type_convert<AccDataType>(v_b0);
+            };
+
+            auto b1_convert = [&](const B1DataType& b1) {
+                B1DataType v_b1;
+
+                arg.b1_element_op_(v_b1, b1);
+
+                return ck::type_convert<AccDataType>(v_b1);
+            };
+
+            const MaskOutPredicate mask{};
+            const std::size_t num_m_tile = (M + MPerTile - 1) / MPerTile;
+
+            host_common::host_parallel_for(num_batch * num_m_tile, [&](std::size_t task) {
+                const std::size_t batch   = task / num_m_tile;
+                const std::size_t m_begin = task % num_m_tile * MPerTile;
+                const std::size_t mt      = std::min(MPerTile, M - m_begin);
+
+                const ADataType* p_a = arg.a_g_m_k_.data() +
+                                       batch_offset(arg.a_g_m_k_.mDesc, batch) +
+                                       m_begin * a_strides[1];
+                const B0DataType* p_b0 =
+                    arg.b0_g_k_n_.data() + batch_offset(arg.b0_g_k_n_.mDesc, batch);
+                const B1DataType* p_b1 =
+                    arg.b1_g_n_o_.data() + batch_offset(arg.b1_g_n_o_.mDesc, batch);
+                CDataType* p_c = arg.c_g_m_o_.data() + batch_offset(arg.c_g_m_o_.mDesc, batch) +
+                                 m_begin * c_strides[1];
+                const D0DataType* p_d0 = arg.d0_g_m_n_
+                                             ? arg.d0_g_m_n_->data() +
+                                                   batch_offset(arg.d0_g_m_n_->mDesc, batch) +
+                                                   m_begin * d0_strides[1]
+                                             : nullptr;
+
+                // N tiles right of the diagonal are fully masked out and contribute nothing
+                auto is_tile_skippable = [&](std::size_t n_begin, std::size_t nt) {
+                    return mask.IsTileSkippable(m_begin, n_begin, mt, nt);
+                };
+
+                // call f(m, n, s) for S of this M tile and columns [n_begin, n_begin + nt),
+                // visiting every row in increasing n. The GEMM runs on the calling thread, the
+                // parallelism is over (batch, M tile) tasks
+                auto for_each_score = [&](std::size_t n_begin, std::size_t nt, auto&& f) {
+                    host_common::host_gemm_packed<AccDataType>(
+                        1,
+                        mt,
+                        nt,
+                        K,
+                        p_a,
+                        a_strides,
+                        p_b0 + n_begin * b0_strides[2],
+                        b0_strides,
+                        a_convert,
+                        b0_convert,
+                        [&](auto, std::size_t m, std::size_t n, AccDataType v_acc) {
+                            AccDataType s;
+
+                            arg.acc0_element_op_(s, v_acc);
+
+                            if(p_d0 != nullptr)
+                                arg.d0_element_op_(
+                                    s, s, p_d0[m * d0_strides[1] + (n_begin + n) * d0_strides[2]]);
+
+                            if(mask(m_begin + m, n_begin + n))
+                                s = -std::numeric_limits<AccDataType>::infinity();
+
+                            f(m, n, s);
+                        },
+                        1);
+                };
+
+                // pass 1: online softmax statistics of every row
+                std::vector<AccDataType> row_max(mt, std::numeric_limits<AccDataType>::lowest());
+                std::vector<AccDataType> row_sum(mt, 0);
+
+                for(std::size_t n_begin = 0; n_begin < N; n_begin += NPerTile)
+                {
+                    const std::size_t nt = std::min(NPerTile, N - n_begin);
+
+                    if(is_tile_skippable(n_begin, nt))
+                        break;
+
+                    for_each_score(n_begin, nt, [&](std::size_t m, std::size_t, AccDataType s) {
+                        if(s > row_max[m])
+                        {
+                            row_sum[m] *= std::exp(row_max[m] - s);
+                            row_max[m] = s;
+                        }
+
+                        row_sum[m] += std::exp(s - row_max[m]);
+                    });
+                }
+
+                // pass 2: C_tile += P_tile * B1_tile, with P rounded to ADataType
+                std::vector<AccDataType> p_tile(mt * NPerTile);
+                std::vector<AccDataType> b1_tile(NPerTile * O);
+                std::vector<AccDataType> acc_tile(mt * O, 0);
+
+                for(std::size_t n_begin = 0; n_begin < N; n_begin += NPerTile)
+                {
+                    const std::size_t nt = std::min(NPerTile, N - n_begin);
+
+                    if(is_tile_skippable(n_begin, nt))
+                        break;
+
+                    for_each_score(n_begin, nt, [&](std::size_t m, std::size_t n, AccDataType s) {
+                        p_tile[m * nt + n] = ck::type_convert<AccDataType>(
+                            ck::type_convert<ADataType>(std::exp(s - row_max[m]) / row_sum[m]));
+                    });
+
+                    for(std::size_t n = 0; n < nt; ++n)
+                        for(std::size_t o = 0; o < O; ++o)
+                            b1_tile[n * O + o] = b1_convert(
+                                p_b1[(n_begin + n) * b1_strides[1] + o * b1_strides[2]]);
+
+                    for(std::size_t m = 0; m < mt; ++m)
+                    {
+                        AccDataType* acc = acc_tile.data() + m * O;
+
+                        for(std::size_t n = 0; n < nt; ++n)
+                        {
+                            const AccDataType p     = p_tile[m * nt + n];
+                            const AccDataType* b1_n = b1_tile.data() + n * O;
+
+                            for(std::size_t o = 0; o < O; ++o)
+                                acc[o] += p * b1_n[o];
+                        }
+                    }
+                }
+
+                for(std::size_t m = 0; m < mt; ++m)
+                    for(std::size_t o = 0; o < O; ++o)
+                    {
+                        AccDataType v_c;
+
+                        arg.c_element_op_(v_c, acc_tile[m * O + o]);
+
+                        p_c[m * c_strides[1] + o * c_strides[2]] =
+                            ck::type_convert<CDataType>(v_c);
+                    }
+            });
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        const Argument* p_arg_ = dynamic_cast<const Argument*>(p_arg);
+
+        const auto& a_lengths  = p_arg_->a_g_m_k_.mDesc.GetLengths();
+        const auto& b0_lengths = p_arg_->b0_g_k_n_.mDesc.GetLengths();
+        const auto& b1_lengths = p_arg_->b1_g_n_o_.mDesc.GetLengths();
+        const auto& c_lengths  = p_arg_->c_g_m_o_.mDesc.GetLengths();
+
+        const std::size_t rank = c_lengths.size();
+
+        if(rank < 3 || a_lengths.size() != rank || b0_lengths.size() != rank ||
+           b1_lengths.size() != rank)
+            return false;
+
+        // batch dimensions
+        for(std::size_t d = 0; d + 2 < rank; ++d)
+            if(a_lengths[d] != c_lengths[d] || b0_lengths[d] != c_lengths[d] ||
+               b1_lengths[d] != c_lengths[d])
+                return false;
+
+        const std::size_t M = c_lengths[rank - 2];
+        const std::size_t N = b0_lengths[rank - 1];
+        const std::size_t K = a_lengths[rank - 1];
+        const std::size_t O = c_lengths[rank - 1];
+
+        if(a_lengths[rank - 2] != M || b0_lengths[rank - 2] != K || b1_lengths[rank - 2] != N ||
+           b1_lengths[rank - 1] != O)
+            return false;
+
+        if(p_arg_->d0_g_m_n_)
+        {
+            auto d0_lengths = p_arg_->d0_g_m_n_->mDesc.GetLengths();
+
+            d0_lengths.back() = O;
+
+            if(d0_lengths != c_lengths || p_arg_->d0_g_m_n_->mDesc.GetLengths().back() != N)
+                return false;
+        }
+
+        return true;
+    }
+
+    static auto MakeArgument(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const B0DataType> b0_g_k_n,
+                             TensorView<const B1DataType> b1_g_n_o,
+                             TensorView<CDataType> c_g_m_o,
+                             AElementwiseOperation a_element_op,
+                             B0ElementwiseOperation b0_element_op,
+                             Acc0ElementwiseOperation acc0_element_op,
+                             B1ElementwiseOperation b1_element_op,
+                             CElementwiseOperation c_element_op)
+    {
+        return Argument{a_g_m_k,
+                        b0_g_k_n,
+                        b1_g_n_o,
+                        c_g_m_o,
+                        std::nullopt,
+                        a_element_op,
+                        b0_element_op,
+                        acc0_element_op,
+                        D0ElementwiseOperation{},
+                        b1_element_op,
+                        c_element_op};
+    }
+
+    // with an Acc0 bias D0, added to S through d0_element_op(s, s, d0)
+    static auto MakeArgument(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const B0DataType> b0_g_k_n,
+                             TensorView<const B1DataType> b1_g_n_o,
+                             TensorView<CDataType> c_g_m_o,
+                             TensorView<const D0DataType> d0_g_m_n,
+                             AElementwiseOperation a_element_op,
+                             B0ElementwiseOperation b0_element_op,
+                             Acc0ElementwiseOperation acc0_element_op,
+                             D0ElementwiseOperation d0_element_op,
+                             B1ElementwiseOperation b1_element_op,
+                             CElementwiseOperation c_element_op)
+    {
+        return Argument{a_g_m_k,
+                        b0_g_k_n,
+                        b1_g_n_o,
+                        c_g_m_o,
+                        d0_g_m_n,
+                        a_element_op,
+                        b0_element_op,
+                        acc0_element_op,
+                        d0_element_op,
+                        b1_element_op,
+                        c_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceBatchedGemmSoftmaxGemm"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -78,8 +78,6 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
               p_dscale_(p_dscale),
               p_dbias_(p_dbias)
         {
-            using ck::host_common::get_index_set;
-
             if(std::any_of(
                    reduceDims.begin(), reduceDims.end(), [](int d) { return d < 0 || d >= Rank; }))
                 throw std::runtime_error("Invalid reduce dimensions!");
@@ -126,9 +124,6 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
             reduceSize_ = std::accumulate(
                 reduce_lengths_.begin(), reduce_lengths_.end(), 1, std::multiplies<size_t>{});
 
-            invariant_index_set_ = get_index_set<NumInvariantDim>(invariant_lengths_);
-            reduce_index_set_    = get_index_set<NumBatchNormReduceDim>(reduce_lengths_);
-
             epsilon_ = type_convert<AccDataType>(epsilon);
 
             haveSavedMeanInvVar_ = (p_savedMean != nullptr && p_savedInvVar != nullptr);
@@ -164,9 +159,6 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
 
         bool haveSavedMeanInvVar_;
 
-        std::vector<std::array<index_t, NumInvariantDim>> invariant_index_set_;
-        std::vector<std::array<index_t, NumBatchNormReduceDim>> reduce_index_set_;
-
         AccDataType epsilon_;
         size_t reduceSize_;
     };
@@ -175,15 +167,21 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
     {
         float Run(const Argument& arg)
         {
-            using ck::host_common::get_offset_from_index;
+            using ck::host_common::make_host_index_odometer;
+
+            const auto reduce_odometer =
+                make_host_index_odometer<NumBatchNormReduceDim>(arg.reduce_lengths_,
+                                                                arg.x_reduce_strides_,
+                                                                arg.dy_reduce_strides_,
+                                                                arg.dx_reduce_strides_);
+
+            // offsets of x, dy, dx, the saved mean/inv-variance, dscale/dbias and the scale
+            auto thread_reduce_func = [&](auto, const auto& invariant_offsets) {
+                size_t x_invariant_offset  = invariant_offsets[0];
+                size_t dy_invariant_offset = invariant_offsets[1];
+                size_t dx_invariant_offset = invariant_offsets[2];
 
-            auto thread_reduce_func = [&](auto invariant_index) {
-                size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.x_invariant_strides_, invariant_index);
-                size_t dy_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.dy_invariant_strides_, invariant_index);
-                size_t dx_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.dx_invariant_strides_, invariant_index);
+                auto reduce_range = reduce_odometer;
 
                 AccDataType mean     = type_convert<AccDataType>(0.0f);
                 AccDataType variance = type_convert<AccDataType>(0.0f);
@@ -192,8 +190,7 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
 
                 if(arg.haveSavedMeanInvVar_)
                 {
-                    size_t mean_invVar_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                        arg.bnMeanVarStrides_, invariant_index);
+                    size_t mean_invVar_invariant_offset = invariant_offsets[3];
 
                     mean =
                         type_convert<AccDataType>(arg.p_savedMean_[mean_invVar_invariant_offset]);
@@ -203,12 +200,8 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                 else
                 {
                     // compute mean, variance using welford method
-                    for(const auto& reduce_index : arg.reduce_index_set_)
-                    {
-                        size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                            arg.x_reduce_strides_, reduce_index);
-
-                        auto x_offset = x_invariant_offset + x_reduce_offset;
+                    reduce_range.ForEach([&](auto, const auto& reduce_offsets) {
+                        auto x_offset = x_invariant_offset + reduce_offsets[0];
 
                         curr_count++;
 
@@ -221,7 +214,7 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                         AccDataType delta2 = x - mean;
 
                         variance += delta * delta2;
-                    };
+                    });
 
                     // actual variance
                     variance = variance / curr_count;
@@ -239,15 +232,9 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                 // 1) calculate dy * (x - mean) * inv-variance
                 // 2) calculate sum(dy) on reduced dimensions
                 // 3) calculate sum(dy * norm_x) on reduced dimensions
-                for(const auto& reduce_index : arg.reduce_index_set_)
-                {
-                    size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.x_reduce_strides_, reduce_index);
-                    size_t dy_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.dy_reduce_strides_, reduce_index);
-
-                    auto x_offset  = x_invariant_offset + x_reduce_offset;
-                    auto dy_offset = dy_invariant_offset + dy_reduce_offset;
+                reduce_range.ForEach([&](auto, const auto& reduce_offsets) {
+                    auto x_offset  = x_invariant_offset + reduce_offsets[0];
+                    auto dy_offset = dy_invariant_offset + reduce_offsets[1];
 
                     AccDataType x = type_convert<AccDataType>(arg.p_x_[x_offset]);
 
@@ -258,18 +245,15 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
 
                     dbias += dy;
                     dscale += norm_x * dy;
-                };
+                });
 
-                size_t dscale_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.bnDscaleDbiasStrides_, invariant_index);
-                size_t dbias_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.bnDscaleDbiasStrides_, invariant_index);
+                size_t dscale_offset = invariant_offsets[4];
+                size_t dbias_offset  = invariant_offsets[4];
 
                 arg.p_dscale_[dscale_offset] = type_convert<DscaleDbiasDataType>(dscale);
                 arg.p_dbias_[dbias_offset]   = type_convert<DscaleDbiasDataType>(dbias);
 
-                size_t scale_offset =
-                    get_offset_from_index<NumInvariantDim>(arg.bnScaleStrides_, invariant_index);
+                size_t scale_offset = invariant_offsets[5];
 
                 AccDataType scale = type_convert<AccDataType>(arg.p_scale_[scale_offset]);
 
@@ -280,18 +264,10 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                 // 1) calculate tmp = dscale * (x - mean) * inv-variance
                 // 2) calculate dx = 1/reduceSize * inv-variance * scale * (reduceSize * dy - dbias
                 // - tmp)
-                for(const auto& reduce_index : arg.reduce_index_set_)
-                {
-                    size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.x_reduce_strides_, reduce_index);
-                    size_t dy_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.dy_reduce_strides_, reduce_index);
-                    size_t dx_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.dx_reduce_strides_, reduce_index);
-
-                    auto x_offset  = x_invariant_offset + x_reduce_offset;
-                    auto dy_offset = dy_invariant_offset + dy_reduce_offset;
-                    auto dx_offset = dx_invariant_offset + dx_reduce_offset;
+                reduce_range.ForEach([&](auto, const auto& reduce_offsets) {
+                    auto x_offset  = x_invariant_offset + reduce_offsets[0];
+                    auto dy_offset = dy_invariant_offset + reduce_offsets[1];
+                    auto dx_offset = dx_invariant_offset + reduce_offsets[2];
 
                     AccDataType x = type_convert<AccDataType>(arg.p_x_[x_offset]);
 
@@ -306,30 +282,17 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                                                    dbias - tmpVal);
 
                     arg.p_dx_[dx_offset] = type_convert<DxDataType>(dx);
-                };
+                });
             };
 
-            std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
-
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
-                    for(std::size_t i = i_begin; i < i_end; ++i)
-                    {
-                        thread_reduce_func(arg.invariant_index_set_[i]);
-                    }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+            make_host_index_odometer<NumInvariantDim>(arg.invariant_lengths_,
+                                                      arg.x_invariant_strides_,
+                                                      arg.dy_invariant_strides_,
+                                                      arg.dx_invariant_strides_,
+                                                      arg.bnMeanVarStrides_,
+                                                      arg.bnDscaleDbiasStrides_,
+                                                      arg.bnScaleStrides_)
+                .ParallelForEach(thread_reduce_func);
 
             return (0.0f);
         };
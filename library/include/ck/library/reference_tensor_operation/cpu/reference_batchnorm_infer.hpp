@@ -69,8 +69,6 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
               estimatedVariance_(estimatedVariance),
               p_y_(p_y)
         {
-            using ck::host_common::get_index_set;
-
             if(std::any_of(
                    reduceDims.begin(), reduceDims.end(), [](int d) { return d < 0 || d >= Rank; }))
                 throw std::runtime_error("Invalid reduce dimensions!");
@@ -113,9 +111,6 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
                 i++;
             };
 
-            invariant_index_set_ = get_index_set<NumInvariantDim>(invariant_lengths_);
-            reduce_index_set_    = get_index_set<NumBatchNormReduceDim>(reduce_lengths_);
-
             epsilon_ = type_convert<AccDataType>(epsilon);
         }
 
@@ -144,9 +139,6 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
 
         YDataType* p_y_;
 
-        std::vector<std::array<index_t, NumInvariantDim>> invariant_index_set_;
-        std::vector<std::array<index_t, NumBatchNormReduceDim>> reduce_index_set_;
-
         AccDataType epsilon_;
     };
 
@@ -154,16 +146,17 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
     {
         float Run(const Argument& arg)
         {
-            using ck::host_common::get_offset_from_index;
+            using ck::host_common::make_host_index_odometer;
+
+            const auto reduce_odometer = make_host_index_odometer<NumBatchNormReduceDim>(
+                arg.reduce_lengths_, arg.x_reduce_strides_, arg.y_reduce_strides_);
 
-            auto thread_reduce_func = [&](auto invariant_index) {
-                size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.x_invariant_strides_, invariant_index);
-                size_t y_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.y_invariant_strides_, invariant_index);
+            // offsets of x, y, the mean/variance, the scale and the bias
+            auto thread_reduce_func = [&](auto, const auto& invariant_offsets) {
+                size_t x_invariant_offset = invariant_offsets[0];
+                size_t y_invariant_offset = invariant_offsets[1];
 
-                size_t mean_variance_offset =
-                    get_offset_from_index<NumInvariantDim>(arg.bnMeanVarStrides_, invariant_index);
+                size_t mean_variance_offset = invariant_offsets[2];
 
                 AccDataType mean     = arg.estimatedMean_[mean_variance_offset];
                 AccDataType variance = arg.estimatedVariance_[mean_variance_offset];
@@ -172,24 +165,18 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
                 AccDataType invVariance =
                     type_convert<AccDataType>(1.0f) / std::sqrt(arg.epsilon_ + variance);
 
-                size_t scale_offset =
-                    get_offset_from_index<NumInvariantDim>(arg.bnScaleStrides_, invariant_index);
-                size_t bias_offset =
-                    get_offset_from_index<NumInvariantDim>(arg.bnBiasStrides_, invariant_index);
+                size_t scale_offset = invariant_offsets[3];
+                size_t bias_offset  = invariant_offsets[4];
 
                 AccDataType scale = type_convert<AccDataType>(arg.bnScale_[scale_offset]);
                 AccDataType bias  = type_convert<AccDataType>(arg.bnBias_[bias_offset]);
 
-                // normalization
-                for(const auto& reduce_index : arg.reduce_index_set_)
-                {
-                    size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.x_reduce_strides_, reduce_index);
-                    size_t y_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.y_reduce_strides_, reduce_index);
+                auto reduce_range = reduce_odometer;
 
-                    auto x_offset = x_invariant_offset + x_reduce_offset;
-                    auto y_offset = y_invariant_offset + y_reduce_offset;
+                // normalization
+                reduce_range.ForEach([&](auto, const auto& reduce_offsets) {
+                    auto x_offset = x_invariant_offset + reduce_offsets[0];
+                    auto y_offset = y_invariant_offset + reduce_offsets[1];
 
                     AccDataType x = type_convert<AccDataType>(arg.p_x_[x_offset]);
 
@@ -200,30 +187,16 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
                     arg.y_elementwise_op_(y, y);
 
                     arg.p_y_[y_offset] = type_convert<YDataType>(y);
-                };
+                });
             };
 
-            std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
-
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
-                    for(std::size_t i = i_begin; i < i_end; ++i)
-                    {
-                        thread_reduce_func(arg.invariant_index_set_[i]);
-                    }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+            make_host_index_odometer<NumInvariantDim>(arg.invariant_lengths_,
+                                                      arg.x_invariant_strides_,
+                                                      arg.y_invariant_strides_,
+                                                      arg.bnMeanVarStrides_,
+                                                      arg.bnScaleStrides_,
+                                                      arg.bnBiasStrides_)
+                .ParallelForEach(thread_reduce_func);
 
             return (0.0f);
         };
@@ -10,6 +10,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -100,171 +101,59 @@ struct ReferenceColumnToImage : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            const index_t N = arg.output_.GetLengths()[1];
-            const index_t C = arg.output_.GetLengths()[2];
-
-            if constexpr(NDimSpatial == 1)
-            {
-                const index_t Wo = arg.output_spatial_lengths_[0];
-                auto func        = [&](auto n) {
-                    for(index_t wo = 0; wo < Wo; ++wo)
-                    {
-                        index_t row    = n * Wo + wo;
-                        index_t column = 0;
-
-                        for(index_t x = 0; x < arg.filter_spatial_lengths_[0]; ++x)
-                        {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                            for(index_t c = 0; c < C; ++c)
-                            {
-                                if(wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.output_.GetLengths()[3])
-                                {
-                                    float v_in  = ck::type_convert<float>(arg.input_(row, column));
-                                    float v_out = ck::type_convert<float>(arg.output_(0, n, c, wi));
-                                    arg.output_(0, n, c, wi) =
-                                        ck::type_convert<OutDataType>(v_in + v_out);
-                                }
-                                column++;
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 2)
-            {
-                const index_t Ho = arg.output_spatial_lengths_[0];
-                const index_t Wo = arg.output_spatial_lengths_[1];
-
-                auto func = [&](auto n) {
-                    for(index_t ho = 0; ho < Ho; ++ho)
-                    {
-                        for(index_t wo = 0; wo < Wo; ++wo)
-                        {
-                            index_t row    = n * Ho * Wo + ho * Wo + wo;
-                            index_t column = 0;
-
-                            for(index_t y = 0; y < arg.filter_spatial_lengths_[0]; ++y)
-                            {
-                                auto hi =
-                                    static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                    static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                                for(index_t x = 0; x < arg.filter_spatial_lengths_[1]; ++x)
-                                {
-                                    auto wi =
-                                        static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                        static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                                    for(index_t c = 0; c < C; ++c)
-                                    {
-
-                                        if(hi >= 0 &&
-                                           ck::type_convert<std::size_t>(hi) <
-                                               arg.output_.GetLengths()[3] &&
-                                           wi >= 0 &&
-                                           ck::type_convert<std::size_t>(wi) <
-                                               arg.output_.GetLengths()[4])
-                                        {
-                                            float v_in =
-                                                ck::type_convert<float>(arg.input_(row, column));
-                                            float v_out = ck::type_convert<float>(
-                                                arg.output_(0, n, c, hi, wi));
-                                            arg.output_(0, n, c, hi, wi) =
-                                                ck::type_convert<OutDataType>(v_in + v_out);
-                                        }
-                                        column++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 3)
-            {
-                const index_t Do = arg.output_spatial_lengths_[0];
-                const index_t Ho = arg.output_spatial_lengths_[1];
-                const index_t Wo = arg.output_spatial_lengths_[2];
-
-                auto func = [&](auto n) {
-                    for(index_t d_o = 0; d_o < Do; ++d_o)
-                    {
-                        for(index_t ho = 0; ho < Ho; ++ho)
-                        {
-                            for(index_t wo = 0; wo < Wo; ++wo)
-                            {
-                                index_t row    = n * Do * Ho * Wo + d_o * Ho * Wo + ho * Wo + wo;
-                                index_t column = 0;
-
-                                for(index_t z = 0; z < arg.filter_spatial_lengths_[0]; ++z)
-                                {
-                                    auto di =
-                                        static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
-                                        static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                                    for(index_t y = 0; y < arg.filter_spatial_lengths_[1]; ++y)
-                                    {
-                                        auto hi =
-                                            static_cast<ck::long_index_t>(ho *
-                                                                          arg.conv_strides_[1]) +
-                                            static_cast<ck::long_index_t>(y *
-                                                                          arg.conv_dilations_[1]) -
-                                            static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                                        for(index_t x = 0; x < arg.filter_spatial_lengths_[2]; ++x)
-                                        {
-                                            auto wi =
-                                                static_cast<ck::long_index_t>(
-                                                    wo * arg.conv_strides_[2]) +
-                                                static_cast<ck::long_index_t>(
-                                                    x * arg.conv_dilations_[2]) -
-                                                static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-                                            for(index_t c = 0; c < C; ++c)
-                                            {
-                                                if(di >= 0 &&
-                                                   ck::type_convert<std::size_t>(di) <
-                                                       arg.output_.GetLengths()[3] &&
-                                                   hi >= 0 &&
-                                                   ck::type_convert<std::size_t>(hi) <
-                                                       arg.output_.GetLengths()[4] &&
-                                                   wi >= 0 &&
-                                                   ck::type_convert<std::size_t>(wi) <
-                                                       arg.output_.GetLengths()[5])
-                                                {
-                                                    float v_in = ck::type_convert<float>(
-                                                        arg.input_(row, column));
-                                                    float v_out = ck::type_convert<float>(
-                                                        arg.output_(0, n, c, di, hi, wi));
-                                                    arg.output_(0, n, c, di, hi, wi) =
-                                                        ck::type_convert<OutDataType>(v_in + v_out);
-                                                }
-                                                column++;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
+            const host_common::HostConvIm2Col<NDimSpatial> im2col(
+                arg.output_.mDesc,
+                arg.filter_spatial_lengths_.begin(),
+                arg.output_spatial_lengths_.begin(),
+                arg.conv_strides_,
+                arg.conv_dilations_,
+                arg.in_left_pads_);
+
+            const auto& in_strides = arg.input_.GetStrides();
+
+            const std::size_t N  = arg.output_.GetLengths()[1];
+            const std::size_t C  = arg.output_.GetLengths()[2];
+            const std::size_t Di = arg.output_.GetLengths()[3];
+
+            // every image is split into bands along its first spatial dimension, so that small
+            // batches still keep the workers busy; a band is written by one worker only, from
+            // the rows that its windows overlap
+            constexpr std::size_t MinNumTask = 64;
+
+            const std::size_t num_band =
+                std::clamp<std::size_t>((MinNumTask + N - 1) / N, 1, std::max<std::size_t>(Di, 1));
+            const std::size_t band_size = (Di + num_band - 1) / num_band;
+
+            auto accumulate = [&](std::size_t offset, const InDataType& v_in) {
+                const float v_out = ck::type_convert<float>(arg.output_.mData[offset]);
+
+                arg.output_.mData[offset] =
+                    ck::type_convert<OutDataType>(ck::type_convert<float>(v_in) + v_out);
+            };
+
+            // columns in [Z, Y, X, C] order, added to the output in increasing (row, column)
+            // order whatever the number of workers
+            auto f_band = [&](std::size_t task) {
+                const std::size_t n          = task / num_band;
+                const std::size_t band_begin = task % num_band * band_size;
+                const std::size_t band_end   = std::min(band_begin + band_size, Di);
+
+                const auto [row_begin, row_end] = im2col.GetBandRows(n, band_begin, band_end);
+
+                im2col.ScatterRows(arg.input_.data() + row_begin * in_strides[0],
+                                   in_strides[0],
+                                   in_strides[1],
+                                   C * in_strides[1],
+                                   row_begin,
+                                   row_end - row_begin,
+                                   band_begin,
+                                   band_end,
+                                   accumulate);
+            };
+
+            host_common::host_parallel_for(N * num_band, f_band);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
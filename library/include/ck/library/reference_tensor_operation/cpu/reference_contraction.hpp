@@ -57,38 +57,44 @@ struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::Base
     {
         using Argument = ReferenceContraction_M2_N2_K2::Argument;
 
-        float Run(const Argument& arg)
+        // Element idx = [m0, m1, n0, n1] of C, computed on its own; point-wise evaluator of
+        // sampled verification
+        template <typename Index>
+        static CDataType ComputeElement(const Argument& arg, const Index& idx)
         {
-            auto f_ms_ns = [&](auto m0, auto m1, auto n0, auto n1) {
-                const ck::index_t K0 = arg.a_ms_ks_.mDesc.GetLengths()[2];
-                const ck::index_t K1 = arg.a_ms_ks_.mDesc.GetLengths()[3];
+            const ck::index_t K0 = arg.a_ms_ks_.mDesc.GetLengths()[2];
+            const ck::index_t K1 = arg.a_ms_ks_.mDesc.GetLengths()[3];
 
-                AccDataType v_acc = 0;
+            AccDataType v_acc = 0;
 
-                for(ck::index_t k0 = 0; k0 < K0; ++k0)
+            for(ck::index_t k0 = 0; k0 < K0; ++k0)
+            {
+                for(ck::index_t k1 = 0; k1 < K1; ++k1)
                 {
-                    for(ck::index_t k1 = 0; k1 < K1; ++k1)
-                    {
-                        AccDataType v_a;
-                        AccDataType v_b;
-
-                        arg.a_element_op_(
-                            v_a, ck::type_convert<const AccDataType>(arg.a_ms_ks_(m0, m1, k0, k1)));
-                        arg.b_element_op_(
-                            v_b, ck::type_convert<const AccDataType>(arg.b_ns_ks_(n0, n1, k0, k1)));
-
-                        v_acc += v_a * v_b;
-                    }
+                    AccDataType v_a;
+                    AccDataType v_b;
+
+                    arg.a_element_op_(
+                        v_a,
+                        ck::type_convert<const AccDataType>(arg.a_ms_ks_(idx[0], idx[1], k0, k1)));
+                    arg.b_element_op_(
+                        v_b,
+                        ck::type_convert<const AccDataType>(arg.b_ns_ks_(idx[2], idx[3], k0, k1)));
+
+                    v_acc += v_a * v_b;
                 }
+            }
 
-                arg.c_ms_ns_(m0, m1, n0, n1) = v_acc;
+            return v_acc;
+        }
+
+        float Run(const Argument& arg)
+        {
+            auto f_ms_ns = [&](const auto& idx, std::size_t offset) {
+                arg.c_ms_ns_.mData[offset] = ComputeElement(arg, idx);
             };
 
-            make_ParallelTensorFunctor(f_ms_ns,
-                                       arg.c_ms_ns_.mDesc.GetLengths()[0],
-                                       arg.c_ms_ns_.mDesc.GetLengths()[1],
-                                       arg.c_ms_ns_.mDesc.GetLengths()[2],
-                                       arg.c_ms_ns_.mDesc.GetLengths()[3])(
+            make_ParallelTensorFunctorNd<4>(f_ms_ns, arg.c_ms_ns_.mDesc)(
                 std::thread::hardware_concurrency());
 
             return 0;
@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -73,218 +74,193 @@ struct ReferenceConvBwdData : public device::BaseOperator
     {
         using Argument = ReferenceConvBwdData::Argument;
 
-        float Run(const Argument& arg)
+        // Input gradient element idx = [g, n, c, wi...], computed on its own; point-wise
+        // evaluator of sampled verification
+        static InDataType ComputeElement(const Argument& arg,
+                                         const std::array<std::size_t, NDimSpatial + 3>& idx)
         {
-            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
-            {
-                throw std::runtime_error("wrong! inconsistent dimension");
-            }
-
             if constexpr(NDimSpatial == 1)
             {
-                auto f_ncw = [&](auto g, auto n, auto c, auto wi) {
-                    std::size_t K  = arg.weight_.GetLengths()[1];
-                    std::size_t X  = arg.weight_.GetLengths()[3];
-                    std::size_t Wo = arg.output_.GetLengths()[3];
+                const auto [g, n, c, wi] = idx;
+
+                std::size_t K  = arg.weight_.GetLengths()[1];
+                std::size_t X  = arg.weight_.GetLengths()[3];
+                std::size_t Wo = arg.output_.GetLengths()[3];
 
-                    float v_acc = 0;
+                float v_acc = 0;
 
-                    for(std::size_t x = 0; x < X; ++x)
+                for(std::size_t x = 0; x < X; ++x)
+                {
+                    auto w_tmp = static_cast<ck::long_index_t>(wi) +
+                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
+                                 static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]);
+
+                    if(w_tmp % arg.conv_strides_[0] == 0)
                     {
-                        auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                     static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                     static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]);
+                        auto wo = static_cast<ck::long_index_t>(w_tmp) /
+                                  static_cast<ck::long_index_t>(arg.conv_strides_[0]);
 
-                        if(w_tmp % arg.conv_strides_[0] == 0)
+                        if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
                         {
-                            auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                      static_cast<ck::long_index_t>(arg.conv_strides_[0]);
-
-                            if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
+                            for(std::size_t k = 0; k < K; ++k)
                             {
-                                for(std::size_t k = 0; k < K; ++k)
-                                {
-                                    float v_out = 0;
-                                    float v_wei = 0;
+                                float v_out = 0;
+                                float v_wei = 0;
 
-                                    arg.out_element_op_(
-                                        v_out, ck::type_convert<float>(arg.output_(g, n, k, wo)));
+                                arg.out_element_op_(
+                                    v_out, ck::type_convert<float>(arg.output_(g, n, k, wo)));
 
-                                    arg.wei_element_op_(
-                                        v_wei, ck::type_convert<float>(arg.weight_(g, k, c, x)));
+                                arg.wei_element_op_(
+                                    v_wei, ck::type_convert<float>(arg.weight_(g, k, c, x)));
 
-                                    v_acc += v_out * v_wei;
-                                }
+                                v_acc += v_out * v_wei;
                             }
                         }
                     }
+                }
 
-                    float v_in;
-
-                    arg.in_element_op_(v_in, v_acc);
+                float v_in;
 
-                    arg.input_(g, n, c, wi) = ck::type_convert<InDataType>(v_in);
-                };
+                arg.in_element_op_(v_in, v_acc);
 
-                make_ParallelTensorFunctor(f_ncw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-
-                return 0;
+                return ck::type_convert<InDataType>(v_in);
             }
             else if constexpr(NDimSpatial == 2)
             {
-                auto f_nchw = [&](auto g, auto n, auto c, auto hi, auto wi) {
-                    std::size_t K = arg.weight_.GetLengths()[1];
-                    std::size_t Y = arg.weight_.GetLengths()[3];
-                    std::size_t X = arg.weight_.GetLengths()[4];
+                const auto [g, n, c, hi, wi] = idx;
+
+                std::size_t K = arg.weight_.GetLengths()[1];
+                std::size_t Y = arg.weight_.GetLengths()[3];
+                std::size_t X = arg.weight_.GetLengths()[4];
 
-                    std::size_t Ho = arg.output_.GetLengths()[3];
-                    std::size_t Wo = arg.output_.GetLengths()[4];
+                std::size_t Ho = arg.output_.GetLengths()[3];
+                std::size_t Wo = arg.output_.GetLengths()[4];
 
-                    float v_acc = 0;
+                float v_acc = 0;
 
-                    for(std::size_t y = 0; y < Y; ++y)
+                for(std::size_t y = 0; y < Y; ++y)
+                {
+                    auto h_tmp = static_cast<ck::long_index_t>(hi) +
+                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
+                                 static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]);
+                    if(h_tmp % arg.conv_strides_[0] == 0)
                     {
-                        auto h_tmp = static_cast<ck::long_index_t>(hi) +
-                                     static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                     static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]);
-                        if(h_tmp % arg.conv_strides_[0] == 0)
+                        auto ho = static_cast<ck::long_index_t>(h_tmp) /
+                                  static_cast<ck::long_index_t>(arg.conv_strides_[0]);
+                        if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
                         {
-                            auto ho = static_cast<ck::long_index_t>(h_tmp) /
-                                      static_cast<ck::long_index_t>(arg.conv_strides_[0]);
-                            if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
+                            for(std::size_t x = 0; x < X; ++x)
                             {
-                                for(std::size_t x = 0; x < X; ++x)
+                                auto w_tmp =
+                                    static_cast<ck::long_index_t>(wi) +
+                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
+                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]);
+                                if(w_tmp % arg.conv_strides_[1] == 0)
                                 {
-                                    auto w_tmp =
-                                        static_cast<ck::long_index_t>(wi) +
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                        static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]);
-                                    if(w_tmp % arg.conv_strides_[1] == 0)
+                                    auto wo = static_cast<ck::long_index_t>(w_tmp) /
+                                              static_cast<ck::long_index_t>(arg.conv_strides_[1]);
+                                    if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
                                     {
-                                        auto wo =
-                                            static_cast<ck::long_index_t>(w_tmp) /
-                                            static_cast<ck::long_index_t>(arg.conv_strides_[1]);
-                                        if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
+                                        for(std::size_t k = 0; k < K; ++k)
                                         {
-                                            for(std::size_t k = 0; k < K; ++k)
-                                            {
-                                                float v_out = 0;
-                                                float v_wei = 0;
+                                            float v_out = 0;
+                                            float v_wei = 0;
 
-                                                arg.out_element_op_(
-                                                    v_out,
-                                                    ck::type_convert<float>(
-                                                        arg.output_(g, n, k, ho, wo)));
+                                            arg.out_element_op_(
+                                                v_out,
+                                                ck::type_convert<float>(
+                                                    arg.output_(g, n, k, ho, wo)));
 
-                                                arg.wei_element_op_(
-                                                    v_wei,
-                                                    ck::type_convert<float>(
-                                                        arg.weight_(g, k, c, y, x)));
+                                            arg.wei_element_op_(
+                                                v_wei,
+                                                ck::type_convert<float>(
+                                                    arg.weight_(g, k, c, y, x)));
 
-                                                v_acc += v_out * v_wei;
-                                            }
+                                            v_acc += v_out * v_wei;
                                         }
                                     }
                                 }
                             }
                         }
                     }
+                }
 
-                    float v_in;
+                float v_in;
 
-                    arg.in_element_op_(v_in, v_acc);
+                arg.in_element_op_(v_in, v_acc);
 
-                    arg.input_(g, n, c, hi, wi) = ck::type_convert<InDataType>(v_in);
-                };
-
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3],
-                                           arg.input_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
-
-                return 0;
+                return ck::type_convert<InDataType>(v_in);
             }
             else if constexpr(NDimSpatial == 3)
             {
-                auto f_ncdhw = [&](auto g, auto n, auto c, auto di, auto hi, auto wi) {
-                    std::size_t K = arg.weight_.GetLengths()[1];
-                    std::size_t Z = arg.weight_.GetLengths()[3];
-                    std::size_t Y = arg.weight_.GetLengths()[4];
-                    std::size_t X = arg.weight_.GetLengths()[5];
+                const auto [g, n, c, di, hi, wi] = idx;
+
+                std::size_t K = arg.weight_.GetLengths()[1];
+                std::size_t Z = arg.weight_.GetLengths()[3];
+                std::size_t Y = arg.weight_.GetLengths()[4];
+                std::size_t X = arg.weight_.GetLengths()[5];
 
-                    std::size_t Do = arg.output_.GetLengths()[3];
-                    std::size_t Ho = arg.output_.GetLengths()[4];
-                    std::size_t Wo = arg.output_.GetLengths()[5];
+                std::size_t Do = arg.output_.GetLengths()[3];
+                std::size_t Ho = arg.output_.GetLengths()[4];
+                std::size_t Wo = arg.output_.GetLengths()[5];
 
-                    float v_acc = 0;
+                float v_acc = 0;
 
-                    for(std::size_t z = 0; z < Z; ++z)
+                for(std::size_t z = 0; z < Z; ++z)
+                {
+                    auto d_tmp = static_cast<ck::long_index_t>(di) +
+                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
+                                 static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]);
+                    if(d_tmp % arg.conv_strides_[0] == 0)
                     {
-                        auto d_tmp = static_cast<ck::long_index_t>(di) +
-                                     static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                     static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]);
-                        if(d_tmp % arg.conv_strides_[0] == 0)
+                        auto do_ = static_cast<ck::long_index_t>(d_tmp) /
+                                   static_cast<ck::long_index_t>(arg.conv_strides_[0]);
+                        if(do_ >= 0 && ck::type_convert<std::size_t>(do_) < Do)
                         {
-                            auto do_ = static_cast<ck::long_index_t>(d_tmp) /
-                                       static_cast<ck::long_index_t>(arg.conv_strides_[0]);
-                            if(do_ >= 0 && ck::type_convert<std::size_t>(do_) < Do)
+                            for(std::size_t y = 0; y < Y; ++y)
                             {
-                                for(std::size_t y = 0; y < Y; ++y)
+                                auto h_tmp =
+                                    static_cast<ck::long_index_t>(hi) +
+                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
+                                    static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]);
+                                if(h_tmp % arg.conv_strides_[1] == 0)
                                 {
-                                    auto h_tmp =
-                                        static_cast<ck::long_index_t>(hi) +
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                        static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]);
-                                    if(h_tmp % arg.conv_strides_[1] == 0)
+                                    auto ho = static_cast<ck::long_index_t>(h_tmp) /
+                                              static_cast<ck::long_index_t>(arg.conv_strides_[1]);
+                                    if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
                                     {
-                                        auto ho =
-                                            static_cast<ck::long_index_t>(h_tmp) /
-                                            static_cast<ck::long_index_t>(arg.conv_strides_[1]);
-                                        if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
+                                        for(std::size_t x = 0; x < X; ++x)
                                         {
-                                            for(std::size_t x = 0; x < X; ++x)
-                                            {
-                                                auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                                             static_cast<ck::long_index_t>(
-                                                                 arg.in_left_pads_[2]) -
-                                                             static_cast<ck::long_index_t>(
-                                                                 x * arg.conv_dilations_[2]);
+                                            auto w_tmp = static_cast<ck::long_index_t>(wi) +
+                                                         static_cast<ck::long_index_t>(
+                                                             arg.in_left_pads_[2]) -
+                                                         static_cast<ck::long_index_t>(
+                                                             x * arg.conv_dilations_[2]);
 
-                                                if(w_tmp % arg.conv_strides_[2] == 0)
+                                            if(w_tmp % arg.conv_strides_[2] == 0)
+                                            {
+                                                auto wo = static_cast<ck::long_index_t>(w_tmp) /
+                                                          static_cast<ck::long_index_t>(
+                                                              arg.conv_strides_[2]);
+                                                if(wo >= 0 &&
+                                                   ck::type_convert<std::size_t>(wo) < Wo)
                                                 {
-                                                    auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                                              static_cast<ck::long_index_t>(
-                                                                  arg.conv_strides_[2]);
-                                                    if(wo >= 0 &&
-                                                       ck::type_convert<std::size_t>(wo) < Wo)
+                                                    for(std::size_t k = 0; k < K; ++k)
                                                     {
-                                                        for(std::size_t k = 0; k < K; ++k)
-                                                        {
-                                                            float v_out = 0;
-                                                            float v_wei = 0;
-
-                                                            arg.out_element_op_(
-                                                                v_out,
-                                                                ck::type_convert<float>(arg.output_(
-                                                                    g, n, k, do_, ho, wo)));
-
-                                                            arg.wei_element_op_(
-                                                                v_wei,
-                                                                ck::type_convert<float>(
-                                                                    arg.weight_(g, k, c, z, y, x)));
-
-                                                            v_acc += v_out * v_wei;
-                                                        }
+                                                        float v_out = 0;
+                                                        float v_wei = 0;
+
+                                                        arg.out_element_op_(
+                                                            v_out,
+                                                            ck::type_convert<float>(
+                                                                arg.output_(g, n, k, do_, ho, wo)));
+
+                                                        arg.wei_element_op_(
+                                                            v_wei,
+                                                            ck::type_convert<float>(
+                                                                arg.weight_(g, k, c, z, y, x)));
+
+                                                        v_acc += v_out * v_wei;
                                                     }
                                                 }
                                             }
@@ -294,25 +270,87 @@ struct ReferenceConvBwdData : public device::BaseOperator
                             }
                         }
                     }
+                }
+
+                float v_in;
+
+                arg.in_element_op_(v_in, v_acc);
 
-                    float v_in;
+                return ck::type_convert<InDataType>(v_in);
+            }
+        }
+
+        static InDataType ComputeElement(const Argument& arg, const std::vector<std::size_t>& idx)
+        {
+            if(idx.size() != NDimSpatial + 3)
+                throw std::runtime_error("wrong! inconsistent dimension");
+
+            std::array<std::size_t, NDimSpatial + 3> index;
+
+            std::copy_n(idx.begin(), NDimSpatial + 3, index.begin());
 
-                    arg.in_element_op_(v_in, v_acc);
+            return ComputeElement(arg, index);
+        }
 
-                    arg.input_(g, n, c, di, hi, wi) = ck::type_convert<InDataType>(v_in);
-                };
+        float Run(const Argument& arg)
+        {
+            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
 
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3],
-                                           arg.input_.GetLengths()[4],
-                                           arg.input_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
 
-                return 0;
+            if(!(in_lengths[0] == wei_lengths[0] && out_lengths[0] == wei_lengths[0] &&
+                 in_lengths[1] == out_lengths[1] && in_lengths[2] == wei_lengths[2] &&
+                 out_lengths[2] == wei_lengths[1]))
+            {
+                throw std::runtime_error("wrong! inconsistent lengths");
             }
+
+            auto out_convert = [&](const OutDataType& out) {
+                float v_out;
+
+                arg.out_element_op_(v_out, ck::type_convert<float>(out));
+
+                return v_out;
+            };
+
+            auto wei_convert = [&](const WeiDataType& wei) {
+                float v_wei;
+
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(wei));
+
+                return v_wei;
+            };
+
+            auto in_store = [&](std::size_t offset, float v_acc) {
+                float v_in;
+
+                arg.in_element_op_(v_in, v_acc);
+
+                arg.input_.mData[offset] = ck::type_convert<InDataType>(v_in);
+            };
+
+            // one stride-free sub-convolution per stride phase, same accumulation order as
+            // ComputeElement(); only non-finite weights differ, see host_conv_bwd_data_packed()
+            host_common::host_conv_bwd_data_packed<float, NDimSpatial>(arg.input_.mDesc,
+                                                                       arg.output_.data(),
+                                                                       arg.output_.mDesc,
+                                                                       arg.weight_.data(),
+                                                                       arg.weight_.mDesc,
+                                                                       arg.conv_strides_,
+                                                                       arg.conv_dilations_,
+                                                                       arg.in_left_pads_,
+                                                                       out_convert,
+                                                                       wei_convert,
+                                                                       in_store);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -18,6 +19,7 @@ namespace host {
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
 // phyiscal layout is irrelavent
+// AccDataType is the precision of the reduction over N and the output pixels
 template <ck::index_t NDimSpatial,
           typename InDataType,
           typename WeiDataType,
@@ -27,6 +29,7 @@ template <ck::index_t NDimSpatial,
           typename OutElementwiseOperation,
           typename ComputeTypeA                                                     = OutDataType,
           typename ComputeTypeB                                                     = InDataType,
+          typename AccDataType                                                      = float,
           typename std::enable_if<NDimSpatial >= 1 && NDimSpatial <= 3, bool>::type = false>
 struct ReferenceConvBwdWeight : public device::BaseOperator
 {
@@ -75,196 +78,239 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
     {
         using Argument = ReferenceConvBwdWeight::Argument;
 
-        float Run(const Argument& arg)
+        // product of the operands as in the reduction, in AccDataType
+        static AccDataType ConvertProduct(const ComputeTypeA& v_out, const ComputeTypeB& v_in)
         {
-            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
-            {
-                throw std::runtime_error("wrong! inconsistent dimension");
-            }
+            return ck::type_convert<AccDataType>(ck::type_convert<float>(v_out)) *
+                   ck::type_convert<AccDataType>(ck::type_convert<float>(v_in));
+        }
 
+        // Weight gradient element idx = [g, k, c, x...], computed on its own; point-wise
+        // evaluator of sampled verification
+        static WeiDataType ComputeElement(const Argument& arg,
+                                          const std::array<std::size_t, NDimSpatial + 3>& idx)
+        {
             if constexpr(NDimSpatial == 1)
             {
-                auto f_kcx = [&](auto g, auto k, auto c, auto x) {
-                    float v_acc = 0;
+                const auto [g, k, c, x] = idx;
 
-                    for(std::size_t n = 0; n < arg.output_.GetLengths()[1]; ++n)
+                AccDataType v_acc = 0;
+
+                for(std::size_t n = 0; n < arg.output_.GetLengths()[1]; ++n)
+                {
+                    for(std::size_t wo = 0; wo < arg.output_.GetLengths()[3]; ++wo)
                     {
-                        for(std::size_t wo = 0; wo < arg.output_.GetLengths()[3]; ++wo)
+                        auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+
+                        if(wi >= 0 &&
+                           ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
                         {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+                            ComputeTypeA v_out;
+                            ComputeTypeB v_in;
+
+                            arg.out_element_op_(
+                                v_out, ck::type_convert<float>(arg.output_(g, n, k, wo)));
+
+                            arg.in_element_op_(
+                                v_in, ck::type_convert<float>(arg.input_(g, n, c, wi)));
+
+                            v_acc += ConvertProduct(v_out, v_in);
+                        }
+                    }
+                }
+
+                float v_wei;
+
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(v_acc));
 
-                            if(wi >= 0 &&
-                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
+                return ck::type_convert<WeiDataType>(v_wei);
+            }
+            else if constexpr(NDimSpatial == 2)
+            {
+                const auto [g, k, c, y, x] = idx;
+
+                std::size_t N = arg.output_.GetLengths()[1];
+
+                std::size_t Ho = arg.output_.GetLengths()[3];
+                std::size_t Wo = arg.output_.GetLengths()[4];
+
+                AccDataType v_acc = 0;
+
+                for(std::size_t n = 0; n < N; ++n)
+                {
+                    for(std::size_t ho = 0; ho < Ho; ++ho)
+                    {
+                        auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+
+                        for(std::size_t wo = 0; wo < Wo; ++wo)
+                        {
+                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
+                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
+                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
+
+                            if(hi >= 0 &&
+                               ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
+                               wi >= 0 &&
+                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
                             {
                                 ComputeTypeA v_out;
                                 ComputeTypeB v_in;
 
                                 arg.out_element_op_(
-                                    v_out, ck::type_convert<float>(arg.output_(g, n, k, wo)));
+                                    v_out, ck::type_convert<float>(arg.output_(g, n, k, ho, wo)));
 
                                 arg.in_element_op_(
-                                    v_in, ck::type_convert<float>(arg.input_(g, n, c, wi)));
+                                    v_in, ck::type_convert<float>(arg.input_(g, n, c, hi, wi)));
 
-                                v_acc += type_convert<float>(v_out) * type_convert<float>(v_in);
+                                v_acc += ConvertProduct(v_out, v_in);
                             }
                         }
                     }
+                }
 
-                    float v_wei;
-
-                    arg.wei_element_op_(v_wei, v_acc);
+                float v_wei;
 
-                    arg.weight_(g, k, c, x) = ck::type_convert<WeiDataType>(v_wei);
-                };
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(v_acc));
 
-                make_ParallelTensorFunctor(f_kcx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-
-                return 0;
+                return ck::type_convert<WeiDataType>(v_wei);
             }
-            else if constexpr(NDimSpatial == 2)
+            else if constexpr(NDimSpatial == 3)
             {
-                auto f_kcyx = [&](auto g, auto k, auto c, auto y, auto x) {
-                    std::size_t N = arg.output_.GetLengths()[1];
-
-                    std::size_t Ho = arg.output_.GetLengths()[3];
-                    std::size_t Wo = arg.output_.GetLengths()[4];
+                const auto [g, k, c, z, y, x] = idx;
 
-                    float v_acc = 0;
+                AccDataType v_acc = 0;
 
-                    for(std::size_t n = 0; n < N; ++n)
+                for(std::size_t n = 0; n < arg.output_.GetLengths()[1]; ++n)
+                {
+                    for(std::size_t do_ = 0; do_ < arg.output_.GetLengths()[3]; ++do_)
                     {
-                        for(std::size_t ho = 0; ho < Ho; ++ho)
+                        auto di = static_cast<ck::long_index_t>(do_ * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+                        for(std::size_t ho = 0; ho < arg.output_.GetLengths()[4]; ++ho)
                         {
-                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                            for(std::size_t wo = 0; wo < Wo; ++wo)
+                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
+                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
+                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
+                            for(std::size_t wo = 0; wo < arg.output_.GetLengths()[5]; ++wo)
                             {
                                 auto wi =
-                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                                if(hi >= 0 &&
-                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
+                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
+                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
+                                    static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
+
+                                if(di >= 0 &&
+                                   ck::type_convert<std::size_t>(di) < arg.input_.GetLengths()[3] &&
+                                   hi >= 0 &&
+                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[4] &&
                                    wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
+                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[5])
                                 {
                                     ComputeTypeA v_out;
                                     ComputeTypeB v_in;
 
-                                    arg.out_element_op_(
-                                        v_out,
-                                        ck::type_convert<float>(arg.output_(g, n, k, ho, wo)));
+                                    arg.out_element_op_(v_out,
+                                                        ck::type_convert<float>(
+                                                            arg.output_(g, n, k, do_, ho, wo)));
 
-                                    arg.in_element_op_(
-                                        v_in, ck::type_convert<float>(arg.input_(g, n, c, hi, wi)));
+                                    arg.in_element_op_(v_in,
+                                                       ck::type_convert<float>(
+                                                           arg.input_(g, n, c, di, hi, wi)));
 
-                                    v_acc += type_convert<float>(v_out) * type_convert<float>(v_in);
+                                    v_acc += ConvertProduct(v_out, v_in);
                                 }
                             }
                         }
                     }
+                }
 
-                    float v_wei;
+                float v_wei;
 
-                    arg.wei_element_op_(v_wei, v_acc);
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(v_acc));
 
-                    arg.weight_(g, k, c, y, x) = ck::type_convert<WeiDataType>(v_wei);
-                };
+                return ck::type_convert<WeiDataType>(v_wei);
+            }
+        }
+
+        static WeiDataType ComputeElement(const Argument& arg, const std::vector<std::size_t>& idx)
+        {
+            if(idx.size() != NDimSpatial + 3)
+                throw std::runtime_error("wrong! inconsistent dimension");
 
-                make_ParallelTensorFunctor(f_kcyx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3],
-                                           arg.weight_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+            std::array<std::size_t, NDimSpatial + 3> index;
 
-                return 0;
+            std::copy_n(idx.begin(), NDimSpatial + 3, index.begin());
+
+            return ComputeElement(arg, index);
+        }
+
+        float Run(const Argument& arg)
+        {
+            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
             }
-            else if constexpr(NDimSpatial == 3)
+
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            if(!(in_lengths[0] == wei_lengths[0] && out_lengths[0] == wei_lengths[0] &&
+                 in_lengths[1] == out_lengths[1] && in_lengths[2] == wei_lengths[2] &&
+                 out_lengths[2] == wei_lengths[1]))
             {
-                auto f_kczyx = [&](auto g, auto k, auto c, auto z, auto y, auto x) {
-                    float v_acc = 0;
+                throw std::runtime_error("wrong! inconsistent lengths");
+            }
 
-                    for(std::size_t n = 0; n < arg.output_.GetLengths()[1]; ++n)
-                    {
-                        for(std::size_t do_ = 0; do_ < arg.output_.GetLengths()[3]; ++do_)
-                        {
-                            auto di = static_cast<ck::long_index_t>(do_ * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                            for(std::size_t ho = 0; ho < arg.output_.GetLengths()[4]; ++ho)
-                            {
-                                auto hi =
-                                    static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
-                                    static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                                for(std::size_t wo = 0; wo < arg.output_.GetLengths()[5]; ++wo)
-                                {
-                                    auto wi =
-                                        static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
-                                        static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-
-                                    if(di >= 0 &&
-                                       ck::type_convert<std::size_t>(di) <
-                                           arg.input_.GetLengths()[3] &&
-                                       hi >= 0 &&
-                                       ck::type_convert<std::size_t>(hi) <
-                                           arg.input_.GetLengths()[4] &&
-                                       wi >= 0 &&
-                                       ck::type_convert<std::size_t>(wi) <
-                                           arg.input_.GetLengths()[5])
-                                    {
-                                        ComputeTypeA v_out;
-                                        ComputeTypeB v_in;
-
-                                        arg.out_element_op_(v_out,
-                                                            ck::type_convert<float>(
-                                                                arg.output_(g, n, k, do_, ho, wo)));
-
-                                        arg.in_element_op_(v_in,
-                                                           ck::type_convert<float>(
-                                                               arg.input_(g, n, c, di, hi, wi)));
-
-                                        v_acc +=
-                                            type_convert<float>(v_out) * type_convert<float>(v_in);
-                                    }
-                                }
-                            }
-                        }
-                    }
+            // dW = dY^T x im2col(X) per group, with the reduction split across workers
+            const host_common::HostConvIm2Col<NDimSpatial> im2col(arg.input_.mDesc,
+                                                                  wei_lengths.begin() + 3,
+                                                                  out_lengths.begin() + 3,
+                                                                  arg.conv_strides_,
+                                                                  arg.conv_dilations_,
+                                                                  arg.in_left_pads_);
 
-                    float v_wei;
+            auto in_convert = [&](const InDataType& in) {
+                ComputeTypeB v_in;
 
-                    arg.wei_element_op_(v_wei, v_acc);
+                arg.in_element_op_(v_in, ck::type_convert<float>(in));
 
-                    arg.weight_(g, k, c, z, y, x) = ck::type_convert<WeiDataType>(v_wei);
-                };
+                return ck::type_convert<AccDataType>(ck::type_convert<float>(v_in));
+            };
 
-                make_ParallelTensorFunctor(f_kczyx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3],
-                                           arg.weight_.GetLengths()[4],
-                                           arg.weight_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+            auto out_convert = [&](const OutDataType& out) {
+                ComputeTypeA v_out;
 
-                return 0;
-            }
+                arg.out_element_op_(v_out, ck::type_convert<float>(out));
+
+                return ck::type_convert<AccDataType>(ck::type_convert<float>(v_out));
+            };
+
+            auto wei_store = [&](std::size_t offset, AccDataType v_acc) {
+                float v_wei;
+
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(v_acc));
+
+                arg.weight_.mData[offset] = ck::type_convert<WeiDataType>(v_wei);
+            };
+
+            host_common::host_conv_bwd_weight_packed<AccDataType>(im2col,
+                                                                  arg.input_.data(),
+                                                                  arg.input_.GetStrides()[0],
+                                                                  arg.output_.data(),
+                                                                  arg.output_.mDesc,
+                                                                  arg.weight_.mDesc,
+                                                                  in_convert,
+                                                                  out_convert,
+                                                                  wei_store);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
@@ -9,6 +9,7 @@
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -48,9 +49,9 @@ struct ReferenceConvFwd : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<InDataType>& input,
-                 const Tensor<WeiDataType>& weight,
-                 Tensor<OutDataType>& output,
+        Argument(TensorView<const InDataType> input,
+                 TensorView<const WeiDataType> weight,
+                 TensorView<OutDataType> output,
                  std::vector<ck::index_t> conv_filter_strides,
                  std::vector<ck::index_t> conv_filter_dilations,
                  std::vector<ck::index_t> input_left_pads,
@@ -71,9 +72,9 @@ struct ReferenceConvFwd : public device::BaseOperator
         {
         }
 
-        const Tensor<InDataType>& input_;
-        const Tensor<WeiDataType>& weight_;
-        Tensor<OutDataType>& output_;
+        TensorView<const InDataType> input_;
+        TensorView<const WeiDataType> weight_;
+        TensorView<OutDataType> output_;
 
         std::vector<index_t> conv_strides_;
         std::vector<index_t> conv_dilations_;
@@ -89,188 +90,230 @@ struct ReferenceConvFwd : public device::BaseOperator
     {
         using Argument = ReferenceConvFwd::Argument;
 
-        float Run(const Argument& arg)
+        // Output element idx = [g, n, k, wo...], computed on its own; point-wise evaluator of
+        // sampled verification
+        static OutDataType ComputeElement(const Argument& arg,
+                                          const std::array<std::size_t, NDimSpatial + 3>& idx)
         {
-            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
-                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
-            {
-                throw std::runtime_error("wrong! inconsistent dimension");
-            }
-
             if constexpr(NDimSpatial == 1)
             {
-                auto func = [&](auto g, auto n, auto k, auto wo) {
-                    float v_acc = 0;
+                const auto [g, n, k, wo] = idx;
+
+                float v_acc = 0;
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                {
+                    for(std::size_t x = 0; x < arg.weight_.GetLengths()[3]; ++x)
                     {
-                        for(std::size_t x = 0; x < arg.weight_.GetLengths()[3]; ++x)
+                        auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+
+                        if(wi >= 0 &&
+                           ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
                         {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+                            float v_in;
+                            float v_wei;
+
+                            arg.in_element_op_(
+                                v_in, ck::type_convert<float>(arg.input_(g, n, c, wi)));
+
+                            arg.wei_element_op_(
+                                v_wei, ck::type_convert<float>(arg.weight_(g, k, c, x)));
+
+                            v_acc += v_in * v_wei;
+                        }
+                    }
+                }
+
+                float v_out;
+
+                arg.out_element_op_(v_out, v_acc);
 
-                            if(wi >= 0 &&
-                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
+                return ck::type_convert<OutDataType>(v_out);
+            }
+            else if constexpr(NDimSpatial == 2)
+            {
+                const auto [g, n, k, ho, wo] = idx;
+
+                float v_acc = 0;
+
+                for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                {
+                    for(std::size_t y = 0; y < arg.weight_.GetLengths()[3]; ++y)
+                    {
+                        auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+
+                        for(std::size_t x = 0; x < arg.weight_.GetLengths()[4]; ++x)
+                        {
+                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
+                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
+                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
+
+                            if(hi >= 0 &&
+                               ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
+                               wi >= 0 &&
+                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
                             {
                                 float v_in;
                                 float v_wei;
 
                                 arg.in_element_op_(
-                                    v_in, ck::type_convert<float>(arg.input_(g, n, c, wi)));
+                                    v_in, ck::type_convert<float>(arg.input_(g, n, c, hi, wi)));
 
                                 arg.wei_element_op_(
-                                    v_wei, ck::type_convert<float>(arg.weight_(g, k, c, x)));
+                                    v_wei, ck::type_convert<float>(arg.weight_(g, k, c, y, x)));
 
                                 v_acc += v_in * v_wei;
                             }
                         }
                     }
+                }
 
-                    float v_out;
-
-                    arg.out_element_op_(v_out, v_acc);
+                float v_out;
 
-                    arg.output_(g, n, k, wo) = ck::type_convert<OutDataType>(v_out);
-                };
+                arg.out_element_op_(v_out, v_acc);
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-
-                return 0;
+                return ck::type_convert<OutDataType>(v_out);
             }
-            else if constexpr(NDimSpatial == 2)
+            else if constexpr(NDimSpatial == 3)
             {
-                auto func = [&](auto g, auto n, auto k, auto ho, auto wo) {
-                    float v_acc = 0;
+                const auto [g, n, k, d_o, ho, wo] = idx;
+
+                float v_acc = 0;
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                {
+                    for(std::size_t z = 0; z < arg.weight_.GetLengths()[3]; ++z)
                     {
-                        for(std::size_t y = 0; y < arg.weight_.GetLengths()[3]; ++y)
+                        auto di = static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
+                                  static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
+                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
+                        for(std::size_t y = 0; y < arg.weight_.GetLengths()[4]; ++y)
                         {
-                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                            for(std::size_t x = 0; x < arg.weight_.GetLengths()[4]; ++x)
+                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
+                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
+                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
+                            for(std::size_t x = 0; x < arg.weight_.GetLengths()[5]; ++x)
                             {
                                 auto wi =
-                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                                if(hi >= 0 &&
-                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
+                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
+                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
+                                    static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
+                                if(di >= 0 &&
+                                   ck::type_convert<std::size_t>(di) < arg.input_.GetLengths()[3] &&
+                                   hi >= 0 &&
+                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[4] &&
                                    wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
+                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[5])
                                 {
                                     float v_in;
                                     float v_wei;
 
-                                    arg.in_element_op_(
-                                        v_in, ck::type_convert<float>(arg.input_(g, n, c, hi, wi)));
+                                    arg.in_element_op_(v_in,
+                                                       ck::type_convert<float>(
+                                                           arg.input_(g, n, c, di, hi, wi)));
 
                                     arg.wei_element_op_(
-                                        v_wei, ck::type_convert<float>(arg.weight_(g, k, c, y, x)));
+                                        v_wei,
+                                        ck::type_convert<float>(arg.weight_(g, k, c, z, y, x)));
 
                                     v_acc += v_in * v_wei;
                                 }
                             }
                         }
                     }
+                }
 
-                    float v_out;
+                float v_out;
 
-                    arg.out_element_op_(v_out, v_acc);
+                arg.out_element_op_(v_out, v_acc);
 
-                    arg.output_(g, n, k, ho, wo) = ck::type_convert<OutDataType>(v_out);
-                };
+                return ck::type_convert<OutDataType>(v_out);
+            }
+        }
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3],
-                                           arg.output_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+        static OutDataType ComputeElement(const Argument& arg, const std::vector<std::size_t>& idx)
+        {
+            if(idx.size() != NDimSpatial + 3)
+                throw std::runtime_error("wrong! inconsistent dimension");
+
+            std::array<std::size_t, NDimSpatial + 3> index;
 
-                return 0;
+            std::copy_n(idx.begin(), NDimSpatial + 3, index.begin());
+
+            return ComputeElement(arg, index);
+        }
+
+        float Run(const Argument& arg)
+        {
+            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
+                 arg.output_.GetNumOfDimension() == NDimSpatial + 3))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
             }
-            else if constexpr(NDimSpatial == 3)
+
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+            const auto& out_strides = arg.output_.GetStrides();
+
+            if(!(in_lengths[0] == wei_lengths[0] && out_lengths[0] == wei_lengths[0] &&
+                 in_lengths[1] == out_lengths[1] && in_lengths[2] == wei_lengths[2] &&
+                 out_lengths[2] == wei_lengths[1]))
             {
-                auto func = [&](auto g, auto n, auto k, auto d_o, auto ho, auto wo) {
-                    float v_acc = 0;
+                throw std::runtime_error("wrong! inconsistent lengths");
+            }
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
-                    {
-                        for(std::size_t z = 0; z < arg.weight_.GetLengths()[3]; ++z)
-                        {
-                            auto di = static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                            for(std::size_t y = 0; y < arg.weight_.GetLengths()[4]; ++y)
-                            {
-                                auto hi =
-                                    static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
-                                    static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                                for(std::size_t x = 0; x < arg.weight_.GetLengths()[5]; ++x)
-                                {
-                                    auto wi =
-                                        static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
-                                        static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-                                    if(di >= 0 &&
-                                       ck::type_convert<std::size_t>(di) <
-                                           arg.input_.GetLengths()[3] &&
-                                       hi >= 0 &&
-                                       ck::type_convert<std::size_t>(hi) <
-                                           arg.input_.GetLengths()[4] &&
-                                       wi >= 0 &&
-                                       ck::type_convert<std::size_t>(wi) <
-                                           arg.input_.GetLengths()[5])
-                                    {
-                                        float v_in;
-                                        float v_wei;
-
-                                        arg.in_element_op_(v_in,
-                                                           ck::type_convert<float>(
-                                                               arg.input_(g, n, c, di, hi, wi)));
-
-                                        arg.wei_element_op_(
-                                            v_wei,
-                                            ck::type_convert<float>(arg.weight_(g, k, c, z, y, x)));
-
-                                        v_acc += v_in * v_wei;
-                                    }
-                                }
-                            }
-                        }
-                    }
+            // lowered per group to im2col panels times the weights, same accumulation order as
+            // ComputeElement(); only non-finite weights differ, see host_conv_fwd_packed()
+            const host_common::HostConvIm2Col<NDimSpatial> im2col(arg.input_.mDesc,
+                                                                  wei_lengths.begin() + 3,
+                                                                  out_lengths.begin() + 3,
+                                                                  arg.conv_strides_,
+                                                                  arg.conv_dilations_,
+                                                                  arg.in_left_pads_);
 
-                    float v_out;
+            const auto out_row_offsets = im2col.GetRowOffsets(arg.output_.mDesc);
 
-                    arg.out_element_op_(v_out, v_acc);
+            auto in_convert = [&](const InDataType& in) {
+                float v_in;
 
-                    arg.output_(g, n, k, d_o, ho, wo) = ck::type_convert<OutDataType>(v_out);
-                };
+                arg.in_element_op_(v_in, ck::type_convert<float>(in));
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3],
-                                           arg.output_.GetLengths()[4],
-                                           arg.output_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+                return v_in;
+            };
 
-                return 0;
-            }
+            auto wei_convert = [&](const WeiDataType& wei) {
+                float v_wei;
+
+                arg.wei_element_op_(v_wei, ck::type_convert<float>(wei));
+
+                return v_wei;
+            };
+
+            auto out_store = [&](std::size_t g, std::size_t m, std::size_t k, float v_acc) {
+                float v_out;
+
+                arg.out_element_op_(v_out, v_acc);
+
+                arg.output_.mData[g * out_strides[0] + out_row_offsets[m] + k * out_strides[2]] =
+                    ck::type_convert<OutDataType>(v_out);
+            };
+
+            host_common::host_conv_fwd_packed<float>(im2col,
+                                                     arg.input_.data(),
+                                                     arg.input_.GetStrides()[0],
+                                                     arg.weight_.data(),
+                                                     arg.weight_.mDesc,
+                                                     in_convert,
+                                                     wei_convert,
+                                                     out_store);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
@@ -291,9 +334,9 @@ struct ReferenceConvFwd : public device::BaseOperator
         return NDimSpatial >= 1 && NDimSpatial <= 3;
     }
 
-    static auto MakeArgument(const Tensor<InDataType>& input,
-                             const Tensor<WeiDataType>& weight,
-                             Tensor<OutDataType>& output,
+    static auto MakeArgument(TensorView<const InDataType> input,
+                             TensorView<const WeiDataType> weight,
+                             TensorView<OutDataType> output,
                              std::vector<ck::index_t> conv_filter_strides,
                              std::vector<ck::index_t> conv_filter_dilations,
                              std::vector<ck::index_t> input_left_pads,
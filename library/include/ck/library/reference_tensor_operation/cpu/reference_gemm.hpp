@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -28,9 +29,9 @@ struct ReferenceGemm : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_m_k,
-                 const Tensor<BDataType>& b_k_n,
-                 Tensor<CDataType>& c_m_n,
+        Argument(TensorView<const ADataType> a_m_k,
+                 TensorView<const BDataType> b_k_n,
+                 TensorView<CDataType> c_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -43,9 +44,9 @@ struct ReferenceGemm : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_m_k_;
-        const Tensor<BDataType>& b_k_n_;
-        Tensor<CDataType>& c_m_n_;
+        TensorView<const ADataType> a_m_k_;
+        TensorView<const BDataType> b_k_n_;
+        TensorView<CDataType> c_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -57,43 +58,73 @@ struct ReferenceGemm : public device::BaseOperator
     {
         using Argument = ReferenceGemm::Argument;
 
+        static AccDataType ConvertA(const Argument& arg, const ADataType& a)
+        {
+            ComputeTypeA v_a;
+
+            // use PassThrough instead of ConvertBF16RTN for reference calculation
+            if constexpr(is_same_v<AElementwiseOperation,
+                                   ck::tensor_operation::element_wise::ConvertBF16RTN>)
+            {
+                ck::tensor_operation::element_wise::PassThrough{}(v_a, a);
+            }
+            else
+            {
+                arg.a_element_op_(v_a, a);
+            }
+
+            return ck::type_convert<AccDataType>(v_a);
+        }
+
+        // same for B matrix
+        static AccDataType ConvertB(const Argument& arg, const BDataType& b)
+        {
+            ComputeTypeB v_b;
+
+            if constexpr(is_same_v<BElementwiseOperation,
+                                   ck::tensor_operation::element_wise::ConvertBF16RTN>)
+            {
+                ck::tensor_operation::element_wise::PassThrough{}(v_b, b);
+            }
+            else
+            {
+                arg.b_element_op_(v_b, b);
+            }
+
+            return ck::type_convert<AccDataType>(v_b);
+        }
+
+        // Element idx = [m, n] of C, computed on its own; point-wise evaluator of sampled
+        // verification
+        template <typename Index>
+        static CDataType ComputeElement(const Argument& arg, const Index& idx)
+        {
+            const std::size_t K = arg.a_m_k_.mDesc.GetLengths()[1];
+
+            AccDataType v_acc{0};
+
+            for(std::size_t k = 0; k < K; ++k)
+            {
+                v_acc +=
+                    ConvertA(arg, arg.a_m_k_(idx[0], k)) * ConvertB(arg, arg.b_k_n_(k, idx[1]));
+            }
+
+            CDataType v_c;
+
+            arg.c_element_op_(v_c, v_acc);
+
+            return v_c;
+        }
+
         float Run(const Argument& arg)
         {
-            auto f_mk_kn_mn = [&](auto m, auto n) {
-                const int K = arg.a_m_k_.mDesc.GetLengths()[1];
-
-                AccDataType v_acc = 0;
-
-                for(int k = 0; k < K; ++k)
-                {
-                    ComputeTypeA v_a;
-                    ComputeTypeB v_b;
-
-                    // use PassThrough instead of ConvertBF16RTN for reference calculation
-                    if constexpr(is_same_v<AElementwiseOperation,
-                                           ck::tensor_operation::element_wise::ConvertBF16RTN>)
-                    {
-                        ck::tensor_operation::element_wise::PassThrough{}(v_a, arg.a_m_k_(m, k));
-                    }
-                    else
-                    {
-                        arg.a_element_op_(v_a, arg.a_m_k_(m, k));
-                    }
-                    // same for B matrix
-                    if constexpr(is_same_v<BElementwiseOperation,
-                                           ck::tensor_operation::element_wise::ConvertBF16RTN>)
-                    {
-                        ck::tensor_operation::element_wise::PassThrough{}(v_b, arg.b_k_n_(k, n));
-                    }
-                    else
-                    {
-                        arg.b_element_op_(v_b, arg.b_k_n_(k, n));
-                    }
-
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
+            const auto& a_strides = arg.a_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_k_n_.mDesc.GetStrides();
+
+            auto a_convert = [&](const ADataType& a) { return ConvertA(arg, a); };
+            auto b_convert = [&](const BDataType& b) { return ConvertB(arg, b); };
 
+            auto c_store = [&](auto, auto m, auto n, AccDataType v_acc) {
                 CDataType v_c;
 
                 arg.c_element_op_(v_c, v_acc);
@@ -101,9 +132,17 @@ struct ReferenceGemm : public device::BaseOperator
                 arg.c_m_n_(m, n) = v_c;
             };
 
-            make_ParallelTensorFunctor(
-                f_mk_kn_mn, arg.c_m_n_.mDesc.GetLengths()[0], arg.c_m_n_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
+            ck::host_common::host_gemm_packed<AccDataType>(1,
+                                                           arg.c_m_n_.mDesc.GetLengths()[0],
+                                                           arg.c_m_n_.mDesc.GetLengths()[1],
+                                                           arg.a_m_k_.mDesc.GetLengths()[1],
+                                                           arg.a_m_k_.data(),
+                                                           {0, a_strides[0], a_strides[1]},
+                                                           arg.b_k_n_.data(),
+                                                           {0, b_strides[0], b_strides[1]},
+                                                           a_convert,
+                                                           b_convert,
+                                                           c_store);
 
             return 0;
         }
@@ -123,9 +162,9 @@ struct ReferenceGemm : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_m_k,
-                             const Tensor<BDataType>& b_k_n,
-                             Tensor<CDataType>& c_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_m_k,
+                             TensorView<const BDataType> b_k_n,
+                             TensorView<CDataType> c_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <sstream>
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "ck/library/utility/host_normalization.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -41,41 +42,46 @@ struct ReferenceGemmLayernorm : public device::BaseOperator
         assert(acc.mDesc.GetLengths()[1] == gamma.mDesc.GetLengths()[0] &&
                acc.mDesc.GetLengths()[1] == beta.mDesc.GetLengths()[0]);
 
-        size_t M = acc.mDesc.GetLengths()[0];
-        size_t N = acc.mDesc.GetLengths()[1];
-
-        Tensor<ComputeDataType> avg_acc_sq({M});
-        Tensor<ComputeDataType> avg_acc({M});
-        Tensor<ComputeDataType> acc_layernorm(acc);
-
-        // reduce N dim
-        for(size_t i = 0; i < M; i++)
-        {
-            ComputeDataType sum_acc_sq = 0;
-            ComputeDataType sum_acc    = 0;
-            for(size_t j = 0; j < N; j++)
-            {
-                sum_acc_sq += acc_layernorm(i, j) * acc_layernorm(i, j);
-                sum_acc += acc_layernorm(i, j);
-            }
-            avg_acc_sq(i) = sum_acc_sq / N;
-            avg_acc(i)    = sum_acc / N;
-        }
-
-        // normalize
-        acc_layernorm.ForEach([&](auto& self, auto idx) {
-            self(idx[0], idx[1]) =
-                (self(idx[0], idx[1]) - avg_acc(idx[0])) /
-                sqrt(avg_acc_sq(idx[0]) - avg_acc(idx[0]) * avg_acc(idx[0]) + epsilon);
-        });
-
-        // affine
-        acc_layernorm.ForEach([&](auto& self, auto idx) {
-            self(idx[0], idx[1]) = self(idx[0], idx[1]) * gamma(idx[1]) + beta(idx[1]);
-        });
-
-        // cast
-        result = acc_layernorm.template CopyAsType<OutDataType>();
+        using Desc = host_common::HostNormalizationDescriptor<1, 1>;
+
+        const auto& acc_strides   = acc.mDesc.GetStrides();
+        const auto& gamma_strides = gamma.mDesc.GetStrides();
+        const auto& beta_strides  = beta.mDesc.GetStrides();
+
+        result = Tensor<OutDataType>(acc.mDesc);
+
+        Desc desc;
+
+        desc.invariant_lengths_ = {static_cast<index_t>(acc.mDesc.GetLengths()[0])};
+        desc.reduce_lengths_    = {static_cast<index_t>(acc.mDesc.GetLengths()[1])};
+
+        desc.invariant_strides_[Desc::X]     = {static_cast<index_t>(acc_strides[0])};
+        desc.invariant_strides_[Desc::Y]     = {static_cast<index_t>(acc_strides[0])};
+        desc.invariant_strides_[Desc::Gamma] = {0};
+        desc.invariant_strides_[Desc::Beta]  = {0};
+
+        desc.reduce_strides_[Desc::X]     = {static_cast<index_t>(acc_strides[1])};
+        desc.reduce_strides_[Desc::Y]     = {static_cast<index_t>(acc_strides[1])};
+        desc.reduce_strides_[Desc::Gamma] = {static_cast<index_t>(gamma_strides[0])};
+        desc.reduce_strides_[Desc::Beta]  = {static_cast<index_t>(beta_strides[0])};
+
+        // normalize, affine and cast
+        host_common::host_normalization(
+            desc,
+            type_convert<ComputeDataType>(epsilon),
+            [&](std::size_t offset) { return acc.mData[offset]; },
+            [&](const auto& offsets,
+                ComputeDataType x,
+                ComputeDataType mean,
+                ComputeDataType inv_std) {
+                const auto gamma_val =
+                    type_convert<ComputeDataType>(gamma.mData[offsets[Desc::Gamma]]);
+                const auto beta_val =
+                    type_convert<ComputeDataType>(beta.mData[offsets[Desc::Beta]]);
+                const ComputeDataType y = (x - mean) * inv_std * gamma_val + beta_val;
+
+                result.mData[offsets[Desc::Y]] = type_convert<OutDataType>(y);
+            });
     }
 
     // Argument
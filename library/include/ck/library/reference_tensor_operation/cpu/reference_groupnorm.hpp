@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_normalization.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -48,9 +49,9 @@ struct ReferenceGroupnorm : public device::BaseOperator
         {
         }
 
-        const Tensor<XDataType> x_;
-        const Tensor<XDataType> gamma_;
-        const Tensor<XDataType> beta_;
+        const Tensor<XDataType>& x_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
         Tensor<YDataType>& y_;
         AccElementwiseOperation acc_elementwise_op_;
         std::vector<index_t> lengths_;
@@ -62,73 +63,56 @@ struct ReferenceGroupnorm : public device::BaseOperator
     {
         float Run(const Argument& arg)
         {
-            int N = arg.lengths_[0];
-            int H = arg.lengths_[1];
-            int W = arg.lengths_[2];
-            int G = arg.lengths_[3];
-            int C = arg.lengths_[4];
-
-            Tensor<AccDataType> mean({N, G});
-            Tensor<AccDataType> var({N, G});
-
-            // Compute mean & var in [H, W, C] by Welford Algorithm
-            // TODO - parallel for each HWC
-            // TODO - address calculation
-            for(int n = 0; n < N; ++n)
-            {
-                for(int g = 0; g < G; ++g)
-                {
-                    AccDataType mean_val = type_convert<AccDataType>(0.0f);
-                    AccDataType var_val  = type_convert<AccDataType>(0.0f);
-                    int32_t curr_count   = 0;
-
-                    for(int h = 0; h < H; ++h)
-                    {
-                        for(int w = 0; w < W; ++w)
-                        {
-                            for(int c = 0; c < C; ++c)
-                            {
-                                curr_count++;
-                                AccDataType x = type_convert<AccDataType>(arg.x_(n, h, w, g, c));
-                                AccDataType delta = x - mean_val;
-                                mean_val += delta / curr_count;
-                                AccDataType delta2 = x - mean_val;
-                                var_val += delta * delta2;
-                            }
-                        }
-                    }
-
-                    mean(n, g) = mean_val;
-                    var(n, g)  = var_val / curr_count;
-                }
-            }
-
-            // Normalization
-            for(int n = 0; n < N; ++n)
-            {
-                for(int h = 0; h < H; ++h)
-                {
-                    for(int w = 0; w < W; ++w)
-                    {
-                        for(int g = 0; g < G; ++g)
-                        {
-                            for(int c = 0; c < C; ++c)
-                            {
-                                AccDataType x = type_convert<AccDataType>(arg.x_(n, h, w, g, c));
-                                AccDataType gamma    = type_convert<AccDataType>(arg.gamma_(g, c));
-                                AccDataType beta     = type_convert<AccDataType>(arg.beta_(g, c));
-                                AccDataType mean_val = type_convert<AccDataType>(mean(n, g));
-                                AccDataType var_val  = type_convert<AccDataType>(var(n, g));
-                                AccDataType y        = gamma * (x - mean_val) /
-                                                    ck::math::sqrt(arg.epsilon_ + var_val) +
-                                                beta;
-                                arg.acc_elementwise_op_(y, y);
-                                arg.y_(n, h, w, g, c) = type_convert<YDataType>(y);
-                            }
-                        }
-                    }
-                }
-            }
+            using Desc = host_common::HostNormalizationDescriptor<2, 3>;
+
+            const index_t N = arg.lengths_[0];
+            const index_t H = arg.lengths_[1];
+            const index_t W = arg.lengths_[2];
+            const index_t G = arg.lengths_[3];
+            const index_t C = arg.lengths_[4];
+
+            const auto& x_strides     = arg.x_.mDesc.GetStrides();
+            const auto& y_strides     = arg.y_.mDesc.GetStrides();
+            const auto& gamma_strides = arg.gamma_.mDesc.GetStrides();
+            const auto& beta_strides  = arg.beta_.mDesc.GetStrides();
+
+            // strides of the given dimensions of a tensor, -1 selects a broadcast (0) stride
+            auto strides = [](const auto& s, auto... dims) {
+                return std::array<index_t, sizeof...(dims)>{
+                    (dims < 0 ? 0 : static_cast<index_t>(s[dims]))...};
+            };
+
+            // rows [N, G], reduce [H, W, C], gamma and beta broadcast along N, H and W
+            Desc desc;
+
+            desc.invariant_lengths_ = {N, G};
+            desc.reduce_lengths_    = {H, W, C};
+
+            desc.invariant_strides_[Desc::X]     = strides(x_strides, 0, 3);
+            desc.invariant_strides_[Desc::Y]     = strides(y_strides, 0, 3);
+            desc.invariant_strides_[Desc::Gamma] = strides(gamma_strides, -1, 0);
+            desc.invariant_strides_[Desc::Beta]  = strides(beta_strides, -1, 0);
+
+            desc.reduce_strides_[Desc::X]     = strides(x_strides, 1, 2, 4);
+            desc.reduce_strides_[Desc::Y]     = strides(y_strides, 1, 2, 4);
+            desc.reduce_strides_[Desc::Gamma] = strides(gamma_strides, -1, -1, 1);
+            desc.reduce_strides_[Desc::Beta]  = strides(beta_strides, -1, -1, 1);
+
+            host_common::host_normalization(
+                desc,
+                arg.epsilon_,
+                [&](std::size_t x_offset) {
+                    return type_convert<AccDataType>(arg.x_.mData[x_offset]);
+                },
+                [&](const auto& offsets, AccDataType x, AccDataType mean, AccDataType inv_std) {
+                    AccDataType gamma =
+                        type_convert<AccDataType>(arg.gamma_.mData[offsets[Desc::Gamma]]);
+                    AccDataType beta =
+                        type_convert<AccDataType>(arg.beta_.mData[offsets[Desc::Beta]]);
+                    AccDataType y = gamma * (x - mean) * inv_std + beta;
+                    arg.acc_elementwise_op_(y, y);
+                    arg.y_.mData[offsets[Desc::Y]] = type_convert<YDataType>(y);
+                });
 
             return 0;
         }
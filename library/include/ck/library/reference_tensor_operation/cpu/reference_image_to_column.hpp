@@ -10,6 +10,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -100,135 +101,41 @@ struct ReferenceImageToColumn : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            const index_t N = arg.input_.GetLengths()[1];
-            const index_t C = arg.input_.GetLengths()[2];
-
-            if constexpr(NDimSpatial == 1)
-            {
-                const index_t Wo = arg.output_spatial_lengths_[0];
-                auto func        = [&](auto n, auto wo) {
-                    index_t row    = n * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t x = 0; x < arg.filter_spatial_lengths_[0]; ++x)
-                    {
-                        auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                        for(index_t c = 0; c < C; ++c)
-                        {
-                            if(wi >= 0 &&
-                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
-                            {
-                                InDataType v_in          = arg.input_(0, n, c, wi);
-                                arg.output_(row, column) = ck::type_convert<OutDataType>(v_in);
-                            }
-                            column++;
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N, Wo)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 2)
-            {
-                const index_t Ho = arg.output_spatial_lengths_[0];
-                const index_t Wo = arg.output_spatial_lengths_[1];
-
-                auto func = [&](auto n, auto ho, auto wo) {
-                    index_t row    = n * Ho * Wo + ho * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t y = 0; y < arg.filter_spatial_lengths_[0]; ++y)
-                    {
-                        auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                        for(index_t x = 0; x < arg.filter_spatial_lengths_[1]; ++x)
-                        {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                            for(index_t c = 0; c < C; ++c)
-                            {
-
-                                if(hi >= 0 &&
-                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
-                                   wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
-                                {
-                                    InDataType v_in          = arg.input_(0, n, c, hi, wi);
-                                    arg.output_(row, column) = ck::type_convert<OutDataType>(v_in);
-                                }
-                                column++;
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N, Ho, Wo)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 3)
-            {
-                const index_t Do = arg.output_spatial_lengths_[0];
-                const index_t Ho = arg.output_spatial_lengths_[1];
-                const index_t Wo = arg.output_spatial_lengths_[2];
-
-                auto func = [&](auto n, auto d_o, auto ho, auto wo) {
-                    index_t row    = n * Do * Ho * Wo + d_o * Ho * Wo + ho * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t z = 0; z < arg.filter_spatial_lengths_[0]; ++z)
-                    {
-                        auto di = static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                        for(index_t y = 0; y < arg.filter_spatial_lengths_[1]; ++y)
-                        {
-                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
-                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                            for(index_t x = 0; x < arg.filter_spatial_lengths_[2]; ++x)
-                            {
-                                auto wi =
-                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
-                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-                                for(index_t c = 0; c < C; ++c)
-                                {
-                                    if(di >= 0 &&
-                                       ck::type_convert<std::size_t>(di) <
-                                           arg.input_.GetLengths()[3] &&
-                                       hi >= 0 &&
-                                       ck::type_convert<std::size_t>(hi) <
-                                           arg.input_.GetLengths()[4] &&
-                                       wi >= 0 &&
-                                       ck::type_convert<std::size_t>(wi) <
-                                           arg.input_.GetLengths()[5])
-                                    {
-                                        InDataType v_in = arg.input_(0, n, c, di, hi, wi);
-                                        arg.output_(row, column) =
-                                            ck::type_convert<OutDataType>(v_in);
-                                    }
-                                    column++;
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, N, Do, Ho, Wo)(
-                    std::thread::hardware_concurrency());
-
-                return 0;
-            }
+            const host_common::HostConvIm2Col<NDimSpatial> im2col(
+                arg.input_.mDesc,
+                arg.filter_spatial_lengths_.begin(),
+                arg.output_spatial_lengths_.begin(),
+                arg.conv_strides_,
+                arg.conv_dilations_,
+                arg.in_left_pads_);
+
+            const auto& out_strides = arg.output_.GetStrides();
+
+            const std::size_t C              = arg.input_.GetLengths()[2];
+            const std::size_t M              = im2col.GetNumRow();
+            const std::size_t rows_per_panel = 64;
+
+            auto convert = [](const InDataType& v_in) {
+                return ck::type_convert<OutDataType>(v_in);
+            };
+
+            // columns in [Z, Y, X, C] order, padding is written as zero
+            auto f_panel = [&](std::size_t panel) {
+                const std::size_t m_begin = panel * rows_per_panel;
+
+                im2col.FillRows(arg.output_.data() + m_begin * out_strides[0],
+                                out_strides[0],
+                                out_strides[1],
+                                C * out_strides[1],
+                                arg.input_.data(),
+                                m_begin,
+                                std::min(rows_per_panel, M - m_begin),
+                                convert);
+            };
+
+            host_common::host_parallel_for((M + rows_per_panel - 1) / rows_per_panel, f_panel);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
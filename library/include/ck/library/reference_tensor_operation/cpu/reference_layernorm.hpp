@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_normalization.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -26,24 +27,31 @@ template <typename XDataType,
           index_t NumReduceDim>
 struct ReferenceLayernorm : public device::BaseOperator
 {
-    // TODO - support generic layernorm
-    static_assert((Rank == 2 && NumReduceDim == 1), "Only support 2D version so far");
+    static_assert(Rank > 0 && NumReduceDim > 0 && NumReduceDim <= Rank,
+                  "Invalid number of reduce dimensions");
+
+    // a layernorm over all dimensions is run as a single row of an extra length-1 dimension
+    static constexpr index_t NumInvariantDim = Rank > NumReduceDim ? Rank - NumReduceDim : 1;
+
+    using NormalizationDescriptor =
+        host_common::HostNormalizationDescriptor<NumInvariantDim, NumReduceDim>;
 
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<XDataType>& x_m_n,
-                 const Tensor<GammaDataType>& gamma_n,
-                 const Tensor<BetaDataType>& beta_n,
-                 Tensor<YDataType>& y_m_n,
+        // gamma and beta either have the full rank of x or only span the reduce dimensions
+        Argument(const Tensor<XDataType>& x,
+                 const Tensor<GammaDataType>& gamma,
+                 const Tensor<BetaDataType>& beta,
+                 Tensor<YDataType>& y,
                  AccElementwiseOperation acc_elementwise_op,
                  const std::vector<index_t> lengths,
                  const std::vector<index_t> reduceDims,
                  AccDataType epsilon)
-            : x_m_n_(x_m_n),
-              gamma_n_(gamma_n),
-              beta_n_(beta_n),
-              y_m_n_(y_m_n),
+            : x_(x),
+              gamma_(gamma),
+              beta_(beta),
+              y_(y),
               acc_elementwise_op_(acc_elementwise_op),
               lengths_(lengths),
               reduceDims_(reduceDims),
@@ -51,57 +59,96 @@ struct ReferenceLayernorm : public device::BaseOperator
         {
         }
 
-        const Tensor<XDataType> x_m_n_;
-        const Tensor<XDataType> gamma_n_;
-        const Tensor<XDataType> beta_n_;
-        Tensor<YDataType>& y_m_n_;
+        const Tensor<XDataType>& x_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
+        Tensor<YDataType>& y_;
         AccElementwiseOperation acc_elementwise_op_;
         std::vector<index_t> lengths_;
         std::vector<index_t> reduceDims_;
         AccDataType epsilon_;
     };
 
+    static bool IsReduceDim(const std::vector<index_t>& reduceDims, index_t dim)
+    {
+        return std::find(reduceDims.begin(), reduceDims.end(), dim) != reduceDims.end();
+    }
+
+    static NormalizationDescriptor MakeNormalizationDescriptor(const Argument& arg)
+    {
+        NormalizationDescriptor desc;
+
+        desc.invariant_lengths_.fill(1);
+
+        for(auto& strides : desc.invariant_strides_)
+            strides.fill(0);
+
+        for(auto& strides : desc.reduce_strides_)
+            strides.fill(0);
+
+        // invariant dimensions keep their order in x, reduce dimensions follow reduceDims
+        const auto& x_strides     = arg.x_.mDesc.GetStrides();
+        const auto& y_strides     = arg.y_.mDesc.GetStrides();
+        const auto& gamma_strides = arg.gamma_.mDesc.GetStrides();
+        const auto& beta_strides  = arg.beta_.mDesc.GetStrides();
+
+        const bool is_gamma_full = gamma_strides.size() == static_cast<std::size_t>(Rank);
+        const bool is_beta_full  = beta_strides.size() == static_cast<std::size_t>(Rank);
+
+        index_t i = 0;
+
+        for(index_t dim = 0; dim < Rank; ++dim)
+        {
+            if(IsReduceDim(arg.reduceDims_, dim))
+                continue;
+
+            desc.invariant_lengths_[i]                                 = arg.lengths_[dim];
+            desc.invariant_strides_[NormalizationDescriptor::X][i]     = x_strides[dim];
+            desc.invariant_strides_[NormalizationDescriptor::Y][i]     = y_strides[dim];
+            desc.invariant_strides_[NormalizationDescriptor::Gamma][i] =
+                is_gamma_full ? gamma_strides[dim] : 0;
+            desc.invariant_strides_[NormalizationDescriptor::Beta][i] =
+                is_beta_full ? beta_strides[dim] : 0;
+            ++i;
+        }
+
+        for(i = 0; i < NumReduceDim; ++i)
+        {
+            const index_t dim = arg.reduceDims_[i];
+
+            desc.reduce_lengths_[i]                                 = arg.lengths_[dim];
+            desc.reduce_strides_[NormalizationDescriptor::X][i]     = x_strides[dim];
+            desc.reduce_strides_[NormalizationDescriptor::Y][i]     = y_strides[dim];
+            desc.reduce_strides_[NormalizationDescriptor::Gamma][i] =
+                gamma_strides[is_gamma_full ? dim : i];
+            desc.reduce_strides_[NormalizationDescriptor::Beta][i] =
+                beta_strides[is_beta_full ? dim : i];
+        }
+
+        return desc;
+    }
+
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
         float Run(const Argument& arg)
         {
-            int M = arg.lengths_[0];
-            int N = arg.lengths_[1];
-
-            Tensor<AccDataType> mean({M});
-            Tensor<AccDataType> var({M});
-
-            for(int m = 0; m < M; ++m)
-            {
-                mean(m) = 0;
-                var(m)  = 0;
-
-                for(int n = 0; n < N; ++n)
-                {
-                    auto x_val = ck::type_convert<AccDataType>(arg.x_m_n_(m, n));
-                    mean(m) += x_val;
-                    var(m) += x_val * x_val;
-                }
-
-                mean(m) = mean(m) / N;
-                var(m)  = (var(m) / N) - (mean(m) * mean(m));
-            }
-
-            for(int m = 0; m < M; ++m)
-            {
-                AccDataType divisor =
-                    static_cast<AccDataType>(1) / ck::math::sqrt(var(m) + arg.epsilon_);
-
-                for(int n = 0; n < N; ++n)
-                {
-                    auto x_val = ck::type_convert<AccDataType>(arg.x_m_n_(m, n));
-                    auto y_val = (x_val - mean(m)) * divisor;
-                    y_val      = (y_val * arg.gamma_n_(n)) + arg.beta_n_(n);
+            using Desc = NormalizationDescriptor;
+
+            host_common::host_normalization(
+                MakeNormalizationDescriptor(arg),
+                arg.epsilon_,
+                [&](std::size_t x_offset) {
+                    return ck::type_convert<AccDataType>(arg.x_.mData[x_offset]);
+                },
+                [&](const auto& offsets, AccDataType x_val, AccDataType mean, AccDataType inv_std) {
+                    auto y_val = (x_val - mean) * inv_std;
+                    y_val = y_val * ck::type_convert<AccDataType>(
+                                        arg.gamma_.mData[offsets[Desc::Gamma]]) +
+                            ck::type_convert<AccDataType>(arg.beta_.mData[offsets[Desc::Beta]]);
                     arg.acc_elementwise_op_(y_val, y_val);
-                    arg.y_m_n_(m, n) = ck::type_convert<YDataType>(y_val);
-                }
-            }
+                    arg.y_.mData[offsets[Desc::Y]] = ck::type_convert<YDataType>(y_val);
+                });
 
             return 0;
         }
@@ -123,30 +170,62 @@ struct ReferenceLayernorm : public device::BaseOperator
     {
         const Argument* p_arg_ = dynamic_cast<const Argument*>(p_arg);
 
-        // TODO - support generic layernorm
-        if(p_arg_->lengths_.size() != 2)
+        if(p_arg_->lengths_.size() != Rank || p_arg_->reduceDims_.size() != NumReduceDim)
             return false;
 
-        if(p_arg_->reduceDims_.size() != 1)
-            return false;
+        for(index_t i = 0; i < NumReduceDim; ++i)
+        {
+            const index_t dim = p_arg_->reduceDims_[i];
+
+            if(dim < 0 || dim >= Rank)
+                return false;
+
+            if(std::count(p_arg_->reduceDims_.begin(), p_arg_->reduceDims_.end(), dim) != 1)
+                return false;
+        }
+
+        auto lengths_match = [&](const auto& desc) {
+            const auto& lengths = desc.GetLengths();
 
-        if(p_arg_->reduceDims_[0] != 1)
+            return std::equal(lengths.begin(),
+                              lengths.end(),
+                              p_arg_->lengths_.begin(),
+                              p_arg_->lengths_.end(),
+                              [](auto a, auto b) { return a == static_cast<std::size_t>(b); });
+        };
+
+        if(!lengths_match(p_arg_->x_.mDesc) || !lengths_match(p_arg_->y_.mDesc))
             return false;
 
-        return true;
+        // gamma/beta: full rank, or one length per reduce dimension
+        auto affine_match = [&](const auto& desc) {
+            if(desc.GetNumOfDimension() == static_cast<std::size_t>(Rank))
+                return lengths_match(desc);
+
+            if(desc.GetNumOfDimension() != static_cast<std::size_t>(NumReduceDim))
+                return false;
+
+            for(index_t i = 0; i < NumReduceDim; ++i)
+                if(desc.GetLengths()[i] !=
+                   static_cast<std::size_t>(p_arg_->lengths_[p_arg_->reduceDims_[i]]))
+                    return false;
+
+            return true;
+        };
+
+        return affine_match(p_arg_->gamma_.mDesc) && affine_match(p_arg_->beta_.mDesc);
     }
 
-    static auto MakeArgument(const Tensor<XDataType>& x_m_n,
-                             const Tensor<GammaDataType>& gamma_n,
-                             const Tensor<BetaDataType>& beta_n,
-                             Tensor<YDataType>& y_m_n,
+    static auto MakeArgument(const Tensor<XDataType>& x,
+                             const Tensor<GammaDataType>& gamma,
+                             const Tensor<BetaDataType>& beta,
+                             Tensor<YDataType>& y,
                              AccElementwiseOperation acc_elementwise_op,
                              const std::vector<index_t> lengths,
                              const std::vector<index_t> reduceDims,
                              AccDataType epsilon)
     {
-        return Argument{
-            x_m_n, gamma_n, beta_n, y_m_n, acc_elementwise_op, lengths, reduceDims, epsilon};
+        return Argument{x, gamma, beta, y, acc_elementwise_op, lengths, reduceDims, epsilon};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -10,6 +10,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_scatter.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -45,28 +46,32 @@ struct ReferenceMaxPoolBwd : public device::BaseOperator
     {
         float Run(const Argument& arg)
         {
-            int din_length  = arg.din_.GetElementSpaceSize();
-            int dout_length = arg.dout_.GetElementSpaceSize();
+            const std::size_t din_length  = arg.din_.GetElementSpaceSize();
+            const std::size_t dout_length = arg.dout_.GetElementSpaceSize();
             std::vector<ConputeDataType> buf(din_length, 0);
 
-            for(int i = 0; i < dout_length; ++i)
-            {
-                int index = arg.indices_.mData[i];
-                if(index >= 0 && index < din_length)
+            auto get_dst = [&](std::size_t i) {
+                return static_cast<long_index_t>(arg.indices_.mData[i]);
+            };
+
+            // gradients are added to an element of din in the order of dout, as a serial loop
+            // would, by the single worker owning that element
+            auto accumulate = [&](std::size_t index, std::size_t i) {
+                if constexpr(is_same_v<ConputeDataType, bhalf_t>)
                 {
-                    if constexpr(is_same_v<ConputeDataType, bhalf_t>)
-                    {
-                        float buf_val = ck::type_convert<float>(buf[index]);
-                        buf_val += ck::type_convert<float>(arg.dout_.mData[i]);
-                        buf[index] = ck::type_convert<ConputeDataType>(buf_val);
-                    }
-                    else
-                        buf[index] += ck::type_convert<ConputeDataType>(arg.dout_.mData[i]);
+                    float buf_val = ck::type_convert<float>(buf[index]);
+                    buf_val += ck::type_convert<float>(arg.dout_.mData[i]);
+                    buf[index] = ck::type_convert<ConputeDataType>(buf_val);
                 }
-            }
+                else
+                    buf[index] += ck::type_convert<ConputeDataType>(arg.dout_.mData[i]);
+            };
+
+            host_common::host_scatter_accumulate(dout_length, din_length, get_dst, accumulate);
 
-            for(int i = 0; i < din_length; ++i)
+            host_common::host_parallel_for(din_length, [&](std::size_t i) {
                 arg.din_.mData[i] = ck::type_convert<DInDataType>(buf[i]);
+            });
             return 0;
         }
 
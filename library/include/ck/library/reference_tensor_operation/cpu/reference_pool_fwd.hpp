@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "ck/utility/reduction_functions_accumulate.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_pool.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -68,8 +70,14 @@ struct ReferencePoolingFwd : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
-        float RunPooling3dFwd(const Argument& arg)
+        // Windows are reduced by separable per-axis passes, see host_common::host_pool_separable(),
+        // which visit the elements of a window in the (z, y, x) order of a direct loop nest. The
+        // reductions are associative, so max pooling picks the same value and index as the loop
+        // nest; sums are associated differently and may round differently.
+        template <std::size_t NDimSpatial>
+        float RunPoolingFwd(const Argument& arg)
         {
+            using host_common::host_pool_separable;
 
             auto elementwise_ops =
                 ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
@@ -78,170 +86,86 @@ struct ReferencePoolingFwd : public device::BaseOperator
             auto in_elementwise_op  = std::get<0>(elementwise_ops);
             auto acc_elementwise_op = std::get<1>(elementwise_ops);
 
-            if constexpr(!OutputIndex)
-            {
-                using Accumulation = ck::detail::
-                    AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
+            // NaNs never win a comparison, so a selection that does not propagate them skips them
+            constexpr bool IgnoreNan =
+                !PropagateNan &&
+                (ReduceOpId == ReduceTensorOp::MIN || ReduceOpId == ReduceTensorOp::MAX ||
+                 ReduceOpId == ReduceTensorOp::AMAX);
 
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal);
-                                }
-                            }
-                        }
-                    }
-                    acc_elementwise_op(accuVal, accuVal);
-
-                    arg.out_(n, c, do_, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
+            const auto& in_lengths  = arg.in_.mDesc.GetLengths();
+            const auto& in_strides  = arg.in_.mDesc.GetStrides();
+            const auto& out_lengths = arg.out_.mDesc.GetLengths();
+            const auto& out_strides = arg.out_.mDesc.GetStrides();
 
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
-            }
-            else
+            const std::size_t C = in_lengths[1];
+
+            std::array<std::size_t, NDimSpatial> in_spatial_lengths;
+            std::array<std::size_t, NDimSpatial> out_spatial_lengths;
+            std::array<std::vector<host_common::HostPoolWindows>, NDimSpatial> windows;
+
+            for(std::size_t d = 0; d < NDimSpatial; ++d)
             {
-                using Accumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
-                                                                                ReduceOperation,
-                                                                                ComputeDataType,
-                                                                                IndexDataType>;
+                in_spatial_lengths[d]  = in_lengths[d + 2];
+                out_spatial_lengths[d] = out_lengths[d + 2];
+                windows[d]             = host_common::get_host_pool_fwd_windows(
+                    out_spatial_lengths[d],
+                    arg.window_spatial_lengths_[d],
+                    arg.window_strides_[d],
+                    arg.window_dilations_[d],
+                    arg.in_left_pads_[d]);
+            }
 
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
-
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-                                    IndexDataType currIndex =
-                                        arg.in_.GetOffsetFromMultiIndex(n, c, di, hi, wi);
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                                }
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-
-                    arg.out_(n, c, do_, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, do_, ho, wo) = accuIndex;
-                };
+            auto get_offset = [C](std::size_t nc,
+                                  const std::array<std::size_t, NDimSpatial>& idx,
+                                  const std::vector<std::size_t>& strides) {
+                std::size_t offset = nc / C * strides[0] + nc % C * strides[1];
+
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                    offset += idx[d] * strides[d + 2];
 
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                return offset;
             };
 
-            return 0;
-        }
+            auto load_value = [&](std::size_t offset) {
+                ComputeDataType v = ck::type_convert<ComputeDataType>(arg.in_.mData[offset]);
 
-        float RunPooling2dFwd(const Argument& arg)
-        {
+                in_elementwise_op(v, v);
 
-            auto elementwise_ops =
-                ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
-                    arg.reduceLength_);
+                if constexpr(IgnoreNan)
+                {
+                    if(ck::math::isnan(v))
+                        v = ReduceOperation::template GetIdentityValue<ComputeDataType>();
+                }
 
-            auto in_elementwise_op  = std::get<0>(elementwise_ops);
-            auto acc_elementwise_op = std::get<1>(elementwise_ops);
+                return v;
+            };
+
+            const ComputeDataType identity =
+                ReduceOperation::template GetIdentityValue<ComputeDataType>();
 
             if constexpr(!OutputIndex)
             {
                 using Accumulation = ck::detail::
                     AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
-                    {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal);
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
-
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                host_pool_separable(
+                    in_lengths[0] * C,
+                    in_spatial_lengths,
+                    out_spatial_lengths,
+                    windows,
+                    identity,
+                    [&](std::size_t nc, const auto& idx) {
+                        return load_value(get_offset(nc, idx, in_strides));
+                    },
+                    [](ComputeDataType& acc, const ComputeDataType& v) {
+                        Accumulation::Calculate(acc, v);
+                    },
+                    [&](std::size_t nc, const auto& idx, ComputeDataType v) {
+                        acc_elementwise_op(v, v);
+
+                        arg.out_.mData[get_offset(nc, idx, out_strides)] =
+                            ck::type_convert<OutDataType>(v);
+                    });
             }
             else
             {
@@ -250,52 +174,45 @@ struct ReferencePoolingFwd : public device::BaseOperator
                                                                                 ComputeDataType,
                                                                                 IndexDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
-
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
-                    {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                IndexDataType currIndex =
-                                    arg.in_.GetOffsetFromMultiIndex(n, c, hi, wi);
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, ho, wo) = accuIndex;
+                struct ValueIndex
+                {
+                    ComputeDataType value;
+                    IndexDataType index;
                 };
 
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-            };
+                const auto& out_indices_strides = arg.out_indices_.mDesc.GetStrides();
+
+                host_pool_separable(
+                    in_lengths[0] * C,
+                    in_spatial_lengths,
+                    out_spatial_lengths,
+                    windows,
+                    ValueIndex{identity, 0},
+                    [&](std::size_t nc, const auto& idx) {
+                        const std::size_t offset = get_offset(nc, idx, in_strides);
+
+                        return ValueIndex{load_value(offset), static_cast<IndexDataType>(offset)};
+                    },
+                    [](ValueIndex& acc, const ValueIndex& v) {
+                        Accumulation::Calculate(acc.value, v.value, acc.index, v.index);
+                    },
+                    [&](std::size_t nc, const auto& idx, ValueIndex v) {
+                        acc_elementwise_op(v.value, v.value);
+
+                        arg.out_.mData[get_offset(nc, idx, out_strides)] =
+                            ck::type_convert<OutDataType>(v.value);
+                        arg.out_indices_.mData[get_offset(nc, idx, out_indices_strides)] =
+                            v.index;
+                    });
+            }
 
             return 0;
         }
 
+        float RunPooling3dFwd(const Argument& arg) { return RunPoolingFwd<3>(arg); }
+
+        float RunPooling2dFwd(const Argument& arg) { return RunPoolingFwd<2>(arg); }
+
         float Run(const Argument& arg)
         {
             // TODO - support generic pooling
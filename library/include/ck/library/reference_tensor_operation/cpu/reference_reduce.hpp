@@ -72,8 +72,6 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
               in_elementwise_op_(in_elementwise_op),
               acc_elementwise_op_(acc_elementwise_op)
         {
-            using ck::host_common::get_index_set;
-
             if(std::any_of(
                    reduceDims.begin(), reduceDims.end(), [](int d) { return d < 0 || d >= Rank; }))
                 throw std::runtime_error("Invalid reduce dimensions!");
@@ -123,11 +121,6 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
                 i++;
             };
 
-            if constexpr(NumInvariantDim > 0)
-                invariant_index_set_ = get_index_set<NumInvariantDim>(invariant_lengths_);
-
-            reduce_index_set_ = get_index_set<NumReduceDim>(reduce_lengths_);
-
             alpha_ = type_convert<AccDataType>(alpha);
             beta_  = type_convert<AccDataType>(beta);
         };
@@ -151,13 +144,50 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
 
         AccDataType alpha_;
         AccDataType beta_;
-
-        std::vector<std::array<index_t, NumInvariantDim>> invariant_index_set_;
-        std::vector<std::array<index_t, NumReduceDim>> reduce_index_set_;
     };
 
     struct Invoker : public device::BaseInvoker
     {
+        // Number of reduced elements per partial result when reducing all dimensions. Fixed, so
+        // the result does not depend on the number of host threads.
+        static constexpr std::size_t ReduceAllBlockSize = 65536;
+
+        // Reduce all dimensions in parallel: reduce_block(begin, end, val, index) accumulates one
+        // block of the reduce space starting from the identity value, then the per-block partials
+        // are merged pairwise in a fixed tree, left operand first, by combine(val, index, val_r,
+        // index_r).
+        template <typename ReduceBlock, typename Combine>
+        static void reduce_all_dims(std::size_t reduce_size,
+                                    AccDataType& accuVal,
+                                    IndexDataType& accuIndex,
+                                    ReduceBlock reduce_block,
+                                    Combine combine)
+        {
+            const std::size_t num_block = std::max<std::size_t>(
+                1, (reduce_size + ReduceAllBlockSize - 1) / ReduceAllBlockSize);
+
+            std::vector<AccDataType> partial_vals(
+                num_block, ReduceOperation::template GetIdentityValue<AccDataType>());
+            std::vector<IndexDataType> partial_indices(num_block, 0);
+
+            ck::host_common::host_parallel_for(num_block, [&](std::size_t b) {
+                reduce_block(b * ReduceAllBlockSize,
+                             std::min(reduce_size, (b + 1) * ReduceAllBlockSize),
+                             partial_vals[b],
+                             partial_indices[b]);
+            });
+
+            for(std::size_t width = 1; width < num_block; width *= 2)
+                for(std::size_t b = 0; b + width < num_block; b += 2 * width)
+                    combine(partial_vals[b],
+                            partial_indices[b],
+                            partial_vals[b + width],
+                            partial_indices[b + width]);
+
+            accuVal   = partial_vals[0];
+            accuIndex = partial_indices[0];
+        }
+
         float Run(const Argument& arg, const StreamConfig& stream_config = StreamConfig{})
         {
             ignore = stream_config;
@@ -165,8 +195,23 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
             using ck::float_equal_one;
             using ck::float_equal_zero;
             using ck::type_convert;
-            using ck::host_common::get_index_set;
-            using ck::host_common::get_offset_from_index;
+            using ck::host_common::make_host_index_odometer;
+
+            const auto reduce_odometer =
+                make_host_index_odometer<NumReduceDim>(arg.reduce_lengths_, arg.in_reduce_strides_);
+
+            auto finalize = [&](AccDataType accuVal, std::size_t dst_offset) {
+                arg.acc_elementwise_op_(accuVal, accuVal);
+
+                if(!float_equal_one{}(arg.alpha_))
+                    accuVal *= type_convert<AccDataType>(arg.alpha_);
+
+                if(!float_equal_zero{}(arg.beta_))
+                    accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
+                               type_convert<AccDataType>(arg.beta_);
+
+                arg.out_host_[dst_offset] = type_convert<OutDataType>(accuVal);
+            };
 
             if constexpr(OutputIndex)
             {
@@ -175,100 +220,63 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
                                                                                 AccDataType,
                                                                                 IndexDataType>;
 
-                if constexpr(NumInvariantDim == 0)
-                {
-                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
-                    IndexDataType accuIndex = 0;
+                // reduce the row-major positions [begin, end) of the reduce space
+                auto reduce_func = [&](std::size_t in_invariant_offset,
+                                       std::size_t begin,
+                                       std::size_t end,
+                                       AccDataType& accuVal,
+                                       IndexDataType& accuIndex) {
+                    auto currIndex = static_cast<IndexDataType>(begin);
+                    auto odometer  = reduce_odometer;
 
-                    for(std::size_t i = 0; i < arg.reduce_index_set_.size(); i++)
-                    {
-                        auto in_offset = get_offset_from_index<NumReduceDim>(
-                            arg.in_reduce_strides_, arg.reduce_index_set_[i]);
-
-                        auto currVal = type_convert<AccDataType>(arg.in_host_[in_offset]);
+                    odometer.ForEachInRange(begin, end, [&](auto, std::size_t in_reduce_offset) {
+                        auto currVal = type_convert<AccDataType>(
+                            arg.in_host_[in_invariant_offset + in_reduce_offset]);
 
                         arg.in_elementwise_op_(currVal, currVal);
 
-                        auto currIndex = static_cast<IndexDataType>(i);
-
                         Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                    };
 
-                    arg.acc_elementwise_op_(accuVal, accuVal);
-
-                    if(!float_equal_one{}(arg.alpha_))
-                        accuVal *= type_convert<AccDataType>(arg.alpha_);
+                        currIndex++;
+                    });
+                };
 
-                    if(!float_equal_zero{}(arg.beta_))
-                        accuVal += type_convert<AccDataType>(arg.out_host_[0]) *
-                                   type_convert<AccDataType>(arg.beta_);
+                if constexpr(NumInvariantDim == 0)
+                {
+                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
+                    IndexDataType accuIndex = 0;
 
-                    arg.out_host_[0]       = type_convert<OutDataType>(accuVal);
+                    reduce_all_dims(
+                        reduce_odometer.GetSize(),
+                        accuVal,
+                        accuIndex,
+                        [&](std::size_t begin, std::size_t end, auto& val, auto& index) {
+                            reduce_func(0, begin, end, val, index);
+                        },
+                        [](auto& val, auto& index, auto partVal, auto partIndex) {
+                            Accumulation::Calculate(val, partVal, index, partIndex);
+                        });
+
+                    finalize(accuVal, 0);
                     arg.out_index_host_[0] = accuIndex;
                 }
                 else
                 {
-                    auto thread_reduce_func = [&](auto invariant_index) {
+                    // offsets of the input and of the output
+                    auto thread_reduce_func = [&](auto, const auto& offsets) {
                         AccDataType accuVal =
                             ReduceOperation::template GetIdentityValue<AccDataType>();
                         IndexDataType accuIndex = 0;
 
-                        auto in_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                            arg.in_invariant_strides_, invariant_index);
-
-                        for(std::size_t i = 0; i < arg.reduce_index_set_.size(); i++)
-                        {
-                            auto in_reduce_offset = get_offset_from_index<NumReduceDim>(
-                                arg.in_reduce_strides_, arg.reduce_index_set_[i]);
-
-                            auto currVal = type_convert<AccDataType>(
-                                arg.in_host_[in_invariant_offset + in_reduce_offset]);
-
-                            arg.in_elementwise_op_(currVal, currVal);
-
-                            auto currIndex = static_cast<IndexDataType>(i);
-
-                            Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                        };
-
-                        arg.acc_elementwise_op_(accuVal, accuVal);
+                        reduce_func(offsets[0], 0, reduce_odometer.GetSize(), accuVal, accuIndex);
 
-                        if(!float_equal_one{}(arg.alpha_))
-                            accuVal *= type_convert<AccDataType>(arg.alpha_);
-
-                        auto dst_offset = get_offset_from_index<NumInvariantDim>(arg.outStrides_,
-                                                                                 invariant_index);
-
-                        if(!float_equal_zero{}(arg.beta_))
-                            accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
-                                       type_convert<AccDataType>(arg.beta_);
-
-                        arg.out_host_[dst_offset]       = type_convert<OutDataType>(accuVal);
-                        arg.out_index_host_[dst_offset] = accuIndex;
+                        finalize(accuVal, offsets[1]);
+                        arg.out_index_host_[offsets[1]] = accuIndex;
                     };
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
-
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-                    std::vector<joinable_thread> threads(num_thread);
-
-                    for(std::size_t it = 0; it < num_thread; ++it)
-                    {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
-                            {
-                                thread_reduce_func(arg.invariant_index_set_[i]);
-                            }
-                        };
-
-                        threads[it] = joinable_thread(f);
-                    }
+                    make_host_index_odometer<NumInvariantDim>(
+                        arg.invariant_lengths_, arg.in_invariant_strides_, arg.outStrides_)
+                        .ParallelForEach(thread_reduce_func);
                 };
             }
             else
@@ -276,92 +284,55 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
                 using Accumulation =
                     ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, AccDataType>;
 
-                if constexpr(NumInvariantDim == 0)
-                {
-                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
-
-                    for(const auto& reduce_index : arg.reduce_index_set_)
-                    {
-                        auto in_offset = get_offset_from_index<NumReduceDim>(arg.in_reduce_strides_,
-                                                                             reduce_index);
+                auto reduce_func = [&](std::size_t in_invariant_offset,
+                                       std::size_t begin,
+                                       std::size_t end,
+                                       AccDataType& accuVal) {
+                    auto odometer = reduce_odometer;
 
-                        auto currVal = type_convert<AccDataType>(arg.in_host_[in_offset]);
+                    odometer.ForEachInRange(begin, end, [&](auto, std::size_t in_reduce_offset) {
+                        auto currVal = type_convert<AccDataType>(
+                            arg.in_host_[in_invariant_offset + in_reduce_offset]);
 
                         arg.in_elementwise_op_(currVal, currVal);
 
                         Accumulation::Calculate(accuVal, currVal);
-                    };
-
-                    arg.acc_elementwise_op_(accuVal, accuVal);
-
-                    if(!float_equal_one{}(arg.alpha_))
-                        accuVal *= type_convert<AccDataType>(arg.alpha_);
+                    });
+                };
 
-                    if(!float_equal_zero{}(arg.beta_))
-                        accuVal += type_convert<AccDataType>(arg.out_host_[0]) *
-                                   type_convert<AccDataType>(arg.beta_);
+                if constexpr(NumInvariantDim == 0)
+                {
+                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
+                    IndexDataType accuIndex = 0;
 
-                    arg.out_host_[0] = type_convert<OutDataType>(accuVal);
+                    reduce_all_dims(
+                        reduce_odometer.GetSize(),
+                        accuVal,
+                        accuIndex,
+                        [&](std::size_t begin, std::size_t end, auto& val, auto&) {
+                            reduce_func(0, begin, end, val);
+                        },
+                        [](auto& val, auto&, auto partVal, auto) {
+                            Accumulation::Calculate(val, partVal);
+                        });
+
+                    finalize(accuVal, 0);
                 }
                 else
                 {
-                    auto thread_reduce_func = [&](auto invariant_index) {
+                    // offsets of the input and of the output
+                    auto thread_reduce_func = [&](auto, const auto& offsets) {
                         AccDataType accuVal =
                             ReduceOperation::template GetIdentityValue<AccDataType>();
 
-                        auto in_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                            arg.in_invariant_strides_, invariant_index);
-
-                        for(const auto& reduce_index : arg.reduce_index_set_)
-                        {
-                            auto in_reduce_offset = get_offset_from_index<NumReduceDim>(
-                                arg.in_reduce_strides_, reduce_index);
-
-                            auto currVal = type_convert<AccDataType>(
-                                arg.in_host_[in_invariant_offset + in_reduce_offset]);
-
-                            arg.in_elementwise_op_(currVal, currVal);
-
-                            Accumulation::Calculate(accuVal, currVal);
-                        };
+                        reduce_func(offsets[0], 0, reduce_odometer.GetSize(), accuVal);
 
-                        arg.acc_elementwise_op_(accuVal, accuVal);
-
-                        if(!float_equal_one{}(arg.alpha_))
-                            accuVal *= type_convert<AccDataType>(arg.alpha_);
-
-                        auto dst_offset = get_offset_from_index<NumInvariantDim>(arg.outStrides_,
-                                                                                 invariant_index);
-
-                        if(!float_equal_zero{}(arg.beta_))
-                            accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
-                                       type_convert<AccDataType>(arg.beta_);
-
-                        arg.out_host_[dst_offset] = type_convert<OutDataType>(accuVal);
+                        finalize(accuVal, offsets[1]);
                     };
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
-
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-                    std::vector<joinable_thread> threads(num_thread);
-
-                    for(std::size_t it = 0; it < num_thread; ++it)
-                    {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
-                            {
-                                thread_reduce_func(arg.invariant_index_set_[i]);
-                            }
-                        };
-
-                        threads[it] = joinable_thread(f);
-                    }
+                    make_host_index_odometer<NumInvariantDim>(
+                        arg.invariant_lengths_, arg.in_invariant_strides_, arg.outStrides_)
+                        .ParallelForEach(thread_reduce_func);
                 };
             };
 
@@ -7,10 +7,15 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -32,17 +37,14 @@ struct ReferenceSoftmax : public device::BaseOperator
             alpha_ = static_cast<AccDataType>(alpha);
             beta_  = static_cast<AccDataType>(beta);
 
-            // std::cout << "debug: scalar dims: ";
             for(size_t i = 0; i < in.mDesc.GetNumOfDimension(); i++)
             {
                 if(std::find(sm_reduce_dims.begin(), sm_reduce_dims.end(), i) ==
                    sm_reduce_dims.end())
                 {
                     sm_scalar_dims_.push_back(i);
-                    // std::cout << i << ", ";
                 }
             }
-            // std::cout << std::endl;
         }
 
         const Tensor<InDataType>& in_;
@@ -56,75 +58,127 @@ struct ReferenceSoftmax : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
-        float Run(const Argument& arg)
+        // lengths and input/output strides of a group of dimensions
+        struct DimGroup
         {
-            std::vector<size_t> scalar_lengths;
-            for(index_t dim : arg.sm_scalar_dims_)
+            std::vector<std::size_t> lengths_;
+            std::vector<std::size_t> in_strides_;
+            std::vector<std::size_t> out_strides_;
+
+            DimGroup(const Argument& arg, const std::vector<index_t>& dims)
+            {
+                for(index_t dim : dims)
+                {
+                    lengths_.push_back(arg.in_.mDesc.GetLengths()[dim]);
+                    in_strides_.push_back(arg.in_.mDesc.GetStrides()[dim]);
+                    out_strides_.push_back(arg.out_.mDesc.GetStrides()[dim]);
+                }
+            }
+
+            std::size_t GetSize() const
             {
-                scalar_lengths.push_back(arg.in_.mDesc.GetLengths()[dim]);
+                return std::accumulate(
+                    lengths_.begin(), lengths_.end(), std::size_t{1}, std::multiplies<>{});
             }
-            // max and sum reduction with final reduced values of dim=0 is a scalar so give it
-            // appropriate lengths of {1}
-            if(arg.sm_scalar_dims_.size() == 0)
+        };
+
+        // Call f(in_offset, out_offset) for every element of one softmax row, starting from the
+        // offsets of its first element. The last reduce dimension is walked by stride, outer
+        // reduce dimensions are advanced by a carried index.
+        template <typename F>
+        static void ForEachInRow(const DimGroup& reduce,
+                                 std::vector<std::size_t>& index,
+                                 std::size_t in_offset,
+                                 std::size_t out_offset,
+                                 F&& f)
+        {
+            const std::size_t num_dim = reduce.lengths_.size();
+
+            if(num_dim == 0)
             {
-                scalar_lengths.push_back(1);
+                f(in_offset, out_offset);
+                return;
             }
 
-            Tensor<AccDataType> reduce_max(scalar_lengths);
-            reduce_max.GenerateTensorValue(
-                GeneratorTensor_1<AccDataType>{std::numeric_limits<AccDataType>::lowest()});
-            Tensor<AccDataType> reduce_sum(scalar_lengths);
-            reduce_sum.GenerateTensorValue(GeneratorTensor_1<AccDataType>{0});
-
-            // when final reduced values is of dim=0, the index will be transformed into empty
-            // std::vector which is actually a valid input for Tensor::operator(std::vector) and
-            // internally accesses 0'th element
-            auto to_sm_scalar_idx = [&](auto idx) {
-                std::vector<size_t> sm_scalar_idx;
-                for(index_t dim : arg.sm_scalar_dims_)
+            const std::size_t last        = num_dim - 1;
+            const std::size_t inner_len   = reduce.lengths_[last];
+            const std::size_t in_stride   = reduce.in_strides_[last];
+            const std::size_t out_stride  = reduce.out_strides_[last];
+            const std::size_t outer_count = reduce.GetSize() / std::max<std::size_t>(inner_len, 1);
+
+            std::fill(index.begin(), index.end(), 0);
+
+            for(std::size_t outer = 0; outer < outer_count; ++outer)
+            {
+                for(std::size_t i = 0; i < inner_len; ++i)
+                    f(in_offset + i * in_stride, out_offset + i * out_stride);
+
+                // advance the outer reduce dimensions
+                for(std::size_t d = last; d-- > 0;)
                 {
-                    sm_scalar_idx.push_back(idx[dim]);
+                    in_offset += reduce.in_strides_[d];
+                    out_offset += reduce.out_strides_[d];
+
+                    if(++index[d] < reduce.lengths_[d])
+                        break;
+
+                    in_offset -= reduce.lengths_[d] * reduce.in_strides_[d];
+                    out_offset -= reduce.lengths_[d] * reduce.out_strides_[d];
+                    index[d] = 0;
                 }
-                return sm_scalar_idx;
-            };
-
-            arg.in_.ForEach([&](auto& self, auto idx) {
-                reduce_max(to_sm_scalar_idx(idx)) = std::max(
-                    reduce_max(to_sm_scalar_idx(idx)), ck::type_convert<AccDataType>(self(idx)));
-            });
-
-            // LogRangeAsType<float>(std::cout << "reduce_max: ", reduce_max.mData, ",") <<
-            // std::endl;
-
-            Tensor<AccDataType> in_stable(arg.in_.mDesc);
-            in_stable.ForEach([&](auto& self, auto idx) {
-                // numerator = exp(x - max(x))
-                self(idx) = std::exp(ck::type_convert<AccDataType>(arg.in_(idx)) -
-                                     reduce_max(to_sm_scalar_idx(idx)));
-            });
-
-            // LogRangeAsType<float>(std::cout << "in_stable: ", in_stable.mData, ",") << std::endl;
-
-            in_stable.ForEach([&](auto& self, auto idx) {
-                // denominator = sum(exp(x - max(x)))
-                reduce_sum(to_sm_scalar_idx(idx)) += self(idx);
-            });
-
-            // LogRangeAsType<float>(std::cout << "reduce_sum: ", reduce_sum.mData, ",") <<
-            // std::endl;
-
-            arg.out_.ForEach([&](auto& self, auto idx) {
-                AccDataType temp_result =
-                    arg.alpha_ * in_stable(idx) / reduce_sum(to_sm_scalar_idx(idx)) +
-                    arg.beta_ * self(idx);
-                self(idx) = ck::type_convert<OutDataType>(temp_result);
-            });
-
-            // LogRangeAsType<float>(std::cout << "out: ", arg.out_.mData, ",") << std::endl;
-            // reduction along reduce dims
-            // LogRangeAsType<float>(std::cout << "reduce_max: ", reduce_max.mData, ",") <<
-            // std::endl; LogRangeAsType<float>(std::cout << "reduce_sum: ", reduce_sum.mData, ",")
-            // << std::endl;
+            }
+        }
+
+        // Online softmax: a single pass keeps the running max and the sum of exp(x - max),
+        // rescaling the sum whenever the max grows, a second pass writes the output. Rows are
+        // processed in parallel, nothing of the size of the input is allocated.
+        float Run(const Argument& arg)
+        {
+            const DimGroup scalar(arg, arg.sm_scalar_dims_);
+            const DimGroup reduce(arg, arg.sm_reduce_dims_);
+
+            const std::size_t num_row = scalar.GetSize();
+
+            host_common::HostThreadPool::GetInstance().ParallelFor(
+                num_row, [&](std::size_t begin, std::size_t end) {
+                    std::vector<std::size_t> index(reduce.lengths_.size());
+
+                    for(std::size_t row = begin; row < end; ++row)
+                    {
+                        std::size_t in_offset  = 0;
+                        std::size_t out_offset = 0;
+
+                        for(std::size_t d = scalar.lengths_.size(), rest = row; d-- > 0;)
+                        {
+                            in_offset += rest % scalar.lengths_[d] * scalar.in_strides_[d];
+                            out_offset += rest % scalar.lengths_[d] * scalar.out_strides_[d];
+                            rest /= scalar.lengths_[d];
+                        }
+
+                        AccDataType max = std::numeric_limits<AccDataType>::lowest();
+                        AccDataType sum = 0;
+
+                        ForEachInRow(reduce, index, in_offset, out_offset, [&](auto i, auto) {
+                            const auto x = ck::type_convert<AccDataType>(arg.in_.mData[i]);
+
+                            if(x > max)
+                            {
+                                sum *= std::exp(max - x);
+                                max = x;
+                            }
+
+                            sum += std::exp(x - max);
+                        });
+
+                        ForEachInRow(reduce, index, in_offset, out_offset, [&](auto i, auto o) {
+                            const auto x = ck::type_convert<AccDataType>(arg.in_.mData[i]);
+                            const auto y = ck::type_convert<AccDataType>(arg.out_.mData[o]);
+
+                            arg.out_.mData[o] = ck::type_convert<OutDataType>(
+                                arg.alpha_ * std::exp(x - max) / sum + arg.beta_ * y);
+                        });
+                    }
+                });
 
             return 0;
         }
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "ck/host_utility/device_prop.hpp"
+
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/utility/tuning_database.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// the source-level name of type, e.g. "ck::tensor_operation::device::DeviceGemm<...>", where the
+// C++ ABI lets us demangle it; type.name() otherwise
+inline std::string get_demangled_type_name(const std::type_info& type)
+{
+#if defined(__GNUG__)
+    int status = 0;
+
+    const std::unique_ptr<char, void (*)(void*)> name(
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+
+    if(status == 0 && name != nullptr)
+        return name.get();
+#endif
+
+    return type.name();
+}
+
+// Key of the instances of DeviceOp in the tuning database. By default the demangled name of
+// DeviceOp, which spells out its data types, layouts and element-wise operations and is the same
+// for every compiler of the Itanium C++ ABI (GCC, Clang, hipcc). Databases do not carry over to
+// other ABIs, whose type names differ, unless DeviceOp is given an explicit signature by
+// specializing this trait.
+template <typename DeviceOp>
+struct DeviceOpSignature
+{
+    static std::string Get() { return get_demangled_type_name(typeid(DeviceOp)); }
+};
+
+template <typename DeviceOp>
+std::string get_device_op_signature()
+{
+    return DeviceOpSignature<DeviceOp>::Get();
+}
+
+// The instance of DeviceOp recorded in the tuning database, e.g. by ckProfiler --tuning-db, for
+// the problem shape on arch, or else for the nearest shape recorded: the first of them that
+// is_supported(), e.g. by IsSupportedArgument(). A record names its instance by type id hash,
+// which is only meaningful to the toolchain that wrote it, and by GetTypeString(), which is
+// matched when no type id does. nullptr if there is none, the instances of
+// DeviceOperationInstanceFactory<DeviceOp>::GetInstances() are then left to try as usual.
+template <typename DeviceOp, typename IsSupported>
+std::unique_ptr<DeviceOp> get_tuned_device_op_instance(
+    const std::vector<int64_t>& shape,
+    const std::string& arch,
+    IsSupported&& is_supported,
+    const utils::TuningDatabase& database = utils::TuningDatabase::GetInstance())
+{
+    const auto records =
+        database.FindCandidates({get_device_op_signature<DeviceOp>(), arch, shape});
+
+    if(records.empty())
+        return nullptr;
+
+    auto op_ptrs = DeviceOperationInstanceFactory<DeviceOp>::GetInstances();
+
+    for(const auto* record : records)
+    {
+        for(const bool by_type_id : {true, false})
+        {
+            for(auto& op_ptr : op_ptrs)
+            {
+                if(op_ptr == nullptr)
+                    continue;
+
+                const bool is_recorded =
+                    by_type_id ? op_ptr->GetTypeIdHashCode() == record->instance_type_id
+                               : !record->instance_name.empty() &&
+                                     op_ptr->GetTypeString() == record->instance_name;
+
+                if(is_recorded && is_supported(*op_ptr))
+                    return std::move(op_ptr);
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+// as above, on the current device
+template <typename DeviceOp, typename IsSupported>
+std::unique_ptr<DeviceOp> get_tuned_device_op_instance(const std::vector<int64_t>& shape,
+                                                       IsSupported&& is_supported)
+{
+    return get_tuned_device_op_instance<DeviceOp>(
+        shape, get_device_name(), std::forward<IsSupported>(is_supported));
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
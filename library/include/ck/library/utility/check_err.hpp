@@ -4,175 +4,713 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 #include "ck/ck.hpp"
 #include "ck/utility/data_type.hpp"
 #include "ck/utility/type.hpp"
+#include "ck/utility/type_convert.hpp"
 #include "ck/host_utility/io.hpp"
 
+#include "ck/library/utility/host_thread_pool.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 namespace ck {
 namespace utils {
 
-template <typename Range, typename RefRange>
-typename std::enable_if<
-    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_floating_point_v<ranges::range_value_t<Range>> &&
-        !std::is_same_v<ranges::range_value_t<Range>, half_t>,
-    bool>::type
-check_err(const Range& out,
-          const RefRange& ref,
-          const std::string& msg = "Error: Incorrect results!",
-          double rtol            = 1e-5,
-          double atol            = 3e-6)
+// Statistics of an element-wise comparison of two ranges, see check_err_stats()
+struct CheckErrStats
 {
-    if(out.size() != ref.size())
+    static constexpr std::size_t NumUlpBucket = 16;
+
+    struct Mismatch
     {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
+        std::size_t offset; // position in the range, i.e. the offset into Tensor::mData
+        double out;
+        double ref;
+    };
+
+    std::size_t num_checked = 0; // smaller than the range size after an early exit
+    std::size_t err_count   = 0;
+    std::size_t nan_count   = 0; // elements with a NaN in out or ref
+    std::size_t inf_count   = 0; // elements with an infinity, but no NaN, in out or ref
+    double max_abs_err      = 0; // over the elements with finite out and ref
+    double max_rel_err      = 0; // over the elements with finite out and finite, nonzero ref
+    double max_err          = 0; // largest absolute error of a failing element
+
+    // ulp_histogram[0] counts exact matches, ulp_histogram[b] errors of [2^(b - 1), 2^b) ulps of
+    // the reference value, with sub-ulp errors in bucket 1 and the last bucket open ended
+    std::array<std::size_t, NumUlpBucket> ulp_histogram{};
+
+    // the first mismatches in range order, unless the comparison stopped early
+    std::vector<Mismatch> mismatches;
+
+    void Merge(const CheckErrStats& other, std::size_t max_report)
+    {
+        num_checked += other.num_checked;
+        err_count += other.err_count;
+        nan_count += other.nan_count;
+        inf_count += other.inf_count;
+        max_abs_err = std::max(max_abs_err, other.max_abs_err);
+        max_rel_err = std::max(max_rel_err, other.max_rel_err);
+        max_err     = std::max(max_err, other.max_err);
+
+        for(std::size_t b = 0; b < NumUlpBucket; ++b)
+            ulp_histogram[b] += other.ulp_histogram[b];
+
+        mismatches.insert(mismatches.end(), other.mismatches.begin(), other.mismatches.end());
+
+        std::sort(mismatches.begin(), mismatches.end(), [](const auto& a, const auto& b) {
+            return a.offset < b.offset;
+        });
+
+        if(mismatches.size() > max_report)
+            mismatches.resize(max_report);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const CheckErrStats& stats)
+    {
+        os << "checked: " << stats.num_checked << ", errors: " << stats.err_count
+           << ", NaN: " << stats.nan_count << ", Inf: " << stats.inf_count
+           << ", max abs err: " << stats.max_abs_err << ", max rel err: " << stats.max_rel_err
+           << ", ulp histogram: {";
+
+        for(std::size_t b = 0; b < NumUlpBucket; ++b)
+            os << (b == 0 ? "" : ", ") << stats.ulp_histogram[b];
+
+        return os << "}";
     }
+};
+
+namespace detail {
+
+// How check_err() compares elements of type T: values are converted to ComputeType, and one ulp
+// of a reference value r is 2^(max(ilogb(r), MinExponent) - NumMantissaBit). DefaultRtol and
+// DefaultAtol are the tolerances check_err() uses unless given others.
+template <typename T, typename = void>
+struct CheckErrTraits
+{
+    using ComputeType = double;
+
+    static constexpr bool IsInteger     = false;
+    static constexpr int NumMantissaBit = std::numeric_limits<T>::digits - 1;
+    static constexpr int MinExponent    = std::numeric_limits<T>::min_exponent - 1;
+    static constexpr double DefaultRtol = 1e-5;
+    static constexpr double DefaultAtol = 3e-6;
+
+    static double Convert(T x) { return static_cast<double>(x); }
+};
+
+template <typename T>
+struct CheckErrTraits<T, std::enable_if_t<std::is_integral_v<T>>>
+{
+    using ComputeType = int64_t;
+
+    static constexpr bool IsInteger     = true;
+    static constexpr int NumMantissaBit = 0;
+    static constexpr int MinExponent    = 0;
+    static constexpr double DefaultRtol = 0;
+    static constexpr double DefaultAtol = 0;
+
+    static int64_t Convert(T x) { return static_cast<int64_t>(x); }
+};
+
+#ifdef CK_EXPERIMENTAL_BIT_INT_EXTENSION_INT4
+template <>
+struct CheckErrTraits<int4_t> : CheckErrTraits<int8_t>
+{
+    static int64_t Convert(int4_t x) { return static_cast<int64_t>(x); }
+};
+#endif
+
+// 16-bit and 8-bit floating point types are compared after conversion to float
+template <typename T, int NumMantissaBit_, int MinExponent_>
+struct CheckErrTraitsViaFloat
+{
+    using ComputeType = double;
+
+    static constexpr bool IsInteger     = false;
+    static constexpr int NumMantissaBit = NumMantissaBit_;
+    static constexpr int MinExponent    = MinExponent_;
+    static constexpr double DefaultRtol = 1e-3;
+    static constexpr double DefaultAtol = 1e-3;
+
+    static double Convert(T x) { return type_convert<float>(x); }
+};
+
+template <>
+struct CheckErrTraits<half_t> : CheckErrTraitsViaFloat<half_t, 10, -14>
+{
+};
+
+template <>
+struct CheckErrTraits<bhalf_t> : CheckErrTraitsViaFloat<bhalf_t, 7, -126>
+{
+};
+
+#if defined CK_ENABLE_FP8
+template <>
+struct CheckErrTraits<f8_t> : CheckErrTraitsViaFloat<f8_t, 3, -7>
+{
+};
+#endif
+
+#if defined CK_ENABLE_BF8
+template <>
+struct CheckErrTraits<bf8_t> : CheckErrTraitsViaFloat<bf8_t, 2, -15>
+{
+};
+#endif
+
+// floor(log2(|x|)) for normal x, -1023 for 0
+inline int get_binary_exponent(double x)
+{
+    uint64_t bits;
+
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    return static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+}
+
+// ulp_histogram bucket of an error, NumUlpBucket for a non-finite error
+template <typename Traits>
+int get_ulp_bucket(double err, double ref)
+{
+    constexpr int NumUlpBucket = static_cast<int>(CheckErrStats::NumUlpBucket);
+
+    const int ulp_exponent =
+        Traits::IsInteger
+            ? 0
+            : std::max(get_binary_exponent(ref), Traits::MinExponent) - Traits::NumMantissaBit;
+
+    const int bucket =
+        std::clamp(get_binary_exponent(err) - ulp_exponent + 1, 1, NumUlpBucket - 1);
+
+    return err == 0 ? 0 : err < std::numeric_limits<double>::infinity() ? bucket : NumUlpBucket;
+}
+
+inline constexpr std::size_t CheckErrBlockSize = 1024;
+
+// Compare size <= CheckErrBlockSize elements starting at the iterators, which are advanced past
+// them. offset is the position of the first element in the whole range. The values are staged in
+// local buffers, so that the pass/fail test runs as a branch free loop the compiler can
+// vectorize; only blocks with failing or non-finite elements take the per-element slow path.
+template <typename T, typename OutIter, typename RefIter>
+void check_err_block(OutIter& out,
+                     RefIter& ref,
+                     std::size_t offset,
+                     std::size_t size,
+                     double rtol,
+                     double atol,
+                     std::size_t max_report,
+                     CheckErrStats& stats)
+{
+    using Traits      = CheckErrTraits<T>;
+    using ComputeType = typename Traits::ComputeType;
+
+    constexpr double Inf       = std::numeric_limits<double>::infinity();
+    constexpr int NumUlpBucket = static_cast<int>(CheckErrStats::NumUlpBucket);
+
+    std::array<ComputeType, CheckErrBlockSize> o;
+    std::array<ComputeType, CheckErrBlockSize> r;
+    std::array<double, CheckErrBlockSize> err;
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<double>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
     {
-        const double o = *std::next(std::begin(out), i);
-        const double r = *std::next(std::begin(ref), i);
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
+        OutIter out_iter = out;
+        RefIter ref_iter = ref;
+
+        for(std::size_t i = 0; i < size; ++i, ++out_iter, ++ref_iter)
         {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
+            o[i] = Traits::Convert(*out_iter);
+            r[i] = Traits::Convert(*ref_iter);
         }
+
+        out = out_iter;
+        ref = ref_iter;
+    }
+
+    // the maxima are taken over the bit patterns, which order non-negative doubles like their
+    // values and, unlike a floating point max, keep the reduction vectorizable
+    std::size_t num_fail      = 0;
+    std::size_t num_nonfinite = 0;
+    uint64_t max_abs_err_bits = 0;
+    uint64_t max_rel_err_bits = 0;
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const double e       = static_cast<double>(std::abs(o[i] - r[i]));
+        const double abs_r   = std::abs(static_cast<double>(r[i]));
+        const bool is_finite = e < Inf; // false if out or ref is NaN or infinite
+        const double rel     = e / abs_r;
+        const bool is_fail =
+            Traits::IsInteger ? e > atol : !(e <= atol + rtol * abs_r && is_finite);
+
+        uint64_t abs_err_bits;
+        uint64_t rel_err_bits;
+
+        std::memcpy(&abs_err_bits, &e, sizeof(abs_err_bits));
+        std::memcpy(&rel_err_bits, &rel, sizeof(rel_err_bits));
+
+        // drop non-finite errors, and relative errors for a zero reference
+        abs_err_bits &= -static_cast<uint64_t>(is_finite);
+        rel_err_bits &= -static_cast<uint64_t>(rel < Inf);
+
+        err[i] = e;
+        num_fail += is_fail;
+        num_nonfinite += !is_finite;
+        max_abs_err_bits = std::max(max_abs_err_bits, abs_err_bits);
+        max_rel_err_bits = std::max(max_rel_err_bits, rel_err_bits);
+    }
+
+    double max_abs_err;
+    double max_rel_err;
+
+    std::memcpy(&max_abs_err, &max_abs_err_bits, sizeof(max_abs_err));
+    std::memcpy(&max_rel_err, &max_rel_err_bits, sizeof(max_rel_err));
+
+    stats.max_abs_err = std::max(stats.max_abs_err, max_abs_err);
+    stats.max_rel_err = std::max(stats.max_rel_err, max_rel_err);
+
+    // the buckets in use are counted by one compare pass each rather than by a scatter, whose
+    // increments of the same few counters would serialize
+    std::array<int, CheckErrBlockSize> bucket;
+
+    int min_bucket = NumUlpBucket;
+    int max_bucket = 0;
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        bucket[i]  = get_ulp_bucket<Traits>(err[i], static_cast<double>(r[i]));
+        min_bucket = std::min(min_bucket, bucket[i]);
+        max_bucket = std::max(max_bucket, bucket[i]);
+    }
+
+    for(int b = min_bucket; b <= std::min(max_bucket, NumUlpBucket - 1); ++b)
+    {
+        std::size_t count = 0;
+
+        for(std::size_t i = 0; i < size; ++i)
+            count += bucket[i] == b;
+
+        stats.ulp_histogram[b] += count;
     }
-    if(!res)
+
+    if(num_fail != 0 || num_nonfinite != 0)
     {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            const double oi = static_cast<double>(o[i]);
+            const double ri = static_cast<double>(r[i]);
+
+            if(std::isnan(oi) || std::isnan(ri))
+                ++stats.nan_count;
+            else if(std::isinf(oi) || std::isinf(ri))
+                ++stats.inf_count;
+
+            const bool is_fail = Traits::IsInteger
+                                     ? err[i] > atol
+                                     : !(err[i] <= atol + rtol * std::abs(ri) && err[i] < Inf);
+
+            if(is_fail)
+            {
+                stats.max_err = err[i] > stats.max_err ? err[i] : stats.max_err;
+
+                if(stats.mismatches.size() < max_report)
+                    stats.mismatches.push_back({offset + i, oi, ri});
+            }
+        }
     }
-    return res;
+
+    stats.err_count += num_fail;
+    stats.num_checked += size;
 }
 
+template <typename Range, typename = void>
+struct HasHostTensorDescriptor : std::false_type
+{
+};
+
+template <typename Range>
+struct HasHostTensorDescriptor<
+    Range,
+    std::void_t<decltype(std::declval<const Range&>().mDesc.GetMultiIndexFromOffset(0))>>
+    : std::true_type
+{
+};
+
+// Whether two tensors (or tensor views) are compared by multi-index rather than as flat ranges
+// over their element space, i.e. unless both have the same lengths and strides and every element
+// of the element space belongs to exactly one multi-index
 template <typename Range, typename RefRange>
-typename std::enable_if<
-    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_same_v<ranges::range_value_t<Range>, bhalf_t>,
-    bool>::type
-check_err(const Range& out,
-          const RefRange& ref,
-          const std::string& msg = "Error: Incorrect results!",
-          double rtol            = 1e-3,
-          double atol            = 1e-3)
+bool is_check_err_by_index(const Range& out, const RefRange& ref)
 {
-    if(out.size() != ref.size())
+    if constexpr(HasHostTensorDescriptor<Range>::value && HasHostTensorDescriptor<RefRange>::value)
     {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
+        return out.mDesc.GetLengths() != ref.mDesc.GetLengths() ||
+               out.mDesc.GetStrides() != ref.mDesc.GetStrides() ||
+               out.mDesc.GetElementSize() != out.mDesc.GetElementSpaceSize();
+    }
+    else
+    {
+        (void)out;
+        (void)ref;
         return false;
     }
+}
 
-    bool res{true};
-    int err_count = 0;
-    double err    = 0;
-    // TODO: This is a hack. We should have proper specialization for bhalf_t data type.
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
+// check_err_stats() of two tensors with equal lengths but different layouts. The elements are
+// gathered block by block in the memory order of out and compared by check_err_block(); the
+// mismatches record the offset of the element in out, as for the flat comparison.
+template <typename T, typename OutTensor, typename RefTensor>
+CheckErrStats check_err_by_index(const OutTensor& out,
+                                 const RefTensor& ref,
+                                 double rtol,
+                                 double atol,
+                                 std::size_t max_report,
+                                 std::size_t max_fail)
+{
+    const auto& lens = out.mDesc.GetLengths();
+
+    if(lens != ref.mDesc.GetLengths())
+        throw std::runtime_error("check_err_stats: out and ref differ in lengths");
+
+    const std::vector<std::size_t> order = out.mDesc.GetTraversalOrder();
+    const auto& out_strides              = out.mDesc.GetStrides();
+    const auto& ref_strides              = ref.mDesc.GetStrides();
+
+    const std::size_t ndim      = lens.size();
+    const std::size_t size      = out.mDesc.GetElementSize();
+    const std::size_t num_block = (size + CheckErrBlockSize - 1) / CheckErrBlockSize;
+
+    CheckErrStats stats;
+    std::mutex mutex;
+    std::atomic<std::size_t> err_count{0};
+
+    host_common::HostThreadPool::GetInstance().ParallelFor(
+        num_block, [&](std::size_t block_begin, std::size_t block_end) {
+            CheckErrStats partial;
+
+            std::array<T, CheckErrBlockSize> o;
+            std::array<T, CheckErrBlockSize> r;
+            std::array<std::size_t, CheckErrBlockSize> out_offsets;
+            std::vector<std::size_t> index(ndim);
+
+            for(std::size_t block = block_begin; block < block_end; ++block)
             {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
+                if(max_fail != 0 && err_count.load(std::memory_order_relaxed) >= max_fail)
+                    break;
+
+                const std::size_t offset     = block * CheckErrBlockSize;
+                const std::size_t block_size = std::min(CheckErrBlockSize, size - offset);
+
+                // multi-index of the first element, innermost loop last
+                std::size_t out_offset = 0;
+                std::size_t ref_offset = 0;
+
+                for(std::size_t level = ndim, i = offset; level-- > 0;)
+                {
+                    const std::size_t d = order[level];
+
+                    index[d] = i % lens[d];
+                    i /= lens[d];
+                    out_offset += index[d] * out_strides[d];
+                    ref_offset += index[d] * ref_strides[d];
+                }
+
+                for(std::size_t i = 0; i < block_size; ++i)
+                {
+                    o[i]           = out.mData[out_offset];
+                    r[i]           = ref.mData[ref_offset];
+                    out_offsets[i] = out_offset;
+
+                    for(std::size_t level = ndim; level-- > 0;)
+                    {
+                        const std::size_t d = order[level];
+
+                        out_offset += out_strides[d];
+                        ref_offset += ref_strides[d];
+
+                        if(++index[d] < lens[d] || level == 0)
+                            break;
+
+                        out_offset -= lens[d] * out_strides[d];
+                        ref_offset -= lens[d] * ref_strides[d];
+                        index[d] = 0;
+                    }
+                }
+
+                const std::size_t num_fail   = partial.err_count;
+                const std::size_t num_report = partial.mismatches.size();
+
+                const T* out_iter = o.data();
+                const T* ref_iter = r.data();
+
+                check_err_block<T>(
+                    out_iter, ref_iter, offset, block_size, rtol, atol, max_report, partial);
+
+                for(std::size_t m = num_report; m < partial.mismatches.size(); ++m)
+                {
+                    auto& mismatch = partial.mismatches[m];
+
+                    mismatch.offset = out_offsets[mismatch.offset - offset];
+                }
+
+                err_count += partial.err_count - num_fail;
             }
-            res = false;
-        }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            stats.Merge(partial, max_report);
+        });
+
+    return stats;
+}
+
+// "i" for plain ranges, "i0, i1, ..." for tensors
+template <typename Range>
+std::string format_check_err_index(const Range& range, std::size_t offset)
+{
+    if constexpr(HasHostTensorDescriptor<Range>::value)
+    {
+        std::string str;
+
+        for(std::size_t i : range.mDesc.GetMultiIndexFromOffset(offset))
+            str += (str.empty() ? "" : ", ") + std::to_string(i);
+
+        return str;
     }
-    if(!res)
+    else
     {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
+        return std::to_string(offset);
     }
-    return res;
 }
 
+} // namespace detail
+
+// Compare out against ref element by element and gather statistics; an element fails if
+// |out - ref| > atol + rtol * |ref| or either value is not finite (integers: |out - ref| > atol).
+// Random access ranges are split into blocks compared on the host thread pool. Tensors or tensor
+// views of different layouts are compared by multi-index and need equal lengths rather than sizes.
+// At most max_report mismatches are recorded. A nonzero max_fail stops the comparison once that
+// many failures are found, the statistics then only cover the elements checked so far.
 template <typename Range, typename RefRange>
-typename std::enable_if<
-    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_same_v<ranges::range_value_t<Range>, half_t>,
-    bool>::type
-check_err(const Range& out,
-          const RefRange& ref,
-          const std::string& msg = "Error: Incorrect results!",
-          double rtol            = 1e-3,
-          double atol            = 1e-3)
+CheckErrStats check_err_stats(const Range& out,
+                              const RefRange& ref,
+                              double rtol,
+                              double atol,
+                              std::size_t max_report = 4,
+                              std::size_t max_fail   = 0)
 {
+    using T = ranges::range_value_t<Range>;
+
+    static_assert(std::is_same_v<T, ranges::range_value_t<RefRange>>);
+
+    constexpr std::size_t BlockSize = detail::CheckErrBlockSize;
+
+    if constexpr(detail::HasHostTensorDescriptor<Range>::value &&
+                 detail::HasHostTensorDescriptor<RefRange>::value)
+    {
+        if(detail::is_check_err_by_index(out, ref))
+            return detail::check_err_by_index<T>(out, ref, rtol, atol, max_report, max_fail);
+    }
+
     if(out.size() != ref.size())
+        throw std::runtime_error("check_err_stats: out and ref differ in size");
+
+    const std::size_t size      = out.size();
+    const std::size_t num_block = (size + BlockSize - 1) / BlockSize;
+
+    using OutIter = decltype(std::begin(out));
+    using RefIter = decltype(std::begin(ref));
+
+    CheckErrStats stats;
+
+    if constexpr(std::is_base_of_v<std::random_access_iterator_tag,
+                                   typename std::iterator_traits<OutIter>::iterator_category> &&
+                 std::is_base_of_v<std::random_access_iterator_tag,
+                                   typename std::iterator_traits<RefIter>::iterator_category>)
+    {
+        std::mutex mutex;
+        std::atomic<std::size_t> err_count{0};
+
+        host_common::HostThreadPool::GetInstance().ParallelFor(
+            num_block, [&](std::size_t block_begin, std::size_t block_end) {
+                CheckErrStats partial;
+
+                for(std::size_t block = block_begin; block < block_end; ++block)
+                {
+                    if(max_fail != 0 && err_count.load(std::memory_order_relaxed) >= max_fail)
+                        break;
+
+                    const std::size_t offset   = block * BlockSize;
+                    const std::size_t num_fail = partial.err_count;
+
+                    OutIter out_iter = std::begin(out) + offset;
+                    RefIter ref_iter = std::begin(ref) + offset;
+
+                    detail::check_err_block<T>(out_iter,
+                                               ref_iter,
+                                               offset,
+                                               std::min(BlockSize, size - offset),
+                                               rtol,
+                                               atol,
+                                               max_report,
+                                               partial);
+
+                    err_count += partial.err_count - num_fail;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                stats.Merge(partial, max_report);
+            });
+    }
+    else
+    {
+        OutIter out_iter = std::begin(out);
+        RefIter ref_iter = std::begin(ref);
+
+        for(std::size_t block = 0; block < num_block; ++block)
+        {
+            if(max_fail != 0 && stats.err_count >= max_fail)
+                break;
+
+            detail::check_err_block<T>(out_iter,
+                                       ref_iter,
+                                       block * BlockSize,
+                                       std::min(BlockSize, size - block * BlockSize),
+                                       rtol,
+                                       atol,
+                                       max_report,
+                                       stats);
+        }
+    }
+
+    return stats;
+}
+
+namespace detail {
+
+// Shared body of the check_err() overloads: print the first mismatches and a summary on failure
+template <typename Range, typename RefRange>
+bool check_err_impl(
+    const Range& out, const RefRange& ref, const std::string& msg, double rtol, double atol)
+{
+    bool is_by_index = false;
+
+    if constexpr(HasHostTensorDescriptor<Range>::value && HasHostTensorDescriptor<RefRange>::value)
+    {
+        is_by_index = is_check_err_by_index(out, ref);
+
+        if(is_by_index && out.mDesc.GetLengths() != ref.mDesc.GetLengths())
+        {
+            std::cerr << msg << " out and ref differ in lengths" << std::endl;
+            return false;
+        }
+    }
+
+    if(!is_by_index && out.size() != ref.size())
     {
         std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
                   << std::endl;
         return false;
     }
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<ranges::range_value_t<Range>>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
+    using Traits = CheckErrTraits<ranges::range_value_t<Range>>;
+
+    const CheckErrStats stats = check_err_stats(out, ref, rtol, atol);
+
+    if(stats.err_count == 0)
+        return true;
+
+    for(const auto& mismatch : stats.mismatches)
     {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
+        const std::string index = format_check_err_index(out, mismatch.offset);
+
+        if constexpr(Traits::IsInteger)
         {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
+            std::cerr << msg << " out[" << index << "] != ref[" << index
+                      << "]: " << static_cast<int64_t>(mismatch.out)
+                      << " != " << static_cast<int64_t>(mismatch.ref) << std::endl;
+        }
+        else
+        {
+            std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << index
+                      << "] != ref[" << index << "]: " << mismatch.out << " != " << mismatch.ref
+                      << std::endl;
         }
     }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+
+    const float error_percent =
+        static_cast<float>(stats.err_count) / static_cast<float>(stats.num_checked) * 100.f;
+    std::cerr << "max err: " << stats.max_err;
+    std::cerr << ", number of errors: " << stats.err_count;
+    std::cerr << ", " << error_percent << "% wrong values";
+
+    if(stats.nan_count != 0 || stats.inf_count != 0)
+        std::cerr << ", NaN: " << stats.nan_count << ", Inf: " << stats.inf_count;
+
+    std::cerr << std::endl;
+
+    return false;
+}
+
+} // namespace detail
+
+template <typename Range, typename RefRange>
+typename std::enable_if<
+    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+        std::is_floating_point_v<ranges::range_value_t<Range>> &&
+        !std::is_same_v<ranges::range_value_t<Range>, half_t>,
+    bool>::type
+check_err(const Range& out,
+          const RefRange& ref,
+          const std::string& msg = "Error: Incorrect results!",
+          double rtol            = detail::CheckErrTraits<float>::DefaultRtol,
+          double atol            = detail::CheckErrTraits<float>::DefaultAtol)
+{
+    return detail::check_err_impl(out, ref, msg, rtol, atol);
+}
+
+template <typename Range, typename RefRange>
+typename std::enable_if<
+    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+        std::is_same_v<ranges::range_value_t<Range>, bhalf_t>,
+    bool>::type
+check_err(const Range& out,
+          const RefRange& ref,
+          const std::string& msg = "Error: Incorrect results!",
+          double rtol            = detail::CheckErrTraits<bhalf_t>::DefaultRtol,
+          double atol            = detail::CheckErrTraits<bhalf_t>::DefaultAtol)
+{
+    return detail::check_err_impl(out, ref, msg, rtol, atol);
+}
+
+template <typename Range, typename RefRange>
+typename std::enable_if<
+    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+        std::is_same_v<ranges::range_value_t<Range>, half_t>,
+    bool>::type
+check_err(const Range& out,
+          const RefRange& ref,
+          const std::string& msg = "Error: Incorrect results!",
+          double rtol            = detail::CheckErrTraits<half_t>::DefaultRtol,
+          double atol            = detail::CheckErrTraits<half_t>::DefaultAtol)
+{
+    return detail::check_err_impl(out, ref, msg, rtol, atol);
 }
 
 template <typename Range, typename RefRange>
@@ -188,46 +726,9 @@ check_err(const Range& out,
           const RefRange& ref,
           const std::string& msg = "Error: Incorrect results!",
           double                 = 0,
-          double atol            = 0)
+          double atol            = detail::CheckErrTraits<int32_t>::DefaultAtol)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    bool res{true};
-    int err_count   = 0;
-    int64_t err     = 0;
-    int64_t max_err = std::numeric_limits<int64_t>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const int64_t o = *std::next(std::begin(out), i);
-        const int64_t r = *std::next(std::begin(ref), i);
-        err             = std::abs(o - r);
-
-        if(err > atol)
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << " out[" << i << "] != ref[" << i << "]: " << o << " != " << r
-                          << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return detail::check_err_impl(out, ref, msg, 0, atol);
 }
 
 #if defined CK_ENABLE_FP8
@@ -238,42 +739,10 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
 check_err(const Range& out,
           const RefRange& ref,
           const std::string& msg = "Error: Incorrect results!",
-          double rtol            = 1e-3,
-          double atol            = 1e-3)
+          double rtol            = detail::CheckErrTraits<f8_t>::DefaultRtol,
+          double atol            = detail::CheckErrTraits<f8_t>::DefaultAtol)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    return detail::check_err_impl(out, ref, msg, rtol, atol);
 }
 #endif
 
@@ -285,42 +754,10 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
 check_err(const Range& out,
           const RefRange& ref,
           const std::string& msg = "Error: Incorrect results!",
-          double rtol            = 1e-3,
-          double atol            = 1e-3)
+          double rtol            = detail::CheckErrTraits<bf8_t>::DefaultRtol,
+          double atol            = detail::CheckErrTraits<bf8_t>::DefaultAtol)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    return detail::check_err_impl(out, ref, msg, rtol, atol);
 }
 #endif
 
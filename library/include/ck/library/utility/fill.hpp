@@ -11,22 +11,28 @@
 #include <utility>
 
 #include "ck/utility/data_type.hpp"
+#include "ck/library/utility/host_random.hpp"
 
 namespace ck {
 namespace utils {
 
+// Values are keyed by the position in the range and the random stream of the functor, so filling
+// runs in parallel and gives the same values for any number of threads.
 template <typename T>
 struct FillUniformDistribution
 {
     float a_{-5.f};
     float b_{5.f};
+    ck::host_common::HostRandomStream rng_{};
 
     template <typename ForwardIter>
     void operator()(ForwardIter first, ForwardIter last) const
     {
-        std::mt19937 gen(11939);
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(first, last, [&dis, &gen]() { return ck::type_convert<T>(dis(gen)); });
+        ck::host_common::host_random_fill(first, last, rng_, [this](std::uint32_t bits) {
+            const float u = ck::host_common::HostRandomStream::ToUniform(bits);
+
+            return ck::type_convert<T>(a_ + u * (b_ - a_));
+        });
     }
 
     template <typename ForwardRange>
@@ -40,38 +46,22 @@ struct FillUniformDistribution
     }
 };
 
-// Normally FillUniformDistributionIntegerValue should use std::uniform_int_distribution as below.
-// However this produces segfaults in std::mt19937 which look like inifite loop.
-//      template <typename T>
-//      struct FillUniformDistributionIntegerValue
-//      {
-//          int a_{-5};
-//          int b_{5};
-//
-//          template <typename ForwardIter>
-//          void operator()(ForwardIter first, ForwardIter last) const
-//          {
-//              std::mt19937 gen(11939);
-//              std::uniform_int_distribution<int> dis(a_, b_);
-//              std::generate(
-//                  first, last, [&dis, &gen]() { return ck::type_convert<T>(dis(gen)); });
-//          }
-//      };
-
-// Workaround for uniform_int_distribution not working as expected. See note above.<
+// Integer values in [a_, b_], drawn as rounded uniform real values
 template <typename T>
 struct FillUniformDistributionIntegerValue
 {
     float a_{-5.f};
     float b_{5.f};
+    ck::host_common::HostRandomStream rng_{};
 
     template <typename ForwardIter>
     void operator()(ForwardIter first, ForwardIter last) const
     {
-        std::mt19937 gen(11939);
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(
-            first, last, [&dis, &gen]() { return ck::type_convert<T>(std::round(dis(gen))); });
+        ck::host_common::host_random_fill(first, last, rng_, [this](std::uint32_t bits) {
+            const float u = ck::host_common::HostRandomStream::ToUniform(bits);
+
+            return ck::type_convert<T>(std::round(a_ + u * (b_ - a_)));
+        });
     }
 
     template <typename ForwardRange>
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ck {
+namespace host_common {
+
+// How Tensor initializes newly allocated storage
+enum struct HostMemoryInit
+{
+    Zero,       // zero filled, for free if the block is mapped directly
+    FirstTouch, // one write per page by the host thread pool, the values are indeterminate
+    None,       // left alone, pages get mapped by whichever thread writes them first
+};
+
+inline constexpr std::size_t HostHugePageSize = std::size_t{2} << 20;
+
+// Allocate bytes aligned to alignment. Allocations of at least one huge page are mapped directly,
+// huge page aligned and, where supported, advised to be backed by transparent huge pages. Throws
+// std::bad_alloc.
+void* allocate_host_memory(std::size_t bytes, std::size_t alignment);
+
+// Release a block of allocate_host_memory(bytes, ...)
+void free_host_memory(void* p, std::size_t bytes) noexcept;
+
+// Initialize a block just returned by allocate_host_memory(bytes, ...) as init asks for. Directly
+// mapped blocks already read as zero. Otherwise large blocks are split by pages over the host
+// thread pool, so that the pages are first touched, i.e. placed, by the threads that work on them
+// later.
+void initialize_host_allocation(void* p, std::size_t bytes, HostMemoryInit init);
+
+// Allocator of host tensor storage. Blocks are Alignment aligned (huge page aligned when large) and
+// elements are default-initialized, so a std::vector of a trivial type is created without writing
+// to its memory; Init tells Tensor how to initialize the storage instead.
+template <typename T, HostMemoryInit Init_ = HostMemoryInit::Zero, std::size_t Alignment = 64>
+struct HostAllocator
+{
+    using value_type = T;
+
+    static constexpr HostMemoryInit Init = Init_;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = HostAllocator<U, Init_, Alignment>;
+    };
+
+    HostAllocator() = default;
+
+    template <typename U>
+    HostAllocator(const HostAllocator<U, Init_, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(
+            allocate_host_memory(n * sizeof(T), std::max(Alignment, alignof(T))));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { free_host_memory(p, n * sizeof(T)); }
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new(static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template <typename T, typename U, HostMemoryInit Init, std::size_t Alignment>
+bool operator==(const HostAllocator<T, Init, Alignment>&, const HostAllocator<U, Init, Alignment>&)
+{
+    return true;
+}
+
+template <typename T, typename U, HostMemoryInit Init, std::size_t Alignment>
+bool operator!=(const HostAllocator<T, Init, Alignment>&, const HostAllocator<U, Init, Alignment>&)
+{
+    return false;
+}
+
+// For tensors that are completely overwritten right after construction, e.g. by
+// GenerateTensorValue() or a copy from the device: the storage is only faulted in.
+template <typename T>
+using HostUninitializedAllocator = HostAllocator<T, HostMemoryInit::FirstTouch>;
+
+// Initialization an allocator asks for; allocators other than HostAllocator value-initialize
+// the elements themselves
+template <typename Allocator, typename = void>
+struct host_memory_init_of
+{
+    static constexpr HostMemoryInit value = HostMemoryInit::None;
+};
+
+template <typename Allocator>
+struct host_memory_init_of<Allocator, std::void_t<decltype(Allocator::Init)>>
+{
+    static constexpr HostMemoryInit value = Allocator::Init;
+};
+
+} // namespace host_common
+} // namespace ck
@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include "ck/ck.hpp"
+#include "ck/library/utility/host_tensor.hpp"
 
 namespace ck {
 
@@ -132,5 +133,25 @@ static inline size_t get_offset_from_index(const std::array<index_t, NDim>& stri
     return (offset);
 };
 
+// Row-major odometer over lengths carrying the offsets under every stride set, so that index
+// spaces are walked lazily instead of being materialized by get_index_set()
+template <int NDim, typename... Strides>
+auto make_host_index_odometer(const std::array<index_t, NDim>& lengths, const Strides&... strides)
+{
+    using Odometer = HostTensorIndexOdometer<NDim, sizeof...(Strides)>;
+    using Index    = typename Odometer::Index;
+
+    auto to_index = [](const std::array<index_t, NDim>& values) {
+        Index index;
+
+        std::copy(values.begin(), values.end(), index.begin());
+
+        return index;
+    };
+
+    return Odometer(to_index(lengths),
+                    std::array<Index, sizeof...(Strides)>{to_index(strides)...});
+}
+
 } // namespace host_common
 } // namespace ck
@@ -0,0 +1,843 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "host_gemm.hpp"
+#include "host_tensor.hpp"
+#include "host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Geometry of a convolution over NDimSpatial dimensions and the lowering of its input to im2col
+// matrices. Row m = (n, o...) of the im2col matrix of a group holds, for every channel c and
+// filter tap t = (z, y, x), the input pixel i = o * stride + t * dilation - left_pad, or zero
+// where i falls into the padding. The input descriptor is in [G, N, C, Di, Hi, Wi] order, any
+// physical layout; only left pads matter, the output lengths bound the rows.
+template <std::size_t NDimSpatial>
+class HostConvIm2Col
+{
+    public:
+    template <typename FilterLengthIterator, typename OutputLengthIterator>
+    HostConvIm2Col(const HostTensorDescriptor& in_desc,
+                   FilterLengthIterator filter_spatial_lengths,
+                   OutputLengthIterator output_spatial_lengths,
+                   const std::vector<index_t>& conv_strides,
+                   const std::vector<index_t>& conv_dilations,
+                   const std::vector<index_t>& in_left_pads)
+        : mN{in_desc.GetLengths()[1]},
+          mC{in_desc.GetLengths()[2]},
+          mInNStride{in_desc.GetStrides()[1]},
+          mInCStride{in_desc.GetStrides()[2]}
+    {
+        if(in_desc.GetNumOfDimension() != NDimSpatial + 3 || conv_strides.size() < NDimSpatial ||
+           conv_dilations.size() < NDimSpatial || in_left_pads.size() < NDimSpatial)
+        {
+            throw std::runtime_error("wrong! inconsistent dimension");
+        }
+
+        for(std::size_t d = 0; d < NDimSpatial; ++d)
+        {
+            mInLengths[d]     = in_desc.GetLengths()[d + 3];
+            mInStrides[d]     = in_desc.GetStrides()[d + 3];
+            mFilterLengths[d] = static_cast<std::size_t>(filter_spatial_lengths[d]);
+            mOutLengths[d]    = static_cast<std::size_t>(output_spatial_lengths[d]);
+            mConvStrides[d]   = conv_strides[d];
+            mConvDilations[d] = conv_dilations[d];
+            mInLeftPads[d]    = in_left_pads[d];
+        }
+    }
+
+    // N * Do * Ho * Wo
+    std::size_t GetNumRow() const { return mN * Product(mOutLengths); }
+
+    // Z * Y * X
+    std::size_t GetNumTap() const { return Product(mFilterLengths); }
+
+    // C * Z * Y * X
+    std::size_t GetNumColumn() const { return mC * GetNumTap(); }
+
+    // {n, do, ho, wo} of row m
+    std::array<std::size_t, NDimSpatial + 1> GetRowIndex(std::size_t m) const
+    {
+        std::array<std::size_t, NDimSpatial + 1> idx;
+
+        for(std::size_t d = NDimSpatial; d > 0; --d)
+        {
+            idx[d] = m % mOutLengths[d - 1];
+            m /= mOutLengths[d - 1];
+        }
+
+        idx[0] = m;
+
+        return idx;
+    }
+
+    // offset under desc, in [G, N, K, Do, Ho, Wo] order, of element (0, n, 0, do, ho, wo) of
+    // every row
+    std::vector<std::size_t> GetRowOffsets(const HostTensorDescriptor& desc) const
+    {
+        if(desc.GetNumOfDimension() != NDimSpatial + 3)
+            throw std::runtime_error("wrong! inconsistent dimension");
+
+        const auto& strides = desc.GetStrides();
+
+        std::vector<std::size_t> offsets(GetNumRow());
+
+        host_parallel_for(offsets.size(), [&](std::size_t m) {
+            const auto row = GetRowIndex(m);
+
+            offsets[m] = row[0] * strides[1];
+
+            for(std::size_t d = 0; d < NDimSpatial; ++d)
+                offsets[m] += row[d + 1] * strides[d + 3];
+        });
+
+        return offsets;
+    }
+
+    // Write rows [row_begin, row_begin + rows) of the im2col matrix of the group at p_in, with
+    // (row r, channel c, tap t) at p_dst[r * row_stride + c * c_stride + t * tap_stride]; c_stride
+    // and tap_stride pick the column order. convert turns an input element into DstDataType.
+    // Rows are walked odometer-style, and the bounds of an input pixel are checked once for all
+    // of its channels, which are read directly when the input has unit channel stride (NHWC).
+    template <typename DstDataType, typename InDataType, typename Convert>
+    void FillRows(DstDataType* p_dst,
+                  std::size_t row_stride,
+                  std::size_t c_stride,
+                  std::size_t tap_stride,
+                  const InDataType* p_in,
+                  std::size_t row_begin,
+                  std::size_t rows,
+                  const Convert& convert) const
+    {
+        const std::size_t num_tap = GetNumTap();
+
+        auto row = GetRowIndex(row_begin);
+
+        for(std::size_t r = 0; r < rows; ++r)
+        {
+            std::array<std::size_t, NDimSpatial> tap{};
+
+            for(std::size_t t = 0; t < num_tap; ++t)
+            {
+                bool is_valid      = true;
+                std::size_t offset = row[0] * mInNStride;
+
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                {
+                    const long_index_t i =
+                        static_cast<long_index_t>(row[d + 1]) * mConvStrides[d] +
+                        static_cast<long_index_t>(tap[d]) * mConvDilations[d] - mInLeftPads[d];
+
+                    is_valid = is_valid && i >= 0 && static_cast<std::size_t>(i) < mInLengths[d];
+
+                    offset += static_cast<std::size_t>(i) * mInStrides[d];
+                }
+
+                DstDataType* dst = p_dst + r * row_stride + t * tap_stride;
+
+                if(!is_valid)
+                {
+                    for(std::size_t c = 0; c < mC; ++c)
+                        dst[c * c_stride] = DstDataType{0};
+                }
+                else if(mInCStride == 1)
+                {
+                    const InDataType* src = p_in + offset;
+
+                    for(std::size_t c = 0; c < mC; ++c)
+                        dst[c * c_stride] = convert(src[c]);
+                }
+                else
+                {
+                    const InDataType* src = p_in + offset;
+
+                    for(std::size_t c = 0; c < mC; ++c)
+                        dst[c * c_stride] = convert(src[c * mInCStride]);
+                }
+
+                Advance(tap, mFilterLengths, 0);
+            }
+
+            Advance(row, mOutLengths, 1);
+        }
+    }
+
+    // [row_begin, row_end) of the rows of image n that may gather a pixel whose first spatial
+    // index lies in [band_begin, band_end); needs non-negative dilations
+    std::pair<std::size_t, std::size_t>
+    GetBandRows(std::size_t n, std::size_t band_begin, std::size_t band_end) const
+    {
+        const long_index_t lowest = static_cast<long_index_t>(band_begin) + mInLeftPads[0] -
+                                    static_cast<long_index_t>(mFilterLengths[0] - 1) *
+                                        mConvDilations[0];
+        const long_index_t highest = static_cast<long_index_t>(band_end) - 1 + mInLeftPads[0];
+
+        const long_index_t o_begin =
+            lowest <= 0 ? 0 : (lowest + mConvStrides[0] - 1) / mConvStrides[0];
+        const long_index_t o_end =
+            highest < 0 ? 0
+                        : std::min(highest / mConvStrides[0] + 1,
+                                   static_cast<long_index_t>(mOutLengths[0]));
+
+        const std::size_t num_out  = Product(mOutLengths);
+        const std::size_t row_base = n * num_out;
+
+        if(num_out == 0 || o_begin >= o_end)
+            return {row_base, row_base};
+
+        const std::size_t rows_per_o = num_out / mOutLengths[0];
+
+        return {row_base + static_cast<std::size_t>(o_begin) * rows_per_o,
+                row_base + static_cast<std::size_t>(o_end) * rows_per_o};
+    }
+
+    // The transpose of FillRows(), limited to a band of the input: for rows [row_begin,
+    // row_begin + rows), calls accumulate(offset, v) with the offset of the input element that
+    // (row r, channel c, tap t) gathers and v = p_src[r * row_stride + c * c_stride +
+    // t * tap_stride], for the input pixels whose first spatial index lies in [band_begin,
+    // band_end) only. Every input element sees its values in increasing (row, tap) order, so
+    // disjoint bands can be scattered concurrently, with the result of a serial scatter.
+    template <typename SrcDataType, typename Accumulate>
+    void ScatterRows(const SrcDataType* p_src,
+                     std::size_t row_stride,
+                     std::size_t c_stride,
+                     std::size_t tap_stride,
+                     std::size_t row_begin,
+                     std::size_t rows,
+                     std::size_t band_begin,
+                     std::size_t band_end,
+                     const Accumulate& accumulate) const
+    {
+        const std::size_t num_tap = GetNumTap();
+
+        auto row = GetRowIndex(row_begin);
+
+        for(std::size_t r = 0; r < rows; ++r)
+        {
+            std::array<std::size_t, NDimSpatial> tap{};
+
+            for(std::size_t t = 0; t < num_tap; ++t)
+            {
+                bool is_valid      = true;
+                std::size_t offset = row[0] * mInNStride;
+
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                {
+                    const long_index_t i =
+                        static_cast<long_index_t>(row[d + 1]) * mConvStrides[d] +
+                        static_cast<long_index_t>(tap[d]) * mConvDilations[d] - mInLeftPads[d];
+
+                    is_valid = is_valid && i >= 0 && static_cast<std::size_t>(i) < mInLengths[d];
+
+                    if(d == 0)
+                    {
+                        is_valid = is_valid && static_cast<std::size_t>(i) >= band_begin &&
+                                   static_cast<std::size_t>(i) < band_end;
+                    }
+
+                    offset += static_cast<std::size_t>(i) * mInStrides[d];
+                }
+
+                if(is_valid)
+                {
+                    const SrcDataType* src = p_src + r * row_stride + t * tap_stride;
+
+                    for(std::size_t c = 0; c < mC; ++c)
+                        accumulate(offset + c * mInCStride, src[c * c_stride]);
+                }
+
+                Advance(tap, mFilterLengths, 0);
+            }
+
+            Advance(row, mOutLengths, 1);
+        }
+    }
+
+    private:
+    template <std::size_t Size>
+    static std::size_t Product(const std::array<std::size_t, Size>& lengths)
+    {
+        return std::accumulate(
+            lengths.begin(), lengths.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    // increment the spatial part of idx, starting at first, last dimension fastest
+    template <std::size_t Size>
+    static void Advance(std::array<std::size_t, Size>& idx,
+                        const std::array<std::size_t, NDimSpatial>& lengths,
+                        std::size_t first)
+    {
+        for(std::size_t d = Size; d > first; --d)
+        {
+            if(++idx[d - 1] < lengths[d - 1 - first])
+                return;
+
+            idx[d - 1] = 0;
+        }
+
+        if(first > 0)
+            ++idx[0];
+    }
+
+    std::size_t mN;
+    std::size_t mC;
+    std::size_t mInNStride;
+    std::size_t mInCStride;
+    std::array<std::size_t, NDimSpatial> mInLengths;
+    std::array<std::size_t, NDimSpatial> mInStrides;
+    std::array<std::size_t, NDimSpatial> mFilterLengths;
+    std::array<std::size_t, NDimSpatial> mOutLengths;
+    std::array<long_index_t, NDimSpatial> mConvStrides;
+    std::array<long_index_t, NDimSpatial> mConvDilations;
+    std::array<long_index_t, NDimSpatial> mInLeftPads;
+};
+
+// Number of im2col rows lowered at a time: a panel of about PanelSize elements for rows of
+// row_size elements, at least one micro-kernel tile and at most max_rows.
+template <typename AccDataType>
+std::size_t get_host_conv_rows_per_panel(std::size_t row_size, std::size_t max_rows)
+{
+    constexpr std::size_t MR        = HostGemmBlocking<AccDataType>::MR;
+    constexpr std::size_t PanelSize = std::size_t{1} << 20;
+
+    const std::size_t rows = PanelSize / std::max<std::size_t>(row_size, 1);
+
+    return std::clamp(rows / MR * MR, MR, std::max(max_rows, MR));
+}
+
+// offset under wei_desc, in [G, K, C, Z, Y, X] order, of element (0, 0, c, z, y, x) of every
+// im2col column c * taps + t
+template <std::size_t NDimSpatial>
+std::vector<std::size_t> get_host_conv_filter_offsets(const HostTensorDescriptor& wei_desc)
+{
+    if(wei_desc.GetNumOfDimension() != NDimSpatial + 3)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    const auto& lengths = wei_desc.GetLengths();
+    const auto& strides = wei_desc.GetStrides();
+
+    const std::size_t num_tap = std::accumulate(
+        lengths.begin() + 3, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>());
+
+    std::vector<std::size_t> offsets(lengths[2] * num_tap);
+
+    for(std::size_t column = 0; column < offsets.size(); ++column)
+    {
+        std::size_t rest = column;
+
+        offsets[column] = 0;
+
+        for(std::size_t d = NDimSpatial + 2; d > 2; --d)
+        {
+            offsets[column] += rest % lengths[d] * strides[d];
+            rest /= lengths[d];
+        }
+
+        offsets[column] += rest * strides[2];
+    }
+
+    return offsets;
+}
+
+// Forward convolution lowered onto host_gemm_packed(), for every group g:
+//   out[g, m, k] = sum_{c, t} in_convert(im2col_g[m, (c, t)]) * wei_convert(wei[g, k, c, t])
+// The weights of a group are converted once into a [K, C * taps] matrix; im2col rows are lowered
+// tile by tile into panels that stay in cache, so the im2col matrix is never materialized. Each
+// result accumulates over c, then over the taps in increasing order, the order of the direct
+// loop nest, with padding taps adding zero. So results match the direct loop nest bit by bit as
+// long as the weights are finite: FillRows() writes padding taps as zero rather than skipping
+// them, and an inf or NaN weight times such a zero yields NaN where the direct loop nest, which
+// never reads padding, does not. wei_desc is in [G, K, C, Z, Y, X] order; out_store(g, m, k, acc)
+// writes one result.
+template <typename AccDataType,
+          std::size_t NDimSpatial,
+          typename InDataType,
+          typename WeiDataType,
+          typename InConvert,
+          typename WeiConvert,
+          typename OutStore>
+void host_conv_fwd_packed(const HostConvIm2Col<NDimSpatial>& im2col,
+                          const InDataType* p_in,
+                          std::size_t in_g_stride,
+                          const WeiDataType* p_wei,
+                          const HostTensorDescriptor& wei_desc,
+                          const InConvert& in_convert,
+                          const WeiConvert& wei_convert,
+                          const OutStore& out_store,
+                          std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    const auto& wei_lengths = wei_desc.GetLengths();
+    const auto& wei_strides = wei_desc.GetStrides();
+
+    const std::size_t G          = wei_lengths[0];
+    const std::size_t K          = wei_lengths[1];
+    const std::size_t M          = im2col.GetNumRow();
+    const std::size_t num_tap    = im2col.GetNumTap();
+    const std::size_t num_column = im2col.GetNumColumn();
+
+    if(wei_desc.GetNumOfDimension() != NDimSpatial + 3 || wei_lengths[2] * num_tap != num_column)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    const auto wei_offsets = get_host_conv_filter_offsets<NDimSpatial>(wei_desc);
+
+    // wei_pack[g, k, c * taps + t]
+    std::vector<AccDataType> wei_pack(G * K * num_column);
+
+    host_parallel_for(
+        G * K,
+        [&](std::size_t gk) {
+            const WeiDataType* src = p_wei + gk / K * wei_strides[0] + gk % K * wei_strides[1];
+            AccDataType* dst       = wei_pack.data() + gk * num_column;
+
+            for(std::size_t column = 0; column < num_column; ++column)
+                dst[column] = wei_convert(src[wei_offsets[column]]);
+        },
+        num_thread);
+
+    const std::size_t rows_per_panel =
+        get_host_conv_rows_per_panel<AccDataType>(num_column, HostGemmBlocking<AccDataType>::MC);
+    const std::size_t num_panel      = (M + rows_per_panel - 1) / rows_per_panel;
+
+    auto identity = [](AccDataType v) { return v; };
+
+    // the GEMM of a panel runs on the calling thread, the parallelism is over (group, panel)
+    host_parallel_for(
+        G * num_panel,
+        [&](std::size_t task) {
+            const std::size_t g       = task / num_panel;
+            const std::size_t m_begin = task % num_panel * rows_per_panel;
+            const std::size_t rows    = std::min(rows_per_panel, M - m_begin);
+
+            std::vector<AccDataType> panel(rows * num_column);
+
+            im2col.FillRows(panel.data(),
+                            num_column,
+                            num_tap,
+                            1,
+                            p_in + g * in_g_stride,
+                            m_begin,
+                            rows,
+                            in_convert);
+
+            host_gemm_packed<AccDataType>(
+                1,
+                rows,
+                K,
+                num_column,
+                panel.data(),
+                {0, num_column, 1},
+                wei_pack.data() + g * K * num_column,
+                {0, 1, num_column},
+                identity,
+                identity,
+                [&](auto, std::size_t m, std::size_t k, AccDataType v_acc) {
+                    out_store(g, m_begin + m, k, v_acc);
+                },
+                1);
+        },
+        num_thread);
+}
+
+// Backward-weight convolution lowered onto host_gemm_packed(), for every group g:
+//   wei[g, k, (c, t)] = sum_m out_convert(out[g, m, k]) * in_convert(im2col_g[m, (c, t)])
+// The reduction over the N * Do * Ho * Wo rows is split into ranges, so that layers with few
+// weights and long reductions (depthwise, few channels) still keep every core busy. Each
+// (group, K block, range) task accumulates the panels of its range into a partial gradient of
+// its own, and the partial gradients are summed in range order. The ranges depend on the problem
+// only, so results do not depend on the number of threads. Padding taps enter the GEMMs as
+// zeros, so an inf or NaN output gradient makes NaN the weights it meets only through padding.
+// out_desc is in [G, N, K, Do, Ho, Wo] order; wei_store(offset, acc) writes the result of offset
+// under wei_desc.
+template <typename AccDataType,
+          std::size_t NDimSpatial,
+          typename InDataType,
+          typename OutDataType,
+          typename InConvert,
+          typename OutConvert,
+          typename WeiStore>
+void host_conv_bwd_weight_packed(const HostConvIm2Col<NDimSpatial>& im2col,
+                                 const InDataType* p_in,
+                                 std::size_t in_g_stride,
+                                 const OutDataType* p_out,
+                                 const HostTensorDescriptor& out_desc,
+                                 const HostTensorDescriptor& wei_desc,
+                                 const InConvert& in_convert,
+                                 const OutConvert& out_convert,
+                                 const WeiStore& wei_store,
+                                 std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    using Blocking = HostGemmBlocking<AccDataType>;
+
+    // at least as many tasks as that, if the reduction is long enough
+    constexpr std::size_t MinNumTask = 256;
+    // at most that many elements in all partial gradients, unless a single range needs more
+    constexpr std::size_t MaxPartialSize = std::size_t{1} << 24;
+
+    const auto& wei_lengths = wei_desc.GetLengths();
+    const auto& wei_strides = wei_desc.GetStrides();
+    const auto& out_strides = out_desc.GetStrides();
+
+    const std::size_t G          = wei_lengths[0];
+    const std::size_t K          = wei_lengths[1];
+    const std::size_t M          = im2col.GetNumRow();
+    const std::size_t num_tap    = im2col.GetNumTap();
+    const std::size_t num_column = im2col.GetNumColumn();
+
+    if(wei_desc.GetNumOfDimension() != NDimSpatial + 3 || wei_lengths[2] * num_tap != num_column ||
+       out_desc.GetLengths()[0] != G || out_desc.GetLengths()[2] != K)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    const auto out_row_offsets = im2col.GetRowOffsets(out_desc);
+    const auto wei_offsets     = get_host_conv_filter_offsets<NDimSpatial>(wei_desc);
+
+    const std::size_t k_per_block = std::max<std::size_t>(std::min(K, Blocking::MC), 1);
+    const std::size_t num_k_block = (K + k_per_block - 1) / k_per_block;
+
+    // rows are the reduction dimension of these GEMMs, so panels run longer than in
+    // host_conv_fwd_packed()
+    const std::size_t rows_per_panel =
+        get_host_conv_rows_per_panel<AccDataType>(num_column + k_per_block, 16 * Blocking::KC);
+    const std::size_t num_panel    = (M + rows_per_panel - 1) / rows_per_panel;
+    const std::size_t partial_size = G * K * num_column;
+
+    std::size_t num_split = (MinNumTask + G * num_k_block - 1) / (G * num_k_block);
+
+    num_split = std::min(num_split, MaxPartialSize / std::max<std::size_t>(partial_size, 1));
+    num_split = std::max<std::size_t>(std::min(num_split, num_panel), 1);
+
+    const std::size_t panels_per_split =
+        std::max<std::size_t>((num_panel + num_split - 1) / num_split, 1);
+
+    num_split = std::max<std::size_t>((num_panel + panels_per_split - 1) / panels_per_split, 1);
+
+    // partial[split, g, k, c * taps + t]
+    std::vector<AccDataType> partial(num_split * partial_size, AccDataType{0});
+
+    auto identity = [](AccDataType v) { return v; };
+
+    // the GEMMs of a task run on the calling thread
+    host_parallel_for(
+        G * num_k_block * num_split,
+        [&](std::size_t task) {
+            const std::size_t g       = task / (num_k_block * num_split);
+            const std::size_t k_begin = task / num_split % num_k_block * k_per_block;
+            const std::size_t split   = task % num_split;
+            const std::size_t kt      = std::min(k_per_block, K - k_begin);
+
+            const OutDataType* p_out_g = p_out + g * out_strides[0] + k_begin * out_strides[2];
+            AccDataType* p_partial =
+                partial.data() + split * partial_size + (g * K + k_begin) * num_column;
+
+            std::vector<AccDataType> out_panel(rows_per_panel * kt);
+            std::vector<AccDataType> in_panel(rows_per_panel * num_column);
+
+            for(std::size_t panel = split * panels_per_split;
+                panel < std::min(num_panel, (split + 1) * panels_per_split);
+                ++panel)
+            {
+                const std::size_t m_begin = panel * rows_per_panel;
+                const std::size_t rows    = std::min(rows_per_panel, M - m_begin);
+
+                for(std::size_t r = 0; r < rows; ++r)
+                {
+                    const OutDataType* src = p_out_g + out_row_offsets[m_begin + r];
+
+                    for(std::size_t k = 0; k < kt; ++k)
+                        out_panel[r * kt + k] = out_convert(src[k * out_strides[2]]);
+                }
+
+                im2col.FillRows(in_panel.data(),
+                                num_column,
+                                num_tap,
+                                1,
+                                p_in + g * in_g_stride,
+                                m_begin,
+                                rows,
+                                in_convert);
+
+                // [kt, rows] x [rows, num_column]
+                host_gemm_packed<AccDataType>(
+                    1,
+                    kt,
+                    num_column,
+                    rows,
+                    out_panel.data(),
+                    {0, 1, kt},
+                    in_panel.data(),
+                    {0, num_column, 1},
+                    identity,
+                    identity,
+                    [&](auto, std::size_t k, std::size_t column, AccDataType v_acc) {
+                        p_partial[k * num_column + column] += v_acc;
+                    },
+                    1);
+            }
+        },
+        num_thread);
+
+    host_parallel_for(
+        G * K,
+        [&](std::size_t gk) {
+            const std::size_t offset = gk / K * wei_strides[0] + gk % K * wei_strides[1];
+
+            for(std::size_t column = 0; column < num_column; ++column)
+            {
+                AccDataType v_acc{0};
+
+                for(std::size_t split = 0; split < num_split; ++split)
+                    v_acc += partial[split * partial_size + gk * num_column + column];
+
+                wei_store(offset + wei_offsets[column], v_acc);
+            }
+        },
+        num_thread);
+}
+
+// Backward-data convolution lowered onto host_gemm_packed() by stride phase. Input pixel
+// i = q * stride + r - left_pad only receives from the taps t with t * dilation = r + j * stride,
+// from output pixel q - j. So for every phase r, one residue per spatial dimension, the input
+// pixels of that phase form a dense, stride-free sub-convolution of the output gradient with
+// the taps of the phase, gathered by a HostConvIm2Col of unit stride and negative dilation:
+//   in[g, (n, q), c] = sum_{t in phase, k} out_convert(out[g, n, k, q - j_t])
+//                                           * wei_convert(wei[g, k, c, t])
+// No modulo test is left in the inner loops. Each result accumulates over the taps in increasing
+// order, then over k, the order of the direct loop nest, with out-of-range taps adding zero: as
+// in host_conv_fwd_packed(), results match the direct loop nest bit by bit for finite weights
+// only, an inf or NaN weight times the zero of an out-of-range tap yielding NaN.
+// in_desc is in [G, N, C, Di, Hi, Wi] order; in_store(offset, acc) writes the result of offset
+// under in_desc, for every input pixel, including those no tap reaches.
+template <typename AccDataType,
+          std::size_t NDimSpatial,
+          typename OutDataType,
+          typename WeiDataType,
+          typename OutConvert,
+          typename WeiConvert,
+          typename InStore>
+void host_conv_bwd_data_packed(const HostTensorDescriptor& in_desc,
+                               const OutDataType* p_out,
+                               const HostTensorDescriptor& out_desc,
+                               const WeiDataType* p_wei,
+                               const HostTensorDescriptor& wei_desc,
+                               const std::vector<index_t>& conv_strides,
+                               const std::vector<index_t>& conv_dilations,
+                               const std::vector<index_t>& in_left_pads,
+                               const OutConvert& out_convert,
+                               const WeiConvert& wei_convert,
+                               const InStore& in_store,
+                               std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    const auto& in_lengths  = in_desc.GetLengths();
+    const auto& in_strides  = in_desc.GetStrides();
+    const auto& wei_lengths = wei_desc.GetLengths();
+    const auto& wei_strides = wei_desc.GetStrides();
+
+    if(in_desc.GetNumOfDimension() != NDimSpatial + 3 ||
+       wei_desc.GetNumOfDimension() != NDimSpatial + 3 ||
+       out_desc.GetNumOfDimension() != NDimSpatial + 3 || conv_strides.size() < NDimSpatial ||
+       conv_dilations.size() < NDimSpatial || in_left_pads.size() < NDimSpatial)
+    {
+        throw std::runtime_error("wrong! inconsistent dimension");
+    }
+
+    const std::size_t G = wei_lengths[0];
+    const std::size_t K = wei_lengths[1];
+    const std::size_t C = wei_lengths[2];
+
+    struct Phase
+    {
+        // gathers the output gradient under the taps of the phase
+        HostConvIm2Col<NDimSpatial> im2col;
+        // row (n, q) is input pixel first_pixel + q * stride
+        std::array<long_index_t, NDimSpatial> first_pixel;
+        // wei_pack[g, c, t * K + k]
+        std::vector<AccDataType> wei_pack;
+        std::size_t rows_per_panel;
+        std::size_t num_panel;
+    };
+
+    std::vector<Phase> phases;
+
+    const std::size_t num_phase =
+        std::accumulate(conv_strides.begin(),
+                        conv_strides.begin() + NDimSpatial,
+                        std::size_t{1},
+                        std::multiplies<std::size_t>());
+
+    for(std::size_t phase = 0; phase < num_phase; ++phase)
+    {
+        // weight taps first_tap + a * tap_step, for a in [0, num_tap)
+        std::array<std::size_t, NDimSpatial> num_tap;
+        std::array<std::size_t, NDimSpatial> first_tap;
+        std::array<std::size_t, NDimSpatial> tap_step;
+        std::array<long_index_t, NDimSpatial> first_pixel;
+        std::array<std::size_t, NDimSpatial> num_row;
+        std::vector<index_t> gather_strides(NDimSpatial, 1);
+        std::vector<index_t> gather_dilations(NDimSpatial);
+        std::vector<index_t> gather_left_pads(NDimSpatial);
+
+        for(std::size_t d = NDimSpatial, rest = phase; d-- > 0; rest /= conv_strides[d])
+        {
+            const long_index_t s = conv_strides[d];
+            const long_index_t l = conv_dilations[d];
+            const long_index_t p = in_left_pads[d];
+            const long_index_t r = rest % s;
+            const long_index_t X = wei_lengths[d + 3];
+            const long_index_t W = in_lengths[d + 3];
+
+            // taps with t * l = r (mod s) exist if gcd(s, l) divides r, they are spaced
+            // s / gcd(s, l) apart, and the first is below that
+            const long_index_t step = s / std::gcd(s, l);
+
+            long_index_t t0 = r % std::gcd(s, l) == 0 ? 0 : X;
+
+            while(t0 < X && (t0 * l - r) % s != 0)
+                ++t0;
+
+            // input pixels q * s + r - p within [0, W)
+            const long_index_t q_begin = p > r ? (p - r + s - 1) / s : 0;
+            const long_index_t q_end   = W - 1 + p - r >= 0 ? (W - 1 + p - r) / s + 1 : 0;
+
+            num_tap[d]     = t0 < X ? (X - 1 - t0) / step + 1 : 0;
+            first_tap[d]   = t0;
+            tap_step[d]    = step;
+            num_row[d]     = std::max<long_index_t>(q_end - q_begin, 0);
+            first_pixel[d] = q_begin * s + r - p;
+
+            // tap a of the phase reads output pixel q - (t0 * l - r) / s - a * step * l / s
+            gather_dilations[d] = static_cast<index_t>(-step * l / s);
+            gather_left_pads[d] = static_cast<index_t>((t0 < X ? (t0 * l - r) / s : 0) - q_begin);
+        }
+
+        Phase current{HostConvIm2Col<NDimSpatial>(out_desc,
+                                                  num_tap.begin(),
+                                                  num_row.begin(),
+                                                  gather_strides,
+                                                  gather_dilations,
+                                                  gather_left_pads),
+                      first_pixel,
+                      {},
+                      0,
+                      0};
+
+        const std::size_t M          = current.im2col.GetNumRow();
+        const std::size_t num_column = current.im2col.GetNumColumn();
+
+        if(M == 0)
+            continue;
+
+        current.rows_per_panel = get_host_conv_rows_per_panel<AccDataType>(
+            num_column, HostGemmBlocking<AccDataType>::MC);
+        current.num_panel = (M + current.rows_per_panel - 1) / current.rows_per_panel;
+        current.wei_pack.resize(G * C * num_column);
+
+        const std::size_t phase_num_tap = current.im2col.GetNumTap();
+
+        host_parallel_for(
+            G * C,
+            [&](std::size_t gc) {
+                AccDataType* dst = current.wei_pack.data() + gc * num_column;
+
+                for(std::size_t t = 0; t < phase_num_tap; ++t)
+                {
+                    std::size_t offset = gc / C * wei_strides[0] + gc % C * wei_strides[2];
+
+                    for(std::size_t d = NDimSpatial, rest = t; d-- > 0; rest /= num_tap[d])
+                        offset += (first_tap[d] + rest % num_tap[d] * tap_step[d]) *
+                                  wei_strides[d + 3];
+
+                    for(std::size_t k = 0; k < K; ++k)
+                        dst[t * K + k] = wei_convert(p_wei[offset + k * wei_strides[1]]);
+                }
+            },
+            num_thread);
+
+        phases.push_back(std::move(current));
+    }
+
+    // first task of every phase, tasks are (phase, group, panel)
+    std::vector<std::size_t> phase_task_begin{0};
+
+    for(const auto& phase : phases)
+        phase_task_begin.push_back(phase_task_begin.back() + G * phase.num_panel);
+
+    auto identity = [](AccDataType v) { return v; };
+
+    // the GEMM of a panel runs on the calling thread
+    host_parallel_for(
+        phase_task_begin.back(),
+        [&](std::size_t task) {
+            const std::size_t i =
+                std::upper_bound(phase_task_begin.begin(), phase_task_begin.end(), task) -
+                phase_task_begin.begin() - 1;
+
+            const Phase& phase = phases[i];
+
+            const std::size_t g          = (task - phase_task_begin[i]) / phase.num_panel;
+            const std::size_t m_begin    = (task - phase_task_begin[i]) % phase.num_panel *
+                                        phase.rows_per_panel;
+            const std::size_t M          = phase.im2col.GetNumRow();
+            const std::size_t rows       = std::min(phase.rows_per_panel, M - m_begin);
+            const std::size_t num_column = phase.im2col.GetNumColumn();
+
+            std::vector<AccDataType> panel(rows * num_column);
+
+            // columns in [taps, K] order
+            phase.im2col.FillRows(panel.data(),
+                                  num_column,
+                                  1,
+                                  K,
+                                  p_out + g * out_desc.GetStrides()[0],
+                                  m_begin,
+                                  rows,
+                                  out_convert);
+
+            // offset of input (g, n, 0, di, hi, wi) of every row of the panel
+            std::vector<std::size_t> in_row_offsets(rows);
+
+            for(std::size_t r = 0; r < rows; ++r)
+            {
+                const auto row = phase.im2col.GetRowIndex(m_begin + r);
+
+                in_row_offsets[r] = g * in_strides[0] + row[0] * in_strides[1];
+
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                    in_row_offsets[r] +=
+                        static_cast<std::size_t>(phase.first_pixel[d] +
+                                                 static_cast<long_index_t>(row[d + 1]) *
+                                                     conv_strides[d]) *
+                        in_strides[d + 3];
+            }
+
+            host_gemm_packed<AccDataType>(
+                1,
+                rows,
+                C,
+                num_column,
+                panel.data(),
+                {0, num_column, 1},
+                phase.wei_pack.data() + g * C * num_column,
+                {0, 1, num_column},
+                identity,
+                identity,
+                [&](auto, std::size_t m, std::size_t c, AccDataType v_acc) {
+                    in_store(in_row_offsets[m] + c * in_strides[2], v_acc);
+                },
+                1);
+        },
+        num_thread);
+}
+
+} // namespace host_common
+} // namespace ck
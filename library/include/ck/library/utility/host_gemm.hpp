@@ -3,8 +3,255 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
 #include "host_tensor.hpp"
 
+namespace ck {
+namespace host_common {
+
+// Blocking parameters of the packed host GEMM engine.
+// MR x NR is the register tile of the micro-kernel, NR is chosen so one row of the register tile
+// fills a 64-byte vector. MC x KC panels of A and KC x NC panels of B are sized to stay in L2.
+// Problems with fewer than MinNumTask MC x NC blocks are also split along K, in ranges of at least
+// KSplit, as long as the partial results fit in MaxPartialSize elements.
+template <typename AccDataType>
+struct HostGemmBlocking
+{
+    static constexpr std::size_t NR = std::max<std::size_t>(64 / sizeof(AccDataType), 4);
+    static constexpr std::size_t MR = 4;
+    static constexpr std::size_t MC = 32 * MR;
+    static constexpr std::size_t NC = 128 / NR * NR;
+    static constexpr std::size_t KC = 256;
+
+    static constexpr std::size_t MinNumTask     = 64;
+    static constexpr std::size_t KSplit         = 4 * KC;
+    static constexpr std::size_t MaxPartialSize = std::size_t{1} << 24;
+};
+
+// C[MR x NR] += A_panel[KC x MR]^T * B_panel[KC x NR]
+// Each C element accumulates over k in increasing order, same as the naive K loop.
+template <typename AccDataType, std::size_t MR, std::size_t NR>
+inline void host_gemm_micro_kernel(std::size_t kc,
+                                   const AccDataType* __restrict__ p_a_panel,
+                                   const AccDataType* __restrict__ p_b_panel,
+                                   AccDataType* __restrict__ p_c,
+                                   std::size_t ldc)
+{
+    AccDataType c[MR][NR];
+
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            c[i][j] = p_c[i * ldc + j];
+
+    for(std::size_t k = 0; k < kc; ++k)
+    {
+        const AccDataType* a = p_a_panel + k * MR;
+        const AccDataType* b = p_b_panel + k * NR;
+
+        for(std::size_t i = 0; i < MR; ++i)
+            for(std::size_t j = 0; j < NR; ++j)
+                c[i][j] += a[i] * b[j];
+    }
+
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            p_c[i * ldc + j] = c[i][j];
+}
+
+// Pack rows [row_begin, row_begin + rows) x cols [col_begin, col_begin + cols) of a strided matrix
+// into R-wide micro-panels: panel p holds element (p * R + r, c) at [p][c][r]. Rows past the end
+// of the matrix are zero-filled. The loop order follows the unit-stride dimension of the source.
+template <std::size_t R, typename AccDataType, typename DataType, typename Convert>
+void host_gemm_pack_panels(AccDataType* p_pack,
+                           const DataType* p_src,
+                           std::size_t row_stride,
+                           std::size_t col_stride,
+                           std::size_t row_begin,
+                           std::size_t rows,
+                           std::size_t col_begin,
+                           std::size_t cols,
+                           const Convert& convert)
+{
+    const std::size_t num_panel = (rows + R - 1) / R;
+
+    std::fill(p_pack, p_pack + num_panel * R * cols, AccDataType{0});
+
+    if(col_stride == 1 && row_stride != 1)
+    {
+        for(std::size_t r = 0; r < rows; ++r)
+        {
+            const DataType* src = p_src + (row_begin + r) * row_stride + col_begin;
+            AccDataType* dst    = p_pack + (r / R) * R * cols + r % R;
+
+            for(std::size_t c = 0; c < cols; ++c)
+                dst[c * R] = convert(src[c]);
+        }
+    }
+    else
+    {
+        for(std::size_t c = 0; c < cols; ++c)
+        {
+            const DataType* src = p_src + (col_begin + c) * col_stride + row_begin * row_stride;
+
+            for(std::size_t r = 0; r < rows; ++r)
+                p_pack[(r / R) * R * cols + c * R + r % R] = convert(src[r * row_stride]);
+        }
+    }
+}
+
+// Cache-blocked, packed host GEMM over G independent batches:
+//   C[g, m, n] = sum_k a_convert(A[g, m, k]) * b_convert(B[g, k, n])
+// A and B are addressed through raw strides, so row-, column-major and batched layouts are all
+// handled without going through Tensor::operator(). a_convert/b_convert turn a source element
+// (after its elementwise op) into AccDataType; c_store(g, m, n, acc) writes one finished result.
+// Elementwise ops are applied once per element while packing instead of once per multiply-add.
+// Each result accumulates over k in increasing order, bit by bit the naive K loop, unless the
+// problem has too few (g, m, n) blocks to keep num_thread > 1 threads busy and K is long: K is
+// then cut into ranges whose partial results are summed in range order. The ranges depend on the
+// problem only, so the result is the same for any num_thread > 1; num_thread = 1 never splits.
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename AConvert,
+          typename BConvert,
+          typename CStore>
+void host_gemm_packed(std::size_t G,
+                      std::size_t M,
+                      std::size_t N,
+                      std::size_t K,
+                      const ADataType* p_a,
+                      const std::array<std::size_t, 3>& a_g_m_k_strides,
+                      const BDataType* p_b,
+                      const std::array<std::size_t, 3>& b_g_k_n_strides,
+                      const AConvert& a_convert,
+                      const BConvert& b_convert,
+                      const CStore& c_store,
+                      std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    using Blocking = HostGemmBlocking<AccDataType>;
+
+    constexpr std::size_t MR = Blocking::MR;
+    constexpr std::size_t NR = Blocking::NR;
+    constexpr std::size_t MC = Blocking::MC;
+    constexpr std::size_t NC = Blocking::NC;
+    constexpr std::size_t KC = Blocking::KC;
+
+    const std::size_t num_m_block = (M + MC - 1) / MC;
+    const std::size_t num_n_block = (N + NC - 1) / NC;
+    const std::size_t num_block   = G * num_m_block * num_n_block;
+
+    // K ranges, each a whole number of KC panels but the last
+    std::size_t num_split   = 1;
+    std::size_t k_per_split = K;
+
+    if(num_thread > 1 && num_block > 0 && num_block < Blocking::MinNumTask)
+    {
+        const std::size_t max_num_split =
+            std::min({(Blocking::MinNumTask + num_block - 1) / num_block,
+                      K / Blocking::KSplit,
+                      Blocking::MaxPartialSize / (G * M * N)});
+
+        if(max_num_split > 1)
+        {
+            k_per_split = (K + max_num_split * KC - 1) / (max_num_split * KC) * KC;
+            num_split   = (K + k_per_split - 1) / k_per_split;
+        }
+    }
+
+    // partial[split, g, m, n], if K is split
+    std::vector<AccDataType> partial(num_split > 1 ? num_split * G * M * N : 0);
+
+    auto f_block = [&](std::size_t g, std::size_t im, std::size_t in, std::size_t split) {
+        const std::size_t m_begin = im * MC;
+        const std::size_t n_begin = in * NC;
+        const std::size_t mc      = std::min(MC, M - m_begin);
+        const std::size_t nc      = std::min(NC, N - n_begin);
+        const std::size_t mc_pad  = (mc + MR - 1) / MR * MR;
+        const std::size_t nc_pad  = (nc + NR - 1) / NR * NR;
+        const std::size_t k_first = split * k_per_split;
+        const std::size_t k_last  = std::min(K, k_first + k_per_split);
+
+        std::vector<AccDataType> a_pack(mc_pad * std::min(KC, K));
+        std::vector<AccDataType> b_pack(nc_pad * std::min(KC, K));
+        std::vector<AccDataType> c_tile(mc_pad * nc_pad, AccDataType{0});
+
+        const ADataType* p_a_g = p_a + g * a_g_m_k_strides[0];
+        const BDataType* p_b_g = p_b + g * b_g_k_n_strides[0];
+
+        for(std::size_t k_begin = k_first; k_begin < k_last; k_begin += KC)
+        {
+            const std::size_t kc = std::min(KC, k_last - k_begin);
+
+            // A[m, k] as MR-row panels, B[k, n] transposed into NR-column panels
+            host_gemm_pack_panels<MR>(a_pack.data(),
+                                      p_a_g,
+                                      a_g_m_k_strides[1],
+                                      a_g_m_k_strides[2],
+                                      m_begin,
+                                      mc,
+                                      k_begin,
+                                      kc,
+                                      a_convert);
+            host_gemm_pack_panels<NR>(b_pack.data(),
+                                      p_b_g,
+                                      b_g_k_n_strides[2],
+                                      b_g_k_n_strides[1],
+                                      n_begin,
+                                      nc,
+                                      k_begin,
+                                      kc,
+                                      b_convert);
+
+            for(std::size_t i = 0; i < mc_pad; i += MR)
+                for(std::size_t j = 0; j < nc_pad; j += NR)
+                    host_gemm_micro_kernel<AccDataType, MR, NR>(kc,
+                                                                a_pack.data() + i * kc,
+                                                                b_pack.data() + j * kc,
+                                                                c_tile.data() + i * nc_pad + j,
+                                                                nc_pad);
+        }
+
+        for(std::size_t i = 0; i < mc; ++i)
+            for(std::size_t j = 0; j < nc; ++j)
+            {
+                const std::size_t m = m_begin + i;
+                const std::size_t n = n_begin + j;
+
+                if(num_split == 1)
+                    c_store(g, m, n, c_tile[i * nc_pad + j]);
+                else
+                    partial[((split * G + g) * M + m) * N + n] = c_tile[i * nc_pad + j];
+            }
+    };
+
+    make_ParallelTensorFunctor(f_block, G, num_m_block, num_n_block, num_split)(num_thread);
+
+    if(num_split == 1)
+        return;
+
+    host_parallel_for(
+        G * M,
+        [&](std::size_t gm) {
+            for(std::size_t n = 0; n < N; ++n)
+            {
+                AccDataType v_acc = partial[gm * N + n];
+
+                for(std::size_t split = 1; split < num_split; ++split)
+                    v_acc += partial[(split * G * M + gm) * N + n];
+
+                c_store(gm / M, gm % M, n, v_acc);
+            }
+        },
+        num_thread);
+}
+
+} // namespace host_common
+} // namespace ck
+
 template <typename AType,
           typename BType,
           typename CType,
@@ -18,22 +265,22 @@ void host_gemm_mk_kn_mn(const Tensor<AType>& a_m_k,
                         const BElementwiseOperation& b_element_op,
                         const CElementwiseOperation& c_element_op)
 {
-    auto f_mk_kn_mn = [&](auto m, auto n) {
-        const int K = a_m_k.mDesc.GetLengths()[1];
-
-        float v_acc = 0;
-
-        for(int k = 0; k < K; ++k)
-        {
-            float v_a;
-            float v_b;
+    const auto& a_strides = a_m_k.mDesc.GetStrides();
+    const auto& b_strides = b_k_n.mDesc.GetStrides();
 
-            a_element_op(v_a, static_cast<const float>(a_m_k(m, k)));
-            b_element_op(v_b, static_cast<const float>(b_k_n(k, n)));
+    auto a_convert = [&](const AType& a) {
+        float v_a;
+        a_element_op(v_a, static_cast<const float>(a));
+        return v_a;
+    };
 
-            v_acc += v_a * v_b;
-        }
+    auto b_convert = [&](const BType& b) {
+        float v_b;
+        b_element_op(v_b, static_cast<const float>(b));
+        return v_b;
+    };
 
+    auto c_store = [&](auto, auto m, auto n, float v_acc) {
         float v_c;
 
         c_element_op(v_c, v_acc);
@@ -41,7 +288,15 @@ void host_gemm_mk_kn_mn(const Tensor<AType>& a_m_k,
         c_m_n(m, n) = v_c;
     };
 
-    make_ParallelTensorFunctor(f_mk_kn_mn,
-                               c_m_n.mDesc.GetLengths()[0],
-                               c_m_n.mDesc.GetLengths()[1])(std::thread::hardware_concurrency());
+    ck::host_common::host_gemm_packed<float>(1,
+                                             c_m_n.mDesc.GetLengths()[0],
+                                             c_m_n.mDesc.GetLengths()[1],
+                                             a_m_k.mDesc.GetLengths()[1],
+                                             a_m_k.data(),
+                                             {0, a_strides[0], a_strides[1]},
+                                             b_k_n.data(),
+                                             {0, b_strides[0], b_strides[1]},
+                                             a_convert,
+                                             b_convert,
+                                             c_store);
 }
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/math_v2.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/tensor_operation/gpu/device/welford_helper.hpp"
+#include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Running mean and sum of squared deviations (M2) of a stream of values, updated and merged with
+// the same welford_update() / welford_merge() the device kernels use.
+template <typename AccDataType>
+struct HostWelford
+{
+    AccDataType mean_  = type_convert<AccDataType>(0.0f);
+    AccDataType m2_    = type_convert<AccDataType>(0.0f);
+    std::size_t count_ = 0;
+
+    void Update(AccDataType x)
+    {
+        tensor_operation::device::welford_update(mean_, m2_, ++count_, x);
+    }
+
+    void Merge(const HostWelford& other)
+    {
+        tensor_operation::device::welford_merge(
+            mean_, m2_, count_, other.mean_, other.m2_, other.count_);
+    }
+
+    // biased (population) variance
+    AccDataType GetVariance() const
+    {
+        return count_ == 0 ? type_convert<AccDataType>(0.0f)
+                           : m2_ / static_cast<AccDataType>(count_);
+    }
+};
+
+// Shape of a normalization problem. Every kept (invariant) index is one row whose mean and
+// variance are taken over the reduced dimensions. The operands x, y, gamma and beta are addressed
+// through their own strides over both groups of dimensions; broadcast operands use stride 0.
+template <index_t NumInvariantDim, index_t NumReduceDim>
+struct HostNormalizationDescriptor
+{
+    static constexpr std::size_t NumOperand = 4;
+
+    enum Operand
+    {
+        X     = 0,
+        Y     = 1,
+        Gamma = 2,
+        Beta  = 3,
+    };
+
+    std::array<index_t, NumInvariantDim> invariant_lengths_;
+    std::array<index_t, NumReduceDim> reduce_lengths_;
+    std::array<std::array<index_t, NumInvariantDim>, NumOperand> invariant_strides_;
+    std::array<std::array<index_t, NumReduceDim>, NumOperand> reduce_strides_;
+};
+
+// Parallel normalization engine shared by the layernorm/groupnorm host references.
+// Every row is cut into blocks of BlockSize reduced elements. Blocks of all rows are processed in
+// parallel, so a few long rows (LLM hidden sizes) scale as well as many short ones. The per-block
+// Welford states are merged left to right, the split does not depend on the number of threads and
+// results are deterministic.
+//
+// load_x(x_offset) returns x as AccDataType, store(offsets, x, mean, inv_std) writes one output
+// given the offsets of x, y, gamma and beta, save_mean_var(row, mean, var) is called once per row
+// with the row number in row-major order of the invariant lengths.
+template <typename AccDataType,
+          index_t NumInvariantDim,
+          index_t NumReduceDim,
+          typename LoadX,
+          typename Store,
+          typename SaveMeanVar>
+void host_normalization(const HostNormalizationDescriptor<NumInvariantDim, NumReduceDim>& desc,
+                        AccDataType epsilon,
+                        const LoadX& load_x,
+                        const Store& store,
+                        const SaveMeanVar& save_mean_var)
+{
+    using Desc    = HostNormalizationDescriptor<NumInvariantDim, NumReduceDim>;
+    using Offsets = std::array<std::size_t, Desc::NumOperand>;
+
+    constexpr std::size_t BlockSize = 4096;
+
+    // offsets of every operand
+    auto invariant_odometer = std::apply(
+        [&](const auto&... strides) {
+            return make_host_index_odometer<NumInvariantDim>(desc.invariant_lengths_, strides...);
+        },
+        desc.invariant_strides_);
+    const auto reduce_odometer = std::apply(
+        [&](const auto&... strides) {
+            return make_host_index_odometer<NumReduceDim>(desc.reduce_lengths_, strides...);
+        },
+        desc.reduce_strides_);
+
+    const std::size_t num_row   = invariant_odometer.GetSize();
+    const std::size_t row_size  = reduce_odometer.GetSize();
+    const std::size_t num_block = std::max<std::size_t>(1, (row_size + BlockSize - 1) / BlockSize);
+    const std::size_t num_chunk = num_row * num_block;
+
+    if(num_row == 0)
+        return;
+
+    std::vector<Offsets> row_offsets;
+
+    row_offsets.reserve(num_row);
+
+    invariant_odometer.ForEach(
+        [&](auto, const Offsets& offsets) { row_offsets.push_back(offsets); });
+
+    auto for_each_in_chunk = [&](std::size_t chunk, auto&& f) {
+        const std::size_t row   = chunk / num_block;
+        const std::size_t begin = chunk % num_block * BlockSize;
+        const std::size_t end   = std::min(row_size, begin + BlockSize);
+
+        auto odometer = reduce_odometer;
+
+        odometer.ForEachInRange(begin, end, [&](auto, const Offsets& reduce_offsets) {
+            Offsets offsets;
+
+            for(std::size_t o = 0; o < Desc::NumOperand; ++o)
+                offsets[o] = row_offsets[row][o] + reduce_offsets[o];
+
+            f(offsets);
+        });
+    };
+
+    // partial statistics of every block
+    std::vector<HostWelford<AccDataType>> partials(num_chunk);
+
+    host_parallel_for(num_chunk, [&](std::size_t chunk) {
+        for_each_in_chunk(chunk, [&](const Offsets& offsets) {
+            partials[chunk].Update(load_x(offsets[Desc::X]));
+        });
+    });
+
+    std::vector<AccDataType> means(num_row);
+    std::vector<AccDataType> inv_stds(num_row);
+
+    for(std::size_t row = 0; row < num_row; ++row)
+    {
+        HostWelford<AccDataType> welford = partials[row * num_block];
+
+        for(std::size_t b = 1; b < num_block; ++b)
+            welford.Merge(partials[row * num_block + b]);
+
+        const AccDataType var = welford.GetVariance();
+
+        means[row]    = welford.mean_;
+        inv_stds[row] = type_convert<AccDataType>(1.0f) / ck::math::sqrt(var + epsilon);
+
+        save_mean_var(row, welford.mean_, var);
+    }
+
+    host_parallel_for(num_chunk, [&](std::size_t chunk) {
+        const std::size_t row = chunk / num_block;
+
+        for_each_in_chunk(chunk, [&](const Offsets& offsets) {
+            store(offsets, load_x(offsets[Desc::X]), means[row], inv_stds[row]);
+        });
+    });
+}
+
+template <typename AccDataType,
+          index_t NumInvariantDim,
+          index_t NumReduceDim,
+          typename LoadX,
+          typename Store>
+void host_normalization(const HostNormalizationDescriptor<NumInvariantDim, NumReduceDim>& desc,
+                        AccDataType epsilon,
+                        const LoadX& load_x,
+                        const Store& store)
+{
+    host_normalization(desc, epsilon, load_x, store, [](auto, auto, auto) {});
+}
+
+} // namespace host_common
+} // namespace ck
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Windows along one axis reduced by one host_reduce_windows() call: window j, stored at position
+// out_begin + j * out_step of the output axis, reduces the elements at positions
+// j * stride + offset + k * dilation, k in [0, window), of the input axis
+struct HostPoolWindows
+{
+    std::size_t num_out;
+    std::size_t out_begin;
+    std::size_t out_step;
+    std::size_t window;
+    long_index_t stride;
+    long_index_t dilation;
+    long_index_t offset;
+};
+
+// Windows of a pooling forward along one axis: output o reduces the input pixels
+// o * stride + x * dilation - left_pad
+inline std::vector<HostPoolWindows> get_host_pool_fwd_windows(std::size_t out_length,
+                                                              std::size_t window,
+                                                              long_index_t stride,
+                                                              long_index_t dilation,
+                                                              long_index_t left_pad)
+{
+    return {{out_length, 0, 1, window, stride, dilation, -left_pad}};
+}
+
+// Windows of the transpose of a pooling forward along one axis: input pixel i sums the outputs
+// o = (i + left_pad - x * dilation) / stride that are whole. The inputs of a residue of i modulo
+// stride see the taps x0, x0 + stride / g, ... for g = gcd(stride, dilation), that is the
+// outputs of a window of dilation dilation / g, one output further per input.
+inline std::vector<HostPoolWindows> get_host_pool_bwd_windows(std::size_t in_length,
+                                                              std::size_t window,
+                                                              long_index_t stride,
+                                                              long_index_t dilation,
+                                                              long_index_t left_pad)
+{
+    const long_index_t g         = std::gcd(stride, dilation);
+    const long_index_t tap_step  = stride / g;
+    const long_index_t out_step  = dilation / g;
+    const long_index_t num_phase = std::min(stride, static_cast<long_index_t>(in_length));
+
+    std::vector<HostPoolWindows> windows;
+
+    for(long_index_t r = 0; r < num_phase; ++r)
+    {
+        const std::size_t num_out = (in_length - r + stride - 1) / stride;
+
+        long_index_t x0 = 0;
+
+        while(x0 < std::min(static_cast<long_index_t>(window), tap_step) &&
+              (r + left_pad - x0 * dilation) % stride != 0)
+            ++x0;
+
+        // no tap reaches these inputs
+        const long_index_t taps =
+            x0 < static_cast<long_index_t>(window) && x0 < tap_step
+                ? (static_cast<long_index_t>(window) - x0 + tap_step - 1) / tap_step
+                : 0;
+        const long_index_t o0 = (r + left_pad - x0 * dilation) / stride;
+
+        windows.push_back({num_out,
+                           static_cast<std::size_t>(r),
+                           static_cast<std::size_t>(stride),
+                           static_cast<std::size_t>(taps),
+                           1,
+                           out_step,
+                           o0 - (taps - 1) * out_step});
+    }
+
+    return windows;
+}
+
+// Reduces the windows of w over a line of length elements, read through load(position); the
+// positions out of the line hold identity. Window j is stored through store(j, value), value the
+// fold, by combine(acc, later), of identity and the elements of the window in increasing
+// position. combine must be associative: the windows of a residue of their positions modulo the
+// dilation are reduced with the van Herk/Gil-Werman scheme, which cuts the positions of the
+// residue into blocks of window elements and keeps, for every position, the reduction of the
+// rest of its block and the one of its block so far. A window spans at most two blocks, so it
+// costs O(1) whatever its size. workspace is reused across calls.
+template <typename T, typename Load, typename Combine, typename Store>
+void host_reduce_windows(std::size_t length,
+                         const HostPoolWindows& w,
+                         const T& identity,
+                         const Load& load,
+                         const Combine& combine,
+                         const Store& store,
+                         std::vector<T>& workspace)
+{
+    if(w.window == 0)
+    {
+        for(std::size_t j = 0; j < w.num_out; ++j)
+            store(j, identity);
+
+        return;
+    }
+
+    if(w.dilation <= 0)
+        throw std::runtime_error("wrong! non-positive dilation");
+
+    const long_index_t l = w.dilation;
+    const long_index_t K = static_cast<long_index_t>(w.window);
+
+    auto floor_div = [](long_index_t x, long_index_t y) {
+        return x >= 0 ? x / y : -((y - 1 - x) / y);
+    };
+
+    // range of the first element of the windows of every residue, then where the residue starts
+    // in the workspace
+    std::vector<long_index_t> a_min(static_cast<std::size_t>(l),
+                                    std::numeric_limits<long_index_t>::max());
+    std::vector<long_index_t> a_max(static_cast<std::size_t>(l),
+                                    std::numeric_limits<long_index_t>::min());
+
+    for(std::size_t j = 0; j < w.num_out; ++j)
+    {
+        const long_index_t p = static_cast<long_index_t>(j) * w.stride + w.offset;
+        const long_index_t a = floor_div(p, l);
+        const long_index_t r = p - a * l;
+
+        a_min[r] = std::min(a_min[r], a);
+        a_max[r] = std::max(a_max[r], a);
+    }
+
+    std::vector<long_index_t> begins(static_cast<std::size_t>(l) + 1, 0);
+
+    for(long_index_t r = 0; r < l; ++r)
+        begins[r + 1] = begins[r] + (a_min[r] <= a_max[r] ? a_max[r] - a_min[r] + K : 0);
+
+    // suffixes of the blocks in the first half, prefixes in the second
+    workspace.resize(static_cast<std::size_t>(2 * begins[l]));
+
+    T* const g = workspace.data();
+    T* const h = workspace.data() + begins[l];
+
+    for(long_index_t r = 0; r < l; ++r)
+    {
+        const long_index_t span = begins[r + 1] - begins[r];
+
+        T* const g_r = g + begins[r];
+        T* const h_r = h + begins[r];
+
+        for(long_index_t q = 0; q < span; ++q)
+        {
+            const long_index_t p = r + (a_min[r] + q) * l;
+
+            g_r[q] = p >= 0 && p < static_cast<long_index_t>(length) ? load(p) : identity;
+            h_r[q] = g_r[q];
+
+            if(q % K != 0)
+            {
+                T acc = h_r[q - 1];
+
+                combine(acc, h_r[q]);
+                h_r[q] = acc;
+            }
+        }
+
+        for(long_index_t q = span - 2; q >= 0; --q)
+        {
+            if((q + 1) % K != 0)
+                combine(g_r[q], g_r[q + 1]);
+        }
+    }
+
+    for(std::size_t j = 0; j < w.num_out; ++j)
+    {
+        const long_index_t p = static_cast<long_index_t>(j) * w.stride + w.offset;
+        const long_index_t a = floor_div(p, l);
+        const long_index_t r = p - a * l;
+        const long_index_t q = begins[r] + (a - a_min[r]);
+
+        T acc = identity;
+
+        combine(acc, g[q]);
+
+        if((a - a_min[r]) % K != 0)
+            combine(acc, h[q + K - 1]);
+
+        store(j, acc);
+    }
+}
+
+// Reduces pooling windows over [N * C, D0, D1, ...] with one pass of host_reduce_windows() per
+// spatial axis, the last axis first, so that a window costs O(NDimSpatial) rather than
+// O(window volume). Pass d reduces the lines along axis d with windows[d], from a packed buffer
+// of T with src_lengths[d] elements on that axis to one with dst_lengths[d]. The elements are
+// read through load(nc, {d0, d1, ...}) and the results written through store(nc, {...}, value).
+// A window of an associative combine is the reduction of its elements in lexicographic order.
+template <typename T, std::size_t NDimSpatial, typename Load, typename Combine, typename Store>
+void host_pool_separable(std::size_t num_nc,
+                         const std::array<std::size_t, NDimSpatial>& src_lengths,
+                         const std::array<std::size_t, NDimSpatial>& dst_lengths,
+                         const std::array<std::vector<HostPoolWindows>, NDimSpatial>& windows,
+                         const T& identity,
+                         const Load& load,
+                         const Combine& combine,
+                         const Store& store)
+{
+    constexpr std::size_t LinesPerTask = 64;
+
+    auto get_index = [](std::size_t offset, const std::array<std::size_t, NDimSpatial>& lengths) {
+        std::array<std::size_t, NDimSpatial> idx;
+
+        for(std::size_t d = NDimSpatial; d > 0; --d)
+        {
+            idx[d - 1] = offset % lengths[d - 1];
+            offset /= lengths[d - 1];
+        }
+
+        return std::make_pair(offset, idx);
+    };
+
+    auto get_size = [&](const std::array<std::size_t, NDimSpatial>& lengths) {
+        return std::accumulate(
+            lengths.begin(), lengths.end(), num_nc, std::multiplies<std::size_t>());
+    };
+
+    auto lengths = src_lengths;
+
+    std::vector<T> src(get_size(lengths));
+
+    host_parallel_for(src.size(), [&](std::size_t i) {
+        const auto [nc, idx] = get_index(i, lengths);
+
+        src[i] = load(nc, idx);
+    });
+
+    for(std::size_t d = NDimSpatial; d > 0; --d)
+    {
+        const std::size_t axis       = d - 1;
+        const std::size_t src_length = lengths[axis];
+
+        lengths[axis] = dst_lengths[axis];
+
+        std::vector<T> dst(get_size(lengths));
+
+        // lines along axis are (outer, inner), inner the position among the axes after it
+        const std::size_t inner =
+            std::accumulate(lengths.begin() + axis + 1,
+                            lengths.end(),
+                            std::size_t{1},
+                            std::multiplies<std::size_t>());
+        const std::size_t outer           = get_size(lengths) / (inner * lengths[axis]);
+        const std::size_t num_inner_block = (inner + LinesPerTask - 1) / LinesPerTask;
+
+        host_parallel_for(outer * num_inner_block, [&](std::size_t task) {
+            const std::size_t o     = task / num_inner_block;
+            const std::size_t begin = task % num_inner_block * LinesPerTask;
+            const std::size_t end   = std::min(begin + LinesPerTask, inner);
+
+            std::vector<T> workspace;
+
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                const T* p_src = src.data() + o * src_length * inner + i;
+                T* p_dst       = dst.data() + o * lengths[axis] * inner + i;
+
+                for(const auto& w : windows[axis])
+                {
+                    host_reduce_windows(
+                        src_length,
+                        w,
+                        identity,
+                        [&](long_index_t p) { return p_src[p * inner]; },
+                        combine,
+                        [&](std::size_t j, const T& v) {
+                            p_dst[(w.out_begin + j * w.out_step) * inner] = v;
+                        },
+                        workspace);
+                }
+            }
+        });
+
+        src = std::move(dst);
+    }
+
+    host_parallel_for(src.size(), [&](std::size_t i) {
+        const auto [nc, idx] = get_index(i, lengths);
+
+        store(nc, idx, src[i]);
+    });
+}
+
+} // namespace host_common
+} // namespace ck
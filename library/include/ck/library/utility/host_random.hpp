@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as
+// 1, 2, 3"). Every output block is a pure function of (counter, key), so any element of a random
+// sequence can be produced independently of all others, on any thread and in any order.
+struct Philox4x32
+{
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key     = std::array<std::uint32_t, 2>;
+
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;
+    static constexpr std::uint32_t W1 = 0xBB67AE85;
+
+    static constexpr int NumRound = 10;
+
+    static Counter Generate(Counter ctr, Key key)
+    {
+        for(int r = 0; r < NumRound; ++r)
+        {
+            const std::uint64_t p0 = std::uint64_t{M0} * ctr[0];
+            const std::uint64_t p1 = std::uint64_t{M1} * ctr[2];
+
+            ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                   static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                   static_cast<std::uint32_t>(p0)};
+
+            key[0] += W0;
+            key[1] += W1;
+        }
+
+        return ctr;
+    }
+};
+
+// Process-wide seed of the host random streams. It defaults to the CK_HOST_RANDOM_SEED environment
+// variable, or a fixed value if that is not set.
+std::uint64_t get_host_random_seed();
+
+// Set the seed and restart the stream numbering.
+void set_host_random_seed(std::uint64_t seed);
+
+// Restart the stream numbering, so that generators created afterwards repeat the values of the
+// generators created after the previous restart.
+void reset_host_random_streams();
+
+// Id of a new, independent random stream.
+std::uint64_t next_host_random_stream();
+
+// One random stream: every generator and fill functor owns one, taken in creation order, so that
+// tensors initialized one after another get different values while a whole run stays reproducible
+// for a given seed. Values are keyed by (seed, stream, element index) only and hence do not depend
+// on the number of threads or on the order elements are visited in.
+struct HostRandomStream
+{
+    std::uint64_t seed_   = get_host_random_seed();
+    std::uint64_t stream_ = next_host_random_stream();
+
+    // 4 random words for one counter value
+    Philox4x32::Counter GetBits(std::uint64_t counter) const
+    {
+        return Philox4x32::Generate({static_cast<std::uint32_t>(counter),
+                                     static_cast<std::uint32_t>(counter >> 32),
+                                     static_cast<std::uint32_t>(stream_),
+                                     static_cast<std::uint32_t>(stream_ >> 32)},
+                                    {static_cast<std::uint32_t>(seed_),
+                                     static_cast<std::uint32_t>(seed_ >> 32)});
+    }
+
+    // counter of a tensor multi-index, the identity for 1-d tensors
+    template <typename... Is>
+    static std::uint64_t GetCounter(Is... is)
+    {
+        std::uint64_t counter = 0;
+
+        ((counter = counter * 0x100000001B3ull + static_cast<std::uint64_t>(is)), ...);
+
+        return counter;
+    }
+
+    // float in [0, 1) from the upper 24 bits of a word
+    static float ToUniform(std::uint32_t bits)
+    {
+        return static_cast<float>(bits >> 8) * (1.f / 16777216.f);
+    }
+
+    // integer in [min_value, max_value)
+    static int ToUniformInt(std::uint32_t bits, int min_value, int max_value)
+    {
+        return min_value +
+               static_cast<int>(bits % static_cast<std::uint32_t>(max_value - min_value));
+    }
+
+    // standard normal value from two words (Box-Muller)
+    static float ToNormal(std::uint32_t bits0, std::uint32_t bits1)
+    {
+        const float u0 = ToUniform(bits0) + 1.f / 16777216.f; // (0, 1]
+        const float u1 = ToUniform(bits1);
+
+        return std::sqrt(-2.f * std::log(u0)) * std::cos(6.283185307f * u1);
+    }
+
+    template <typename... Is>
+    float Uniform(Is... is) const
+    {
+        return ToUniform(GetBits(GetCounter(is...))[0]);
+    }
+
+    template <typename... Is>
+    int UniformInt(int min_value, int max_value, Is... is) const
+    {
+        return ToUniformInt(GetBits(GetCounter(is...))[0], min_value, max_value);
+    }
+
+    template <typename... Is>
+    float Normal(Is... is) const
+    {
+        const auto bits = GetBits(GetCounter(is...));
+
+        return ToNormal(bits[0], bits[1]);
+    }
+};
+
+// Assign *(first + i) = f(bits) for every element of [first, last), where bits is word i % 4 of
+// the stream block for counter i / 4. Random access ranges are filled by the host thread pool.
+template <typename ForwardIter, typename F>
+void host_random_fill(ForwardIter first, ForwardIter last, const HostRandomStream& rng, F&& f)
+{
+    using Category = typename std::iterator_traits<ForwardIter>::iterator_category;
+
+    if constexpr(std::is_base_of_v<std::random_access_iterator_tag, Category>)
+    {
+        const std::size_t size      = static_cast<std::size_t>(last - first);
+        const std::size_t num_block = (size + 3) / 4;
+
+        HostThreadPool::GetInstance().ParallelFor(
+            num_block, [&](std::size_t block_begin, std::size_t block_end) {
+                for(std::size_t block = block_begin; block < block_end; ++block)
+                {
+                    const auto bits     = rng.GetBits(block);
+                    const std::size_t i = block * 4;
+
+                    for(std::size_t j = 0; j < 4 && i + j < size; ++j)
+                        first[i + j] = f(bits[j]);
+                }
+            });
+    }
+    else
+    {
+        Philox4x32::Counter bits{};
+
+        for(std::size_t i = 0; first != last; ++first, ++i)
+        {
+            if(i % 4 == 0)
+                bits = rng.GetBits(i / 4);
+
+            *first = f(bits[i % 4]);
+        }
+    }
+}
+
+} // namespace host_common
+} // namespace ck
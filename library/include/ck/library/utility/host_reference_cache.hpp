@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_file.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Signature of a verification problem: the operation, its types, the element-wise operations and
+// the inputs. Tensors are hashed by descriptor and contents, so the key holds for whatever
+// init_method or seed generated them. 128-bit digest, meant to tell problems apart, not to resist
+// deliberate collisions.
+struct HostReferenceCacheKey
+{
+    explicit HostReferenceCacheKey(const std::string& op_name);
+
+    HostReferenceCacheKey& AddBytes(const void* data, std::size_t bytes);
+
+    HostReferenceCacheKey& Add(const std::string& str);
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+    HostReferenceCacheKey& Add(T value)
+    {
+        return AddBytes(&value, sizeof(value));
+    }
+
+    template <typename T>
+    HostReferenceCacheKey& Add(const std::vector<T>& values)
+    {
+        Add(values.size());
+
+        for(const auto& value : values)
+            Add(value);
+
+        return *this;
+    }
+
+    HostReferenceCacheKey& Add(const HostTensorDescriptor& desc);
+
+    template <typename T>
+    HostReferenceCacheKey& Add(const TensorView<T>& tensor)
+    {
+        AddType<T>();
+        Add(tensor.mDesc);
+
+        return AddBytes(tensor.data(), tensor.GetElementSpaceSizeInBytes());
+    }
+
+    template <typename T, typename Allocator>
+    HostReferenceCacheKey& Add(const Tensor<T, Allocator>& tensor)
+    {
+        return Add(TensorView<const T>(tensor));
+    }
+
+    template <typename T>
+    HostReferenceCacheKey& AddType()
+    {
+        return Add(std::string(typeid(T).name()));
+    }
+
+    // type and state of e.g. an element-wise operation. The state is the given fields, e.g.
+    // AddObject(scale, scale.scale_), or else the object bytes, which requires a type without
+    // padding or floating-point members; empty types like PassThrough have no state
+    template <typename T, typename... Fields>
+    HostReferenceCacheKey& AddObject(const T& object, const Fields&... fields)
+    {
+        AddType<T>();
+
+        if constexpr(sizeof...(Fields) > 0)
+        {
+            (Add(fields), ...);
+        }
+        else if constexpr(!std::is_empty_v<T>)
+        {
+            static_assert(std::has_unique_object_representations_v<T>,
+                          "wrong! pass the fields of objects with padding or floating-point state");
+
+            AddBytes(&object, sizeof(object));
+        }
+
+        return *this;
+    }
+
+    // 32 hex digits
+    std::string ToString() const;
+
+    std::array<uint64_t, 2> mDigest;
+};
+
+// Content-addressed on-disk cache of reference outputs, one tensor file per key. Entries are
+// mapped on lookup and their checksums verified; the least recently used entries are evicted once
+// the cache grows beyond its capacity. Configured by CK_REFERENCE_CACHE_DIR, disabled if unset,
+// and CK_REFERENCE_CACHE_SIZE_MB, 8192 by default. Failures to read or write the cache are not
+// errors, the reference is computed instead.
+struct HostReferenceCache
+{
+    static HostReferenceCache& GetInstance();
+
+    bool IsEnabled() const { return !mDirectory.empty(); }
+
+    void SetDirectory(const std::string& directory) { mDirectory = directory; }
+
+    const std::string& GetDirectory() const { return mDirectory; }
+
+    void SetCapacity(std::size_t bytes) { mCapacity = bytes; }
+
+    std::size_t GetCapacity() const { return mCapacity; }
+
+    // mapped entry of key, nullptr on a miss
+    std::shared_ptr<const HostTensorFile> Find(const std::string& key) const;
+
+    void Insert(const std::string& key,
+                HostTensorDataType data_type,
+                const std::vector<std::size_t>& lens,
+                const std::vector<std::size_t>& strides,
+                const void* data) const;
+
+    private:
+    HostReferenceCache();
+
+    std::string mDirectory;
+    std::size_t mCapacity;
+};
+
+// Fill result with the cached reference output of the problem key or, on a miss, call compute()
+// to fill it and add it to the cache. Returns true on a cache hit.
+template <typename T, typename Allocator, typename F>
+bool compute_cached_host_reference(const HostReferenceCacheKey& key,
+                                   Tensor<T, Allocator>& result,
+                                   F&& compute)
+{
+    const auto& cache = HostReferenceCache::GetInstance();
+
+    if constexpr(host_tensor_data_type_v<T> != HostTensorDataType::Unknown)
+    {
+        if(cache.IsEnabled())
+        {
+            const std::string name = HostReferenceCacheKey(key).Add(result.mDesc).ToString();
+
+            const auto file = cache.Find(name);
+
+            if(file != nullptr && file->GetDataType() == host_tensor_data_type_v<T> &&
+               file->GetLengths() == result.GetLengths() &&
+               file->GetStrides() == result.GetStrides())
+            {
+                const T* cached = static_cast<const T*>(file->GetData());
+
+                HostThreadPool::GetInstance().ParallelFor(
+                    result.mData.size(), [&](std::size_t begin, std::size_t end) {
+                        std::copy(cached + begin, cached + end, result.data() + begin);
+                    });
+
+                return true;
+            }
+
+            compute();
+
+            cache.Insert(name,
+                         host_tensor_data_type_v<T>,
+                         result.GetLengths(),
+                         result.GetStrides(),
+                         result.data());
+
+            return false;
+        }
+    }
+
+    compute();
+
+    return false;
+}
+
+} // namespace host_common
+} // namespace ck
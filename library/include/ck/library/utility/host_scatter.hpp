@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Scatter-accumulate without atomics: calls accumulate(dst, src) for every source src in
+// [0, num_src) whose destination dst = get_dst(src), a signed index, lies in [0, num_dst); the
+// other sources are dropped. The destinations are cut into tiles, each owned by a single task,
+// and the sources are bucketed by tile with a stable counting sort: counted and placed in
+// parallel over chunks of sources, bucket offsets laid out in (tile, chunk) order. A destination
+// thus sees its sources in increasing order, as in a serial loop, whatever the number of threads.
+template <typename GetDst, typename Accumulate>
+void host_scatter_accumulate(std::size_t num_src,
+                             std::size_t num_dst,
+                             const GetDst& get_dst,
+                             const Accumulate& accumulate,
+                             std::size_t max_num_thread = 0)
+{
+    constexpr std::size_t MinTileSize = 4096;
+    constexpr std::size_t MaxNumTile  = 1024;
+    constexpr std::size_t SrcPerChunk = std::size_t{1} << 16;
+
+    if(num_src == 0 || num_dst == 0)
+        return;
+
+    const std::size_t tile_size = std::max(MinTileSize, (num_dst + MaxNumTile - 1) / MaxNumTile);
+    const std::size_t num_tile  = (num_dst + tile_size - 1) / tile_size;
+    const std::size_t num_chunk = (num_src + SrcPerChunk - 1) / SrcPerChunk;
+
+    // number of sources of every (chunk, tile), then the bucket offset of every (chunk, tile)
+    std::vector<std::size_t> offsets(num_chunk * num_tile, 0);
+
+    auto for_each_src = [&](std::size_t chunk, auto&& f) {
+        const std::size_t src_end = std::min(num_src, (chunk + 1) * SrcPerChunk);
+
+        for(std::size_t src = chunk * SrcPerChunk; src < src_end; ++src)
+        {
+            const std::int64_t dst = get_dst(src);
+
+            if(dst >= 0 && static_cast<std::size_t>(dst) < num_dst)
+                f(src, static_cast<std::size_t>(dst) / tile_size);
+        }
+    };
+
+    host_parallel_for(
+        num_chunk,
+        [&](std::size_t chunk) {
+            for_each_src(chunk, [&](std::size_t, std::size_t tile) {
+                ++offsets[chunk * num_tile + tile];
+            });
+        },
+        max_num_thread);
+
+    std::vector<std::size_t> tile_begins(num_tile + 1, 0);
+
+    for(std::size_t tile = 0; tile < num_tile; ++tile)
+    {
+        std::size_t offset = tile_begins[tile];
+
+        for(std::size_t chunk = 0; chunk < num_chunk; ++chunk)
+        {
+            const std::size_t count          = offsets[chunk * num_tile + tile];
+            offsets[chunk * num_tile + tile] = offset;
+            offset += count;
+        }
+
+        tile_begins[tile + 1] = offset;
+    }
+
+    std::vector<std::size_t> buckets(tile_begins[num_tile]);
+
+    host_parallel_for(
+        num_chunk,
+        [&](std::size_t chunk) {
+            for_each_src(chunk, [&](std::size_t src, std::size_t tile) {
+                buckets[offsets[chunk * num_tile + tile]++] = src;
+            });
+        },
+        max_num_thread);
+
+    host_parallel_for(
+        num_tile,
+        [&](std::size_t tile) {
+            for(std::size_t b = tile_begins[tile]; b < tile_begins[tile + 1]; ++b)
+            {
+                const std::size_t src = buckets[b];
+
+                accumulate(static_cast<std::size_t>(get_dst(src)), src);
+            }
+        },
+        max_num_thread);
+}
+
+} // namespace host_common
+} // namespace ck
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -16,6 +19,9 @@
 #include "ck/utility/type_convert.hpp"
 
 #include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_tensor_file.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 template <typename Range>
@@ -123,6 +129,11 @@ struct HostTensorDescriptor
     const std::vector<std::size_t>& GetLengths() const;
     const std::vector<std::size_t>& GetStrides() const;
 
+    // Dimensions sorted from the largest to the smallest stride, i.e. the loop nest (outermost
+    // first) that walks the tensor in memory order. Length-1 dimensions go first, ties keep the
+    // logical order, so a packed tensor gets 0, 1, ..., N - 1.
+    std::vector<std::size_t> GetTraversalOrder() const;
+
     template <typename... Is>
     std::size_t GetOffsetFromMultiIndex(Is... is) const
     {
@@ -136,6 +147,10 @@ struct HostTensorDescriptor
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
 
+    // Inverse of GetOffsetFromMultiIndex() for layouts without aliased elements. Dimensions are
+    // peeled off in traversal order, so any permutation of a packed or padded layout works.
+    std::vector<std::size_t> GetMultiIndexFromOffset(std::size_t offset) const;
+
     friend std::ostream& operator<<(std::ostream& os, const HostTensorDescriptor& desc);
 
     private:
@@ -176,6 +191,149 @@ struct joinable_thread : std::thread
     }
 };
 
+// Odometer over an NDIM-dimensional index space. Carries the multi-index and the matching linear
+// offsets under NumOffset sets of arbitrary strides, e.g. those of the input and the output of an
+// operation, so advancing costs an increment per offset (plus a carry at the end of every
+// innermost run) instead of NDIM divisions and an inner product per element.
+// mOrder lists the dimensions from the outermost to the innermost loop; the default is row-major.
+template <std::size_t NDIM, std::size_t NumOffset = 1>
+struct HostTensorIndexOdometer
+{
+    static_assert(NDIM >= 1, "NDIM >= 1 is required");
+    static_assert(NumOffset >= 1, "NumOffset >= 1 is required");
+
+    using Index   = std::array<std::size_t, NDIM>;
+    using Offsets = std::array<std::size_t, NumOffset>;
+
+    Index mLens;
+    std::array<Index, NumOffset> mStrides;
+    Index mOrder;
+    Index mIndex{};
+    Offsets mOffsets{};
+
+    HostTensorIndexOdometer(const Index& lens, const std::array<Index, NumOffset>& strides)
+        : mLens(lens), mStrides(strides)
+    {
+        std::iota(mOrder.begin(), mOrder.end(), std::size_t{0});
+    }
+
+    HostTensorIndexOdometer(const Index& lens,
+                            const std::array<Index, NumOffset>& strides,
+                            const Index& order)
+        : mLens(lens), mStrides(strides), mOrder(order)
+    {
+    }
+
+    // a single offset
+    HostTensorIndexOdometer(const Index& lens, const Index& strides)
+        : HostTensorIndexOdometer(lens, std::array<Index, 1>{strides})
+    {
+    }
+
+    HostTensorIndexOdometer(const Index& lens, const Index& strides, const Index& order)
+        : HostTensorIndexOdometer(lens, std::array<Index, 1>{strides}, order)
+    {
+    }
+
+    std::size_t GetSize() const
+    {
+        return std::accumulate(
+            mLens.begin(), mLens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    // position the odometer at the i-th multi-index in loop order
+    void Seek(std::size_t i)
+    {
+        mOffsets = {};
+
+        for(std::size_t level = NDIM; level-- > 0;)
+        {
+            const std::size_t idim = mOrder[level];
+
+            mIndex[idim] = i % mLens[idim];
+            i /= mLens[idim];
+
+            for(std::size_t o = 0; o < NumOffset; ++o)
+                mOffsets[o] += mIndex[idim] * mStrides[o][idim];
+        }
+    }
+
+    // propagate the carry once the innermost index has run past its length
+    void Carry()
+    {
+        for(std::size_t level = NDIM - 1;
+            level > 0 && mIndex[mOrder[level]] == mLens[mOrder[level]];
+            --level)
+        {
+            const std::size_t idim  = mOrder[level];
+            const std::size_t outer = mOrder[level - 1];
+
+            mIndex[idim] = 0;
+            ++mIndex[outer];
+
+            for(std::size_t o = 0; o < NumOffset; ++o)
+                mOffsets[o] += mStrides[o][outer] - mLens[idim] * mStrides[o][idim];
+        }
+    }
+
+    // call f(index, offset) for the positions [begin, end) in loop order, offset being the
+    // std::size_t offset if there is a single one, the std::array of the offsets otherwise
+    template <typename F>
+    void ForEachInRange(std::size_t begin, std::size_t end, F&& f)
+    {
+        if(begin >= end)
+            return;
+
+        Seek(begin);
+
+        const std::size_t last = mOrder[NDIM - 1];
+
+        for(std::size_t i = begin; i < end;)
+        {
+            const std::size_t run = std::min(end - i, mLens[last] - mIndex[last]);
+
+            for(std::size_t r = 0; r < run; ++r)
+            {
+                if constexpr(NumOffset == 1)
+                    f(static_cast<const Index&>(mIndex), mOffsets[0]);
+                else
+                    f(static_cast<const Index&>(mIndex), static_cast<const Offsets&>(mOffsets));
+
+                ++mIndex[last];
+
+                for(std::size_t o = 0; o < NumOffset; ++o)
+                    mOffsets[o] += mStrides[o][last];
+            }
+
+            i += run;
+
+            if(i < end)
+                Carry();
+        }
+    }
+
+    template <typename F>
+    void ForEach(F&& f)
+    {
+        ForEachInRange(0, GetSize(), f);
+    }
+
+    // split the positions across the host thread pool, each chunk walked by a copy of the
+    // odometer; f has to be safe to call concurrently
+    template <typename F>
+    void ParallelForEach(F&& f, std::size_t num_thread = 0) const
+    {
+        ck::host_common::HostThreadPool::GetInstance().ParallelFor(
+            GetSize(),
+            [&](std::size_t begin, std::size_t end) {
+                auto odometer = *this;
+
+                odometer.ForEachInRange(begin, end, f);
+            },
+            num_thread);
+    }
+};
+
 template <typename F, typename... Xs>
 struct ParallelTensorFunctor
 {
@@ -208,71 +366,421 @@ struct ParallelTensorFunctor
         return indices;
     }
 
+    // num_thread caps the number of threads of the host thread pool taking part. Every chunk
+    // decodes its first index once and then advances it odometer-style.
     void operator()(std::size_t num_thread = 1) const
     {
-        std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
+        ck::host_common::HostThreadPool::GetInstance().ParallelFor(
+            mN1d,
+            [&](std::size_t iw_begin, std::size_t iw_end) {
+                HostTensorIndexOdometer<NDIM> odometer(mLens, mStrides);
+
+                odometer.ForEachInRange(
+                    iw_begin, iw_end, [&](const std::array<std::size_t, NDIM>& indices, auto) {
+                        call_f_unpack_args(mF, indices);
+                    });
+            },
+            num_thread);
+    }
+};
+
+template <typename F, typename... Xs>
+auto make_ParallelTensorFunctor(F f, Xs... xs)
+{
+    return ParallelTensorFunctor<F, Xs...>(f, xs...);
+}
+
+// Rank-templated variant of ParallelTensorFunctor. Calls f(index, offset) for every multi-index
+// of the index space, where index is a std::array<std::size_t, NDIM> and offset is the matching
+// linear offset under mStrides (typically the strides of the tensor being written), maintained
+// incrementally. Loops are nested in mOrder, outermost dimension first.
+template <std::size_t NDIM, typename F>
+struct ParallelTensorFunctorNd
+{
+    F mF;
+    std::array<std::size_t, NDIM> mLens;
+    std::array<std::size_t, NDIM> mStrides;
+    std::array<std::size_t, NDIM> mOrder;
+    std::size_t mN1d;
+
+    ParallelTensorFunctorNd(F f,
+                            const std::array<std::size_t, NDIM>& lens,
+                            const std::array<std::size_t, NDIM>& strides)
+        : mF(f),
+          mLens(lens),
+          mStrides(strides),
+          mN1d(std::accumulate(
+              lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>()))
+    {
+        std::iota(mOrder.begin(), mOrder.end(), std::size_t{0});
+    }
 
-        std::vector<joinable_thread> threads(num_thread);
+    ParallelTensorFunctorNd(F f,
+                            const std::array<std::size_t, NDIM>& lens,
+                            const std::array<std::size_t, NDIM>& strides,
+                            const std::array<std::size_t, NDIM>& order)
+        : ParallelTensorFunctorNd(f, lens, strides)
+    {
+        mOrder = order;
+    }
 
-        for(std::size_t it = 0; it < num_thread; ++it)
+    void operator()(std::size_t num_thread = 1) const
+    {
+        ck::host_common::HostThreadPool::GetInstance().ParallelFor(
+            mN1d,
+            [&](std::size_t iw_begin, std::size_t iw_end) {
+                HostTensorIndexOdometer<NDIM> odometer(mLens, mStrides, mOrder);
+
+                odometer.ForEachInRange(iw_begin, iw_end, mF);
+            },
+            num_thread);
+    }
+};
+
+template <std::size_t NDIM, typename F>
+auto make_ParallelTensorFunctorNd(F f,
+                                  const std::array<std::size_t, NDIM>& lens,
+                                  const std::array<std::size_t, NDIM>& strides)
+{
+    return ParallelTensorFunctorNd<NDIM, F>(f, lens, strides);
+}
+
+// iterate over the lengths of desc in the memory order of desc, passing offsets under its strides
+template <std::size_t NDIM, typename F>
+auto make_ParallelTensorFunctorNd(F f, const HostTensorDescriptor& desc)
+{
+    if(desc.GetNumOfDimension() != NDIM)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    std::array<std::size_t, NDIM> lens;
+    std::array<std::size_t, NDIM> strides;
+    std::array<std::size_t, NDIM> order;
+
+    const auto traversal_order = desc.GetTraversalOrder();
+
+    std::copy_n(desc.GetLengths().begin(), NDIM, lens.begin());
+    std::copy_n(desc.GetStrides().begin(), NDIM, strides.begin());
+    std::copy_n(traversal_order.begin(), NDIM, order.begin());
+
+    return ParallelTensorFunctorNd<NDIM, F>(f, lens, strides, order);
+}
+
+// Call f(index) for every multi-index of desc, index being a std::vector<std::size_t>, visiting
+// the elements serially in the memory order of desc.
+template <typename F>
+void for_each_host_tensor_index(const HostTensorDescriptor& desc, F&& f)
+{
+    const auto& lens      = desc.GetLengths();
+    const std::size_t rank = lens.size();
+
+    if(desc.GetElementSize() == 0)
+        return;
+
+    std::vector<std::size_t> idx(rank, 0);
+
+    if(rank == 0)
+    {
+        f(idx);
+        return;
+    }
+
+    const auto order       = desc.GetTraversalOrder();
+    const std::size_t last = order.back();
+
+    for(;;)
+    {
+        for(idx[last] = 0; idx[last] < lens[last]; ++idx[last])
+            f(idx);
+
+        idx[last] = 0;
+
+        std::size_t level = rank - 1;
+
+        while(level > 0 && ++idx[order[level - 1]] == lens[order[level - 1]])
+            idx[order[--level]] = 0;
+
+        if(level == 0)
+            return;
+    }
+}
+
+// Loop nest visiting the elements of NumTensor tensors of equal lengths, used for element-wise
+// host loops where only offsets are needed. The loops follow the memory order of the first tensor
+// (normally the one written): length-1 dimensions are dropped and neighbouring dimensions that are
+// contiguous in every tensor are merged, so packed tensors become a single loop. If the innermost
+// dimension of another tensor is strided in the first one (a transposing copy), both dimensions are
+// blocked into TileSize x TileSize tiles so neither side streams through memory with a large
+// stride.
+template <std::size_t NumTensor>
+struct HostTensorTraversal
+{
+    static_assert(NumTensor >= 1, "NumTensor >= 1 is required");
+
+    static constexpr std::size_t TileSize = 32;
+
+    using Offsets = std::array<std::size_t, NumTensor>;
+
+    struct Loop
+    {
+        std::size_t length;
+        Offsets strides;
+        // for the intra-tile loop of a blocked dimension: level of the matching tile loop and the
+        // length of the dimension, the last tile is cut to length - tile_index * TileSize
+        std::size_t tile_level = 0;
+        std::size_t full_length = 0;
+        bool is_tile_inner      = false;
+    };
+
+    std::vector<Loop> mLoops;
+    bool mIsEmpty = false;
+
+    explicit HostTensorTraversal(const std::array<const HostTensorDescriptor*, NumTensor>& descs)
+    {
+        const auto& lens = descs[0]->GetLengths();
+
+        for(const auto* desc : descs)
+            if(desc->GetLengths() != lens || desc->GetStrides().size() != lens.size())
+                throw std::runtime_error("wrong! inconsistent lengths");
+
+        mIsEmpty = std::find(lens.begin(), lens.end(), std::size_t{0}) != lens.end();
+
+        for(std::size_t idim : descs[0]->GetTraversalOrder())
         {
-            std::size_t iw_begin = it * work_per_thread;
-            std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
-
-            auto f = [=] {
-                for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
-                {
-                    call_f_unpack_args(mF, GetNdIndices(iw));
-                }
-            };
-            threads[it] = joinable_thread(f);
+            if(lens[idim] == 1)
+                continue;
+
+            Loop loop;
+
+            loop.length = lens[idim];
+
+            for(std::size_t t = 0; t < NumTensor; ++t)
+                loop.strides[t] = descs[t]->GetStrides()[idim];
+
+            // merge into the enclosing loop if the pair is contiguous in every tensor
+            if(!mLoops.empty() && IsContiguous(mLoops.back(), loop))
+            {
+                loop.length *= mLoops.back().length;
+                mLoops.back() = loop;
+            }
+            else
+            {
+                mLoops.push_back(loop);
+            }
+        }
+
+        BlockTransposedLoops();
+    }
+
+    // call f(offsets) for every element, with the outermost loop split across the host thread pool
+    // when its iterations write disjoint elements of the first tensor; a broadcast or overlapping
+    // first tensor is walked serially
+    template <typename F>
+    void operator()(F&& f, std::size_t num_thread = 1) const
+    {
+        if(mIsEmpty)
+            return;
+
+        if(mLoops.empty())
+        {
+            f(Offsets{});
+            return;
+        }
+
+        ck::host_common::HostThreadPool::GetInstance().ParallelFor(
+            mLoops[0].length,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<std::size_t> index(mLoops.size(), 0);
+
+                Walk(0, begin, end, Offsets{}, index, f);
+            },
+            IsOuterLoopDisjoint() ? num_thread : 1);
+    }
+
+    // whether the iterations of the outermost loop write disjoint elements of the first tensor:
+    // its stride there is non-zero and exceeds the span of the inner loops
+    bool IsOuterLoopDisjoint() const
+    {
+        if(mLoops.empty() || mLoops[0].strides[0] == 0)
+            return false;
+
+        std::size_t inner_span = 1;
+
+        for(std::size_t l = 1; l < mLoops.size(); ++l)
+            inner_span += (mLoops[l].length - 1) * mLoops[l].strides[0];
+
+        return mLoops[0].strides[0] >= inner_span;
+    }
+
+    private:
+    static bool IsContiguous(const Loop& outer, const Loop& inner)
+    {
+        for(std::size_t t = 0; t < NumTensor; ++t)
+            if(outer.strides[t] != inner.length * inner.strides[t])
+                return false;
+
+        return true;
+    }
+
+    void BlockTransposedLoops()
+    {
+        if(mLoops.size() < 2)
+            return;
+
+        const std::size_t inner = mLoops.size() - 1;
+
+        for(std::size_t t = 1; t < NumTensor; ++t)
+        {
+            // innermost loop of tensor t
+            std::size_t fast = inner;
+
+            for(std::size_t l = 0; l < mLoops.size(); ++l)
+                if(mLoops[l].strides[t] != 0 && (mLoops[fast].strides[t] == 0 ||
+                                                 mLoops[l].strides[t] < mLoops[fast].strides[t]))
+                    fast = l;
+
+            if(fast == inner || mLoops[inner].strides[t] <= 1 || mLoops[fast].length <= TileSize ||
+               mLoops[inner].length <= TileSize)
+                continue;
+
+            Loop slow_dim = mLoops[fast];
+            Loop fast_dim = mLoops[inner];
+
+            mLoops.erase(mLoops.begin() + fast);
+            mLoops.pop_back();
+
+            const std::size_t first_tile_level = mLoops.size();
+
+            for(Loop dim : {slow_dim, fast_dim})
+            {
+                Loop tile = dim;
+
+                tile.length = (dim.length + TileSize - 1) / TileSize;
+
+                for(auto& stride : tile.strides)
+                    stride *= TileSize;
+
+                mLoops.push_back(tile);
+            }
+
+            for(std::size_t i = 0; i < 2; ++i)
+            {
+                Loop dim = i == 0 ? slow_dim : fast_dim;
+
+                dim.tile_level    = first_tile_level + i;
+                dim.full_length   = dim.length;
+                dim.length        = TileSize;
+                dim.is_tile_inner = true;
+
+                mLoops.push_back(dim);
+            }
+
+            return;
+        }
+    }
+
+    template <typename F>
+    void Walk(std::size_t level,
+              std::size_t begin,
+              std::size_t end,
+              Offsets offsets,
+              std::vector<std::size_t>& index,
+              F& f) const
+    {
+        const Loop& loop = mLoops[level];
+
+        for(std::size_t t = 0; t < NumTensor; ++t)
+            offsets[t] += begin * loop.strides[t];
+
+        if(level + 1 == mLoops.size())
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                f(static_cast<const Offsets&>(offsets));
+
+                for(std::size_t t = 0; t < NumTensor; ++t)
+                    offsets[t] += loop.strides[t];
+            }
+
+            return;
+        }
+
+        const Loop& next = mLoops[level + 1];
+
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            index[level] = i;
+
+            const std::size_t next_end =
+                next.is_tile_inner
+                    ? std::min(TileSize, next.full_length - index[next.tile_level] * TileSize)
+                    : next.length;
+
+            Walk(level + 1, 0, next_end, offsets, index, f);
+
+            for(std::size_t t = 0; t < NumTensor; ++t)
+                offsets[t] += loop.strides[t];
         }
     }
 };
 
-template <typename F, typename... Xs>
-auto make_ParallelTensorFunctor(F f, Xs... xs)
+template <typename... Descs>
+auto make_host_tensor_traversal(const HostTensorDescriptor& desc, const Descs&... descs)
 {
-    return ParallelTensorFunctor<F, Xs...>(f, xs...);
+    return HostTensorTraversal<1 + sizeof...(Descs)>({&desc, &descs...});
 }
 
 template <typename T>
+struct MappedTensor;
+
+// Host tensor. The storage policy is the allocator of mData: the default HostAllocator zero fills
+// new tensors on the host thread pool, HostUninitializedAllocator only faults the pages in.
+template <typename T, typename Allocator = ck::host_common::HostAllocator<T>>
 struct Tensor
 {
     using Descriptor = HostTensorDescriptor;
-    using Data       = std::vector<T>;
+    using Data       = std::vector<T, Allocator>;
 
     template <typename X>
     Tensor(std::initializer_list<X> lens) : mDesc(lens), mData(mDesc.GetElementSpaceSize())
     {
+        InitializeData();
     }
 
     template <typename X, typename Y>
     Tensor(std::initializer_list<X> lens, std::initializer_list<Y> strides)
         : mDesc(lens, strides), mData(mDesc.GetElementSpaceSize())
     {
+        InitializeData();
     }
 
     template <typename Lengths>
     Tensor(const Lengths& lens) : mDesc(lens), mData(mDesc.GetElementSpaceSize())
     {
+        InitializeData();
     }
 
     template <typename Lengths, typename Strides>
     Tensor(const Lengths& lens, const Strides& strides)
         : mDesc(lens, strides), mData(GetElementSpaceSize())
     {
+        InitializeData();
     }
 
-    Tensor(const Descriptor& desc) : mDesc(desc), mData(mDesc.GetElementSpaceSize()) {}
+    Tensor(const Descriptor& desc) : mDesc(desc), mData(mDesc.GetElementSpaceSize())
+    {
+        InitializeData();
+    }
 
     template <typename OutT>
     Tensor<OutT> CopyAsType() const
     {
         Tensor<OutT> ret(mDesc);
 
-        ck::ranges::transform(
-            mData, ret.mData.begin(), [](auto value) { return ck::type_convert<OutT>(value); });
+        make_host_tensor_traversal(mDesc)(
+            [&](const auto& offsets) {
+                ret.mData[offsets[0]] = ck::type_convert<OutT>(mData[offsets[0]]);
+            },
+            std::thread::hardware_concurrency());
 
         return ret;
     }
@@ -305,55 +813,67 @@ struct Tensor
 
     void SetZero() { ck::ranges::fill<T>(mData, 0); }
 
-    template <typename F>
-    void ForEach_impl(F&& f, std::vector<size_t>& idx, size_t rank)
+    // Write the tensor to a file, see ck::host_common::save_host_tensor_file()
+    void Save(const std::string& path,
+              const ck::host_common::HostTensorFileOptions& options = {}) const
     {
-        if(rank == mDesc.GetNumOfDimension())
-        {
-            f(*this, idx);
-            return;
-        }
-        // else
-        for(size_t i = 0; i < mDesc.GetLengths()[rank]; i++)
-        {
-            idx[rank] = i;
-            ForEach_impl(std::forward<F>(f), idx, rank + 1);
-        }
+        ck::host_common::save_host_tensor_file(path,
+                                               ck::host_common::host_tensor_data_type_v<T>,
+                                               GetLengths(),
+                                               GetStrides(),
+                                               data(),
+                                               options);
     }
 
-    template <typename F>
-    void ForEach(F&& f)
+    // Map a file written by Save() or a .npy file; no element is read before it is accessed
+    static MappedTensor<T> LoadMapped(const std::string& path) { return MappedTensor<T>(path); }
+
+    // Read a file written by Save() or a .npy file into a tensor of the same lengths and strides,
+    // after verifying the checksums of the file, if any
+    static Tensor Load(const std::string& path)
     {
-        std::vector<size_t> idx(mDesc.GetNumOfDimension(), 0);
-        ForEach_impl(std::forward<F>(f), idx, size_t(0));
+        const MappedTensor<T> mapped(path);
+
+        if(!mapped.mFile->VerifyChecksums())
+            throw std::runtime_error("wrong! checksum mismatch in tensor file " + path);
+
+        Tensor tensor(mapped.mDesc);
+
+        ck::host_common::HostThreadPool::GetInstance().ParallelFor(
+            tensor.mData.size(), [&](std::size_t begin, std::size_t end) {
+                std::copy(mapped.data() + begin, mapped.data() + end, tensor.data() + begin);
+            });
+
+        return tensor;
     }
 
+    // call f(*this, idx) for every multi-index, in the memory order of the tensor
     template <typename F>
-    void ForEach_impl(const F&& f, std::vector<size_t>& idx, size_t rank) const
+    void ForEach(F&& f)
     {
-        if(rank == mDesc.GetNumOfDimension())
-        {
-            f(*this, idx);
-            return;
-        }
-        // else
-        for(size_t i = 0; i < mDesc.GetLengths()[rank]; i++)
-        {
-            idx[rank] = i;
-            ForEach_impl(std::forward<const F>(f), idx, rank + 1);
-        }
+        for_each_host_tensor_index(mDesc, [&](std::vector<std::size_t>& idx) { f(*this, idx); });
     }
 
     template <typename F>
     void ForEach(const F&& f) const
     {
-        std::vector<size_t> idx(mDesc.GetNumOfDimension(), 0);
-        ForEach_impl(std::forward<const F>(f), idx, size_t(0));
+        for_each_host_tensor_index(mDesc, [&](std::vector<std::size_t>& idx) { f(*this, idx); });
     }
 
+    // Set every element to g(indices...). num_thread caps the number of threads of the host thread
+    // pool taking part, 0 uses all of them; g must then be callable concurrently, which holds for
+    // the GeneratorTensor_* functors. Tensors whose elements alias (broadcast strides) are filled
+    // on the calling thread, so that the last index of a shared element always wins.
     template <typename G>
-    void GenerateTensorValue(G g, std::size_t num_thread = 1)
+    void GenerateTensorValue(G g, std::size_t num_thread = 0)
     {
+        for(std::size_t d = 0; d < mDesc.GetNumOfDimension(); ++d)
+            if(mDesc.GetLengths()[d] > 1 && mDesc.GetStrides()[d] == 0)
+                num_thread = 1;
+
+        if(mDesc.GetElementSpaceSize() < mDesc.GetElementSize())
+            num_thread = 1;
+
         switch(mDesc.GetNumOfDimension())
         {
         case 1: {
@@ -476,4 +996,211 @@ struct Tensor
 
     Descriptor mDesc;
     Data mData;
+
+    private:
+    // the allocator leaves trivial elements uninitialized, do what its policy asks for instead
+    void InitializeData()
+    {
+        using ck::host_common::host_memory_init_of;
+
+        if constexpr(std::is_trivially_default_constructible_v<T>)
+        {
+            ck::host_common::initialize_host_allocation(
+                mData.data(), mData.size() * sizeof(T), host_memory_init_of<Allocator>::value);
+        }
+    }
+};
+
+// Non-owning view of a host tensor: a descriptor over memory owned elsewhere, e.g. by a Tensor, a
+// mapped file or a staging buffer. Copies are shallow and the element access of a const view is
+// not const, as for std::span; T is const for read-only views. Slices, sub-tensors and transposes
+// only change the descriptor and the base pointer, so they never copy elements.
+template <typename T>
+struct TensorView
+{
+    using Descriptor = HostTensorDescriptor;
+    using Data       = ck::span<T>;
+    using value_type = std::remove_cv_t<T>;
+
+    TensorView(T* p, const Descriptor& desc)
+        : mDesc(desc), mData(p, desc.GetElementSize() == 0 ? 0 : desc.GetElementSpaceSize())
+    {
+    }
+
+    template <typename Allocator>
+    TensorView(Tensor<value_type, Allocator>& tensor) : TensorView(tensor.data(), tensor.mDesc)
+    {
+    }
+
+    template <typename Allocator,
+              typename U = T,
+              typename   = std::enable_if_t<std::is_const_v<U>>>
+    TensorView(const Tensor<value_type, Allocator>& tensor)
+        : TensorView(tensor.data(), tensor.mDesc)
+    {
+    }
+
+    // read-only view of a mutable view
+    template <typename U,
+              typename = std::enable_if_t<std::is_const_v<T> && std::is_same_v<U, value_type>>>
+    TensorView(const TensorView<U>& other) : TensorView(other.data(), other.mDesc)
+    {
+    }
+
+    decltype(auto) GetLengths() const { return mDesc.GetLengths(); }
+
+    decltype(auto) GetStrides() const { return mDesc.GetStrides(); }
+
+    std::size_t GetNumOfDimension() const { return mDesc.GetNumOfDimension(); }
+
+    std::size_t GetElementSize() const { return mDesc.GetElementSize(); }
+
+    std::size_t GetElementSpaceSize() const { return mData.size(); }
+
+    std::size_t GetElementSpaceSizeInBytes() const { return sizeof(T) * GetElementSpaceSize(); }
+
+    // see Tensor::Save()
+    void Save(const std::string& path,
+              const ck::host_common::HostTensorFileOptions& options = {}) const
+    {
+        ck::host_common::save_host_tensor_file(path,
+                                               ck::host_common::host_tensor_data_type_v<T>,
+                                               GetLengths(),
+                                               GetStrides(),
+                                               data(),
+                                               options);
+    }
+
+    // elements [begin, end) of dimension dim
+    TensorView Slice(std::size_t dim, std::size_t begin, std::size_t end) const
+    {
+        if(dim >= GetNumOfDimension() || begin > end || end > GetLengths()[dim])
+            throw std::runtime_error("wrong! slice out of range");
+
+        std::vector<std::size_t> lens = GetLengths();
+
+        lens[dim] = end - begin;
+
+        return TensorView(data() + begin * GetStrides()[dim], Descriptor(lens, GetStrides()));
+    }
+
+    // the box of the given lengths starting at multi-index origin
+    TensorView SubView(const std::vector<std::size_t>& origin,
+                       const std::vector<std::size_t>& lens) const
+    {
+        if(origin.size() != GetNumOfDimension() || lens.size() != GetNumOfDimension())
+            throw std::runtime_error("wrong! inconsistent dimension");
+
+        for(std::size_t d = 0; d < GetNumOfDimension(); ++d)
+            if(origin[d] + lens[d] > GetLengths()[d])
+                throw std::runtime_error("wrong! sub-view out of range");
+
+        return TensorView(data() + mDesc.GetOffsetFromMultiIndex(origin),
+                          Descriptor(lens, GetStrides()));
+    }
+
+    // fix dimension dim at index, e.g. a [M, K] matrix of a [G, M, K] batch
+    TensorView Select(std::size_t dim, std::size_t index) const
+    {
+        if(dim >= GetNumOfDimension() || index >= GetLengths()[dim])
+            throw std::runtime_error("wrong! selection out of range");
+
+        std::vector<std::size_t> lens    = GetLengths();
+        std::vector<std::size_t> strides = GetStrides();
+
+        lens.erase(lens.begin() + dim);
+        strides.erase(strides.begin() + dim);
+
+        return TensorView(data() + index * GetStrides()[dim], Descriptor(lens, strides));
+    }
+
+    template <typename New2Old>
+    TensorView Transpose(const New2Old& new2old) const
+    {
+        return TensorView(data(), transpose_host_tensor_descriptor_given_new2old(mDesc, new2old));
+    }
+
+    template <typename... Is>
+    std::size_t GetOffsetFromMultiIndex(Is... is) const
+    {
+        return mDesc.GetOffsetFromMultiIndex(is...);
+    }
+
+    template <typename... Is>
+    T& operator()(Is... is) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    T& operator()(std::vector<std::size_t> idx) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    // the element space, as for Tensor
+    typename Data::iterator begin() const { return mData.begin(); }
+
+    typename Data::iterator end() const { return mData.end(); }
+
+    typename Data::pointer data() const { return mData.data(); }
+
+    typename Data::size_type size() const { return mData.size(); }
+
+    // packed copy of the viewed elements
+    template <typename OutT = value_type>
+    Tensor<OutT> CopyAsType() const
+    {
+        Tensor<OutT> ret(GetLengths());
+
+        make_host_tensor_traversal(ret.mDesc, mDesc)(
+            [&](const auto& offsets) {
+                ret.mData[offsets[0]] = ck::type_convert<OutT>(mData[offsets[1]]);
+            },
+            0);
+
+        return ret;
+    }
+
+    Descriptor mDesc;
+    Data mData;
+};
+
+template <typename T, typename Allocator>
+TensorView(Tensor<T, Allocator>&) -> TensorView<T>;
+
+template <typename T, typename Allocator>
+TensorView(const Tensor<T, Allocator>&) -> TensorView<const T>;
+
+// A tensor file mapped into memory, see ck::host_common::HostTensorFile. Loading costs page faults
+// on first access instead of reading or generating the whole tensor up front. Copies share the
+// mapping; views taken from a MappedTensor must not outlive it.
+template <typename T>
+struct MappedTensor : TensorView<T>
+{
+    explicit MappedTensor(const std::string& path)
+        : MappedTensor(std::make_shared<const ck::host_common::HostTensorFile>(path))
+    {
+    }
+
+    explicit MappedTensor(std::shared_ptr<const ck::host_common::HostTensorFile> file)
+        : TensorView<T>(GetData(*file),
+                        HostTensorDescriptor(file->GetLengths(), file->GetStrides())),
+          mFile(std::move(file))
+    {
+    }
+
+    std::shared_ptr<const ck::host_common::HostTensorFile> mFile;
+
+    private:
+    static T* GetData(const ck::host_common::HostTensorFile& file)
+    {
+        using ck::host_common::get_host_tensor_data_type_name;
+
+        if(file.GetDataType() != ck::host_common::host_tensor_data_type_v<T>)
+            throw std::runtime_error(std::string("wrong! tensor file holds ") +
+                                     get_host_tensor_data_type_name(file.GetDataType()) +
+                                     " elements");
+
+        return static_cast<T*>(file.GetData());
+    }
 };
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+
+namespace ck {
+namespace host_common {
+
+// Element types of host tensor files; the values are stored in the files
+enum struct HostTensorDataType : uint32_t
+{
+    Unknown = 0,
+    F32     = 1,
+    F64     = 2,
+    F16     = 3,
+    BF16    = 4,
+    F8      = 5,
+    BF8     = 6,
+    I8      = 7,
+    U8      = 8,
+    I32     = 9,
+    I64     = 10,
+    Int4    = 11,
+};
+
+template <typename T>
+struct host_tensor_data_type
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::Unknown;
+};
+
+template <>
+struct host_tensor_data_type<float>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::F32;
+};
+
+template <>
+struct host_tensor_data_type<double>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::F64;
+};
+
+template <>
+struct host_tensor_data_type<half_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::F16;
+};
+
+template <>
+struct host_tensor_data_type<bhalf_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::BF16;
+};
+
+template <>
+struct host_tensor_data_type<int8_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::I8;
+};
+
+template <>
+struct host_tensor_data_type<uint8_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::U8;
+};
+
+template <>
+struct host_tensor_data_type<int32_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::I32;
+};
+
+template <>
+struct host_tensor_data_type<int64_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::I64;
+};
+
+#if defined CK_ENABLE_FP8
+template <>
+struct host_tensor_data_type<f8_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::F8;
+};
+#endif
+
+#if defined CK_ENABLE_BF8
+template <>
+struct host_tensor_data_type<bf8_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::BF8;
+};
+#endif
+
+#ifdef CK_EXPERIMENTAL_BIT_INT_EXTENSION_INT4
+template <>
+struct host_tensor_data_type<int4_t>
+{
+    static constexpr HostTensorDataType value = HostTensorDataType::Int4;
+};
+#endif
+
+template <typename T>
+inline constexpr HostTensorDataType host_tensor_data_type_v =
+    host_tensor_data_type<std::remove_cv_t<T>>::value;
+
+// size of one element in bytes, 0 for Unknown
+std::size_t get_host_tensor_data_type_size(HostTensorDataType data_type);
+
+const char* get_host_tensor_data_type_name(HostTensorDataType data_type);
+
+// 64-bit checksums of the chunk_size byte chunks of data, computed on the host thread pool. Meant
+// to catch truncated or corrupted data, not tampering.
+std::vector<uint64_t>
+compute_host_chunk_checksums(const void* data, std::size_t bytes, std::size_t chunk_size);
+
+enum struct HostTensorFileFormat
+{
+    Auto,   // Npy for paths ending in ".npy", Native otherwise
+    Native, // header, 4 KB aligned element space, optional chunk checksums
+    Npy,    // NumPy .npy 1.0, bhalf_t stored as '<u2'; no F8, BF8 and Int4
+};
+
+struct HostTensorFileOptions
+{
+    HostTensorFileFormat format = HostTensorFileFormat::Auto;
+
+    // checksum every checksum_chunk_size bytes of the payload, 0 for none; Native only
+    std::size_t checksum_chunk_size = std::size_t{64} << 20;
+};
+
+// Write the element space of a tensor, lens and strides in elements. The Native format keeps the
+// strides, so the element space is written as is; .npy files are always packed row-major, other
+// layouts are gathered first. Throws std::runtime_error.
+void save_host_tensor_file(const std::string& path,
+                           HostTensorDataType data_type,
+                           const std::vector<std::size_t>& lens,
+                           const std::vector<std::size_t>& strides,
+                           const void* data,
+                           const HostTensorFileOptions& options = {});
+
+// A Native or .npy tensor file mapped into memory. The payload is mapped copy-on-write: pages are
+// read from the file on first access and writes stay private to the process. Throws
+// std::runtime_error if the file cannot be mapped or is malformed.
+struct HostTensorFile
+{
+    explicit HostTensorFile(const std::string& path);
+
+    HostTensorFile(const HostTensorFile&) = delete;
+    HostTensorFile& operator=(const HostTensorFile&) = delete;
+
+    ~HostTensorFile();
+
+    HostTensorDataType GetDataType() const { return mDataType; }
+
+    const std::vector<std::size_t>& GetLengths() const { return mLens; }
+
+    const std::vector<std::size_t>& GetStrides() const { return mStrides; }
+
+    void* GetData() const { return mpData; }
+
+    // size of the element space in bytes
+    std::size_t GetDataSize() const { return mDataSize; }
+
+    bool HasChecksums() const { return !mChecksums.empty(); }
+
+    // Recompute the chunk checksums on the host thread pool, which reads every page. True if they
+    // match or the file has none.
+    bool VerifyChecksums() const;
+
+    private:
+    void* mpMapping          = nullptr;
+    std::size_t mMappingSize = 0;
+    void* mpData             = nullptr;
+    std::size_t mDataSize    = 0;
+
+    HostTensorDataType mDataType = HostTensorDataType::Unknown;
+    std::vector<std::size_t> mLens;
+    std::vector<std::size_t> mStrides;
+
+    std::size_t mChecksumChunkSize = 0;
+    std::vector<uint64_t> mChecksums;
+};
+
+} // namespace host_common
+} // namespace ck
@@ -8,6 +8,7 @@
 #include <random>
 
 #include "ck/ck.hpp"
+#include "ck/library/utility/host_random.hpp"
 
 template <typename T>
 struct GeneratorTensor_0
@@ -55,16 +56,18 @@ struct GeneratorTensor_1<int8_t>
     }
 };
 
+// integer values in [min_value, max_value), keyed by the multi-index of the element
 template <typename T>
 struct GeneratorTensor_2
 {
     int min_value = 0;
     int max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is) const
     {
-        return static_cast<T>((std::rand() % (max_value - min_value)) + min_value);
+        return static_cast<T>(rng.UniformInt(min_value, max_value, is...));
     }
 };
 
@@ -73,11 +76,12 @@ struct GeneratorTensor_2<ck::bhalf_t>
 {
     int min_value = 0;
     int max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::bhalf_t operator()(Is...)
+    ck::bhalf_t operator()(Is... is) const
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = rng.UniformInt(min_value, max_value, is...);
         return ck::type_convert<ck::bhalf_t>(tmp);
     }
 };
@@ -87,11 +91,12 @@ struct GeneratorTensor_2<int8_t>
 {
     int min_value = 0;
     int max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    int8_t operator()(Is...)
+    int8_t operator()(Is... is) const
     {
-        return (std::rand() % (max_value - min_value)) + min_value;
+        return rng.UniformInt(min_value, max_value, is...);
     }
 };
 
@@ -101,11 +106,12 @@ struct GeneratorTensor_2<ck::f8_t>
 {
     int min_value = 0;
     int max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::f8_t operator()(Is...)
+    ck::f8_t operator()(Is... is) const
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = rng.UniformInt(min_value, max_value, is...);
         return ck::type_convert<ck::f8_t>(tmp);
     }
 };
@@ -117,26 +123,29 @@ struct GeneratorTensor_2<ck::bf8_t>
 {
     int min_value = 0;
     int max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::bf8_t operator()(Is...)
+    ck::bf8_t operator()(Is... is) const
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = rng.UniformInt(min_value, max_value, is...);
         return ck::type_convert<ck::bf8_t>(tmp);
     }
 };
 #endif
 
+// real values in [min_value, max_value), keyed by the multi-index of the element
 template <typename T>
 struct GeneratorTensor_3
 {
     float min_value = 0;
     float max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = rng.Uniform(is...);
 
         return static_cast<T>(min_value + tmp * (max_value - min_value));
     }
@@ -147,11 +156,12 @@ struct GeneratorTensor_3<ck::bhalf_t>
 {
     float min_value = 0;
     float max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::bhalf_t operator()(Is...)
+    ck::bhalf_t operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = rng.Uniform(is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -165,11 +175,12 @@ struct GeneratorTensor_3<ck::f8_t>
 {
     float min_value = 0;
     float max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::f8_t operator()(Is...)
+    ck::f8_t operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = rng.Uniform(is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -184,11 +195,12 @@ struct GeneratorTensor_3<ck::bf8_t>
 {
     float min_value = 0;
     float max_value = 1;
+    ck::host_common::HostRandomStream rng{};
 
     template <typename... Is>
-    ck::bf8_t operator()(Is...)
+    ck::bf8_t operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = rng.Uniform(is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -197,18 +209,20 @@ struct GeneratorTensor_3<ck::bf8_t>
 };
 #endif
 
+// normally distributed values, keyed by the multi-index of the element
 template <typename T>
 struct GeneratorTensor_4
 {
-    std::default_random_engine generator;
-    std::normal_distribution<float> distribution;
+    float mean;
+    float stddev;
+    ck::host_common::HostRandomStream rng{};
 
-    GeneratorTensor_4(float mean, float stddev) : generator(1), distribution(mean, stddev){};
+    GeneratorTensor_4(float mean_, float stddev_) : mean(mean_), stddev(stddev_){};
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is) const
     {
-        float tmp = distribution(generator);
+        float tmp = mean + stddev * rng.Normal(is...);
 
         return ck::type_convert<T>(tmp);
     }
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ck {
+namespace host_common {
+
+// Process-wide pool of host worker threads used by ParallelTensorFunctor and the CPU reference
+// operators. Workers are started lazily on the first parallel call and reused afterwards.
+//
+// A parallel loop over [0, size) is cut into chunks. Every participating thread owns a contiguous
+// range of chunks and, once it runs dry, steals half of the remaining range of another thread, so
+// skewed work (padding borders, ragged groups) does not leave threads idle at the tail.
+//
+// The number of threads defaults to std::thread::hardware_concurrency() and can be overridden by
+// the CK_HOST_NUM_THREADS environment variable or SetNumThreads().
+class HostThreadPool
+{
+    public:
+    static HostThreadPool& GetInstance();
+
+    HostThreadPool(const HostThreadPool&) = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    ~HostThreadPool();
+
+    // number of threads taking part in a parallel loop, including the calling thread
+    std::size_t GetNumThreads() const { return num_thread_; }
+
+    // throws when called from inside a parallel loop
+    void SetNumThreads(std::size_t num_thread);
+
+    // true on any thread currently executing a chunk of a parallel loop
+    static bool InParallelRegion() { return in_parallel_region_; }
+
+    // Call f(begin, end) on disjoint ranges covering [0, size) and wait for all of them.
+    // At most max_num_thread threads (0 means no limit) take part. grain is the chunk size,
+    // 0 picks one automatically. Nested calls from inside a parallel loop run on the calling
+    // thread. An exception thrown by f is rethrown to the caller.
+    template <typename F>
+    void ParallelFor(std::size_t size, F&& f, std::size_t max_num_thread = 0, std::size_t grain = 0)
+    {
+        if(size == 0)
+            return;
+
+        std::size_t num_participant = num_thread_.load();
+
+        if(max_num_thread != 0)
+            num_participant = std::min(num_participant, max_num_thread);
+
+        if(num_participant <= 1 || size == 1 || in_parallel_region_)
+        {
+            f(std::size_t{0}, size);
+            return;
+        }
+
+        if(grain == 0)
+            grain = std::max<std::size_t>(1, size / (num_participant * ChunksPerThread));
+
+        // chunk ids are packed into 32 bits, see Job::Range
+        grain = std::max(grain, (size + MaxNumChunk - 1) / MaxNumChunk);
+
+        Job job;
+
+        job.invoke = [](const void* p_f, std::size_t begin, std::size_t end) {
+            (*static_cast<const std::remove_reference_t<F>*>(p_f))(begin, end);
+        };
+        job.p_f             = &f;
+        job.size            = size;
+        job.grain           = grain;
+        job.num_chunk       = (size + grain - 1) / grain;
+        job.num_participant = std::min(num_participant, job.num_chunk);
+
+        Run(job);
+    }
+
+    private:
+    static constexpr std::size_t ChunksPerThread = 16;
+    static constexpr std::size_t MaxNumChunk     = std::size_t{0xffffffff};
+
+    struct Job
+    {
+        // [begin, end) of chunk ids owned by one participant, packed as end << 32 | begin so that
+        // the owner (taking from the front) and thieves (taking from the back) update it with a
+        // single compare-and-swap
+        struct alignas(64) Range
+        {
+            std::atomic<std::uint64_t> chunks{0};
+        };
+
+        void (*invoke)(const void*, std::size_t, std::size_t) = nullptr;
+        const void* p_f                                       = nullptr;
+
+        std::size_t size            = 0;
+        std::size_t grain           = 0;
+        std::size_t num_chunk       = 0;
+        std::size_t num_participant = 0;
+
+        std::vector<Range> ranges;
+
+        std::atomic<std::size_t> num_pending{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
+    };
+
+    HostThreadPool();
+
+    void Run(Job& job);
+    void RunParticipant(Job& job, std::size_t participant);
+    void StartWorkers();
+    void StopWorkers();
+    void WorkerLoop(std::size_t worker_id);
+
+    std::atomic<std::size_t> num_thread_;
+
+    // serializes top-level parallel loops and thread count changes
+    std::mutex submit_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable done_cv_;
+    Job* job_                  = nullptr;
+    std::uint64_t generation_  = 0;
+    bool stop_                 = false;
+    std::vector<std::thread> workers_;
+
+    static thread_local bool in_parallel_region_;
+};
+
+inline std::size_t get_host_num_threads()
+{
+    return HostThreadPool::GetInstance().GetNumThreads();
+}
+
+inline void set_host_num_threads(std::size_t num_thread)
+{
+    HostThreadPool::GetInstance().SetNumThreads(num_thread);
+}
+
+// Convenience wrapper over HostThreadPool::ParallelFor() calling f(i) for every i in [0, size)
+template <typename F>
+void host_parallel_for(std::size_t size, F&& f, std::size_t max_num_thread = 0)
+{
+    HostThreadPool::GetInstance().ParallelFor(
+        size,
+        [&f](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                f(i);
+        },
+        max_num_thread);
+}
+
+} // namespace host_common
+} // namespace ck
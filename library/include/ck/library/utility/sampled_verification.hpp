@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/span.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace utils {
+
+// How a device operation tiles its output, seen as a GEMM: the output dimensions m_dims, in that
+// order, form the M dimension, which is cut into tiles of m_per_block rows, and likewise for N.
+// Dimensions in neither list, e.g. the batch or group, are not tiled. A zero tile size leaves just
+// the first and last row (column).
+struct SampledVerificationTiling
+{
+    std::vector<std::size_t> m_dims;
+    std::vector<std::size_t> n_dims;
+    std::size_t m_per_block = 0;
+    std::size_t n_per_block = 0;
+};
+
+struct SampledVerificationConfig
+{
+    // output elements drawn uniformly at random, the basis of the error rate bounds
+    std::size_t num_samples = 16384;
+
+    // elements drawn from every row and column next to a tile boundary, 0 for the whole line
+    std::size_t num_boundary_samples = 64;
+
+    // of the error rate bounds
+    double confidence = 0.95;
+
+    // 0 for ck::host_common::get_host_random_seed()
+    uint64_t seed = 0;
+};
+
+// Output elements to verify: num_random uniformly drawn multi-indices, followed by the ones on
+// tile boundaries
+struct SampledIndices
+{
+    std::vector<std::vector<std::size_t>> indices;
+    std::size_t num_random = 0;
+};
+
+SampledIndices make_sampled_indices(const std::vector<std::size_t>& lengths,
+                                    const SampledVerificationTiling& tiling,
+                                    const SampledVerificationConfig& config = {});
+
+// Wilson score interval of an error rate estimated from err_count failures among num_checked
+// samples, at the given confidence
+std::pair<double, double>
+get_error_rate_bounds(std::size_t err_count, std::size_t num_checked, double confidence);
+
+// MPerBlock and NPerBlock from the type string of a device operation, which lists
+// <BlockSize, MPerBlock, NPerBlock, ...> first by convention; zeros if it does not
+std::array<std::size_t, 2> get_block_tile_lengths(const std::string& type_string);
+
+// Reference values of a sample of the output elements
+template <typename T>
+struct SampledReference
+{
+    SampledIndices samples;
+    std::vector<T> values;
+    double confidence;
+};
+
+// Compute the reference only at the sampled output elements, calling compute_element(index) for
+// every multi-index on the host thread pool. With point-wise evaluators, i.e. the ComputeElement()
+// of the reference operations, this costs O(samples x K) instead of O(M x N x K).
+template <typename T, typename F>
+SampledReference<T> compute_sampled_reference(const std::vector<std::size_t>& lengths,
+                                              const SampledVerificationTiling& tiling,
+                                              F&& compute_element,
+                                              const SampledVerificationConfig& config = {})
+{
+    SampledReference<T> ref{make_sampled_indices(lengths, tiling, config), {}, config.confidence};
+
+    const auto& indices = ref.samples.indices;
+
+    ref.values.resize(indices.size());
+
+    host_common::HostThreadPool::GetInstance().ParallelFor(
+        indices.size(), [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                ref.values[i] = compute_element(indices[i]);
+        });
+
+    return ref;
+}
+
+// Statistics of check_err_sampled_stats(), the error rate bounds are those of the uniform samples
+struct SampledCheckErrStats
+{
+    CheckErrStats random;
+    CheckErrStats boundary;
+    double confidence;
+    double err_rate_lower;
+    double err_rate_upper;
+
+    friend std::ostream& operator<<(std::ostream& os, const SampledCheckErrStats& stats)
+    {
+        return os << "random samples: {" << stats.random << "}, boundary samples: {"
+                  << stats.boundary << "}, error rate: [" << stats.err_rate_lower << ", "
+                  << stats.err_rate_upper << "] at " << stats.confidence * 100 << "% confidence";
+    }
+};
+
+// check_err_stats() of out at the sampled elements against their reference values; the mismatch
+// offsets index ref.samples.indices
+template <typename OutTensor, typename T>
+SampledCheckErrStats check_err_sampled_stats(const OutTensor& out,
+                                             const SampledReference<T>& ref,
+                                             double rtol,
+                                             double atol,
+                                             std::size_t max_report = 4)
+{
+    const auto& indices        = ref.samples.indices;
+    const std::size_t num_rand = ref.samples.num_random;
+
+    std::vector<T> values(indices.size());
+
+    for(std::size_t i = 0; i < indices.size(); ++i)
+        values[i] = out(indices[i]);
+
+    const auto get_stats = [&](std::size_t begin, std::size_t end) {
+        CheckErrStats stats =
+            check_err_stats(ck::span<const T>(values.data() + begin, end - begin),
+                            ck::span<const T>(ref.values.data() + begin, end - begin),
+                            rtol,
+                            atol,
+                            max_report);
+
+        for(auto& mismatch : stats.mismatches)
+            mismatch.offset += begin;
+
+        return stats;
+    };
+
+    SampledCheckErrStats stats{get_stats(0, num_rand),
+                               get_stats(num_rand, indices.size()),
+                               ref.confidence,
+                               0,
+                               0};
+
+    std::tie(stats.err_rate_lower, stats.err_rate_upper) =
+        get_error_rate_bounds(stats.random.err_count, stats.random.num_checked, ref.confidence);
+
+    return stats;
+}
+
+// Sampled counterpart of check_err(): compare out at the sampled elements, with the default
+// tolerances of check_err() for T, and print the first mismatches and the statistics on failure
+template <typename OutTensor, typename T>
+bool check_err_sampled(const OutTensor& out,
+                       const SampledReference<T>& ref,
+                       const std::string& msg = "Error: Incorrect results!",
+                       double rtol            = detail::CheckErrTraits<T>::DefaultRtol,
+                       double atol            = detail::CheckErrTraits<T>::DefaultAtol)
+{
+    const SampledCheckErrStats stats = check_err_sampled_stats(out, ref, rtol, atol);
+
+    if(stats.random.err_count == 0 && stats.boundary.err_count == 0)
+        return true;
+
+    for(const auto* partial : {&stats.random, &stats.boundary})
+    {
+        for(const auto& mismatch : partial->mismatches)
+        {
+            std::string index;
+
+            for(auto i : ref.samples.indices[mismatch.offset])
+                index += (index.empty() ? "" : ", ") + std::to_string(i);
+
+            std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << index
+                      << "] != ref[" << index << "]: " << mismatch.out << " != " << mismatch.ref
+                      << std::endl;
+        }
+    }
+
+    std::cerr << stats << std::endl;
+
+    return false;
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace utils {
+
+struct StreamingVerificationConfig
+{
+    // bound of each of the two slice buffers, the reference and the device readback
+    std::size_t max_slice_bytes = std::size_t{256} << 20;
+
+    // positions of the sliced dimension per slice, e.g. MPerBlock; 0 for as many as fit into
+    // max_slice_bytes
+    std::size_t slice_length = 0;
+};
+
+// How an output is cut into slices along dim, the outermost dimension in memory. Every slice of
+// length positions covers a contiguous range of the element space, slice_space_size elements for
+// a full one.
+struct StreamingSlicing
+{
+    std::size_t dim;
+    std::size_t length;
+    std::size_t stride;
+    std::size_t slice_space_size;
+};
+
+StreamingSlicing make_streaming_slicing(const HostTensorDescriptor& desc,
+                                        std::size_t element_bytes,
+                                        const StreamingVerificationConfig& config = {});
+
+// Reference of one slice of a streamed output computed element by element: ref(index) =
+// compute_element(index), with begin added to index[dim], for every multi-index of ref on the host
+// thread pool. A fallback for slices no packed host reference can compute.
+template <typename T, typename F>
+void compute_streaming_slice_elementwise(const TensorView<T>& ref,
+                                         std::size_t dim,
+                                         std::size_t begin,
+                                         F&& compute_element)
+{
+    const auto& lens = ref.GetLengths();
+
+    host_common::HostThreadPool::GetInstance().ParallelFor(
+        ref.GetElementSize(), [&](std::size_t element_begin, std::size_t element_end) {
+            std::vector<std::size_t> index(lens.size());
+
+            for(std::size_t i = element_begin; i < element_end; ++i)
+            {
+                // position in the slice, the last dimension varying fastest
+                for(std::size_t d = lens.size(), j = i; d-- > 0;)
+                {
+                    index[d] = j % lens[d];
+                    j /= lens[d];
+                }
+
+                const std::size_t offset = ref.mDesc.GetOffsetFromMultiIndex(index);
+
+                index[dim] += begin;
+
+                ref.mData[offset] = compute_element(index);
+            }
+        });
+}
+
+// Verify an output without holding it or its reference on the host: slice by slice, the
+// reference is computed by compute_slice(ref, dim, begin), which fills ref, a view of the
+// positions [begin, begin + ref.GetLengths()[dim]) of dimension dim, normally by running a packed
+// host reference on the matching slices of the operands. The matching part of the output is read
+// by fetch(T* p, offset, size), which copies size elements of the element space starting at
+// offset, and both are compared by check_err_stats(). Host memory is bounded by two slice
+// buffers. The mismatch offsets are offsets into the element space of desc.
+template <typename T, typename ComputeSlice, typename Fetch>
+CheckErrStats check_err_streaming_stats(const HostTensorDescriptor& desc,
+                                        ComputeSlice&& compute_slice,
+                                        Fetch&& fetch,
+                                        double rtol,
+                                        double atol,
+                                        const StreamingVerificationConfig& config = {},
+                                        std::size_t max_report                    = 4)
+{
+    CheckErrStats stats;
+
+    if(desc.GetElementSize() == 0)
+        return stats;
+
+    const StreamingSlicing slicing = make_streaming_slicing(desc, sizeof(T), config);
+
+    const auto& lens = desc.GetLengths();
+
+    std::vector<T> out_buf(slicing.slice_space_size);
+    std::vector<T> ref_buf(slicing.slice_space_size);
+
+    for(std::size_t begin = 0; begin < lens[slicing.dim]; begin += slicing.length)
+    {
+        const std::size_t end = std::min(begin + slicing.length, lens[slicing.dim]);
+
+        std::vector<std::size_t> slice_lens = lens;
+
+        slice_lens[slicing.dim] = end - begin;
+
+        const HostTensorDescriptor slice_desc(slice_lens, desc.GetStrides());
+
+        const std::size_t slice_offset = begin * slicing.stride;
+
+        fetch(out_buf.data(), slice_offset, slice_desc.GetElementSpaceSize());
+
+        compute_slice(TensorView<T>(ref_buf.data(), slice_desc), slicing.dim, begin);
+
+        CheckErrStats partial =
+            check_err_stats(TensorView<const T>(out_buf.data(), slice_desc),
+                            TensorView<const T>(ref_buf.data(), slice_desc),
+                            rtol,
+                            atol,
+                            max_report);
+
+        for(auto& mismatch : partial.mismatches)
+            mismatch.offset += slice_offset;
+
+        stats.Merge(partial, max_report);
+    }
+
+    return stats;
+}
+
+// Streaming counterpart of check_err(): print the first mismatches and the statistics on failure
+template <typename T, typename ComputeSlice, typename Fetch>
+bool check_err_streaming(const HostTensorDescriptor& desc,
+                         ComputeSlice&& compute_slice,
+                         Fetch&& fetch,
+                         const std::string& msg = "Error: Incorrect results!",
+                         double rtol            = detail::CheckErrTraits<T>::DefaultRtol,
+                         double atol            = detail::CheckErrTraits<T>::DefaultAtol)
+{
+    const CheckErrStats stats = check_err_streaming_stats<T>(
+        desc, std::forward<ComputeSlice>(compute_slice), std::forward<Fetch>(fetch), rtol, atol);
+
+    if(stats.err_count == 0)
+        return true;
+
+    for(const auto& mismatch : stats.mismatches)
+    {
+        std::string index;
+
+        for(auto i : desc.GetMultiIndexFromOffset(mismatch.offset))
+            index += (index.empty() ? "" : ", ") + std::to_string(i);
+
+        std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << index
+                  << "] != ref[" << index << "]: " << mismatch.out << " != " << mismatch.ref
+                  << std::endl;
+    }
+
+    std::cerr << stats << std::endl;
+
+    return false;
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ck/library/utility/convolution_parameter.hpp"
+
+namespace ck {
+namespace utils {
+
+// The problem an instance is tuned for: the signature of the device operation, see
+// get_device_op_signature(), the GPU architecture and the problem shape, e.g. {M, N, K}
+struct TuningKey
+{
+    std::string signature;
+    std::string arch;
+    std::vector<int64_t> shape;
+};
+
+struct TuningRecord
+{
+    TuningKey key;
+    // GetTypeIdHashCode() of the instance, and its GetTypeString() for the reader
+    std::string instance_type_id;
+    std::string instance_name;
+    float ave_time = 0;
+    float tflops   = 0;
+};
+
+// {G, N, K, C, filter, input, strides, dilations, left pads, right pads}
+std::vector<int64_t> get_tuning_shape(const conv::ConvParam& param);
+
+// Distance of shapes of the same rank: the sum over the dimensions of |log2(1 + x) - log2(1 + y)|,
+// so that doubling any dimension counts the same whatever its size.
+double get_tuning_shape_distance(const std::vector<int64_t>& x, const std::vector<int64_t>& y);
+
+// The fastest instance measured per problem, as written by ckProfiler --tuning-db, so that an
+// application gets a tuned instance without timing them all. A text file, one record per line:
+//
+//   ck_tuning_db <version>
+//   <signature> \t <arch> \t <shape> \t <instance type id> \t <ave_time> \t <tflops> \t <instance>
+//
+// with comma separated shapes. Not synchronized: populate it before sharing it between threads.
+class TuningDatabase
+{
+    public:
+    // bump it when the keys change meaning, files of other versions are rejected
+    static constexpr int Version = 2;
+
+    // the records of CK_TUNING_DB, loaded on first use, empty if it is unset
+    static TuningDatabase& GetInstance();
+
+    // adds the records of the file at path, replacing those with the same keys; does nothing if
+    // there is no such file, throws if it is malformed or of another version
+    void Load(const std::string& path);
+
+    // writes every record to path, replacing the file atomically; throws on failure
+    void Save(const std::string& path) const;
+
+    // replaces the record with the same key, if any
+    void Insert(const TuningRecord& record);
+
+    // the record of key, or else that of the nearest shape with the same signature, arch and rank;
+    // nullptr if there is none
+    const TuningRecord* Find(const TuningKey& key) const;
+
+    // the records with the signature, arch and rank of key, nearest shape first
+    std::vector<const TuningRecord*> FindCandidates(const TuningKey& key) const;
+
+    std::size_t GetSize() const { return mRecords.size(); }
+
+    void Clear() { mRecords.clear(); }
+
+    private:
+    using Key = std::tuple<std::string, std::string, std::vector<int64_t>>;
+
+    std::map<Key, TuningRecord> mRecords;
+};
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ck {
+namespace utils {
+
+// Runs verification tasks, the host reference and the comparisons of device results against it,
+// on a background thread in submission order, so that a profiler times the next instances
+// meanwhile. The tasks may use the host thread pool; the submitting thread should not while a
+// task runs, since top-level parallel loops are serialized.
+//
+// Tasks hold the device readback they compare, so memory grows with the queue: Submit() blocks
+// while the pending tasks account for more than max_pending_bytes, which defaults to
+// CK_VERIFY_QUEUE_SIZE_MB or 4 GB. A task failing with an exception cancels the ones after it.
+class VerificationPipeline
+{
+    public:
+    VerificationPipeline();
+
+    explicit VerificationPipeline(std::size_t max_pending_bytes);
+
+    VerificationPipeline(const VerificationPipeline&) = delete;
+    VerificationPipeline& operator=(const VerificationPipeline&) = delete;
+
+    // waits for the pending tasks, exceptions are dropped
+    ~VerificationPipeline();
+
+    // queue task, bytes being the memory it holds until it completes; the result of a
+    // comparison, false fails Wait()
+    void Submit(std::function<bool()> task, std::size_t bytes = 0);
+
+    // wait for all tasks submitted so far; true if they all returned true. Rethrows the exception
+    // of a failed task.
+    bool Wait();
+
+    private:
+    struct Task
+    {
+        std::function<bool()> run;
+        std::size_t bytes;
+    };
+
+    void WorkerLoop();
+
+    std::size_t max_pending_bytes_;
+
+    std::mutex mutex_;
+    std::condition_variable submit_cv_;
+    std::condition_variable worker_cv_;
+    std::condition_variable done_cv_;
+
+    std::deque<Task> tasks_;
+    std::size_t pending_bytes_ = 0;
+    std::size_t num_running_   = 0;
+    bool pass_                 = true;
+    bool stop_                 = false;
+    std::exception_ptr exception_;
+
+    std::thread worker_;
+};
+
+} // namespace utils
+} // namespace ck
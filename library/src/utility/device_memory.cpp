@@ -59,6 +59,17 @@ void DeviceMem::FromDevice(void* p, const std::size_t cpySize) const
     hip_check_error(hipMemcpy(p, mpDeviceBuf, cpySize, hipMemcpyDeviceToHost));
 }
 
+void DeviceMem::FromDevice(void* p, const std::size_t cpySize, const std::size_t offset) const
+{
+    if(offset + cpySize > mMemSize)
+    {
+        throw std::runtime_error("FromDevice out of range");
+    }
+
+    hip_check_error(hipMemcpy(
+        p, static_cast<const char*>(mpDeviceBuf) + offset, cpySize, hipMemcpyDeviceToHost));
+}
+
 void DeviceMem::SetZero() const
 {
     if(mpDeviceBuf)
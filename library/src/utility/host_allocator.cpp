@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+namespace {
+
+constexpr std::size_t PageSize = 4096;
+
+// below this, waking up the thread pool costs more than the initialization itself
+constexpr std::size_t MinParallelInitBytes = std::size_t{1} << 20;
+
+std::size_t round_up(std::size_t x, std::size_t alignment)
+{
+    return (x + alignment - 1) / alignment * alignment;
+}
+
+// large blocks are anonymous mappings of their own, which read as zero and go back to the system
+// on release
+bool is_mapped_allocation(std::size_t bytes)
+{
+#if defined(__linux__)
+    return bytes >= HostHugePageSize;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+void initialize_pages(unsigned char* p, std::size_t bytes, HostMemoryInit init)
+{
+    if(init == HostMemoryInit::Zero)
+    {
+        std::memset(p, 0, bytes);
+    }
+    else
+    {
+        for(std::size_t i = 0; i < bytes; i += PageSize)
+            p[i] = 0;
+    }
+}
+
+} // namespace
+
+void* allocate_host_memory(std::size_t bytes, std::size_t alignment)
+{
+#if defined(__linux__)
+    if(is_mapped_allocation(bytes))
+    {
+        // map one huge page more than needed and trim both ends to a huge page aligned block
+        const std::size_t size = round_up(bytes, HostHugePageSize);
+
+        void* p = mmap(nullptr,
+                       size + HostHugePageSize,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+
+        if(p == MAP_FAILED)
+            throw std::bad_alloc();
+
+        const auto begin   = reinterpret_cast<std::uintptr_t>(p);
+        const auto aligned = round_up(begin, HostHugePageSize);
+
+        if(aligned != begin)
+            munmap(p, aligned - begin);
+
+        munmap(reinterpret_cast<void*>(aligned + size), begin + HostHugePageSize - aligned);
+
+#if defined(MADV_HUGEPAGE)
+        // only a hint, the block is fine without huge pages
+        madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<void*>(aligned);
+    }
+#endif
+
+    // std::aligned_alloc wants a multiple of the alignment
+    void* p = std::aligned_alloc(alignment, round_up(std::max<std::size_t>(bytes, 1), alignment));
+
+    if(p == nullptr)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void free_host_memory(void* p, std::size_t bytes) noexcept
+{
+#if defined(__linux__)
+    if(is_mapped_allocation(bytes))
+    {
+        munmap(p, round_up(bytes, HostHugePageSize));
+        return;
+    }
+#endif
+
+    std::free(p);
+}
+
+void initialize_host_allocation(void* p, std::size_t bytes, HostMemoryInit init)
+{
+    if(init == HostMemoryInit::None || bytes == 0)
+        return;
+
+    if(init == HostMemoryInit::Zero && is_mapped_allocation(bytes))
+        return;
+
+    auto* first = static_cast<unsigned char*>(p);
+
+    if(bytes < MinParallelInitBytes)
+    {
+        initialize_pages(first, bytes, init);
+        return;
+    }
+
+    const std::size_t num_page = (bytes + PageSize - 1) / PageSize;
+
+    HostThreadPool::GetInstance().ParallelFor(num_page, [&](std::size_t begin, std::size_t end) {
+        const std::size_t offset = begin * PageSize;
+
+        initialize_pages(first + offset, std::min(end * PageSize, bytes) - offset, init);
+    });
+}
+
+} // namespace host_common
+} // namespace ck
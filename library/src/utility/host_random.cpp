@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#include "ck/library/utility/host_random.hpp"
+
+namespace ck {
+namespace host_common {
+
+namespace {
+
+std::uint64_t get_default_seed()
+{
+    if(const char* env = std::getenv("CK_HOST_RANDOM_SEED"))
+    {
+        try
+        {
+            return std::stoull(env);
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+
+    return 11939;
+}
+
+std::atomic<std::uint64_t>& host_random_seed()
+{
+    static std::atomic<std::uint64_t> seed{get_default_seed()};
+
+    return seed;
+}
+
+std::atomic<std::uint64_t>& host_random_stream()
+{
+    static std::atomic<std::uint64_t> stream{0};
+
+    return stream;
+}
+
+} // namespace
+
+std::uint64_t get_host_random_seed() { return host_random_seed().load(); }
+
+void set_host_random_seed(std::uint64_t seed)
+{
+    host_random_seed() = seed;
+
+    reset_host_random_streams();
+}
+
+void reset_host_random_streams() { host_random_stream() = 0; }
+
+std::uint64_t next_host_random_stream() { return host_random_stream()++; }
+
+} // namespace host_common
+} // namespace ck
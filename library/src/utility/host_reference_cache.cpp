@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#include "ck/library/utility/host_reference_cache.hpp"
+
+namespace ck {
+namespace host_common {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// part of every key, bump it when a reference implementation changes its results
+constexpr uint64_t HostReferenceCacheVersion = 1;
+
+constexpr std::size_t KeyChunkSize = std::size_t{1} << 20;
+
+constexpr const char* EntryExtension = ".ckt";
+
+std::size_t get_default_capacity()
+{
+    if(const char* env = std::getenv("CK_REFERENCE_CACHE_SIZE_MB"))
+    {
+        try
+        {
+            return static_cast<std::size_t>(std::stoull(env)) << 20;
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+
+    return std::size_t{8192} << 20;
+}
+
+uint64_t mix(uint64_t h, uint64_t w, uint64_t multiplier)
+{
+    h = (h ^ w) * multiplier;
+    return h ^ (h >> 31);
+}
+
+// remove the least recently used entries until the cache fits into capacity bytes
+void evict(const fs::path& directory, std::size_t capacity)
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        std::uintmax_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+
+    for(const auto& item : fs::directory_iterator(directory, ec))
+    {
+        if(item.path().extension() != EntryExtension)
+            continue;
+
+        const auto size = item.file_size(ec);
+        const auto time = item.last_write_time(ec);
+
+        if(!ec)
+        {
+            entries.push_back({item.path(), time, size});
+            total += size;
+        }
+    }
+
+    if(total <= capacity)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.time < b.time;
+    });
+
+    for(const auto& entry : entries)
+    {
+        if(total <= capacity)
+            break;
+
+        if(fs::remove(entry.path, ec))
+            total -= entry.size;
+    }
+}
+
+} // namespace
+
+HostReferenceCacheKey::HostReferenceCacheKey(const std::string& op_name)
+    : mDigest{HostReferenceCacheVersion, ~HostReferenceCacheVersion}
+{
+    Add(op_name);
+}
+
+HostReferenceCacheKey& HostReferenceCacheKey::AddBytes(const void* data, std::size_t bytes)
+{
+    mDigest[0] = mix(mDigest[0], bytes, 0x9E3779B97F4A7C15);
+    mDigest[1] = mix(mDigest[1], bytes, 0xC2B2AE3D27D4EB4F);
+
+    if(bytes == 0)
+        return *this;
+
+    for(uint64_t checksum : compute_host_chunk_checksums(data, bytes, KeyChunkSize))
+    {
+        mDigest[0] = mix(mDigest[0], checksum, 0x9E3779B97F4A7C15);
+        mDigest[1] = mix(mDigest[1], checksum, 0xC2B2AE3D27D4EB4F);
+    }
+
+    return *this;
+}
+
+HostReferenceCacheKey& HostReferenceCacheKey::Add(const std::string& str)
+{
+    return AddBytes(str.data(), str.size());
+}
+
+HostReferenceCacheKey& HostReferenceCacheKey::Add(const HostTensorDescriptor& desc)
+{
+    Add(desc.GetLengths());
+
+    return Add(desc.GetStrides());
+}
+
+std::string HostReferenceCacheKey::ToString() const
+{
+    constexpr char Digits[] = "0123456789abcdef";
+
+    std::string str;
+
+    for(uint64_t h : mDigest)
+        for(int shift = 60; shift >= 0; shift -= 4)
+            str += Digits[(h >> shift) & 0xf];
+
+    return str;
+}
+
+HostReferenceCache::HostReferenceCache() : mCapacity(get_default_capacity())
+{
+    if(const char* env = std::getenv("CK_REFERENCE_CACHE_DIR"))
+        mDirectory = env;
+}
+
+HostReferenceCache& HostReferenceCache::GetInstance()
+{
+    static HostReferenceCache cache;
+
+    return cache;
+}
+
+std::shared_ptr<const HostTensorFile> HostReferenceCache::Find(const std::string& key) const
+{
+    if(!IsEnabled())
+        return nullptr;
+
+    const fs::path path = fs::path(mDirectory) / (key + EntryExtension);
+
+    std::error_code ec;
+
+    if(!fs::exists(path, ec))
+        return nullptr;
+
+    try
+    {
+        auto file = std::make_shared<const HostTensorFile>(path.string());
+
+        if(file->VerifyChecksums())
+        {
+            // the modification time orders the entries for eviction
+            fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+            return file;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "reference cache: " << e.what() << std::endl;
+    }
+
+    fs::remove(path, ec);
+
+    return nullptr;
+}
+
+void HostReferenceCache::Insert(const std::string& key,
+                                HostTensorDataType data_type,
+                                const std::vector<std::size_t>& lens,
+                                const std::vector<std::size_t>& strides,
+                                const void* data) const
+{
+    if(!IsEnabled())
+        return;
+
+    const HostTensorDescriptor desc(lens, strides);
+
+    if(desc.GetElementSpaceSize() * get_host_tensor_data_type_size(data_type) > mCapacity)
+        return;
+
+    const fs::path directory = mDirectory;
+    const fs::path path      = directory / (key + EntryExtension);
+
+    // written under a name of its own and renamed, so that concurrent runs never see a partial
+    // entry
+    const auto stamp         = std::chrono::steady_clock::now().time_since_epoch().count();
+    const fs::path temp_path = directory / (key + ".tmp" + std::to_string(stamp));
+
+    std::error_code ec;
+
+    try
+    {
+        fs::create_directories(directory);
+
+        save_host_tensor_file(temp_path.string(), data_type, lens, strides, data);
+
+        fs::rename(temp_path, path);
+
+        // same clock as the updates on lookup, file systems stamp new files with a coarser one
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+        evict(directory, mCapacity);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "reference cache: " << e.what() << std::endl;
+
+        fs::remove(temp_path, ec);
+    }
+}
+
+} // namespace host_common
+} // namespace ck
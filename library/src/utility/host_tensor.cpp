@@ -43,6 +43,43 @@ const std::vector<std::size_t>& HostTensorDescriptor::GetLengths() const { retur
 
 const std::vector<std::size_t>& HostTensorDescriptor::GetStrides() const { return mStrides; }
 
+std::vector<std::size_t> HostTensorDescriptor::GetTraversalOrder() const
+{
+    assert(mLens.size() == mStrides.size());
+
+    std::vector<std::size_t> order(mLens.size());
+
+    std::iota(order.begin(), order.end(), std::size_t{0});
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        const bool a_is_one = mLens[a] == 1;
+        const bool b_is_one = mLens[b] == 1;
+
+        if(a_is_one || b_is_one)
+            return a_is_one && !b_is_one;
+
+        return mStrides[a] > mStrides[b];
+    });
+
+    return order;
+}
+
+std::vector<std::size_t> HostTensorDescriptor::GetMultiIndexFromOffset(std::size_t offset) const
+{
+    std::vector<std::size_t> index(mLens.size(), 0);
+
+    for(std::size_t dim : GetTraversalOrder())
+    {
+        if(mLens[dim] == 1 || mStrides[dim] == 0)
+            continue;
+
+        index[dim] = std::min(offset / mStrides[dim], mLens[dim] - 1);
+        offset -= index[dim] * mStrides[dim];
+    }
+
+    return index;
+}
+
 std::ostream& operator<<(std::ostream& os, const HostTensorDescriptor& desc)
 {
     os << "dim " << desc.GetNumOfDimension() << ", ";
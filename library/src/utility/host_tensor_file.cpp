@@ -0,0 +1,598 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_file.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+namespace {
+
+// Native files are little-endian, like every host CK runs on:
+//   NativeHeader
+//   lengths, strides and chunk checksums, uint64_t each
+//   zero padding up to payload_offset, a multiple of PayloadAlignment
+//   the element space
+constexpr char NativeMagic[8]           = {'C', 'K', 'T', 'E', 'N', 'S', 'O', 'R'};
+constexpr uint32_t NativeVersion        = 1;
+constexpr std::size_t PayloadAlignment  = 4096;
+constexpr std::size_t MaxNumDim         = 64;
+constexpr char NpyMagic[6]              = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+constexpr std::size_t NpyFixedHeaderLen = 10;
+
+struct NativeHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t data_type;
+    uint64_t num_dim;
+    uint64_t payload_offset;
+    uint64_t payload_size;
+    uint64_t checksum_chunk_size;
+    uint64_t num_checksum;
+};
+
+static_assert(sizeof(NativeHeader) == 56, "NativeHeader must not have padding");
+
+struct DataTypeInfo
+{
+    HostTensorDataType data_type;
+    std::size_t size;
+    const char* name;
+    const char* npy_descr; // nullptr if NumPy has no such type
+};
+
+constexpr DataTypeInfo DataTypeInfos[] = {
+    {HostTensorDataType::F32, 4, "f32", "<f4"},
+    {HostTensorDataType::F64, 8, "f64", "<f8"},
+    {HostTensorDataType::F16, 2, "f16", "<f2"},
+    {HostTensorDataType::BF16, 2, "bf16", "<u2"},
+    {HostTensorDataType::F8, 1, "f8", nullptr},
+    {HostTensorDataType::BF8, 1, "bf8", nullptr},
+    {HostTensorDataType::I8, 1, "i8", "|i1"},
+    {HostTensorDataType::U8, 1, "u8", "|u1"},
+    {HostTensorDataType::I32, 4, "i32", "<i4"},
+    {HostTensorDataType::I64, 8, "i64", "<i8"},
+    {HostTensorDataType::Int4, 1, "int4", nullptr},
+};
+
+const DataTypeInfo* find_data_type_info(HostTensorDataType data_type)
+{
+    for(const auto& info : DataTypeInfos)
+        if(info.data_type == data_type)
+            return &info;
+
+    return nullptr;
+}
+
+std::size_t round_up(std::size_t x, std::size_t alignment)
+{
+    return (x + alignment - 1) / alignment * alignment;
+}
+
+std::size_t get_element_space_size(const std::vector<std::size_t>& lens,
+                                   const std::vector<std::size_t>& strides)
+{
+    const HostTensorDescriptor desc(lens, strides);
+
+    return desc.GetElementSize() == 0 ? 0 : desc.GetElementSpaceSize();
+}
+
+// Four independent multiply-xorshift lanes over 64-bit words, fast enough to keep up with the
+// memory bandwidth of one core
+uint64_t compute_checksum(const unsigned char* p, std::size_t bytes)
+{
+    constexpr uint64_t Prime = 0x9E3779B97F4A7C15;
+
+    uint64_t lanes[4] = {bytes, 1, 2, 3};
+
+    auto mix = [](uint64_t h, uint64_t w) {
+        h = (h ^ w) * Prime;
+        return h ^ (h >> 29);
+    };
+
+    std::size_t i = 0;
+
+    for(; i + 32 <= bytes; i += 32)
+    {
+        for(int l = 0; l < 4; ++l)
+        {
+            uint64_t w;
+
+            std::memcpy(&w, p + i + 8 * l, sizeof(w));
+
+            lanes[l] = mix(lanes[l], w);
+        }
+    }
+
+    uint64_t h = lanes[0];
+
+    for(int l = 1; l < 4; ++l)
+        h = mix(h, lanes[l]);
+
+    for(; i < bytes; ++i)
+        h = mix(h, p[i]);
+
+    return h;
+}
+
+template <typename Word>
+void gather_packed(unsigned char* dst,
+                   const unsigned char* src,
+                   const HostTensorDescriptor& dst_desc,
+                   const HostTensorDescriptor& src_desc)
+{
+    make_host_tensor_traversal(dst_desc, src_desc)(
+        [&](const auto& offsets) {
+            std::memcpy(dst + offsets[0] * sizeof(Word),
+                        src + offsets[1] * sizeof(Word),
+                        sizeof(Word));
+        },
+        0);
+}
+
+void write_file(const std::string& path,
+                const std::vector<char>& header,
+                const void* payload,
+                std::size_t payload_size)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    file.write(header.data(), header.size());
+    file.write(static_cast<const char*>(payload), payload_size);
+    file.close();
+
+    if(!file)
+        throw std::runtime_error("wrong! cannot write tensor file " + path);
+}
+
+void save_native(const std::string& path,
+                 const DataTypeInfo& info,
+                 const std::vector<std::size_t>& lens,
+                 const std::vector<std::size_t>& strides,
+                 const void* data,
+                 std::size_t checksum_chunk_size)
+{
+    const std::size_t payload_size = get_element_space_size(lens, strides) * info.size;
+
+    std::vector<uint64_t> checksums;
+
+    if(checksum_chunk_size != 0)
+        checksums = compute_host_chunk_checksums(data, payload_size, checksum_chunk_size);
+
+    std::vector<uint64_t> tail;
+
+    tail.insert(tail.end(), lens.begin(), lens.end());
+    tail.insert(tail.end(), strides.begin(), strides.end());
+    tail.insert(tail.end(), checksums.begin(), checksums.end());
+
+    NativeHeader header{};
+
+    std::memcpy(header.magic, NativeMagic, sizeof(NativeMagic));
+    header.version             = NativeVersion;
+    header.data_type           = static_cast<uint32_t>(info.data_type);
+    header.num_dim             = lens.size();
+    header.payload_offset      = round_up(sizeof(header) + tail.size() * 8, PayloadAlignment);
+    header.payload_size        = payload_size;
+    header.checksum_chunk_size = checksum_chunk_size;
+    header.num_checksum        = checksums.size();
+
+    std::vector<char> bytes(header.payload_offset, 0);
+
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), tail.data(), tail.size() * 8);
+
+    write_file(path, bytes, data, payload_size);
+}
+
+void save_npy(const std::string& path,
+              const DataTypeInfo& info,
+              const std::vector<std::size_t>& lens,
+              const std::vector<std::size_t>& strides,
+              const void* data)
+{
+    if(info.npy_descr == nullptr)
+        throw std::runtime_error(std::string("wrong! .npy has no equivalent of ") + info.name);
+
+    std::string shape;
+
+    for(std::size_t len : lens)
+        shape += std::to_string(len) + ", ";
+
+    // "(2, 3)", "(5,)" or "()"
+    if(!shape.empty())
+        shape.erase(shape.size() - (lens.size() == 1 ? 1 : 2));
+
+    std::string dict = std::string("{'descr': '") + info.npy_descr +
+                       "', 'fortran_order': False, 'shape': (" + shape + "), }";
+
+    // pad with spaces so that the payload starts at a page boundary
+    const std::size_t header_len =
+        round_up(NpyFixedHeaderLen + dict.size() + 1, PayloadAlignment) - NpyFixedHeaderLen;
+
+    if(header_len > 0xffff)
+        throw std::runtime_error("wrong! too many dimensions for .npy");
+
+    dict.resize(header_len - 1, ' ');
+    dict += '\n';
+
+    std::vector<char> bytes(NpyMagic, NpyMagic + sizeof(NpyMagic));
+
+    bytes.push_back(1); // version 1.0
+    bytes.push_back(0);
+    bytes.push_back(static_cast<char>(header_len & 0xff));
+    bytes.push_back(static_cast<char>(header_len >> 8));
+    bytes.insert(bytes.end(), dict.begin(), dict.end());
+
+    const HostTensorDescriptor src_desc(lens, strides);
+    const HostTensorDescriptor dst_desc(lens);
+
+    const std::size_t payload_size = dst_desc.GetElementSize() * info.size;
+
+    if(src_desc.GetStrides() == dst_desc.GetStrides())
+    {
+        write_file(path, bytes, data, payload_size);
+        return;
+    }
+
+    std::vector<unsigned char> packed(payload_size);
+
+    const auto* src = static_cast<const unsigned char*>(data);
+
+    switch(info.size)
+    {
+    case 1: gather_packed<uint8_t>(packed.data(), src, dst_desc, src_desc); break;
+    case 2: gather_packed<uint16_t>(packed.data(), src, dst_desc, src_desc); break;
+    case 4: gather_packed<uint32_t>(packed.data(), src, dst_desc, src_desc); break;
+    default: gather_packed<uint64_t>(packed.data(), src, dst_desc, src_desc); break;
+    }
+
+    write_file(path, bytes, packed.data(), payload_size);
+}
+
+struct ParsedHeader
+{
+    HostTensorDataType data_type;
+    std::vector<std::size_t> lens;
+    std::vector<std::size_t> strides;
+    std::size_t payload_offset;
+    std::size_t checksum_chunk_size = 0;
+    std::vector<uint64_t> checksums;
+};
+
+ParsedHeader parse_native_header(const unsigned char* p, std::size_t size)
+{
+    NativeHeader header;
+
+    std::memcpy(&header, p, sizeof(header));
+
+    if(header.version != NativeVersion)
+        throw std::runtime_error("unsupported version " + std::to_string(header.version));
+
+    const auto* info = find_data_type_info(static_cast<HostTensorDataType>(header.data_type));
+
+    if(info == nullptr)
+        throw std::runtime_error("unknown data type " + std::to_string(header.data_type));
+
+    if(header.num_dim > MaxNumDim || header.num_checksum > size / 8 ||
+       sizeof(header) + (2 * header.num_dim + header.num_checksum) * 8 > header.payload_offset ||
+       header.payload_offset > size || header.payload_size > size - header.payload_offset)
+        throw std::runtime_error("truncated file");
+
+    ParsedHeader parsed;
+
+    const auto* tail = p + sizeof(header);
+
+    parsed.data_type = info->data_type;
+    parsed.lens.resize(header.num_dim);
+    parsed.strides.resize(header.num_dim);
+    parsed.checksums.resize(header.num_checksum);
+
+    for(std::size_t d = 0; d < header.num_dim; ++d)
+    {
+        uint64_t len;
+        uint64_t stride;
+
+        std::memcpy(&len, tail + 8 * d, 8);
+        std::memcpy(&stride, tail + 8 * (header.num_dim + d), 8);
+
+        parsed.lens[d]    = len;
+        parsed.strides[d] = stride;
+    }
+
+    std::memcpy(parsed.checksums.data(), tail + 16 * header.num_dim, 8 * header.num_checksum);
+
+    parsed.payload_offset      = header.payload_offset;
+    parsed.checksum_chunk_size = header.checksum_chunk_size;
+
+    if(get_element_space_size(parsed.lens, parsed.strides) * info->size != header.payload_size)
+        throw std::runtime_error("payload does not match the lengths and strides");
+
+    if(!parsed.checksums.empty() &&
+       (parsed.checksum_chunk_size == 0 ||
+        (header.payload_size + parsed.checksum_chunk_size - 1) / parsed.checksum_chunk_size !=
+            parsed.checksums.size()))
+        throw std::runtime_error("inconsistent checksums");
+
+    return parsed;
+}
+
+// value of 'key': in the header dictionary, up to the next ',' or the closing ')' of a tuple
+std::string find_npy_value(const std::string& dict, const std::string& key)
+{
+    const std::size_t pos = dict.find("'" + key + "':");
+
+    if(pos == std::string::npos)
+        throw std::runtime_error("missing " + key);
+
+    const std::size_t begin = dict.find_first_not_of(' ', pos + key.size() + 3);
+
+    if(begin == std::string::npos)
+        throw std::runtime_error("malformed " + key);
+
+    const bool is_tuple   = dict[begin] == '(';
+    const std::size_t end = is_tuple ? dict.find(')', begin) : dict.find_first_of(",}", begin);
+
+    if(end == std::string::npos)
+        throw std::runtime_error("malformed " + key);
+
+    std::string value = dict.substr(begin, end - begin + (is_tuple ? 1 : 0));
+
+    value.erase(value.find_last_not_of(' ') + 1);
+
+    return value;
+}
+
+ParsedHeader parse_npy_header(const unsigned char* p, std::size_t size)
+{
+    const int major = p[6];
+
+    std::size_t begin;
+    std::size_t header_len;
+
+    if(major == 1)
+    {
+        begin      = NpyFixedHeaderLen;
+        header_len = p[8] | (std::size_t{p[9]} << 8);
+    }
+    else if(major == 2 || major == 3)
+    {
+        begin      = NpyFixedHeaderLen + 2;
+        header_len = p[8] | (std::size_t{p[9]} << 8) | (std::size_t{p[10]} << 16) |
+                     (std::size_t{p[11]} << 24);
+    }
+    else
+    {
+        throw std::runtime_error("unsupported .npy version " + std::to_string(major));
+    }
+
+    if(begin + header_len > size)
+        throw std::runtime_error("truncated file");
+
+    const std::string dict(reinterpret_cast<const char*>(p) + begin, header_len);
+
+    ParsedHeader parsed;
+
+    const std::string descr = find_npy_value(dict, "descr");
+    const DataTypeInfo* info = nullptr;
+
+    for(const auto& i : DataTypeInfos)
+        if(i.npy_descr != nullptr && descr == std::string("'") + i.npy_descr + "'")
+            info = &i;
+
+    if(info == nullptr)
+        throw std::runtime_error("unsupported descr " + descr);
+
+    const std::string shape = find_npy_value(dict, "shape");
+
+    for(std::size_t i = 1; i < shape.size();)
+    {
+        const std::size_t end = shape.find_first_of(",)", i);
+
+        if(end == std::string::npos)
+            break;
+
+        if(end > i && shape.find_first_not_of(' ', i) < end)
+            parsed.lens.push_back(std::stoull(shape.substr(i, end - i)));
+
+        i = end + 1;
+    }
+
+    const bool is_fortran_order = find_npy_value(dict, "fortran_order") == "True";
+
+    parsed.data_type = info->data_type;
+    parsed.strides.resize(parsed.lens.size());
+
+    std::size_t stride = 1;
+
+    for(std::size_t i = 0; i < parsed.lens.size(); ++i)
+    {
+        const std::size_t d = is_fortran_order ? i : parsed.lens.size() - 1 - i;
+
+        parsed.strides[d] = stride;
+        stride *= parsed.lens[d];
+    }
+
+    parsed.payload_offset = begin + header_len;
+
+    if(parsed.payload_offset % info->size != 0)
+        throw std::runtime_error("misaligned payload");
+
+    if(get_element_space_size(parsed.lens, parsed.strides) * info->size >
+       size - parsed.payload_offset)
+        throw std::runtime_error("truncated file");
+
+    return parsed;
+}
+
+void release_file_data(void* p, std::size_t size)
+{
+#if defined(__unix__)
+    munmap(p, size);
+#else
+    free_host_memory(p, size);
+#endif
+}
+
+} // namespace
+
+std::size_t get_host_tensor_data_type_size(HostTensorDataType data_type)
+{
+    const auto* info = find_data_type_info(data_type);
+
+    return info == nullptr ? 0 : info->size;
+}
+
+const char* get_host_tensor_data_type_name(HostTensorDataType data_type)
+{
+    const auto* info = find_data_type_info(data_type);
+
+    return info == nullptr ? "unknown" : info->name;
+}
+
+std::vector<uint64_t>
+compute_host_chunk_checksums(const void* data, std::size_t bytes, std::size_t chunk_size)
+{
+    const auto* p               = static_cast<const unsigned char*>(data);
+    const std::size_t num_chunk = (bytes + chunk_size - 1) / chunk_size;
+    std::vector<uint64_t> result(num_chunk);
+
+    HostThreadPool::GetInstance().ParallelFor(num_chunk, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t c = begin; c < end; ++c)
+        {
+            const std::size_t offset = c * chunk_size;
+
+            result[c] = compute_checksum(p + offset, std::min(chunk_size, bytes - offset));
+        }
+    });
+
+    return result;
+}
+
+void save_host_tensor_file(const std::string& path,
+                           HostTensorDataType data_type,
+                           const std::vector<std::size_t>& lens,
+                           const std::vector<std::size_t>& strides,
+                           const void* data,
+                           const HostTensorFileOptions& options)
+{
+    const auto* info = find_data_type_info(data_type);
+
+    if(info == nullptr)
+        throw std::runtime_error("wrong! tensor files do not support this data type");
+
+    if(lens.size() != strides.size() || lens.size() > MaxNumDim)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    const bool is_npy = options.format == HostTensorFileFormat::Npy ||
+                        (options.format == HostTensorFileFormat::Auto && path.size() >= 4 &&
+                         path.compare(path.size() - 4, 4, ".npy") == 0);
+
+    if(is_npy)
+        save_npy(path, *info, lens, strides, data);
+    else
+        save_native(path, *info, lens, strides, data, options.checksum_chunk_size);
+}
+
+HostTensorFile::HostTensorFile(const std::string& path)
+{
+#if defined(__unix__)
+    const int fd = open(path.c_str(), O_RDONLY);
+
+    if(fd < 0)
+        throw std::runtime_error("wrong! cannot open tensor file " + path);
+
+    struct stat st;
+
+    if(fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        throw std::runtime_error("wrong! empty tensor file " + path);
+    }
+
+    mMappingSize = static_cast<std::size_t>(st.st_size);
+
+    // private and writable: the views of the payload may be modified without touching the file
+    void* p = mmap(nullptr, mMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if(p == MAP_FAILED)
+        throw std::runtime_error("wrong! cannot map tensor file " + path);
+
+    mpMapping = p;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if(!file || file.tellg() <= 0)
+        throw std::runtime_error("wrong! cannot open tensor file " + path);
+
+    mMappingSize = static_cast<std::size_t>(file.tellg());
+    mpMapping    = allocate_host_memory(mMappingSize, PayloadAlignment);
+
+    file.seekg(0);
+    file.read(static_cast<char*>(mpMapping), mMappingSize);
+
+    if(!file)
+    {
+        free_host_memory(mpMapping, mMappingSize);
+        throw std::runtime_error("wrong! cannot read tensor file " + path);
+    }
+#endif
+
+    try
+    {
+        const auto* bytes = static_cast<const unsigned char*>(mpMapping);
+
+        ParsedHeader parsed;
+
+        if(mMappingSize >= sizeof(NativeHeader) &&
+           std::memcmp(bytes, NativeMagic, sizeof(NativeMagic)) == 0)
+            parsed = parse_native_header(bytes, mMappingSize);
+        else if(mMappingSize >= NpyFixedHeaderLen + 2 &&
+                std::memcmp(bytes, NpyMagic, sizeof(NpyMagic)) == 0)
+            parsed = parse_npy_header(bytes, mMappingSize);
+        else
+            throw std::runtime_error("not a tensor file");
+
+        mDataType = parsed.data_type;
+        mLens     = std::move(parsed.lens);
+        mStrides  = std::move(parsed.strides);
+        mpData    = static_cast<unsigned char*>(mpMapping) + parsed.payload_offset;
+        mDataSize =
+            get_element_space_size(mLens, mStrides) * get_host_tensor_data_type_size(mDataType);
+        mChecksumChunkSize = parsed.checksum_chunk_size;
+        mChecksums         = std::move(parsed.checksums);
+    }
+    catch(const std::exception& e)
+    {
+        release_file_data(mpMapping, mMappingSize);
+        throw std::runtime_error("wrong! bad tensor file " + path + ": " + e.what());
+    }
+}
+
+HostTensorFile::~HostTensorFile() { release_file_data(mpMapping, mMappingSize); }
+
+bool HostTensorFile::VerifyChecksums() const
+{
+    return mChecksums.empty() ||
+           compute_host_chunk_checksums(mpData, mDataSize, mChecksumChunkSize) == mChecksums;
+}
+
+} // namespace host_common
+} // namespace ck
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace host_common {
+
+namespace {
+
+std::uint64_t make_chunk_range(std::uint64_t begin, std::uint64_t end)
+{
+    return (end << 32) | begin;
+}
+
+std::uint64_t chunk_range_begin(std::uint64_t range) { return range & 0xffffffff; }
+
+std::uint64_t chunk_range_end(std::uint64_t range) { return range >> 32; }
+
+std::size_t get_default_num_threads()
+{
+    if(const char* env = std::getenv("CK_HOST_NUM_THREADS"))
+    {
+        try
+        {
+            const long num_thread = std::stol(env);
+
+            if(num_thread > 0)
+                return static_cast<std::size_t>(num_thread);
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+thread_local bool HostThreadPool::in_parallel_region_ = false;
+
+HostThreadPool& HostThreadPool::GetInstance()
+{
+    static HostThreadPool pool;
+
+    return pool;
+}
+
+HostThreadPool::HostThreadPool() : num_thread_(get_default_num_threads()) {}
+
+HostThreadPool::~HostThreadPool() { StopWorkers(); }
+
+void HostThreadPool::SetNumThreads(std::size_t num_thread)
+{
+    // the submitting thread holds submit_mutex_ and a worker would have to join itself
+    if(InParallelRegion())
+        throw std::runtime_error("wrong! cannot change the number of threads in a parallel loop");
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    if(num_thread == num_thread_)
+        return;
+
+    StopWorkers();
+
+    num_thread_ = num_thread;
+}
+
+void HostThreadPool::StartWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+    }
+
+    // the thread submitting a loop is participant 0, workers are 1 .. num_thread_ - 1
+    for(std::size_t i = 1; i < num_thread_; ++i)
+        workers_.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+void HostThreadPool::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    job_cv_.notify_all();
+
+    for(auto& worker : workers_)
+        worker.join();
+
+    workers_.clear();
+}
+
+void HostThreadPool::WorkerLoop(std::size_t worker_id)
+{
+    std::uint64_t seen_generation = 0;
+
+    for(;;)
+    {
+        Job* job = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            job_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+
+            if(stop_)
+                return;
+
+            seen_generation = generation_;
+
+            if(job_ != nullptr && worker_id < job_->num_participant)
+                job = job_;
+        }
+
+        if(job == nullptr)
+            continue;
+
+        RunParticipant(*job, worker_id);
+
+        if(job->num_pending.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_cv_.notify_all();
+        }
+    }
+}
+
+void HostThreadPool::Run(Job& job)
+{
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+    if(workers_.empty())
+        StartWorkers();
+
+    job.num_participant = std::min(job.num_participant, num_thread_.load());
+
+    // initial static split, rebalanced by stealing
+    job.ranges = std::vector<Job::Range>(job.num_participant);
+
+    for(std::size_t p = 0; p < job.num_participant; ++p)
+    {
+        const std::size_t begin = job.num_chunk * p / job.num_participant;
+        const std::size_t end   = job.num_chunk * (p + 1) / job.num_participant;
+
+        job.ranges[p].chunks.store(make_chunk_range(begin, end), std::memory_order_relaxed);
+    }
+
+    job.num_pending.store(job.num_participant - 1);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        ++generation_;
+    }
+
+    job_cv_.notify_all();
+
+    RunParticipant(job, 0);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        done_cv_.wait(lock, [&] { return job.num_pending.load() == 0; });
+
+        job_ = nullptr;
+    }
+
+    if(job.exception)
+        std::rethrow_exception(job.exception);
+}
+
+void HostThreadPool::RunParticipant(Job& job, std::size_t participant)
+{
+    auto& own = job.ranges[participant].chunks;
+
+    // take one chunk from the front of the own range
+    auto pop_front = [&](std::size_t& chunk) {
+        std::uint64_t range = own.load();
+
+        for(;;)
+        {
+            const std::uint64_t begin = chunk_range_begin(range);
+            const std::uint64_t end   = chunk_range_end(range);
+
+            if(begin >= end)
+                return false;
+
+            if(own.compare_exchange_weak(range, make_chunk_range(begin + 1, end)))
+            {
+                chunk = begin;
+                return true;
+            }
+        }
+    };
+
+    // move the back half of some other participant's range into the own (empty) range
+    auto steal = [&]() {
+        for(std::size_t i = 1; i < job.num_participant; ++i)
+        {
+            auto& victim        = job.ranges[(participant + i) % job.num_participant].chunks;
+            std::uint64_t range = victim.load();
+
+            for(;;)
+            {
+                const std::uint64_t begin = chunk_range_begin(range);
+                const std::uint64_t end   = chunk_range_end(range);
+
+                if(begin >= end)
+                    break;
+
+                const std::uint64_t half = (end - begin + 1) / 2;
+
+                if(victim.compare_exchange_weak(range, make_chunk_range(begin, end - half)))
+                {
+                    own.store(make_chunk_range(end - half, end));
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    };
+
+    const bool was_in_parallel_region = in_parallel_region_;
+
+    in_parallel_region_ = true;
+
+    std::size_t chunk;
+
+    for(;;)
+    {
+        if(!pop_front(chunk))
+        {
+            if(steal())
+                continue;
+            else
+                break;
+        }
+
+        if(job.failed.load(std::memory_order_relaxed))
+            continue;
+
+        const std::size_t begin = chunk * job.grain;
+        const std::size_t end   = std::min(begin + job.grain, job.size);
+
+        try
+        {
+            job.invoke(job.p_f, begin, end);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(job.exception_mutex);
+
+            if(!job.exception)
+                job.exception = std::current_exception();
+
+            job.failed = true;
+        }
+    }
+
+    in_parallel_region_ = was_in_parallel_region;
+}
+
+} // namespace host_common
+} // namespace ck
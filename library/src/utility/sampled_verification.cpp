@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "ck/library/utility/host_random.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+// random stream of the samples, apart from the streams numbered by next_host_random_stream()
+constexpr std::uint64_t SampledVerificationStream = ~std::uint64_t{0};
+
+std::size_t get_extent(const std::vector<std::size_t>& lengths,
+                       const std::vector<std::size_t>& dims)
+{
+    std::size_t extent = 1;
+
+    for(auto d : dims)
+        extent *= lengths[d];
+
+    return extent;
+}
+
+// write position pos of the flattened dims into idx, the last dimension varying fastest
+void set_flat_index(std::vector<std::size_t>& idx,
+                    const std::vector<std::size_t>& lengths,
+                    const std::vector<std::size_t>& dims,
+                    std::size_t pos)
+{
+    for(auto d = dims.rbegin(); d != dims.rend(); ++d)
+    {
+        idx[*d] = pos % lengths[*d];
+        pos /= lengths[*d];
+    }
+}
+
+// first and last position of every tile, the first and last position overall without tiles
+std::vector<std::size_t> get_boundary_positions(std::size_t size, std::size_t per_block)
+{
+    std::vector<std::size_t> positions{0, size - 1};
+
+    if(per_block != 0)
+    {
+        for(std::size_t b = per_block; b < size; b += per_block)
+        {
+            positions.push_back(b - 1);
+            positions.push_back(b);
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    return positions;
+}
+
+} // namespace
+
+SampledIndices make_sampled_indices(const std::vector<std::size_t>& lengths,
+                                    const SampledVerificationTiling& tiling,
+                                    const SampledVerificationConfig& config)
+{
+    SampledIndices samples;
+
+    if(std::find(lengths.begin(), lengths.end(), std::size_t{0}) != lengths.end())
+        return samples;
+
+    const host_common::HostRandomStream rng{
+        config.seed != 0 ? config.seed : host_common::get_host_random_seed(),
+        SampledVerificationStream};
+
+    std::uint64_t counter = 0;
+
+    const auto get_random_index = [&]() {
+        std::vector<std::size_t> idx(lengths.size());
+
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+        {
+            const auto bits = rng.GetBits(counter++);
+
+            idx[d] = ((std::uint64_t{bits[0]} << 32) | bits[1]) % lengths[d];
+        }
+
+        return idx;
+    };
+
+    for(std::size_t i = 0; i < config.num_samples; ++i)
+        samples.indices.push_back(get_random_index());
+
+    samples.num_random = samples.indices.size();
+
+    // rows next to the boundaries of the line_dims tiles, sampled across cross_dims
+    const auto add_boundary_lines = [&](const std::vector<std::size_t>& line_dims,
+                                        std::size_t per_block,
+                                        const std::vector<std::size_t>& cross_dims) {
+        if(line_dims.empty())
+            return;
+
+        const std::size_t cross_extent = get_extent(lengths, cross_dims);
+
+        const bool is_whole_line =
+            config.num_boundary_samples == 0 || config.num_boundary_samples >= cross_extent;
+
+        const std::size_t num_per_line = is_whole_line ? cross_extent : config.num_boundary_samples;
+
+        for(auto pos : get_boundary_positions(get_extent(lengths, line_dims), per_block))
+        {
+            for(std::size_t j = 0; j < num_per_line; ++j)
+            {
+                auto idx = get_random_index();
+
+                set_flat_index(idx, lengths, line_dims, pos);
+
+                if(is_whole_line)
+                    set_flat_index(idx, lengths, cross_dims, j);
+
+                samples.indices.push_back(std::move(idx));
+            }
+        }
+    };
+
+    add_boundary_lines(tiling.m_dims, tiling.m_per_block, tiling.n_dims);
+    add_boundary_lines(tiling.n_dims, tiling.n_per_block, tiling.m_dims);
+
+    return samples;
+}
+
+std::pair<double, double>
+get_error_rate_bounds(std::size_t err_count, std::size_t num_checked, double confidence)
+{
+    if(num_checked == 0)
+        return {0., 1.};
+
+    // two-sided normal quantile, P(|Z| > z) = 1 - confidence, by bisection
+    double z_lo = 0;
+    double z_hi = 40;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        const double z = (z_lo + z_hi) / 2;
+
+        if(std::erfc(z / std::sqrt(2.)) > 1 - confidence)
+            z_lo = z;
+        else
+            z_hi = z;
+    }
+
+    const double z  = (z_lo + z_hi) / 2;
+    const double n  = static_cast<double>(num_checked);
+    const double p  = static_cast<double>(err_count) / n;
+    const double z2 = z * z;
+
+    const double denom  = 1 + z2 / n;
+    const double center = (p + z2 / (2 * n)) / denom;
+    const double half   = z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denom;
+
+    return {err_count == 0 ? 0. : std::max(0., center - half),
+            err_count == num_checked ? 1. : std::min(1., center + half)};
+}
+
+std::array<std::size_t, 2> get_block_tile_lengths(const std::string& type_string)
+{
+    std::size_t pos = type_string.find('<');
+
+    std::array<std::size_t, 3> values{};
+
+    for(auto& value : values)
+    {
+        if(pos == std::string::npos)
+            return {0, 0};
+
+        const char* begin = type_string.c_str() + pos + 1;
+        char* end         = nullptr;
+
+        value = std::strtoull(begin, &end, 10);
+
+        if(end == begin || (*end != ',' && *end != '>'))
+            return {0, 0};
+
+        pos = *end == ',' ? end - type_string.c_str() : std::string::npos;
+    }
+
+    // values[0] is the block size
+    return {values[1], values[2]};
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ck/library/utility/streaming_verification.hpp"
+
+namespace ck {
+namespace utils {
+
+StreamingSlicing make_streaming_slicing(const HostTensorDescriptor& desc,
+                                        std::size_t element_bytes,
+                                        const StreamingVerificationConfig& config)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+
+    if(lens.empty())
+        throw std::runtime_error("wrong! streaming verification of a scalar");
+
+    // the outermost dimension longer than 1; dimensions of length 1 lead the traversal order
+    const auto order = desc.GetTraversalOrder();
+
+    std::size_t dim = order.front();
+
+    for(auto d : order)
+    {
+        if(lens[d] != 1)
+        {
+            dim = d;
+            break;
+        }
+    }
+
+    // element space of a single position of dim
+    std::vector<std::size_t> position_lens = lens;
+
+    position_lens[dim] = 1;
+
+    const std::size_t position_space =
+        HostTensorDescriptor(position_lens, strides).GetElementSpaceSize();
+
+    const std::size_t position_bytes = std::max(strides[dim], position_space) * element_bytes;
+
+    std::size_t length = config.slice_length;
+
+    if(length == 0)
+        length = std::max<std::size_t>(config.max_slice_bytes / position_bytes, 1);
+
+    length = std::min(length, lens[dim]);
+
+    return {dim, length, strides[dim], (length - 1) * strides[dim] + position_space};
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "ck/library/utility/tuning_database.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* FileTag = "ck_tuning_db";
+
+std::vector<std::string> split(const std::string& str, char delimiter)
+{
+    std::vector<std::string> fields;
+    std::istringstream is(str);
+
+    for(std::string field; std::getline(is, field, delimiter);)
+        fields.push_back(field);
+
+    // a trailing delimiter ends an empty field
+    if(!str.empty() && str.back() == delimiter)
+        fields.emplace_back();
+
+    return fields;
+}
+
+std::string to_string(const std::vector<int64_t>& shape)
+{
+    std::string str;
+
+    for(const auto x : shape)
+        str += (str.empty() ? "" : ",") + std::to_string(x);
+
+    return str;
+}
+
+std::vector<int64_t> parse_shape(const std::string& str)
+{
+    std::vector<int64_t> shape;
+
+    if(str.empty())
+        return shape;
+
+    for(const auto& field : split(str, ','))
+    {
+        std::size_t pos = 0;
+
+        shape.push_back(std::stoll(field, &pos));
+
+        if(pos != field.size())
+            throw std::invalid_argument(field);
+    }
+
+    return shape;
+}
+
+bool is_candidate(const TuningKey& x, const TuningKey& y)
+{
+    return x.signature == y.signature && x.arch == y.arch && x.shape.size() == y.shape.size();
+}
+
+} // namespace
+
+std::vector<int64_t> get_tuning_shape(const conv::ConvParam& param)
+{
+    std::vector<int64_t> shape{param.G_, param.N_, param.K_, param.C_};
+
+    for(const auto* lengths : {&param.filter_spatial_lengths_,
+                               &param.input_spatial_lengths_,
+                               &param.conv_filter_strides_,
+                               &param.conv_filter_dilations_,
+                               &param.input_left_pads_,
+                               &param.input_right_pads_})
+    {
+        shape.insert(shape.end(), lengths->begin(), lengths->end());
+    }
+
+    return shape;
+}
+
+double get_tuning_shape_distance(const std::vector<int64_t>& x, const std::vector<int64_t>& y)
+{
+    if(x.size() != y.size())
+        throw std::runtime_error("wrong! shapes of different ranks");
+
+    double distance = 0;
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        distance += std::abs(std::log2(1.0 + x[i]) - std::log2(1.0 + y[i]));
+
+    return distance;
+}
+
+TuningDatabase& TuningDatabase::GetInstance()
+{
+    static TuningDatabase database = [] {
+        TuningDatabase db;
+
+        if(const char* env = std::getenv("CK_TUNING_DB"))
+        {
+            try
+            {
+                db.Load(env);
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << "tuning database: " << e.what() << std::endl;
+            }
+        }
+
+        return db;
+    }();
+
+    return database;
+}
+
+void TuningDatabase::Load(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if(!file)
+    {
+        std::error_code ec;
+
+        if(!fs::exists(path, ec))
+            return;
+
+        throw std::runtime_error("wrong! cannot open tuning database " + path);
+    }
+
+    std::string line;
+
+    if(!std::getline(file, line) || line != FileTag + (" " + std::to_string(Version)))
+        throw std::runtime_error("wrong! " + path + " is not a tuning database of version " +
+                                 std::to_string(Version));
+
+    // parsed completely before any record is added, so that a bad file leaves the database as is
+    std::vector<TuningRecord> records;
+
+    for(std::size_t line_number = 2; std::getline(file, line); ++line_number)
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        const auto fields = split(line, '\t');
+
+        try
+        {
+            if(fields.size() != 7)
+                throw std::invalid_argument("expected 7 fields");
+
+            records.push_back({{fields[0], fields[1], parse_shape(fields[2])},
+                               fields[3],
+                               fields[6],
+                               std::stof(fields[4]),
+                               std::stof(fields[5])});
+        }
+        catch(const std::exception& e)
+        {
+            throw std::runtime_error("wrong! " + path + ":" + std::to_string(line_number) +
+                                     ": invalid record (" + e.what() + ")");
+        }
+    }
+
+    for(const auto& record : records)
+        Insert(record);
+}
+
+void TuningDatabase::Save(const std::string& path) const
+{
+    // written under a name of its own and renamed, so that readers never see a partial file
+    const auto stamp         = std::chrono::steady_clock::now().time_since_epoch().count();
+    const fs::path temp_path = path + ".tmp" + std::to_string(stamp);
+
+    {
+        std::ofstream file(temp_path);
+
+        file << FileTag << " " << Version << "\n"
+             << "# signature\tarch\tshape\tinstance_type_id\tave_time_ms\ttflops\tinstance\n";
+
+        for(const auto& [key, record] : mRecords)
+        {
+            file << record.key.signature << "\t" << record.key.arch << "\t"
+                 << to_string(record.key.shape) << "\t" << record.instance_type_id << "\t"
+                 << record.ave_time << "\t" << record.tflops << "\t" << record.instance_name
+                 << "\n";
+        }
+
+        if(!file.flush())
+        {
+            std::error_code ec;
+
+            fs::remove(temp_path, ec);
+
+            throw std::runtime_error("wrong! cannot write tuning database " + path);
+        }
+    }
+
+    fs::rename(temp_path, path);
+}
+
+void TuningDatabase::Insert(const TuningRecord& record)
+{
+    const auto& key = record.key;
+
+    for(const auto& field : {key.signature, key.arch, record.instance_type_id})
+    {
+        if(field.empty() || field.find_first_of("\t\n") != std::string::npos)
+            throw std::runtime_error("wrong! invalid tuning record field: " + field);
+    }
+
+    if(record.instance_name.find_first_of("\t\n") != std::string::npos)
+        throw std::runtime_error("wrong! invalid instance name: " + record.instance_name);
+
+    mRecords.insert_or_assign(Key{key.signature, key.arch, key.shape}, record);
+}
+
+const TuningRecord* TuningDatabase::Find(const TuningKey& key) const
+{
+    if(const auto it = mRecords.find(Key{key.signature, key.arch, key.shape});
+       it != mRecords.end())
+        return &it->second;
+
+    const auto candidates = FindCandidates(key);
+
+    return candidates.empty() ? nullptr : candidates.front();
+}
+
+std::vector<const TuningRecord*> TuningDatabase::FindCandidates(const TuningKey& key) const
+{
+    std::vector<std::pair<double, const TuningRecord*>> candidates;
+
+    // the records of a signature and arch are adjacent, ordered by shape
+    for(auto it = mRecords.lower_bound(Key{key.signature, key.arch, {}});
+        it != mRecords.end() && std::get<0>(it->first) == key.signature &&
+        std::get<1>(it->first) == key.arch;
+        ++it)
+    {
+        if(is_candidate(it->second.key, key))
+        {
+            candidates.emplace_back(get_tuning_shape_distance(it->second.key.shape, key.shape),
+                                    &it->second);
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto& x, const auto& y) {
+        return x.first < y.first;
+    });
+
+    std::vector<const TuningRecord*> records;
+
+    for(const auto& candidate : candidates)
+        records.push_back(candidate.second);
+
+    return records;
+}
+
+} // namespace utils
+} // namespace ck
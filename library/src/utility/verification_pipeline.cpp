@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <string>
+
+#include "ck/library/utility/verification_pipeline.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+std::size_t get_default_max_pending_bytes()
+{
+    if(const char* env = std::getenv("CK_VERIFY_QUEUE_SIZE_MB"))
+    {
+        try
+        {
+            return static_cast<std::size_t>(std::stoull(env)) << 20;
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+
+    return std::size_t{4096} << 20;
+}
+
+} // namespace
+
+VerificationPipeline::VerificationPipeline()
+    : VerificationPipeline(get_default_max_pending_bytes())
+{
+}
+
+VerificationPipeline::VerificationPipeline(std::size_t max_pending_bytes)
+    : max_pending_bytes_(max_pending_bytes), worker_([this] { WorkerLoop(); })
+{
+}
+
+VerificationPipeline::~VerificationPipeline()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        done_cv_.wait(lock, [&] { return tasks_.empty() && num_running_ == 0; });
+
+        stop_ = true;
+    }
+
+    worker_cv_.notify_all();
+
+    worker_.join();
+}
+
+void VerificationPipeline::Submit(std::function<bool()> task, std::size_t bytes)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        // a task larger than the limit still goes through once the queue has drained
+        submit_cv_.wait(lock, [&] {
+            return pending_bytes_ == 0 || pending_bytes_ + bytes <= max_pending_bytes_;
+        });
+
+        tasks_.push_back({std::move(task), bytes});
+        pending_bytes_ += bytes;
+    }
+
+    worker_cv_.notify_one();
+}
+
+bool VerificationPipeline::Wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    done_cv_.wait(lock, [&] { return tasks_.empty() && num_running_ == 0; });
+
+    if(exception_)
+    {
+        const auto exception = exception_;
+
+        exception_ = nullptr;
+
+        std::rethrow_exception(exception);
+    }
+
+    return pass_;
+}
+
+void VerificationPipeline::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for(;;)
+    {
+        worker_cv_.wait(lock, [&] { return stop_ || !tasks_.empty(); });
+
+        if(tasks_.empty())
+            return;
+
+        Task task = std::move(tasks_.front());
+
+        tasks_.pop_front();
+        ++num_running_;
+
+        const bool is_cancelled = exception_ != nullptr;
+
+        lock.unlock();
+
+        bool pass = true;
+        std::exception_ptr exception;
+
+        if(!is_cancelled)
+        {
+            try
+            {
+                pass = task.run();
+            }
+            catch(...)
+            {
+                exception = std::current_exception();
+            }
+        }
+
+        // release whatever the task holds before admitting new ones
+        task.run = nullptr;
+
+        lock.lock();
+
+        pass_ = pass_ && pass;
+
+        if(exception && !exception_)
+            exception_ = exception;
+
+        pending_bytes_ -= task.bytes;
+        --num_running_;
+
+        submit_cv_.notify_all();
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -15,6 +15,9 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -117,9 +120,7 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
         DeviceAvgPoolBwd<3, DOutDataType, DInDataType, DOutLayout, DInLayout>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
@@ -145,6 +146,17 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
         ref_invoker.Run(ref_pooling_bwd_argument);
     }
 
+    ProfilerResults profiler_results("avg_pool3d_bwd",
+                                     ProblemDescriptor{}
+                                         .AddTypes<DOutDataType, DInDataType, ComputeDataType>()
+                                         .AddLayouts<DOutLayout, DInLayout>()
+                                         .Add("in_lengths", in_length)
+                                         .Add("window", window_spatial_lengths)
+                                         .Add("strides", window_strides)
+                                         .Add("dilations", window_dilations)
+                                         .Add("left_pads", input_left_pads)
+                                         .Add("right_pads", input_right_pads));
+
     int num_kernel = 0;
 
     for(auto& inst_ptr : instance_ptrs)
@@ -168,6 +180,8 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString() << " skipped due to unsupported argument: ";
@@ -188,6 +202,8 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(time_kernel)
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
@@ -202,11 +218,12 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
         if(do_verification)
         {
             din_device_buf.FromDevice(din_n_c_di_hi_wi_device.mData.data());
-            bool pass = ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
-                                             din_n_c_di_hi_wi_host.mData,
-                                             "Error: Incorrect results",
-                                             1e-3,
-                                             1e-3);
+            bool pass = profiler_results.RecordVerification(
+                ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
+                                     din_n_c_di_hi_wi_host.mData,
+                                     "Error: Incorrect results",
+                                     1e-3,
+                                     1e-3));
 
             if(do_log)
             {
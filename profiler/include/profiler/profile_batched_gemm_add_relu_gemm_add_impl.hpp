@@ -15,8 +15,12 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -210,55 +214,89 @@ bool profile_batched_gemm_add_relu_gemm_add_impl(bool do_verification,
                                                                           CDE1ElementOp>;
 
     // get device op instances
-    const auto op_ptrs = tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "batched_gemm_add_relu_gemm_add",
+        ProblemDescriptor{}
+            .AddTypes<A0DataType, B0DataType, D0DataType, B1DataType, D1DataType, E1DataType>()
+            .AddLayouts<A0Layout, B0Layout, D0Layout, B1Layout, D1Layout, E1Layout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("O", O)
+            .Add("BatchCount", BatchCount)
+            .Add("StrideA0", StrideA0)
+            .Add("StrideB0", StrideB0)
+            .Add("StrideD0", StrideD0)
+            .Add("StrideB1", StrideB1)
+            .Add("StrideD1", StrideD1)
+            .Add("StrideE1", StrideE1)
+            .Add("BatchStrideA0", BatchStrideA0)
+            .Add("BatchStrideB0", BatchStrideB0)
+            .Add("BatchStrideD0", BatchStrideD0)
+            .Add("BatchStrideB1", BatchStrideB1)
+            .Add("BatchStrideD1", BatchStrideD1)
+            .Add("BatchStrideE1", BatchStrideE1));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        // Ref Gemm0
-        using ReferenceGemm0Instance = tensor_operation::host::ReferenceBatchedGemm<A0DataType,
-                                                                                    B0DataType,
-                                                                                    RefAcc0DataType,
-                                                                                    RefAcc0DataType,
-                                                                                    A0ElementOp,
-                                                                                    B0ElementOp,
-                                                                                    PassThrough>;
-
-        // Ref Gemm1
-        using ReferenceGemm1Instance = tensor_operation::host::ReferenceBatchedGemm<RefAcc0DataType,
-                                                                                    B1DataType,
-                                                                                    RefAcc1DataType,
-                                                                                    RefAcc1DataType,
-                                                                                    PassThrough,
-                                                                                    B1ElementOp,
-                                                                                    PassThrough>;
-
-        auto ref_gemm0          = ReferenceGemm0Instance{};
-        auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
-        auto ref_gemm0_argument = ref_gemm0.MakeArgument(
-            a0_g_m_k, b0_g_k_n, c0_g_m_n, a0_element_op, b0_element_op, PassThrough{});
-
-        ref_gemm0_invoker.Run(ref_gemm0_argument);
-
-        // cde0_elementwise
-        e0_g_m_n.ForEach(
-            [&](auto&, auto idx) { cde0_element_op(e0_g_m_n(idx), c0_g_m_n(idx), d0_g_m_n(idx)); });
-
-        auto ref_gemm1          = ReferenceGemm1Instance{};
-        auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
-        auto ref_gemm1_argument = ref_gemm1.MakeArgument(
-            e0_g_m_n, b1_g_n_o, c1_g_m_o, PassThrough{}, b1_element_op, PassThrough{});
-
-        ref_gemm1_invoker.Run(ref_gemm1_argument);
-
-        // cde1_elementwise
-        e1_g_m_o_host_result.ForEach([&](auto&, auto idx) {
-            cde1_element_op(e1_g_m_o_host_result(idx), c1_g_m_o(idx), d1_g_m_o(idx));
+        verification.Submit([&] {
+            // Ref Gemm0
+            using ReferenceGemm0Instance =
+                tensor_operation::host::ReferenceBatchedGemm<A0DataType,
+                                                             B0DataType,
+                                                             RefAcc0DataType,
+                                                             RefAcc0DataType,
+                                                             A0ElementOp,
+                                                             B0ElementOp,
+                                                             PassThrough>;
+
+            // Ref Gemm1
+            using ReferenceGemm1Instance =
+                tensor_operation::host::ReferenceBatchedGemm<RefAcc0DataType,
+                                                             B1DataType,
+                                                             RefAcc1DataType,
+                                                             RefAcc1DataType,
+                                                             PassThrough,
+                                                             B1ElementOp,
+                                                             PassThrough>;
+
+            auto ref_gemm0          = ReferenceGemm0Instance{};
+            auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
+            auto ref_gemm0_argument = ref_gemm0.MakeArgument(
+                a0_g_m_k, b0_g_k_n, c0_g_m_n, a0_element_op, b0_element_op, PassThrough{});
+
+            ref_gemm0_invoker.Run(ref_gemm0_argument);
+
+            // cde0_elementwise
+            e0_g_m_n.ForEach([&](auto&, auto idx) {
+                cde0_element_op(e0_g_m_n(idx), c0_g_m_n(idx), d0_g_m_n(idx));
+            });
+
+            auto ref_gemm1          = ReferenceGemm1Instance{};
+            auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
+            auto ref_gemm1_argument = ref_gemm1.MakeArgument(
+                e0_g_m_n, b1_g_n_o, c1_g_m_o, PassThrough{}, b1_element_op, PassThrough{});
+
+            ref_gemm1_invoker.Run(ref_gemm1_argument);
+
+            // cde1_elementwise
+            e1_g_m_o_host_result.ForEach([&](auto&, auto idx) {
+                cde1_element_op(e1_g_m_o_host_result(idx), c1_g_m_o(idx), d1_g_m_o(idx));
+            });
+
+            return true;
         });
     }
 
+    const auto& e1_g_m_o_desc = e1_g_m_o_device_result.mDesc;
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -319,6 +357,8 @@ bool profile_batched_gemm_add_relu_gemm_add_impl(bool do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -329,27 +369,51 @@ bool profile_batched_gemm_add_relu_gemm_add_impl(bool do_verification,
 
             if(do_verification)
             {
-                e1_g_m_o_device_buf.FromDevice(e1_g_m_o_device_result.mData.data());
-
-                pass = pass & ck::utils::check_err(e1_g_m_o_device_result, e1_g_m_o_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(
-                        std::cout << "e1_g_m_o_host_result : ", e1_g_m_o_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "e1_g_m_o_device_result : ", e1_g_m_o_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<E1DataType> e1_g_m_o_device_data(e1_g_m_o_desc.GetElementSpaceSize());
+
+                e1_g_m_o_device_buf.FromDevice(e1_g_m_o_device_data.data());
+
+                const std::size_t e1_bytes = sizeof(E1DataType) * e1_g_m_o_device_data.size();
+
+                auto compare =
+                    [&, op_name, e1_g_m_o_device_data = std::move(e1_g_m_o_device_data)] {
+                        const TensorView<const E1DataType> e1_g_m_o_device_view(
+                            e1_g_m_o_device_data.data(), e1_g_m_o_desc);
+
+                        if(do_log)
+                        {
+                            LogRangeAsType<float>(std::cout << "e1_g_m_o_host_result : ",
+                                                  e1_g_m_o_host_result.mData,
+                                                  ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "e1_g_m_o_device_result : ", e1_g_m_o_device_data, ",")
+                                << std::endl;
+                        }
+
+                        return ck::utils::check_err(e1_g_m_o_device_view,
+                                                    e1_g_m_o_host_result,
+                                                    "Error: Incorrect results of " + op_name + "!");
+                    };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    e1_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
@@ -17,8 +17,12 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -191,8 +195,7 @@ bool profile_batched_gemm_gemm_impl(bool do_verification,
                                                                      CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
@@ -202,23 +205,54 @@ bool profile_batched_gemm_gemm_impl(bool do_verification,
         return false;
     }
 
+    ProfilerResults profiler_results("batched_gemm_gemm",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, B0DataType, B1DataType, CDataType>()
+                                         .AddLayouts<ALayout, B0Layout, B1Layout, CLayout>()
+                                         .Add("M", M)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("O", O)
+                                         .Add("BatchCount", BatchCount)
+                                         .Add("StrideA", StrideA)
+                                         .Add("StrideB0", StrideB0)
+                                         .Add("StrideB1", StrideB1)
+                                         .Add("StrideC", StrideC)
+                                         .Add("BatchStrideA", BatchStrideA)
+                                         .Add("BatchStrideB0", BatchStrideB0)
+                                         .Add("BatchStrideB1", BatchStrideB1)
+                                         .Add("BatchStrideC", BatchStrideC));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        auto ref_gemm0          = ReferenceGemm0Instance{};
-        auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
-        auto ref_gemm0_argument = ref_gemm0.MakeArgument(
-            a_g_m_k, b0_g_k_n, acc0_g_m_n, a_element_op, b0_element_op, PassThrough{});
-
-        ref_gemm0_invoker.Run(ref_gemm0_argument);
-
-        auto ref_gemm1          = ReferenceGemm1Instance{};
-        auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
-        auto ref_gemm1_argument = ref_gemm1.MakeArgument(
-            acc0_g_m_n, b1_g_n_o, c_g_m_o_host_result, PassThrough{}, b1_element_op, c_element_op);
-
-        ref_gemm1_invoker.Run(ref_gemm1_argument);
+        verification.Submit([&] {
+            auto ref_gemm0          = ReferenceGemm0Instance{};
+            auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
+            auto ref_gemm0_argument = ref_gemm0.MakeArgument(
+                a_g_m_k, b0_g_k_n, acc0_g_m_n, a_element_op, b0_element_op, PassThrough{});
+
+            ref_gemm0_invoker.Run(ref_gemm0_argument);
+
+            auto ref_gemm1          = ReferenceGemm1Instance{};
+            auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
+            auto ref_gemm1_argument = ref_gemm1.MakeArgument(acc0_g_m_n,
+                                                             b1_g_n_o,
+                                                             c_g_m_o_host_result,
+                                                             PassThrough{},
+                                                             b1_element_op,
+                                                             c_element_op);
+
+            ref_gemm1_invoker.Run(ref_gemm1_argument);
+
+            return true;
+        });
     }
 
+    const auto& c_g_m_o_desc = c_g_m_o_device_result.mDesc;
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -272,6 +306,8 @@ bool profile_batched_gemm_gemm_impl(bool do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -282,33 +318,55 @@ bool profile_batched_gemm_gemm_impl(bool do_verification,
 
             if(do_verification)
             {
-                c_g_m_o_device_buf.FromDevice(c_g_m_o_device_result.mData.data());
-
-                pass = pass & ck::utils::check_err(c_g_m_o_device_result, c_g_m_o_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a_g_m_k: ", a_g_m_k.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b0_g_k_n : ", b0_g_k_n.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b1_g_n_o : ", b1_g_n_o.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_g_m_o_host_result : ", c_g_m_o_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_g_m_o_device_result : ", c_g_m_o_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_g_m_o_device_data(c_g_m_o_desc.GetElementSpaceSize());
+
+                c_g_m_o_device_buf.FromDevice(c_g_m_o_device_data.data());
+
+                const std::size_t c_bytes = sizeof(CDataType) * c_g_m_o_device_data.size();
+
+                auto compare = [&, op_name, c_g_m_o_device_data = std::move(c_g_m_o_device_data)] {
+                    const TensorView<const CDataType> c_g_m_o_device_view(
+                        c_g_m_o_device_data.data(), c_g_m_o_desc);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a_g_m_k: ", a_g_m_k.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "b0_g_k_n : ", b0_g_k_n.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "b1_g_n_o : ", b1_g_n_o.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_g_m_o_host_result : ", c_g_m_o_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_g_m_o_device_result : ", c_g_m_o_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(c_g_m_o_device_view,
+                                                c_g_m_o_host_result,
+                                                "Error: Incorrect results of " + op_name + "!");
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
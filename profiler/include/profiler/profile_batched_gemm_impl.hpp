@@ -16,11 +16,16 @@
 
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -98,25 +103,20 @@ bool profile_batched_gemm_impl(int do_verification,
     const auto b_element_op = BElementOp{};
     const auto c_element_op = CElementOp{};
 
-    if(do_verification)
-    {
-        using ReferenceBatchedGemmInstance =
-            ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                             BDataType,
-                                                             CDataType,
-                                                             float,
-                                                             AElementOp,
-                                                             BElementOp,
-                                                             CElementOp>;
-
-        auto ref_batched_gemm = ReferenceBatchedGemmInstance{};
-        auto ref_invoker      = ref_batched_gemm.MakeInvoker();
-
-        auto ref_argument = ref_batched_gemm.MakeArgument(
-            a_g_m_k, b_g_k_n, c_g_m_n_host_result, a_element_op, b_element_op, c_element_op);
-
-        ref_invoker.Run(ref_argument);
-    }
+    using ReferenceBatchedGemmInstance =
+        ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
+                                                         BDataType,
+                                                         CDataType,
+                                                         float,
+                                                         AElementOp,
+                                                         BElementOp,
+                                                         CElementOp>;
+
+    auto ref_batched_gemm = ReferenceBatchedGemmInstance{};
+    auto ref_invoker      = ref_batched_gemm.MakeInvoker();
+
+    auto ref_argument = ref_batched_gemm.MakeArgument(
+        a_g_m_k, b_g_k_n, c_g_m_n_host_result, a_element_op, b_element_op, c_element_op);
 
     DeviceMem a_device_buf(sizeof(ADataType) * a_g_m_k.mDesc.GetElementSpaceSize());
     DeviceMem b_device_buf(sizeof(BDataType) * b_g_k_n.mDesc.GetElementSpaceSize());
@@ -127,11 +127,49 @@ bool profile_batched_gemm_impl(int do_verification,
     c_device_buf.ToDevice(c_g_m_n_device_result.mData.data());
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results("batched_gemm",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, BDataType, CDataType>()
+                                         .AddLayouts<ALayout, BLayout, CLayout>()
+                                         .Add("M", M)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("BatchCount", BatchCount)
+                                         .Add("StrideA", StrideA)
+                                         .Add("StrideB", StrideB)
+                                         .Add("StrideC", StrideC)
+                                         .Add("BatchStrideA", BatchStrideA)
+                                         .Add("BatchStrideB", BatchStrideB)
+                                         .Add("BatchStrideC", BatchStrideC));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        const auto key = ck::host_common::HostReferenceCacheKey("batched_gemm")
+                             .AddType<ReferenceBatchedGemmInstance>()
+                             .AddObject(a_element_op)
+                             .AddObject(b_element_op)
+                             .AddObject(c_element_op)
+                             .Add(a_g_m_k)
+                             .Add(b_g_k_n);
+
+        verification.Submit([&, key] {
+            ck::host_common::compute_cached_host_reference(
+                key, c_g_m_n_host_result, [&] { ref_invoker.Run(ref_argument); });
+
+            return true;
+        });
+    }
+
+    const auto& c_g_m_n_desc  = c_g_m_n_host_result.mDesc;
+    const std::size_t c_bytes = sizeof(CDataType) * c_g_m_n_desc.GetElementSpaceSize();
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -222,6 +260,8 @@ bool profile_batched_gemm_impl(int do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -232,28 +272,49 @@ bool profile_batched_gemm_impl(int do_verification,
 
             if(do_verification)
             {
-                c_device_buf.FromDevice(c_g_m_n_device_result.mData.data());
-
-                pass = pass & ck::utils::check_err(c_g_m_n_device_result, c_g_m_n_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a : ", a_g_m_k.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "b: ", b_g_k_n.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_host: ", c_g_m_n_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_device: ", c_g_m_n_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_g_m_n_device_data(c_g_m_n_desc.GetElementSpaceSize());
+
+                c_device_buf.FromDevice(c_g_m_n_device_data.data(), c_bytes);
+
+                auto compare = [&, op_name, c_g_m_n_device_data = std::move(c_g_m_n_device_data)] {
+                    const TensorView<const CDataType> c_g_m_n_device_view(
+                        c_g_m_n_device_data.data(), c_g_m_n_desc);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a : ", a_g_m_k.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "b: ", b_g_k_n.mData, ",") << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_host: ", c_g_m_n_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "c_device: ", c_g_m_n_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(c_g_m_n_device_view,
+                                                c_g_m_n_host_result,
+                                                "Error: Incorrect results of " + op_name + "!");
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
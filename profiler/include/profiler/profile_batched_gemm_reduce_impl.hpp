@@ -15,8 +15,11 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -115,12 +118,12 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
     {
     case 0: break;
     case 1:
-        std::srand(0);
+        ck::host_common::reset_host_random_streams();
         a_g_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-5, 5}, num_thread);
         b_g_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5}, num_thread);
         break;
     default:
-        std::srand(0);
+        ck::host_common::reset_host_random_streams();
         a_g_m_k.GenerateTensorValue(GeneratorTensor_3<ADataType>{0.0, 1.0}, num_thread);
         b_g_k_n.GenerateTensorValue(GeneratorTensor_3<BDataType>{-0.5, 0.5}, num_thread);
     }
@@ -146,51 +149,6 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
     std::array<void*, 2> reduce_in_element_ops  = {&passthrough, &square};
     std::array<void*, 2> reduce_out_element_ops = {&passthrough, &passthrough};
 
-    if(do_verification)
-    {
-        using ReferenceBatchedGemmInstance =
-            ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                             BDataType,
-                                                             CDataType,
-                                                             float,
-                                                             AElementOp,
-                                                             BElementOp,
-                                                             CElementOp>;
-
-        using ReduceAccDataType = ReduceDataType;
-
-        auto ref_batched_gemm = ReferenceBatchedGemmInstance{};
-        auto ref_invoker      = ref_batched_gemm.MakeInvoker();
-
-        auto ref_argument = ref_batched_gemm.MakeArgument(
-            a_g_m_k, b_g_k_n, c_g_m_n_host_result, a_element_op, b_element_op, c_element_op);
-
-        ref_invoker.Run(ref_argument);
-
-        for(int batch = 0; batch < BatchCount; ++batch)
-        {
-            for(int m = 0; m < M; ++m)
-            {
-                auto reduce0_acc = reduce0_op.GetIdentityValue<ReduceAccDataType>();
-                auto reduce1_acc = reduce1_op.GetIdentityValue<ReduceAccDataType>();
-
-                for(int n = 0; n < N; ++n)
-                {
-                    ReduceAccDataType d0_val =
-                        ck::type_convert<ReduceAccDataType>(c_g_m_n_host_result(batch, m, n));
-                    ReduceAccDataType d1_val;
-
-                    square(d1_val, d0_val);
-                    reduce0_op(reduce0_acc, d0_val);
-                    reduce1_op(reduce1_acc, d1_val);
-                }
-
-                d0_g_m_host_result(batch, m) = ck::type_convert<ReduceDataType>(reduce0_acc);
-                d1_g_m_host_result(batch, m) = ck::type_convert<ReduceDataType>(reduce1_acc);
-            }
-        }
-    }
-
     DeviceMem a_device_buf(sizeof(ADataType) * a_g_m_k.mDesc.GetElementSpaceSize());
     DeviceMem b_device_buf(sizeof(BDataType) * b_g_k_n.mDesc.GetElementSpaceSize());
     DeviceMem c_device_buf(sizeof(CDataType) * c_g_m_n_device_result.mDesc.GetElementSpaceSize());
@@ -250,6 +208,74 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
         throw std::runtime_error("wrong! no device GEMM instance found");
     }
 
+    ProfilerResults profiler_results(
+        "batched_gemm_reduce",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, CDataType, ReduceDataType>()
+            .AddLayouts<ALayout, BLayout, CLayout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("BatchCount", BatchCount)
+            .Add("StrideA", StrideA)
+            .Add("StrideB", StrideB)
+            .Add("StrideC", StrideC));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        verification.Submit([&] {
+            using ReferenceBatchedGemmInstance =
+                ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
+                                                                 BDataType,
+                                                                 CDataType,
+                                                                 float,
+                                                                 AElementOp,
+                                                                 BElementOp,
+                                                                 CElementOp>;
+
+            using ReduceAccDataType = ReduceDataType;
+
+            auto ref_batched_gemm = ReferenceBatchedGemmInstance{};
+            auto ref_invoker      = ref_batched_gemm.MakeInvoker();
+
+            auto ref_argument = ref_batched_gemm.MakeArgument(
+                a_g_m_k, b_g_k_n, c_g_m_n_host_result, a_element_op, b_element_op, c_element_op);
+
+            ref_invoker.Run(ref_argument);
+
+            for(int batch = 0; batch < BatchCount; ++batch)
+            {
+                for(int m = 0; m < M; ++m)
+                {
+                    auto reduce0_acc = reduce0_op.GetIdentityValue<ReduceAccDataType>();
+                    auto reduce1_acc = reduce1_op.GetIdentityValue<ReduceAccDataType>();
+
+                    for(int n = 0; n < N; ++n)
+                    {
+                        ReduceAccDataType d0_val =
+                            ck::type_convert<ReduceAccDataType>(c_g_m_n_host_result(batch, m, n));
+                        ReduceAccDataType d1_val;
+
+                        square(d1_val, d0_val);
+                        reduce0_op(reduce0_acc, d0_val);
+                        reduce1_op(reduce1_acc, d1_val);
+                    }
+
+                    d0_g_m_host_result(batch, m) = ck::type_convert<ReduceDataType>(reduce0_acc);
+                    d1_g_m_host_result(batch, m) = ck::type_convert<ReduceDataType>(reduce1_acc);
+                }
+            }
+
+            return true;
+        });
+    }
+
+    const auto& c_g_m_n_desc = c_g_m_n_device_result.mDesc;
+    const auto& d_g_m_desc   = d0_g_m_device_result.mDesc;
+
     std::string best_gemm_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -302,6 +328,8 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << gemm_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*gemm_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_gemm_name  = gemm_name;
@@ -312,46 +340,80 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
 
             if(do_verification)
             {
-                c_device_buf.FromDevice(c_g_m_n_device_result.mData.data());
-                reduce0_device_buf.FromDevice(d0_g_m_device_result.mData.data());
-                reduce1_device_buf.FromDevice(d1_g_m_device_result.mData.data());
-
-                bool c_error  = ck::utils::check_err(c_g_m_n_device_result, c_g_m_n_host_result);
-                bool d0_error = ck::utils::check_err(d0_g_m_device_result, d0_g_m_host_result);
-                bool d1_error = ck::utils::check_err(d1_g_m_device_result, d1_g_m_host_result);
-
-                pass = pass && (c_error == true);
-                pass = pass && (d0_error == true);
-                pass = pass && (d1_error == true);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a : ", a_g_m_k.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "b: ", b_g_k_n.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_host: ", c_g_m_n_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_device: ", c_g_m_n_device_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "d0_host: ", d0_g_m_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d0_device: ", d0_g_m_device_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "d1_host: ", d1_g_m_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d1_device: ", d1_g_m_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not Tensors, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_g_m_n_device_data(c_g_m_n_desc.GetElementSpaceSize());
+                std::vector<ReduceDataType> d0_g_m_device_data(d_g_m_desc.GetElementSpaceSize());
+                std::vector<ReduceDataType> d1_g_m_device_data(d_g_m_desc.GetElementSpaceSize());
+
+                c_device_buf.FromDevice(c_g_m_n_device_data.data());
+                reduce0_device_buf.FromDevice(d0_g_m_device_data.data());
+                reduce1_device_buf.FromDevice(d1_g_m_device_data.data());
+
+                const std::size_t bytes = sizeof(CDataType) * c_g_m_n_device_data.size() +
+                                          2 * sizeof(ReduceDataType) * d0_g_m_device_data.size();
+
+                auto compare = [&,
+                                gemm_name,
+                                c_g_m_n_device_data = std::move(c_g_m_n_device_data),
+                                d0_g_m_device_data  = std::move(d0_g_m_device_data),
+                                d1_g_m_device_data  = std::move(d1_g_m_device_data)] {
+                    const TensorView<const CDataType> c_g_m_n_device_view(
+                        c_g_m_n_device_data.data(), c_g_m_n_desc);
+                    const TensorView<const ReduceDataType> d0_g_m_device_view(
+                        d0_g_m_device_data.data(), d_g_m_desc);
+                    const TensorView<const ReduceDataType> d1_g_m_device_view(
+                        d1_g_m_device_data.data(), d_g_m_desc);
+
+                    const std::string msg = "Error: Incorrect results of " + gemm_name + "!";
+
+                    bool c_error =
+                        ck::utils::check_err(c_g_m_n_device_view, c_g_m_n_host_result, msg);
+                    bool d0_error =
+                        ck::utils::check_err(d0_g_m_device_view, d0_g_m_host_result, msg);
+                    bool d1_error =
+                        ck::utils::check_err(d1_g_m_device_view, d1_g_m_host_result, msg);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a : ", a_g_m_k.mData, ",") << std::endl;
+                        LogRangeAsType<float>(std::cout << "b: ", b_g_k_n.mData, ",") << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_host: ", c_g_m_n_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "c_device: ", c_g_m_n_device_data, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d0_host: ", d0_g_m_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "d0_device: ", d0_g_m_device_data, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d1_host: ", d1_g_m_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "d1_device: ", d1_g_m_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return c_error && d0_error && d1_error;
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*gemm_ptr);
+
             std::cout << "does not support this GEMM problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_gemm_name << std::endl;
 
@@ -15,10 +15,14 @@
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm_softmax_gemm.hpp"
+
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -64,27 +68,20 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
     using CElementOp    = PassThrough;
     using AccDataType   = float;
 
-    // Ref Gemm0: various type in, fp32 out
-    using ReferenceGemm0Instance = tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B0DataType,
-                                                                                AccDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B0ElementOp,
-                                                                                Acc0ElementOp>;
-
-    // Ref Softmax: fp32 in, various type out
-    using ReferenceSoftmaxInstance =
-        tensor_operation::host::ReferenceSoftmax<AccDataType, ADataType, AccDataType>;
-
-    // Ref Gemm1: various type in, various type out
-    using ReferenceGemm1Instance = tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B1DataType,
-                                                                                CDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B1ElementOp,
-                                                                                CElementOp>;
+    // Ref Gemm0 -> Softmax -> Gemm1, fused so that no [G, M, N] intermediate is allocated
+    using ReferenceInstance = tensor_operation::host::ReferenceBatchedGemmSoftmaxGemm<
+        ADataType,
+        B0DataType,
+        B1DataType,
+        CDataType,
+        AccDataType,
+        AElementOp,
+        B0ElementOp,
+        Acc0ElementOp,
+        B1ElementOp,
+        CElementOp,
+        MaskOutUpperTriangle ? tensor_operation::device::MaskingSpecialization::MaskOutUpperTriangle
+                             : tensor_operation::device::MaskingSpecialization::MaskDisabled>;
 
     bool pass = true;
 
@@ -137,16 +134,13 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
         f_host_tensor_descriptor(BatchCount, M, O, StrideC, BatchStrideC, CLayout{}));
     Tensor<CDataType> c_g_m_o_device_result(
         f_host_tensor_descriptor(BatchCount, M, O, StrideC, BatchStrideC, CLayout{}));
-    // Host verification: Output of Gemm0 is input A of Gemm1
-    Tensor<AccDataType> acc0_g_m_n(f_host_tensor_descriptor(BatchCount, M, N, N, M * N, Row{}));
-    Tensor<ADataType> a1_g_m_n(f_host_tensor_descriptor(BatchCount, M, N, N, M * N, Row{}));
 
     std::cout << "a_g_m_k: " << a_g_m_k.mDesc << std::endl;
     std::cout << "b0_g_k_n: " << b0_g_k_n.mDesc << std::endl;
     std::cout << "b1_g_n_o: " << b1_g_n_o.mDesc << std::endl;
     std::cout << "c_g_m_o: " << c_g_m_o_host_result.mDesc << std::endl;
 
-    std::srand(1); // work around test flakiness
+    ck::host_common::reset_host_random_streams(); // work around test flakiness
     switch(init_method)
     {
     case 0: break;
@@ -213,40 +207,68 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
                                                                             MaskOutUpperTriangle>;
 
     // get device op instances
-    const auto op_ptrs = tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results("batched_gemm_softmax_gemm",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, B0DataType, B1DataType, CDataType>()
+                                         .AddLayouts<ALayout, B0Layout, B1Layout, CLayout>()
+                                         .Add("MaskOutUpperTriangle", MaskOutUpperTriangle)
+                                         .Add("M", M)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("O", O)
+                                         .Add("BatchCount", BatchCount)
+                                         .Add("StrideA", StrideA)
+                                         .Add("StrideB0", StrideB0)
+                                         .Add("StrideB1", StrideB1)
+                                         .Add("StrideC", StrideC)
+                                         .Add("BatchStrideA", BatchStrideA)
+                                         .Add("BatchStrideB0", BatchStrideB0)
+                                         .Add("BatchStrideB1", BatchStrideB1)
+                                         .Add("BatchStrideC", BatchStrideC)
+                                         .Add("alpha", alpha));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        auto ref_gemm0          = ReferenceGemm0Instance{};
-        auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
-        auto ref_gemm0_argument = ref_gemm0.MakeArgument(
-            a_g_m_k, b0_g_k_n, acc0_g_m_n, a_element_op, b0_element_op, Scale{alpha});
-
-        ref_gemm0_invoker.Run(ref_gemm0_argument);
-
-        // mask out upper triangle
-        acc0_g_m_n.ForEach([&](auto& self, auto idx) {
-            if(MaskOutUpperTriangle && idx[1] < idx[2])
-                self(idx) = -ck::NumericLimits<float>::Infinity();
+        const auto key = ck::host_common::HostReferenceCacheKey("batched_gemm_softmax_gemm")
+                             .AddType<ReferenceInstance>()
+                             .AddObject(a_element_op)
+                             .AddObject(b0_element_op)
+                             .AddObject(acc0_element_op, acc0_element_op.scale_)
+                             .AddObject(b1_element_op)
+                             .AddObject(c_element_op)
+                             .Add(a_g_m_k)
+                             .Add(b0_g_k_n)
+                             .Add(b1_g_n_o);
+
+        verification.Submit([&, key] {
+            auto ref          = ReferenceInstance{};
+            auto ref_invoker  = ref.MakeInvoker();
+            auto ref_argument = ref.MakeArgument(a_g_m_k,
+                                                 b0_g_k_n,
+                                                 b1_g_n_o,
+                                                 c_g_m_o_host_result,
+                                                 a_element_op,
+                                                 b0_element_op,
+                                                 acc0_element_op,
+                                                 b1_element_op,
+                                                 c_element_op);
+
+            ck::host_common::compute_cached_host_reference(
+                key, c_g_m_o_host_result, [&] { ref_invoker.Run(ref_argument); });
+
+            return true;
         });
-
-        auto ref_softmax          = ReferenceSoftmaxInstance{};
-        auto ref_softmax_invoker  = ref_softmax.MakeInvoker();
-        auto ref_softmax_argument = ref_softmax.MakeArgument(acc0_g_m_n, a1_g_m_n, 1, 0, {2});
-
-        ref_softmax_invoker.Run(ref_softmax_argument);
-
-        auto ref_gemm1          = ReferenceGemm1Instance{};
-        auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
-        auto ref_gemm1_argument = ref_gemm1.MakeArgument(
-            a1_g_m_n, b1_g_n_o, c_g_m_o_host_result, PassThrough{}, b1_element_op, c_element_op);
-
-        ref_gemm1_invoker.Run(ref_gemm1_argument);
     }
 
+    const auto& c_g_m_o_desc = c_g_m_o_device_result.mDesc;
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -300,6 +322,8 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -310,33 +334,55 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
 
             if(do_verification)
             {
-                c_g_m_o_device_buf.FromDevice(c_g_m_o_device_result.mData.data());
-
-                pass = pass & ck::utils::check_err(c_g_m_o_device_result, c_g_m_o_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a_g_m_k: ", a_g_m_k.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b0_g_k_n : ", b0_g_k_n.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b1_g_n_o : ", b1_g_n_o.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_g_m_o_host_result : ", c_g_m_o_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_g_m_o_device_result : ", c_g_m_o_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_g_m_o_device_data(c_g_m_o_desc.GetElementSpaceSize());
+
+                c_g_m_o_device_buf.FromDevice(c_g_m_o_device_data.data());
+
+                const std::size_t c_bytes = sizeof(CDataType) * c_g_m_o_device_data.size();
+
+                auto compare = [&, op_name, c_g_m_o_device_data = std::move(c_g_m_o_device_data)] {
+                    const TensorView<const CDataType> c_g_m_o_device_view(
+                        c_g_m_o_device_data.data(), c_g_m_o_desc);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a_g_m_k: ", a_g_m_k.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "b0_g_k_n : ", b0_g_k_n.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "b1_g_n_o : ", b1_g_n_o.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_g_m_o_host_result : ", c_g_m_o_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_g_m_o_device_result : ", c_g_m_o_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(c_g_m_o_device_view,
+                                                c_g_m_o_host_result,
+                                                "Error: Incorrect results of " + op_name + "!");
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
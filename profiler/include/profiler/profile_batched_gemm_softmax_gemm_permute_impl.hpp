@@ -17,8 +17,11 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm_softmax_gemm.hpp"
+
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -57,29 +60,20 @@ bool profile_batched_gemm_softmax_gemm_permute_impl(bool do_verification,
     using B1ElementOp   = PassThrough;
     using CElementOp    = PassThrough;
     using AccDataType   = float;
-    using tensor_operation::device::MaskingSpecialization;
-
-    // Ref Gemm0: various type in, fp32 out
-    using ReferenceGemm0Instance = tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B0DataType,
-                                                                                AccDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B0ElementOp,
-                                                                                Acc0ElementOp>;
-
-    // Ref Softmax: fp32 in, various type out
-    using ReferenceSoftmaxInstance =
-        tensor_operation::host::ReferenceSoftmax<AccDataType, ADataType, AccDataType>;
-
-    // Ref Gemm1: various type in, various type out
-    using ReferenceGemm1Instance = tensor_operation::host::ReferenceBatchedGemm<ADataType,
-                                                                                B1DataType,
-                                                                                CDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                B1ElementOp,
-                                                                                CElementOp>;
+
+    // Ref Gemm0 -> Softmax -> Gemm1, fused so that no [G, M, N] intermediate is allocated
+    using ReferenceInstance =
+        tensor_operation::host::ReferenceBatchedGemmSoftmaxGemm<ADataType,
+                                                                B0DataType,
+                                                                B1DataType,
+                                                                CDataType,
+                                                                AccDataType,
+                                                                AElementOp,
+                                                                B0ElementOp,
+                                                                Acc0ElementOp,
+                                                                B1ElementOp,
+                                                                CElementOp,
+                                                                MaskingSpec>;
 
     bool pass = true;
 
@@ -112,7 +106,7 @@ bool profile_batched_gemm_softmax_gemm_permute_impl(bool do_verification,
     std::cout << "b1_gs_os_ns: " << b1_gs_os_ns.mDesc << std::endl;
     std::cout << "c_gs_ms_os: " << c_gs_ms_os_host_result.mDesc << std::endl;
 
-    std::srand(1); // work around test flakiness
+    ck::host_common::reset_host_random_streams(); // work around test flakiness
     switch(init_method)
     {
     case 0: break;
@@ -183,70 +177,57 @@ bool profile_batched_gemm_softmax_gemm_permute_impl(bool do_verification,
                                                                                    MaskingSpec>;
 
     // get device op instances
-    const auto op_ptrs = tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "batched_gemm_softmax_gemm_permute",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, B0DataType, B1DataType, CDataType>()
+            .Add("NumDims", std::vector<index_t>{NumDimG, NumDimM, NumDimN, NumDimK, NumDimO})
+            .Add("MaskingSpec", static_cast<int>(MaskingSpec))
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("O", O)
+            .Add("G0", G0)
+            .Add("G1", G1)
+            .Add("alpha", alpha));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        c_device_buf.FromDevice(c_gs_ms_os_device_result.mData.data());
-
-        Tensor<ADataType> a_g_m_k({BatchCount, M, K});
-        Tensor<B0DataType> b0_g_k_n({BatchCount, K, N});
-        Tensor<B1DataType> b1_g_n_o({BatchCount, N, O});
-        Tensor<AccDataType> acc0_g_m_n({BatchCount, M, N});        // scratch object after gemm0
-        Tensor<ADataType> a1_g_m_n({BatchCount, M, N});            // scratch object after softmax
-        Tensor<CDataType> c_g_m_o_host_result({BatchCount, M, O}); // scratch object after gemm1
-
-        // permute
-        a_gs_ms_ks.ForEach([&](auto& self, auto idx) {
-            a_g_m_k(idx[0] * G1 + idx[1], idx[2], idx[3]) = self(idx);
-        });
-        b0_gs_ns_ks.ForEach([&](auto& self, auto idx) {
-            b0_g_k_n(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
-        });
-        b1_gs_os_ns.ForEach([&](auto& self, auto idx) {
-            b1_g_n_o(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
-        });
-
-        auto ref_gemm0          = ReferenceGemm0Instance{};
-        auto ref_gemm0_invoker  = ref_gemm0.MakeInvoker();
-        auto ref_gemm0_argument = ref_gemm0.MakeArgument(
-            a_g_m_k, b0_g_k_n, acc0_g_m_n, a_element_op, b0_element_op, Scale{alpha});
-
-        ref_gemm0_invoker.Run(ref_gemm0_argument);
-
-        // mask out upper triangle
-        acc0_g_m_n.ForEach([&](auto& self, auto idx) {
-            if(MaskingSpec == MaskingSpecialization::MaskOutUpperTriangle && idx[1] < idx[2])
-                self(idx) = -ck::NumericLimits<float>::Infinity();
-        });
-
-        auto ref_softmax          = ReferenceSoftmaxInstance{};
-        auto ref_softmax_invoker  = ref_softmax.MakeInvoker();
-        auto ref_softmax_argument = ref_softmax.MakeArgument(acc0_g_m_n, a1_g_m_n, 1, 0, {2});
-
-        ref_softmax_invoker.Run(ref_softmax_argument);
-
-        auto ref_gemm1          = ReferenceGemm1Instance{};
-        auto ref_gemm1_invoker  = ref_gemm1.MakeInvoker();
-        auto ref_gemm1_argument = ref_gemm1.MakeArgument(
-            a1_g_m_n, b1_g_n_o, c_g_m_o_host_result, PassThrough{}, b1_element_op, c_element_op);
-
-        ref_gemm1_invoker.Run(ref_gemm1_argument);
-
-        // permute
-        c_gs_ms_os_host_result.ForEach([&](auto& self, auto idx) {
-            const size_t& g0 = idx[0];
-            const size_t& g1 = idx[1];
-
-            const size_t g = g0 * G1 + g1;
-
-            self(idx) = c_g_m_o_host_result(g, idx[2], idx[3]);
+        verification.Submit([&] {
+            // [G0, G1, K, N] and [G0, G1, N, O] views over the storage of B0 and B1, not copies;
+            // A and C are used as they are
+            const auto b0_gs_ks_ns =
+                TensorView(b0_gs_ns_ks).Transpose(std::vector<std::size_t>{0, 1, 3, 2});
+            const auto b1_gs_ns_os =
+                TensorView(b1_gs_os_ns).Transpose(std::vector<std::size_t>{0, 1, 3, 2});
+
+            auto ref          = ReferenceInstance{};
+            auto ref_invoker  = ref.MakeInvoker();
+            auto ref_argument = ref.MakeArgument(a_gs_ms_ks,
+                                                 b0_gs_ks_ns,
+                                                 b1_gs_ns_os,
+                                                 c_gs_ms_os_host_result,
+                                                 a_element_op,
+                                                 b0_element_op,
+                                                 acc0_element_op,
+                                                 b1_element_op,
+                                                 c_element_op);
+
+            ref_invoker.Run(ref_argument);
+
+            return true;
         });
     }
 
+    const auto& c_gs_ms_os_desc = c_gs_ms_os_device_result.mDesc;
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -301,6 +282,8 @@ bool profile_batched_gemm_softmax_gemm_permute_impl(bool do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -311,52 +294,78 @@ bool profile_batched_gemm_softmax_gemm_permute_impl(bool do_verification,
 
             if(do_verification)
             {
-                c_device_buf.FromDevice(c_gs_ms_os_device_result.mData.data());
-
-                // default absolute error and relative error is 0.001
-                double rtol = 1e-3;
-                double atol = 1e-3;
-
-                // when BF16 is taken, set absolute error and relative error to 0.01
-                if(std::is_same_v<ADataType, ck::bhalf_t> &&
-                   std::is_same_v<B0DataType, ck::bhalf_t> &&
-                   std::is_same_v<B1DataType, ck::bhalf_t> &&
-                   std::is_same_v<CDataType, ck::bhalf_t>)
-                {
-                    rtol = 1e-2;
-                    atol = 1e-2;
-                }
-
-                pass = pass & ck::utils::check_err(c_gs_ms_os_device_result,
-                                                   c_gs_ms_os_host_result,
-                                                   "Error: Incorrect results!",
-                                                   rtol,
-                                                   atol);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a_gs_ms_ks: ", a_gs_ms_ks.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b0_gs_ns_ks : ", b0_gs_ns_ks.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "b1_gs_os_ns : ", b1_gs_os_ns.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "c_gs_ms_os_host_result : ", c_gs_ms_os_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_gs_ms_os_device_result : ",
-                                          c_gs_ms_os_device_result.mData,
-                                          ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_gs_ms_os_device_data(
+                    c_gs_ms_os_desc.GetElementSpaceSize());
+
+                c_device_buf.FromDevice(c_gs_ms_os_device_data.data());
+
+                const std::size_t c_bytes = sizeof(CDataType) * c_gs_ms_os_device_data.size();
+
+                auto compare =
+                    [&, op_name, c_gs_ms_os_device_data = std::move(c_gs_ms_os_device_data)] {
+                        const TensorView<const CDataType> c_gs_ms_os_device_view(
+                            c_gs_ms_os_device_data.data(), c_gs_ms_os_desc);
+
+                        // default absolute error and relative error is 0.001
+                        double rtol = 1e-3;
+                        double atol = 1e-3;
+
+                        // when BF16 is taken, set absolute error and relative error to 0.01
+                        if(std::is_same_v<ADataType, ck::bhalf_t> &&
+                           std::is_same_v<B0DataType, ck::bhalf_t> &&
+                           std::is_same_v<B1DataType, ck::bhalf_t> &&
+                           std::is_same_v<CDataType, ck::bhalf_t>)
+                        {
+                            rtol = 1e-2;
+                            atol = 1e-2;
+                        }
+
+                        if(do_log)
+                        {
+                            LogRangeAsType<float>(
+                                std::cout << "a_gs_ms_ks: ", a_gs_ms_ks.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "b0_gs_ns_ks : ", b0_gs_ns_ks.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "b1_gs_os_ns : ", b1_gs_os_ns.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(std::cout << "c_gs_ms_os_host_result : ",
+                                                  c_gs_ms_os_host_result.mData,
+                                                  ",")
+                                << std::endl;
+                            LogRangeAsType<float>(std::cout << "c_gs_ms_os_device_result : ",
+                                                  c_gs_ms_os_device_data,
+                                                  ",")
+                                << std::endl;
+                        }
+
+                        return ck::utils::check_err(c_gs_ms_os_device_view,
+                                                    c_gs_ms_os_host_result,
+                                                    "Error: Incorrect results of " + op_name + "!",
+                                                    rtol,
+                                                    atol);
+                    };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
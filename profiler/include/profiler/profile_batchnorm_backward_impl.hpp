@@ -15,6 +15,9 @@
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_backward.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_backward.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -205,9 +208,7 @@ bool profile_batchnorm_backward_impl(bool do_verification,
                                                                       NumBatchNormReduceDim>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
@@ -264,6 +265,15 @@ bool profile_batchnorm_backward_impl(bool do_verification,
         (void)invoker_ptr_ref->Run(argument_ptr_ref.get());
     }
 
+    ProfilerResults profiler_results(
+        "batchnorm_bwd",
+        ProblemDescriptor{}
+            .AddTypes<XDataType, DxDataType, DyDataType, AccDataType, ScaleDataType>()
+            .Add("lengths", inOutLengths)
+            .Add("reduce_dims", reduceDims)
+            .Add("saved_mean_inv_var", haveSavedMeanInvVar)
+            .Add("epsilon", epsilon));
+
     int num_kernel = 0;
     bool pass      = true;
 
@@ -296,6 +306,8 @@ bool profile_batchnorm_backward_impl(bool do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString()
@@ -327,6 +339,8 @@ bool profile_batchnorm_backward_impl(bool do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(time_kernel)
             std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
@@ -353,7 +367,7 @@ bool profile_batchnorm_backward_impl(bool do_verification,
             single_pass = single_pass && ck::utils::check_err(dbias.mData, dbias_ref.mData, "dBias result:", 3e-3, 3e-3);
             // clang-format on
 
-            pass = pass && single_pass;
+            pass = profiler_results.RecordVerification(single_pass) && pass;
         };
 
         if(do_dumpout)
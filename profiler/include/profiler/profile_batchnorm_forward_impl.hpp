@@ -15,6 +15,9 @@
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_forward.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_forward.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -200,9 +203,7 @@ bool profile_batchnorm_forward_impl(int do_verification,
                                                                       NumBatchNormReduceDim>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
@@ -258,6 +259,17 @@ bool profile_batchnorm_forward_impl(int do_verification,
         (void)invoker_ptr_ref->Run(argument_ptr_ref.get());
     }
 
+    ProfilerResults profiler_results(
+        "batchnorm_fwd",
+        ProblemDescriptor{}
+            .AddTypes<XDataType, YDataType, AccDataType, ScaleDataType, BiasDataType>()
+            .Add("lengths", inOutLengths)
+            .Add("reduce_dims", reduceDims)
+            .Add("update_moving_average", updateMovingAverage)
+            .Add("save_mean_inv_variance", saveMeanAndInvVariance)
+            .Add("average_factor", averageFactor)
+            .Add("epsilon", epsilon));
+
     int num_kernel = 0;
     bool pass      = true;
 
@@ -290,6 +302,8 @@ bool profile_batchnorm_forward_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString()
@@ -323,6 +337,8 @@ bool profile_batchnorm_forward_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(time_kernel)
             std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
@@ -368,7 +384,7 @@ bool profile_batchnorm_forward_impl(int do_verification,
                 // clang-format on
             };
 
-            pass = pass && single_pass;
+            pass = profiler_results.RecordVerification(single_pass) && pass;
         };
 
         if(do_dumpout)
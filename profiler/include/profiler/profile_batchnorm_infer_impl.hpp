@@ -15,6 +15,9 @@
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_infer.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_infer.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -174,9 +177,7 @@ bool profile_batchnorm_infer_impl(int do_verification,
         Rank>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
@@ -230,6 +231,14 @@ bool profile_batchnorm_infer_impl(int do_verification,
         (void)invoker_ptr_ref->Run(argument_ptr_ref.get());
     }
 
+    ProfilerResults profiler_results(
+        "batchnorm_infer",
+        ProblemDescriptor{}
+            .AddTypes<XDataType, YDataType, AccDataType, ScaleDataType, BiasDataType>()
+            .Add("lengths", inOutLengths)
+            .Add("reduce_dims", reduceDims)
+            .Add("epsilon", epsilon));
+
     int num_kernel = 0;
     bool pass      = true;
 
@@ -256,6 +265,8 @@ bool profile_batchnorm_infer_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString()
@@ -278,6 +289,8 @@ bool profile_batchnorm_infer_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(time_kernel)
             std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
@@ -301,7 +314,7 @@ bool profile_batchnorm_infer_impl(int do_verification,
             else
                 single_pass = check_err(y.mData, y_ref.mData, "y results", 4e-3, 4e-3);
 
-            pass = pass && single_pass;
+            pass = profiler_results.RecordVerification(single_pass) && pass;
         };
 
         if(do_dumpout)
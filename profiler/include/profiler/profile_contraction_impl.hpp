@@ -25,6 +25,9 @@
 
 #include "ck/host_utility/io.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -121,8 +124,7 @@ int profile_contraction_impl(ck::index_t do_verification,
                                                                               CDElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
@@ -179,6 +181,19 @@ int profile_contraction_impl(ck::index_t do_verification,
         }
     }
 
+    ProfilerResults profiler_results("contraction",
+                                     ProblemDescriptor{}
+                                         .AddTypes<DataType>()
+                                         .AddLayouts<ALayout, BLayout, CDELayout>()
+                                         .Add("num_d", DTupleDataType::Size())
+                                         .Add("M", M)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("StridesA", StridesA)
+                                         .Add("StridesB", StridesB)
+                                         .Add("StridesE", StridesE)
+                                         .Add("StridesD", StridesD));
+
     std::string best_op_name;
     float best_avg_time   = 0;
     float best_tflops     = 0;
@@ -260,6 +275,8 @@ int profile_contraction_impl(ck::index_t do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -274,11 +291,12 @@ int profile_contraction_impl(ck::index_t do_verification,
 
                 float threshold =
                     static_cast<DataType>(nelems_k) * std::numeric_limits<DataType>::epsilon();
-                pass = pass & ck::utils::check_err(e_m_n_device_result,
-                                                   e_m_n_host_result,
-                                                   "Error: incorrect results!",
-                                                   threshold,
-                                                   threshold);
+                pass = pass & profiler_results.RecordVerification(
+                                  ck::utils::check_err(e_m_n_device_result,
+                                                       e_m_n_host_result,
+                                                       "Error: incorrect results!",
+                                                       threshold,
+                                                       threshold));
 
                 if(do_log)
                 {
@@ -293,6 +311,8 @@ int profile_contraction_impl(ck::index_t do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
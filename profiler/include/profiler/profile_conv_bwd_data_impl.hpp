@@ -18,6 +18,9 @@
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -142,11 +145,16 @@ bool profile_conv_bwd_data_impl(int do_verification,
                                                                      OutElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results("conv_bwd_data",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, WeiDataType, OutDataType>()
+                                         .AddLayouts<InLayout, WeiLayout, OutLayout>()
+                                         .Add(conv_param));
+
     std::string best_op_name;
     float best_avg_time   = 0;
     float best_tflops     = 0;
@@ -197,6 +205,8 @@ bool profile_conv_bwd_data_impl(int do_verification,
             std::cout << "Perf: " << avg_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s" << std::endl;
 
+            profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -209,7 +219,8 @@ bool profile_conv_bwd_data_impl(int do_verification,
             {
                 in_device_buf.FromDevice(input_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(input_device_result, input_host_result);
+                pass = pass & profiler_results.RecordVerification(
+                                  ck::utils::check_err(input_device_result, input_host_result));
 
                 if(do_log)
                 {
@@ -233,6 +244,8 @@ bool profile_conv_bwd_data_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
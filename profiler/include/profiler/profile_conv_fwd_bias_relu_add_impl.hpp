@@ -15,6 +15,8 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd_bias_activation_add.hpp"
 
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -188,6 +190,21 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
         throw std::runtime_error("wrong! no device Conv instance found");
     }
 
+    ProfilerResults profiler_results("conv_fwd_bias_relu_add",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, WeiDataType, OutDataType>()
+                                         .AddLayouts<InLayout, WeiLayout, OutLayout>()
+                                         .Add("NDimSpatial", NDimSpatial)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("C", C)
+                                         .Add("filter", filter_spatial_lengths)
+                                         .Add("input", input_spatial_lengths)
+                                         .Add("strides", conv_filter_strides)
+                                         .Add("dilations", conv_filter_dilations)
+                                         .Add("left_pads", input_left_pads)
+                                         .Add("right_pads", input_right_pads));
+
     std::string best_conv_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -239,6 +256,8 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << conv_name << std::endl;
 
+            profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_conv_name  = conv_name;
@@ -251,7 +270,8 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
             {
                 out_device_buf.FromDevice(out_n_k_ho_wo_device_result.mData.data());
 
-                ck::utils::check_err(out_n_k_ho_wo_device_result, out_n_k_ho_wo_host_result);
+                profiler_results.RecordVerification(
+                    ck::utils::check_err(out_n_k_ho_wo_device_result, out_n_k_ho_wo_host_result));
 
                 if(do_log)
                 {
@@ -268,6 +288,10 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
                 }
             }
         }
+        else
+        {
+            profiler_results.AddUnsupported(*op_ptr);
+        }
     }
 
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
@@ -23,6 +23,9 @@
 #include "ck/library/reference_tensor_operation/cpu/reference_image_to_column.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_column_to_image.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -194,11 +197,17 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
                                                                              ConvTensorRearrangeOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results("conv_tensor_rearrange",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InputDataType, OutputDataType>()
+                                         .AddLayouts<InputLayout>()
+                                         .Add("op", ConvTensorRearrangeOp::name)
+                                         .Add(conv_param));
+
     std::string best_op_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -239,6 +248,8 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << op_name << std::endl;
 
+            profiler_results.Add(*op_ptr, avg_time, 0, gb_per_sec);
+
             if(avg_time < best_avg_time)
             {
                 best_op_name    = op_name;
@@ -249,7 +260,8 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
             if(do_verification)
             {
                 out_device_buf.FromDevice(device_output.mData.data());
-                pass = pass & ck::utils::check_err(device_output, host_output);
+                pass = pass & profiler_results.RecordVerification(
+                                  ck::utils::check_err(device_output, host_output));
 
                 if(do_log)
                 {
@@ -263,6 +275,8 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
@@ -16,27 +16,26 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
 template <typename HostTensorA, typename HostTensorB, typename HostTensorC, typename Functor>
-void host_elementwise2D(HostTensorC& C,
-                        const HostTensorA& A,
-                        const HostTensorB& B,
-                        const std::vector<std::size_t>& shape,
-                        Functor functor)
+void host_elementwise2D(HostTensorC& C, const HostTensorA& A, const HostTensorB& B, Functor functor)
 {
     using ctype = ck::remove_reference_t<decltype(C(0, 0))>;
 
-    for(std::size_t m = 0; m < shape[0]; ++m)
-        for(std::size_t n = 0; n < shape[1]; ++n)
-        {
-            auto a_val  = A(m, n);
-            auto b_val  = B(m, n);
+    make_host_tensor_traversal(C.mDesc, A.mDesc, B.mDesc)(
+        [&](const auto& offsets) {
+            auto a_val  = A.mData[offsets[1]];
+            auto b_val  = B.mData[offsets[2]];
             ctype c_val = 0;
             functor(c_val, a_val, b_val);
-            C(m, n) = c_val;
-        }
+            C.mData[offsets[0]] = c_val;
+        },
+        std::thread::hardware_concurrency());
 }
 
 template <typename ADataType,
@@ -128,24 +127,27 @@ bool profile_elementwise_layernorm_impl(int do_verification,
         1>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "elementwise_layernorm",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, GammaDataType, BetaDataType, AccDataType, YDataType>()
+            .Add("M", M)
+            .Add("N", N));
+
     std::string best_instance_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
 
     if(do_verification)
     {
-        using XDataType             = ADataType;
-        std::vector<std::size_t> mn = {static_cast<unsigned long>(M),
-                                       static_cast<unsigned long>(N)};
+        using XDataType = ADataType;
         Tensor<XDataType> x(f_host_tensor_descriptor2d(M, N, Stride));
         host_elementwise2D<Tensor<ADataType>, Tensor<BDataType>, Tensor<XDataType>, Add>(
-            x, a, b, mn, Add{});
+            x, a, b, Add{});
 
         using ReferenceInstance = ck::tensor_operation::host::ReferenceLayernorm<XDataType,
                                                                                  GammaDataType,
@@ -191,6 +193,8 @@ bool profile_elementwise_layernorm_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             continue;
         }
 
@@ -210,6 +214,8 @@ bool profile_elementwise_layernorm_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(avg_time < best_avg_time)
         {
             best_instance_name = inst_ptr->GetTypeString();
@@ -221,8 +227,8 @@ bool profile_elementwise_layernorm_impl(int do_verification,
         {
             y_dev.FromDevice(y.mData.data());
 
-            bool pass =
-                ck::utils::check_err(y.mData, host_y.mData, "Error: Incorrect results", 1e-3, 1e-3);
+            bool pass = profiler_results.RecordVerification(ck::utils::check_err(
+                y.mData, host_y.mData, "Error: Incorrect results", 1e-3, 1e-3));
 
             if(do_log)
             {
@@ -17,8 +17,12 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -114,51 +118,74 @@ bool profile_gemm_add_add_fastgelu_impl(int do_verification,
         ck::tensor_operation::element_wise::AddAddFastGelu>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // run reference
+    DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
+    DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
+    DeviceMem d0_m_n_device_buf(sizeof(D0DataType) * d0_m_n.mDesc.GetElementSpaceSize());
+    DeviceMem d1_m_n_device_buf(sizeof(D1DataType) * d1_m_n.mDesc.GetElementSpaceSize());
+    DeviceMem e_device_buf(sizeof(EDataType) * e_m_n_device_result.mDesc.GetElementSpaceSize());
+
+    a_device_buf.ToDevice(a_m_k.mData.data());
+    b_device_buf.ToDevice(b_k_n.mData.data());
+    d0_m_n_device_buf.ToDevice(d0_m_n.mData.data());
+    d1_m_n_device_buf.ToDevice(d1_m_n.mData.data());
+
+    ProfilerResults profiler_results(
+        "gemm_add_add_fastgelu",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, AccDataType, D0DataType, D1DataType, EDataType>()
+            .AddLayouts<ALayout, BLayout, D0Layout, D1Layout, ELayout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("StrideA", StrideA)
+            .Add("StrideB", StrideB)
+            .Add("StrideD0", StrideD0)
+            .Add("StrideD1", StrideD1)
+            .Add("StrideE", StrideE));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        Tensor<AccDataType> c_m_n({M, N});
+        verification.Submit([&] {
+            Tensor<AccDataType> c_m_n({M, N});
 
-        using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                                BDataType,
-                                                                                AccDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                BElementOp,
-                                                                                PassThrough>;
+            using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                                                    BDataType,
+                                                                                    AccDataType,
+                                                                                    AccDataType,
+                                                                                    AElementOp,
+                                                                                    BElementOp,
+                                                                                    PassThrough>;
 
-        auto ref_gemm    = ReferenceGemmInstance{};
-        auto ref_invoker = ref_gemm.MakeInvoker();
+            auto ref_gemm    = ReferenceGemmInstance{};
+            auto ref_invoker = ref_gemm.MakeInvoker();
 
-        auto ref_argument =
-            ref_gemm.MakeArgument(a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, PassThrough{});
+            auto ref_argument = ref_gemm.MakeArgument(
+                a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, PassThrough{});
 
-        ref_invoker.Run(ref_argument);
+            ref_invoker.Run(ref_argument);
 
-        for(int m = 0; m < M; ++m)
-        {
-            for(int n = 0; n < N; ++n)
+            for(int m = 0; m < M; ++m)
             {
-                cde_element_op(e_m_n_host_result(m, n), c_m_n(m, n), d0_m_n(m, n), d1_m_n(m, n));
+                for(int n = 0; n < N; ++n)
+                {
+                    cde_element_op(
+                        e_m_n_host_result(m, n), c_m_n(m, n), d0_m_n(m, n), d1_m_n(m, n));
+                }
             }
-        }
-    }
 
-    DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
-    DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
-    DeviceMem d0_m_n_device_buf(sizeof(D0DataType) * d0_m_n.mDesc.GetElementSpaceSize());
-    DeviceMem d1_m_n_device_buf(sizeof(D1DataType) * d1_m_n.mDesc.GetElementSpaceSize());
-    DeviceMem e_device_buf(sizeof(EDataType) * e_m_n_device_result.mDesc.GetElementSpaceSize());
+            return true;
+        });
+    }
 
-    a_device_buf.ToDevice(a_m_k.mData.data());
-    b_device_buf.ToDevice(b_k_n.mData.data());
-    d0_m_n_device_buf.ToDevice(d0_m_n.mData.data());
-    d1_m_n_device_buf.ToDevice(d1_m_n.mData.data());
+    const auto& e_m_n_desc    = e_m_n_device_result.mDesc;
+    const std::size_t e_bytes = sizeof(EDataType) * e_m_n_desc.GetElementSpaceSize();
 
     std::string best_op_name;
     float best_ave_time   = 0;
@@ -211,6 +238,8 @@ bool profile_gemm_add_add_fastgelu_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -221,17 +250,37 @@ bool profile_gemm_add_add_fastgelu_impl(int do_verification,
 
             if(do_verification)
             {
-                e_device_buf.FromDevice(e_m_n_device_result.mData.data());
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<EDataType> e_m_n_device_data(e_m_n_desc.GetElementSpaceSize());
+
+                e_device_buf.FromDevice(e_m_n_device_data.data(), e_bytes);
 
-                pass = pass && ck::utils::check_err(e_m_n_device_result, e_m_n_host_result);
+                auto compare = [&, op_name, e_m_n_device_data = std::move(e_m_n_device_data)] {
+                    const TensorView<const EDataType> e_m_n_device_view(e_m_n_device_data.data(),
+                                                                        e_m_n_desc);
+
+                    return ck::utils::check_err(e_m_n_device_view,
+                                                e_m_n_host_result,
+                                                "Error: Incorrect results of " + op_name + "!");
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    e_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_name << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_op_name << std::endl;
 
@@ -17,9 +17,13 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -199,38 +203,10 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
         ck::tensor_operation::element_wise::PassThrough>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // run reference
-    if(do_verification)
-    {
-        host_gemm_layernorm<ADataType,
-                            BDataType,
-                            AccDataType,
-                            D0DataType,
-                            D1DataType,
-                            EMeanVarDataType,
-                            GammaDataType,
-                            BetaDataType,
-                            HDataType>(h_m_n_host,
-                                       a_m_k,
-                                       b_k_n,
-                                       d0_m_n,
-                                       d1_m_n,
-                                       gamma_n,
-                                       beta_n,
-                                       a_element_op,
-                                       b_element_op,
-                                       cde_element_op,
-                                       h_element_op,
-                                       M,
-                                       N,
-                                       epsilon);
-    }
-
     DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
     DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
     DeviceMem d0_m_n_device_buf(sizeof(D0DataType) * d0_m_n.mDesc.GetElementSpaceSize());
@@ -246,6 +222,49 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
     gamma_device_buf.ToDevice(gamma_n.mData.data());
     beta_device_buf.ToDevice(beta_n.mData.data());
 
+    ProfilerResults profiler_results(
+        "gemm_add_relu_add_layernorm",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, D0DataType, D1DataType, HDataType>()
+            .AddLayouts<ALayout, BLayout, D0Layout, D1Layout, HLayout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        verification.Submit([&] {
+            host_gemm_layernorm<ADataType,
+                                BDataType,
+                                AccDataType,
+                                D0DataType,
+                                D1DataType,
+                                EMeanVarDataType,
+                                GammaDataType,
+                                BetaDataType,
+                                HDataType>(h_m_n_host,
+                                           a_m_k,
+                                           b_k_n,
+                                           d0_m_n,
+                                           d1_m_n,
+                                           gamma_n,
+                                           beta_n,
+                                           a_element_op,
+                                           b_element_op,
+                                           cde_element_op,
+                                           h_element_op,
+                                           M,
+                                           N,
+                                           epsilon);
+            return true;
+        });
+    }
+
+    const auto& h_m_n_desc = h_m_n.mDesc;
+
     std::string best_op_name;
     float best_ave_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -305,6 +324,8 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
                 std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << gb_per_sec
                           << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, ave_time, 0, gb_per_sec);
+
             if(ave_time < best_ave_time)
             {
                 best_op_name    = op_name;
@@ -314,19 +335,42 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
 
             if(do_verification)
             {
-                h_device_buf.FromDevice(h_m_n.mData.data());
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<HDataType> h_m_n_device_data(h_m_n_desc.GetElementSpaceSize());
+
+                h_device_buf.FromDevice(h_m_n_device_data.data());
+
+                const std::size_t bytes = sizeof(HDataType) * h_m_n_device_data.size();
 
-                pass = pass && ck::utils::check_err(
-                                   h_m_n, h_m_n_host, "Error: Incorrect results h_m_n", 1e-2, 1e-2);
+                auto compare = [&, h_m_n_device_data = std::move(h_m_n_device_data)] {
+                    const TensorView<const HDataType> h_m_n_device_view(h_m_n_device_data.data(),
+                                                                        h_m_n_desc);
+
+                    return ck::utils::check_err(h_m_n_device_view,
+                                                h_m_n_host,
+                                                "Error: Incorrect results h_m_n",
+                                                1e-2,
+                                                1e-2);
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             if(time_kernel)
                 std::cout << op_name << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     if(num_kernel == 0)
     {
         std::cout << "Error: No kernel is applicable" << std::endl;
@@ -15,8 +15,11 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -117,14 +120,14 @@ void profile_gemm_bias_add_reduce_impl(int do_verification,
     {
     case 0: break;
     case 1:
-        std::srand(0);
+        ck::host_common::reset_host_random_streams();
         a_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-5, 5}, num_thread);
         b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5}, num_thread);
         bias_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5}, num_thread);
         d0_m_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5}, num_thread);
         break;
     default:
-        std::srand(0);
+        ck::host_common::reset_host_random_streams();
         a_m_k.GenerateTensorValue(GeneratorTensor_3<ADataType>{0.0, 1.0}, num_thread);
         b_k_n.GenerateTensorValue(GeneratorTensor_3<BDataType>{-0.5, 0.5}, num_thread);
         bias_n.GenerateTensorValue(GeneratorTensor_3<ADataType>{-0.5, 0.5}, num_thread);
@@ -157,62 +160,6 @@ void profile_gemm_bias_add_reduce_impl(int do_verification,
     std::array<void*, 2> reduce_in_element_ops  = {&passthrough, &square};
     std::array<void*, 2> reduce_out_element_ops = {&div, &div};
 
-    if(do_verification)
-    {
-        using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                                BDataType,
-                                                                                CDataType,
-                                                                                ReduceDataType,
-                                                                                AElementOp,
-                                                                                BElementOp,
-                                                                                CElementOp>;
-
-        using ReduceAccDataType = ReduceDataType;
-
-        auto ref_gemm    = ReferenceGemmInstance{};
-        auto ref_invoker = ref_gemm.MakeInvoker();
-
-        auto ref_argument = ref_gemm.MakeArgument(
-            a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, PassThrough{});
-
-        ref_invoker.Run(ref_argument);
-
-        for(int m = 0; m < M; ++m)
-            for(int n = 0; n < N; ++n)
-            {
-                ReduceAccDataType acc = static_cast<ReduceAccDataType>(c_m_n_host_result(m, n)) +
-                                        static_cast<ReduceAccDataType>(bias_n(n));
-
-                ReduceAccDataType d0 = static_cast<ReduceAccDataType>(d0_m_n(m, n));
-                c_element_op(acc, acc);
-                d0_element_op(d0, d0);
-                acc += d0;
-                c_m_n_host_result(m, n) = static_cast<CDataType>(acc);
-            }
-
-        for(int m = 0; m < M; ++m)
-        {
-            auto reduce0_acc = reduce0_op.GetIdentityValue<ReduceAccDataType>();
-            auto reduce1_acc = reduce1_op.GetIdentityValue<ReduceAccDataType>();
-
-            for(int n = 0; n < N; ++n)
-            {
-                ReduceAccDataType d0_val =
-                    ck::type_convert<ReduceAccDataType>(c_m_n_host_result(m, n));
-                ReduceAccDataType d1_val;
-
-                square(d1_val, d0_val);
-                reduce0_op(reduce0_acc, d0_val);
-                reduce1_op(reduce1_acc, d1_val);
-            }
-
-            div(reduce0_acc, reduce0_acc);
-            div(reduce1_acc, reduce1_acc);
-            reduce0_m_host_result(m) = ck::type_convert<ReduceDataType>(reduce0_acc);
-            reduce1_m_host_result(m) = ck::type_convert<ReduceDataType>(reduce1_acc);
-        }
-    }
-
     DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
     DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
     DeviceMem c_device_buf(sizeof(CDataType) * c_m_n_device_result.mDesc.GetElementSpaceSize());
@@ -276,6 +223,86 @@ void profile_gemm_bias_add_reduce_impl(int do_verification,
         throw std::runtime_error("wrong! no device GEMM instance found");
     }
 
+    ProfilerResults profiler_results(
+        "gemm_bias_add_reduce",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, CDataType, BiasDataType, D0DataType, ReduceDataType>()
+            .AddLayouts<ALayout, BLayout, CLayout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("StrideA", StrideA)
+            .Add("StrideB", StrideB)
+            .Add("StrideC", StrideC));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        verification.Submit([&] {
+            using ReferenceGemmInstance =
+                ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                          BDataType,
+                                                          CDataType,
+                                                          ReduceDataType,
+                                                          AElementOp,
+                                                          BElementOp,
+                                                          CElementOp>;
+
+            using ReduceAccDataType = ReduceDataType;
+
+            auto ref_gemm    = ReferenceGemmInstance{};
+            auto ref_invoker = ref_gemm.MakeInvoker();
+
+            auto ref_argument = ref_gemm.MakeArgument(
+                a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, PassThrough{});
+
+            ref_invoker.Run(ref_argument);
+
+            for(int m = 0; m < M; ++m)
+                for(int n = 0; n < N; ++n)
+                {
+                    ReduceAccDataType acc =
+                        static_cast<ReduceAccDataType>(c_m_n_host_result(m, n)) +
+                        static_cast<ReduceAccDataType>(bias_n(n));
+
+                    ReduceAccDataType d0 = static_cast<ReduceAccDataType>(d0_m_n(m, n));
+                    c_element_op(acc, acc);
+                    d0_element_op(d0, d0);
+                    acc += d0;
+                    c_m_n_host_result(m, n) = static_cast<CDataType>(acc);
+                }
+
+            for(int m = 0; m < M; ++m)
+            {
+                auto reduce0_acc = reduce0_op.GetIdentityValue<ReduceAccDataType>();
+                auto reduce1_acc = reduce1_op.GetIdentityValue<ReduceAccDataType>();
+
+                for(int n = 0; n < N; ++n)
+                {
+                    ReduceAccDataType d0_val =
+                        ck::type_convert<ReduceAccDataType>(c_m_n_host_result(m, n));
+                    ReduceAccDataType d1_val;
+
+                    square(d1_val, d0_val);
+                    reduce0_op(reduce0_acc, d0_val);
+                    reduce1_op(reduce1_acc, d1_val);
+                }
+
+                div(reduce0_acc, reduce0_acc);
+                div(reduce1_acc, reduce1_acc);
+                reduce0_m_host_result(m) = ck::type_convert<ReduceDataType>(reduce0_acc);
+                reduce1_m_host_result(m) = ck::type_convert<ReduceDataType>(reduce1_acc);
+            }
+
+            return true;
+        });
+    }
+
+    const auto& c_m_n_desc  = c_m_n_device_result.mDesc;
+    const auto& reduce_desc = reduce0_m_device_result.mDesc;
+
     std::string best_gemm_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -329,6 +356,8 @@ void profile_gemm_bias_add_reduce_impl(int do_verification,
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
                       << " GB/s, " << gemm_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*gemm_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_gemm_name  = gemm_name;
@@ -339,43 +368,81 @@ void profile_gemm_bias_add_reduce_impl(int do_verification,
 
             if(do_verification)
             {
-                c_device_buf.FromDevice(c_m_n_device_result.mData.data());
-                reduce0_device_buf.FromDevice(reduce0_m_device_result.mData.data());
-                reduce1_device_buf.FromDevice(reduce1_m_device_result.mData.data());
-
-                ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
-                ck::utils::check_err(reduce0_m_device_result, reduce0_m_host_result);
-                ck::utils::check_err(reduce1_m_device_result, reduce1_m_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_host: ", c_m_n_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d0_host: ", reduce0_m_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d0_device: ", reduce0_m_device_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d1_host: ", reduce1_m_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "d1_device: ", reduce1_m_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not Tensors, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_m_n_device_data(c_m_n_desc.GetElementSpaceSize());
+                std::vector<ReduceDataType> reduce0_m_device_data(
+                    reduce_desc.GetElementSpaceSize());
+                std::vector<ReduceDataType> reduce1_m_device_data(
+                    reduce_desc.GetElementSpaceSize());
+
+                c_device_buf.FromDevice(c_m_n_device_data.data());
+                reduce0_device_buf.FromDevice(reduce0_m_device_data.data());
+                reduce1_device_buf.FromDevice(reduce1_m_device_data.data());
+
+                const std::size_t bytes = sizeof(CDataType) * c_m_n_device_data.size() +
+                                          2 * sizeof(ReduceDataType) * reduce0_m_device_data.size();
+
+                auto compare = [&,
+                                gemm_name,
+                                c_m_n_device_data     = std::move(c_m_n_device_data),
+                                reduce0_m_device_data = std::move(reduce0_m_device_data),
+                                reduce1_m_device_data = std::move(reduce1_m_device_data)] {
+                    const TensorView<const CDataType> c_m_n_device_view(c_m_n_device_data.data(),
+                                                                        c_m_n_desc);
+                    const TensorView<const ReduceDataType> reduce0_m_device_view(
+                        reduce0_m_device_data.data(), reduce_desc);
+                    const TensorView<const ReduceDataType> reduce1_m_device_view(
+                        reduce1_m_device_data.data(), reduce_desc);
+
+                    const std::string msg = "Error: Incorrect results of " + gemm_name + "!";
+
+                    const bool instance_pass =
+                        ck::utils::check_err(c_m_n_device_view, c_m_n_host_result, msg) &
+                        ck::utils::check_err(reduce0_m_device_view, reduce0_m_host_result, msg) &
+                        ck::utils::check_err(reduce1_m_device_view, reduce1_m_host_result, msg);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
+                        LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
+                        LogRangeAsType<float>(std::cout << "c_host: ", c_m_n_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_data, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d0_host: ", reduce0_m_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d0_device: ", reduce0_m_device_data, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d1_host: ", reduce1_m_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "d1_device: ", reduce1_m_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return instance_pass;
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*gemm_ptr);
+
             std::cout << "does not support this GEMM problem" << std::endl;
         }
     }
 
+    verification.Wait();
+
     std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
               << best_gb_per_sec << " GB/s, " << best_gemm_name << std::endl;
 }
@@ -16,11 +16,18 @@
 
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
+#include "ck/library/utility/streaming_verification.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -60,12 +67,15 @@ int profile_gemm_impl(int do_verification,
 
     Tensor<ADataType> a_m_k(f_host_tensor_descriptor(M, K, StrideA, ALayout{}));
     Tensor<BDataType> b_k_n(f_host_tensor_descriptor(K, N, StrideB, BLayout{}));
-    Tensor<CDataType> c_m_n_host_result(f_host_tensor_descriptor(M, N, StrideC, CLayout{}));
-    Tensor<CDataType> c_m_n_device_result(f_host_tensor_descriptor(M, N, StrideC, CLayout{}));
+    const auto c_m_n_desc = f_host_tensor_descriptor(M, N, StrideC, CLayout{});
+
+    // only full verification keeps a host result, device results are read back per instance
+    Tensor<CDataType> c_m_n_host_result(do_verification == 1 ? c_m_n_desc
+                                                             : HostTensorDescriptor({1, 1}));
 
     std::cout << "a_m_k: " << a_m_k.mDesc << std::endl;
     std::cout << "b_k_n: " << b_k_n.mDesc << std::endl;
-    std::cout << "c_m_n: " << c_m_n_device_result.mDesc << std::endl;
+    std::cout << "c_m_n: " << c_m_n_desc << std::endl;
 
     switch(init_method)
     {
@@ -87,12 +97,19 @@ int profile_gemm_impl(int do_verification,
     const auto b_element_op = BElementOp{};
     const auto c_element_op = CElementOp{};
 
-    DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
-    DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
-    DeviceMem c_device_buf(sizeof(CDataType) * c_m_n_device_result.mDesc.GetElementSpaceSize());
+    const std::size_t a_bytes = sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize();
+    const std::size_t b_bytes = sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize();
+    const std::size_t c_bytes = sizeof(CDataType) * c_m_n_desc.GetElementSpaceSize();
+
+    // reused across the problems of a suite
+    ProfilerDeviceBuffers device_buffers;
+
+    DeviceMem& a_device_buf = device_buffers.Get(a_bytes);
+    DeviceMem& b_device_buf = device_buffers.Get(b_bytes);
+    DeviceMem& c_device_buf = device_buffers.Get(c_bytes);
 
-    a_device_buf.ToDevice(a_m_k.mData.data());
-    b_device_buf.ToDevice(b_k_n.mData.data());
+    a_device_buf.ToDevice(a_m_k.mData.data(), a_bytes);
+    b_device_buf.ToDevice(b_k_n.mData.data(), b_bytes);
 
     using DeviceOp = ck::tensor_operation::device::DeviceGemm<ALayout,
                                                               BLayout,
@@ -105,29 +122,77 @@ int profile_gemm_impl(int do_verification,
                                                               CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference op
-    if(do_verification)
-    {
-        using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                                BDataType,
-                                                                                CDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                BElementOp,
-                                                                                CElementOp>;
+    using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                                            BDataType,
+                                                                            CDataType,
+                                                                            AccDataType,
+                                                                            AElementOp,
+                                                                            BElementOp,
+                                                                            CElementOp>;
+
+    auto ref_op      = ReferenceGemmInstance{};
+    auto ref_invoker = ref_op.MakeInvoker();
+
+    auto ref_argument = ref_op.MakeArgument(
+        a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
+
+    // evaluates the reference at a single element, for sampled verification
+    const auto compute_element = [&](const auto& idx) {
+        return ReferenceGemmInstance::Invoker::ComputeElement(ref_argument, idx);
+    };
+
+    // reference of a slice of C for streaming verification: the packed GEMM of the matching rows
+    // of A or columns of B
+    const auto compute_slice =
+        [&](const TensorView<CDataType>& c_slice, std::size_t dim, std::size_t begin) {
+            const std::size_t end = begin + c_slice.GetLengths()[dim];
+
+            const auto a_slice =
+                dim == 0 ? TensorView(a_m_k).Slice(0, begin, end) : TensorView(a_m_k);
+            const auto b_slice =
+                dim == 1 ? TensorView(b_k_n).Slice(1, begin, end) : TensorView(b_k_n);
+
+            ref_invoker.Run(ref_op.MakeArgument(
+                a_slice, b_slice, c_slice, a_element_op, b_element_op, c_element_op));
+        };
+
+    ProfilerResults profiler_results("gemm",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, BDataType, AccDataType, CDataType>()
+                                         .AddLayouts<ALayout, BLayout, CLayout>()
+                                         .Add("M", M)
+                                         .Add("N", N)
+                                         .Add("K", K)
+                                         .Add("StrideA", StrideA)
+                                         .Add("StrideB", StrideB)
+                                         .Add("StrideC", StrideC));
 
-        auto ref_op      = ReferenceGemmInstance{};
-        auto ref_invoker = ref_op.MakeInvoker();
+    profiler_results.SetTuningShape<DeviceOp>({M, N, K});
 
-        auto ref_argument = ref_op.MakeArgument(
-            a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
 
-        ref_invoker.Run(ref_argument);
+    // Run reference op, sampled and streaming verification evaluate it per instance
+    if(do_verification == 1)
+    {
+        const auto key = ck::host_common::HostReferenceCacheKey("gemm")
+                             .AddType<AccDataType>()
+                             .AddObject(a_element_op)
+                             .AddObject(b_element_op)
+                             .AddObject(c_element_op)
+                             .Add(a_m_k)
+                             .Add(b_k_n);
+
+        verification.Submit([&, key] {
+            ck::host_common::compute_cached_host_reference(
+                key, c_m_n_host_result, [&] { ref_invoker.Run(ref_argument); });
+
+            return true;
+        });
     }
 
     std::string best_op_name;
@@ -176,6 +241,8 @@ int profile_gemm_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -184,29 +251,75 @@ int profile_gemm_impl(int do_verification,
                 best_gb_per_sec = gb_per_sec;
             }
 
-            if(do_verification)
+            if(do_verification == 3)
+            {
+                // the device result is read back slice by slice, along with its reference
+                const auto fetch = [&](CDataType* p, std::size_t offset, std::size_t size) {
+                    c_device_buf.FromDevice(
+                        p, sizeof(CDataType) * size, sizeof(CDataType) * offset);
+                };
+
+                pass = pass & profiler_results.RecordVerification(
+                                  ck::utils::check_err_streaming<CDataType>(
+                                      c_m_n_desc, compute_slice, fetch));
+            }
+            else if(do_verification)
             {
-                c_device_buf.FromDevice(c_m_n_device_result.mData.data());
-
-                pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_result.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_m_n_device_data(c_m_n_desc.GetElementSpaceSize());
+
+                c_device_buf.FromDevice(c_m_n_device_data.data(), c_bytes);
+
+                auto compare = [&, op_name, c_m_n_device_data = std::move(c_m_n_device_data)] {
+                    const TensorView<const CDataType> c_m_n_device_result(c_m_n_device_data.data(),
+                                                                          c_m_n_desc);
+
+                    const std::string msg = "Error: Incorrect results of " + op_name + "!";
+
+                    if(do_verification == 2)
+                    {
+                        const auto [m_per_block, n_per_block] =
+                            ck::utils::get_block_tile_lengths(op_name);
+
+                        const auto ref = ck::utils::compute_sampled_reference<CDataType>(
+                            c_m_n_desc.GetLengths(),
+                            {{0}, {1}, m_per_block, n_per_block},
+                            compute_element);
+
+                        return ck::utils::check_err_sampled(c_m_n_device_result, ref, msg);
+                    }
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
+                        LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(c_m_n_device_result, c_m_n_host_result, msg);
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     if constexpr(is_same<CDataType, float>::value)
     {
         std::cout << "Best Perf for datatype = f32";
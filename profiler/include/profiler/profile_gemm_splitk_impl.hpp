@@ -19,8 +19,12 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -108,32 +112,53 @@ bool profile_gemm_splitk_impl(int do_verification,
                                                                     ComputeType>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference GEMM
+    ProfilerResults profiler_results(
+        "gemm_splitk",
+        ProblemDescriptor{}
+            .AddTypes<ADataType, BDataType, AccDataType, CDataType, ComputeType>()
+            .AddLayouts<ALayout, BLayout, CLayout>()
+            .Add("M", M)
+            .Add("N", N)
+            .Add("K", K)
+            .Add("StrideA", StrideA)
+            .Add("StrideB", StrideB)
+            .Add("StrideC", StrideC));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                                BDataType,
-                                                                                CDataType,
-                                                                                AccDataType,
-                                                                                AElementOp,
-                                                                                BElementOp,
-                                                                                CElementOp,
-                                                                                ComputeType>;
-
-        auto ref_gemm    = ReferenceGemmInstance{};
-        auto ref_invoker = ref_gemm.MakeInvoker();
-
-        auto ref_argument = ref_gemm.MakeArgument(
-            a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
-
-        ref_invoker.Run(ref_argument);
+        verification.Submit([&] {
+            using ReferenceGemmInstance =
+                ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                          BDataType,
+                                                          CDataType,
+                                                          AccDataType,
+                                                          AElementOp,
+                                                          BElementOp,
+                                                          CElementOp,
+                                                          ComputeType>;
+
+            auto ref_gemm    = ReferenceGemmInstance{};
+            auto ref_invoker = ref_gemm.MakeInvoker();
+
+            auto ref_argument = ref_gemm.MakeArgument(
+                a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
+
+            ref_invoker.Run(ref_argument);
+
+            return true;
+        });
     }
 
+    const auto& c_m_n_desc    = c_m_n_device_result.mDesc;
+    const std::size_t c_bytes = sizeof(CDataType) * c_m_n_desc.GetElementSpaceSize();
+
     std::string best_op_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -180,23 +205,15 @@ bool profile_gemm_splitk_impl(int do_verification,
 
                 invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, false});
 
+                // read back before timing, split-K instances accumulate into C; not a Tensor,
+                // whose initialization would wait for the host thread pool
+                std::vector<CDataType> c_m_n_device_data;
+
                 if(do_verification)
                 {
-                    c_device_buf.FromDevice(c_m_n_device_result.mData.data());
-
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
-
-                    if(do_log)
-                    {
-                        LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
-                        LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
-                        LogRangeAsType<float>(
-                            std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
-                            << std::endl;
-                        LogRangeAsType<float>(
-                            std::cout << "c_device: ", c_m_n_device_result.mData, ",")
-                            << std::endl;
-                    }
+                    c_m_n_device_data.resize(c_m_n_desc.GetElementSpaceSize());
+
+                    c_device_buf.FromDevice(c_m_n_device_data.data(), c_bytes);
                 }
 
                 std::string op_name = op_ptr->GetTypeString();
@@ -217,24 +234,59 @@ bool profile_gemm_splitk_impl(int do_verification,
                           << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
                           << kbatch_curr << std::endl;
 
-#if defined CK_ENABLE_FP8
-                // set softer tolerances for fp8
-                if constexpr(is_same_v<ADataType, f8_t> || is_same_v<BDataType, f8_t> ||
-                             is_same_v<CDataType, f8_t>)
-                {
-                    std::string msg = "Error: Incorrect results!";
-                    double rtol     = 1e-1;
-                    double atol     = 1e-1;
-                    pass            = pass & ck::utils::check_err(
-                                      c_m_n_device_result, c_m_n_host_result, msg, rtol, atol);
-                }
-                else
+                const auto result_id = profiler_results.Add(
+                    *op_ptr, ave_time, tflops, gb_per_sec, "KBatch=" + std::to_string(kbatch_curr));
+
+                if(do_verification)
                 {
+                    auto compare = [&,
+                                    op_name,
+                                    kbatch_curr,
+                                    c_m_n_device_data = std::move(c_m_n_device_data)] {
+                        const TensorView<const CDataType> c_m_n_device_view(
+                            c_m_n_device_data.data(), c_m_n_desc);
+
+                        const std::string msg = "Error: Incorrect results of " + op_name +
+                                                ", KBatch " + std::to_string(kbatch_curr) + "!";
+
+                        if(do_log)
+                        {
+                            LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_data, ",")
+                                << std::endl;
+                        }
+
+#if defined CK_ENABLE_FP8
+                        // set softer tolerances for fp8
+                        if constexpr(is_same_v<ADataType, f8_t> || is_same_v<BDataType, f8_t> ||
+                                     is_same_v<CDataType, f8_t>)
+                        {
+                            double rtol = 1e-1;
+                            double atol = 1e-1;
+                            return ck::utils::check_err(
+                                c_m_n_device_view, c_m_n_host_result, msg, rtol, atol);
+                        }
+                        else
+                        {
 #endif
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                            return ck::utils::check_err(c_m_n_device_view, c_m_n_host_result, msg);
 #if defined CK_ENABLE_FP8
-                }
+                        }
 #endif
+                    };
+
+                    verification.Submit(
+                        [&, result_id, compare = std::move(compare)] {
+                            return profiler_results.RecordVerification(result_id, compare());
+                        },
+                        c_bytes);
+                }
 
                 if(tflops > best_tflops)
                 {
@@ -247,12 +299,16 @@ bool profile_gemm_splitk_impl(int do_verification,
             }
             else
             {
+                profiler_results.AddUnsupported(*op_ptr, "KBatch=" + std::to_string(kbatch_curr));
+
                 std::cout << op_ptr->GetTypeString() << " does not support this problem"
                           << std::endl;
             }
         }
     }
 
+    pass = verification.Wait() && pass;
+
     if constexpr(is_same<CDataType, float>::value)
     {
         std::cout << "Best Perf for datatype = f32";
@@ -15,11 +15,16 @@
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
 #include "ck/library/tensor_operation_instance/gpu/grouped_convolution_backward_data.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -56,7 +61,6 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
     Tensor<OutDataType> out(out_g_n_k_wos_desc);
     Tensor<WeiDataType> wei(wei_g_k_c_xs_desc);
     Tensor<InDataType> in_host(in_g_n_c_wis_desc);
-    Tensor<InDataType> in_device(in_g_n_c_wis_desc);
 
     std::cout << "out: " << out.mDesc << std::endl;
     std::cout << "wei: " << wei.mDesc << std::endl;
@@ -80,7 +84,7 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
 
     DeviceMem out_device_buf(sizeof(OutDataType) * out.mDesc.GetElementSpaceSize());
     DeviceMem wei_device_buf(sizeof(WeiDataType) * wei.mDesc.GetElementSpaceSize());
-    DeviceMem in_device_buf(sizeof(InDataType) * in_device.mDesc.GetElementSpaceSize());
+    DeviceMem in_device_buf(sizeof(InDataType) * in_g_n_c_wis_desc.GetElementSpaceSize());
 
     out_device_buf.ToDevice(out.mData.data());
     wei_device_buf.ToDevice(wei.mData.data());
@@ -88,34 +92,61 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
     // reset input to zero
     in_device_buf.SetZero();
 
+    auto ref_conv     = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
+                                                                       InDataType,
+                                                                       WeiDataType,
+                                                                       OutDataType,
+                                                                       InElementOp,
+                                                                       WeiElementOp,
+                                                                       OutElementOp>();
+    auto ref_invoker  = ref_conv.MakeInvoker();
+    auto ref_argument = ref_conv.MakeArgument(in_host,
+                                              wei,
+                                              out,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_,
+                                              out_element_op,
+                                              wei_element_op,
+                                              in_element_op);
+
+    ProfilerResults profiler_results("grouped_conv_bwd_data",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, WeiDataType, OutDataType>()
+                                         .AddLayouts<InLayout, WeiLayout, OutLayout>()
+                                         .Add(conv_param));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        auto ref_conv = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
-                                                                         InDataType,
-                                                                         WeiDataType,
-                                                                         OutDataType,
-                                                                         InElementOp,
-                                                                         WeiElementOp,
-                                                                         OutElementOp>();
-
-        auto ref_invoker = ref_conv.MakeInvoker();
-
-        in_host.SetZero();
-
-        auto ref_argument = ref_conv.MakeArgument(in_host,
-                                                  wei,
-                                                  out,
-                                                  conv_param.conv_filter_strides_,
-                                                  conv_param.conv_filter_dilations_,
-                                                  conv_param.input_left_pads_,
-                                                  conv_param.input_right_pads_,
-                                                  out_element_op,
-                                                  wei_element_op,
-                                                  in_element_op);
-
-        ref_invoker.Run(ref_argument);
+        const auto key = ck::host_common::HostReferenceCacheKey("conv_bwd_data")
+                             .Add(NDimSpatial)
+                             .Add(conv_param.conv_filter_strides_)
+                             .Add(conv_param.conv_filter_dilations_)
+                             .Add(conv_param.input_left_pads_)
+                             .Add(conv_param.input_right_pads_)
+                             .AddObject(out_element_op)
+                             .AddObject(wei_element_op)
+                             .AddObject(in_element_op)
+                             .Add(wei)
+                             .Add(out);
+
+        verification.Submit([&, key] {
+            ck::host_common::compute_cached_host_reference(key, in_host, [&] {
+                in_host.SetZero();
+
+                ref_invoker.Run(ref_argument);
+            });
+
+            return true;
+        });
     }
 
+    const std::size_t in_bytes = sizeof(InDataType) * in_g_n_c_wis_desc.GetElementSpaceSize();
+
     std::string best_op_name;
     float best_avg_time   = 0;
     float best_tflops     = 0;
@@ -147,6 +178,8 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -157,23 +190,42 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
 
             if(do_verification)
             {
-                in_device_buf.FromDevice(in_device.mData.data());
-
-                pass = pass & ck::utils::check_err(in_device, in_host);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "output : ", out.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "weight: ", wei.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "in_host  : ", in_host.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "in_device: ", in_device.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<InDataType> device_data(in_g_n_c_wis_desc.GetElementSpaceSize());
+
+                in_device_buf.FromDevice(device_data.data(), in_bytes);
+
+                auto compare = [&, op_name, device_data = std::move(device_data)] {
+                    const TensorView<const InDataType> device_input(device_data.data(),
+                                                                    in_g_n_c_wis_desc);
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "output : ", out.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "weight: ", wei.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "in_host  : ", in_host.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "in_device: ", device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(
+                        device_input, in_host, "Error: Incorrect results of " + op_name + "!");
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    in_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     };
@@ -193,8 +245,7 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
                                                                                      InElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::array<ck::index_t, NDimSpatial + 3> out_lengths{};
     std::array<ck::index_t, NDimSpatial + 3> out_strides{};
@@ -246,6 +297,8 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
         run_impl(op_ptr, argument_ptr);
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best configuration parameters:"
               << "\nname: " << best_op_name << "\navg_time: " << best_avg_time
               << "\ntflops: " << best_tflops << "\nGB/s: " << best_gb_per_sec << std::endl;
@@ -20,10 +20,15 @@
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -62,7 +67,6 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
 
     Tensor<InDataType> input(in_g_n_c_wis_desc);
     Tensor<WeiDataType> weight_host_result(wei_g_k_c_xs_desc);
-    Tensor<WeiDataType> weight_device_result(wei_g_k_c_xs_desc);
     Tensor<OutDataType> output(out_g_n_k_wos_desc);
 
     std::cout << "input: " << input.mDesc << std::endl;
@@ -82,36 +86,30 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
     }
 
     DeviceMem in_device_buf(sizeof(InDataType) * input.mDesc.GetElementSpaceSize());
-    DeviceMem wei_device_buf(sizeof(WeiDataType) *
-                             weight_device_result.mDesc.GetElementSpaceSize());
+    DeviceMem wei_device_buf(sizeof(WeiDataType) * wei_g_k_c_xs_desc.GetElementSpaceSize());
     DeviceMem out_device_buf(sizeof(OutDataType) * output.mDesc.GetElementSpaceSize());
 
     in_device_buf.ToDevice(input.mData.data());
     out_device_buf.ToDevice(output.mData.data());
 
-    if(do_verification)
-    {
-        auto ref_conv     = ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
-                                                                           InDataType,
-                                                                           WeiDataType,
-                                                                           OutDataType,
-                                                                           InElementOp,
-                                                                           WeiElementOp,
-                                                                           OutElementOp>{};
-        auto ref_invoker  = ref_conv.MakeInvoker();
-        auto ref_argument = ref_conv.MakeArgument(input,
-                                                  weight_host_result,
-                                                  output,
-                                                  conv_param.conv_filter_strides_,
-                                                  conv_param.conv_filter_dilations_,
-                                                  conv_param.input_left_pads_,
-                                                  conv_param.input_right_pads_,
-                                                  in_element_op,
-                                                  wei_element_op,
-                                                  out_element_op);
-
-        ref_invoker.Run(ref_argument);
-    }
+    auto ref_conv     = ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
+                                                                       InDataType,
+                                                                       WeiDataType,
+                                                                       OutDataType,
+                                                                       InElementOp,
+                                                                       WeiElementOp,
+                                                                       OutElementOp>{};
+    auto ref_invoker  = ref_conv.MakeInvoker();
+    auto ref_argument = ref_conv.MakeArgument(input,
+                                              weight_host_result,
+                                              output,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_,
+                                              in_element_op,
+                                              wei_element_op,
+                                              out_element_op);
 
     using DeviceOp = ck::tensor_operation::device::DeviceGroupedConvBwdWeight<NDimSpatial,
                                                                               InLayout,
@@ -127,11 +125,44 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
                                                                               ComputeTypeB>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results("grouped_conv_bwd_weight",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, WeiDataType, OutDataType>()
+                                         .AddLayouts<InLayout, WeiLayout, OutLayout>()
+                                         .Add(conv_param)
+                                         .Add("split_k", split_k));
+
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        const auto key = ck::host_common::HostReferenceCacheKey("conv_bwd_weight")
+                             .Add(NDimSpatial)
+                             .Add(conv_param.conv_filter_strides_)
+                             .Add(conv_param.conv_filter_dilations_)
+                             .Add(conv_param.input_left_pads_)
+                             .Add(conv_param.input_right_pads_)
+                             .AddObject(in_element_op)
+                             .AddObject(wei_element_op)
+                             .AddObject(out_element_op)
+                             .Add(input)
+                             .Add(output);
+
+        verification.Submit([&, key] {
+            ck::host_common::compute_cached_host_reference(
+                key, weight_host_result, [&] { ref_invoker.Run(ref_argument); });
+
+            return true;
+        });
+    }
+
+    const std::size_t wei_bytes = sizeof(WeiDataType) * wei_g_k_c_xs_desc.GetElementSpaceSize();
+
     std::string best_op_name;
     float best_avg_time   = 0;
     float best_tflops     = 0;
@@ -206,6 +237,8 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -216,40 +249,55 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
 
             if(do_verification)
             {
-                wei_device_buf.FromDevice(weight_device_result.mData.data());
-
-                bool pass = ck::utils::check_err(weight_device_result, weight_host_result);
-
-                if(!pass)
-                {
-                    std::cout << "Fail info: " << op_ptr->GetTypeString() << std::endl;
-                }
-
-                all_pass &= pass;
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "output : ", output.mData, ",") << std::endl;
-                    ;
-                    LogRangeAsType<float>(
-                        std::cout << "weight (device): ", weight_device_result.mData, ",")
-                        << std::endl;
-                    ;
-                    LogRangeAsType<float>(
-                        std::cout << "weight (host): ", weight_host_result.mData, ",")
-                        << std::endl;
-                    ;
-                    LogRangeAsType<float>(std::cout << "input: ", input.mData, ",") << std::endl;
-                    ;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<WeiDataType> device_data(wei_g_k_c_xs_desc.GetElementSpaceSize());
+
+                wei_device_buf.FromDevice(device_data.data(), wei_bytes);
+
+                auto compare = [&, op_name, device_data = std::move(device_data)] {
+                    const TensorView<const WeiDataType> device_weight(device_data.data(),
+                                                                      wei_g_k_c_xs_desc);
+
+                    const bool pass = ck::utils::check_err(device_weight, weight_host_result);
+
+                    if(!pass)
+                    {
+                        std::cout << "Fail info: " << op_name << std::endl;
+                    }
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "output : ", output.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "weight (device): ", device_data, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "weight (host): ", weight_host_result.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "input: ", input.mData, ",")
+                            << std::endl;
+                    }
+
+                    return pass;
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    wei_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     }
 
+    all_pass = verification.Wait() && all_pass;
+
     std::cout << "Best configuration parameters:"
               << "\nname: " << best_op_name << "\navg_time: " << best_avg_time
               << "\ntflops: " << best_tflops << "\nGB/s: " << best_gb_per_sec << std::endl;
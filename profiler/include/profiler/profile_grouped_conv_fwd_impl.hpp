@@ -18,10 +18,17 @@
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
+#include "ck/library/utility/streaming_verification.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -81,12 +88,15 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
 
     Tensor<InDataType> input(in_g_n_c_wis_desc);
     Tensor<WeiDataType> weight(wei_g_k_c_xs_desc);
-    Tensor<OutDataType> host_output(out_g_n_k_wos_desc);
-    Tensor<OutDataType> device_output(out_g_n_k_wos_desc);
+
+    // only full verification keeps a host output, device outputs are read back per instance
+    Tensor<OutDataType> host_output(
+        do_verification == 1 ? out_g_n_k_wos_desc
+                             : HostTensorDescriptor(std::vector<std::size_t>(NDimSpatial + 3, 1)));
 
     std::cout << "input: " << input.mDesc << std::endl;
     std::cout << "weight: " << weight.mDesc << std::endl;
-    std::cout << "output: " << host_output.mDesc << std::endl;
+    std::cout << "output: " << out_g_n_k_wos_desc << std::endl;
 
     switch(init_method)
     {
@@ -100,42 +110,121 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
         weight.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
     }
 
-    DeviceMem in_device_buf(sizeof(InDataType) * input.mDesc.GetElementSpaceSize());
-    DeviceMem wei_device_buf(sizeof(WeiDataType) * weight.mDesc.GetElementSpaceSize());
-    DeviceMem out_device_buf(sizeof(OutDataType) * device_output.mDesc.GetElementSpaceSize());
+    const std::size_t in_bytes  = sizeof(InDataType) * input.mDesc.GetElementSpaceSize();
+    const std::size_t wei_bytes = sizeof(WeiDataType) * weight.mDesc.GetElementSpaceSize();
+    const std::size_t out_bytes = sizeof(OutDataType) * out_g_n_k_wos_desc.GetElementSpaceSize();
+
+    // reused across the problems of a suite
+    ProfilerDeviceBuffers device_buffers;
+
+    DeviceMem& in_device_buf  = device_buffers.Get(in_bytes);
+    DeviceMem& wei_device_buf = device_buffers.Get(wei_bytes);
+    DeviceMem& out_device_buf = device_buffers.Get(out_bytes);
+
+    in_device_buf.ToDevice(input.mData.data(), in_bytes);
+    wei_device_buf.ToDevice(weight.mData.data(), wei_bytes);
+
+    using ReferenceConvFwdInstance = ck::tensor_operation::host::ReferenceConvFwd<NDimSpatial,
+                                                                                  InDataType,
+                                                                                  WeiDataType,
+                                                                                  OutDataType,
+                                                                                  InElementOp,
+                                                                                  WeiElementOp,
+                                                                                  OutElementOp>;
+
+    auto ref_conv     = ReferenceConvFwdInstance{};
+    auto ref_invoker  = ref_conv.MakeInvoker();
+    auto ref_argument = ref_conv.MakeArgument(input,
+                                              weight,
+                                              host_output,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_,
+                                              in_element_op,
+                                              wei_element_op,
+                                              out_element_op);
+
+    // evaluates the reference at a single element, for sampled verification
+    const auto compute_element = [&](const auto& idx) {
+        return ReferenceConvFwdInstance::Invoker::ComputeElement(ref_argument, idx);
+    };
+
+    // reference of a slice of the [G, N, K, Wo...] output for streaming verification: the packed
+    // convolution of the matching groups, images or filters; element by element when the output
+    // is sliced along a spatial dimension
+    const auto compute_slice =
+        [&](const TensorView<OutDataType>& out_slice, std::size_t dim, std::size_t begin) {
+            if(dim > 2)
+            {
+                ck::utils::compute_streaming_slice_elementwise(
+                    out_slice, dim, begin, compute_element);
+
+                return;
+            }
 
-    in_device_buf.ToDevice(input.mData.data());
-    wei_device_buf.ToDevice(weight.mData.data());
+            const std::size_t end = begin + out_slice.GetLengths()[dim];
 
-    // run reference op
-    if(do_verification)
-    {
-        auto ref_conv = ck::tensor_operation::host::ReferenceConvFwd<NDimSpatial,
-                                                                     InDataType,
-                                                                     WeiDataType,
-                                                                     OutDataType,
-                                                                     InElementOp,
-                                                                     WeiElementOp,
-                                                                     OutElementOp>{};
-
-        auto ref_invoker  = ref_conv.MakeInvoker();
-        auto ref_argument = ref_conv.MakeArgument(input,
-                                                  weight,
-                                                  host_output,
+            const auto in_slice =
+                dim < 2 ? TensorView(input).Slice(dim, begin, end) : TensorView(input);
+            const auto wei_slice = dim == 0   ? TensorView(weight).Slice(0, begin, end)
+                                   : dim == 2 ? TensorView(weight).Slice(1, begin, end)
+                                              : TensorView(weight);
+
+            ref_invoker.Run(ref_conv.MakeArgument(in_slice,
+                                                  wei_slice,
+                                                  out_slice,
                                                   conv_param.conv_filter_strides_,
                                                   conv_param.conv_filter_dilations_,
                                                   conv_param.input_left_pads_,
                                                   conv_param.input_right_pads_,
                                                   in_element_op,
                                                   wei_element_op,
-                                                  out_element_op);
+                                                  out_element_op));
+        };
+
+    ProfilerResults profiler_results("grouped_conv_fwd",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, WeiDataType, OutDataType>()
+                                         .AddLayouts<InLayout, WeiLayout, OutLayout>()
+                                         .Add(conv_param));
 
-        // init host output to zero
-        host_output.SetZero();
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
 
-        ref_invoker.Run(ref_argument);
+    // run reference op, sampled and streaming verification evaluate it per instance
+    if(do_verification == 1)
+    {
+        const auto key = ck::host_common::HostReferenceCacheKey("conv_fwd")
+                             .Add(NDimSpatial)
+                             .Add(conv_param.conv_filter_strides_)
+                             .Add(conv_param.conv_filter_dilations_)
+                             .Add(conv_param.input_left_pads_)
+                             .Add(conv_param.input_right_pads_)
+                             .AddObject(in_element_op)
+                             .AddObject(wei_element_op)
+                             .AddObject(out_element_op)
+                             .Add(input)
+                             .Add(weight);
+
+        verification.Submit([&, key] {
+            ck::host_common::compute_cached_host_reference(key, host_output, [&] {
+                // init host output to zero
+                host_output.SetZero();
+
+                ref_invoker.Run(ref_argument);
+            });
+
+            return true;
+        });
     }
 
+    // the output [G, N, K, Wo...] as the GEMM the instances compute: M = N * Wo..., N = K
+    ck::utils::SampledVerificationTiling tiling{{1}, {2}, 0, 0};
+
+    for(std::size_t d = 0; d < NDimSpatial; ++d)
+        tiling.m_dims.push_back(3 + d);
+
     std::string best_op_name;
     float best_avg_time   = 0;
     float best_tflops     = 0;
@@ -167,6 +256,8 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << op_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*op_ptr, avg_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_op_name    = op_name;
@@ -175,25 +266,73 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
                 best_gb_per_sec = gb_per_sec;
             }
 
-            if(do_verification)
+            if(do_verification == 3)
+            {
+                // the device output is read back slice by slice, along with its reference
+                const auto fetch = [&](OutDataType* p, std::size_t offset, std::size_t size) {
+                    out_device_buf.FromDevice(
+                        p, sizeof(OutDataType) * size, sizeof(OutDataType) * offset);
+                };
+
+                pass = pass & profiler_results.RecordVerification(
+                                  ck::utils::check_err_streaming<OutDataType>(
+                                      out_g_n_k_wos_desc, compute_slice, fetch));
+            }
+            else if(do_verification)
             {
-                out_device_buf.FromDevice(device_output.mData.data());
-
-                pass = pass & ck::utils::check_err(device_output, host_output);
-
-                if(do_log)
-                {
-                    LogRangeAsType<float>(std::cout << "input : ", input.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "weight: ", weight.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "host_output  : ", host_output.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "device_output: ", device_output.mData, ",")
-                        << std::endl;
-                }
+                // not a Tensor, whose initialization would wait for the host thread pool
+                std::vector<OutDataType> device_data(out_g_n_k_wos_desc.GetElementSpaceSize());
+
+                out_device_buf.FromDevice(device_data.data(), out_bytes);
+
+                auto compare = [&, op_name, device_data = std::move(device_data)] {
+                    const TensorView<const OutDataType> device_output(device_data.data(),
+                                                                      out_g_n_k_wos_desc);
+
+                    const std::string msg = "Error: Incorrect results of " + op_name + "!";
+
+                    if(do_verification == 2)
+                    {
+                        const auto tile_lengths = ck::utils::get_block_tile_lengths(op_name);
+
+                        auto instance_tiling = tiling;
+
+                        instance_tiling.m_per_block = tile_lengths[0];
+                        instance_tiling.n_per_block = tile_lengths[1];
+
+                        const auto ref = ck::utils::compute_sampled_reference<OutDataType>(
+                            out_g_n_k_wos_desc.GetLengths(), instance_tiling, compute_element);
+
+                        return ck::utils::check_err_sampled(device_output, ref, msg);
+                    }
+
+                    if(do_log)
+                    {
+                        LogRangeAsType<float>(std::cout << "input : ", input.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "weight: ", weight.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(
+                            std::cout << "host_output  : ", host_output.mData, ",")
+                            << std::endl;
+                        LogRangeAsType<float>(std::cout << "device_output: ", device_data, ",")
+                            << std::endl;
+                    }
+
+                    return ck::utils::check_err(device_output, host_output, msg);
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    out_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*op_ptr);
+
             std::cout << op_ptr->GetTypeString() << " does not support this problem" << std::endl;
         }
     };
@@ -211,9 +350,10 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
                                                                                  WeiElementOp,
                                                                                  OutElementOp>;
 
+    profiler_results.SetTuningShape<DeviceOp>(ck::utils::get_tuning_shape(conv_param));
+
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "ckProfiler found " << op_ptrs.size() << " instances" << std::endl;
 
@@ -242,6 +382,8 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
         run_impl(op_ptr, argument_ptr);
     }
 
+    pass = verification.Wait() && pass;
+
     std::cout << "Best configuration parameters:"
               << "\nname: " << best_op_name << "\navg_time: " << best_avg_time
               << "\ntflops: " << best_tflops << "\nGB/s: " << best_gb_per_sec << std::endl;
@@ -12,11 +12,15 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/fill.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_grouped_gemm.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -65,6 +69,7 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
 
     std::vector<Tensor<ADataType>> a_m_k;
     std::vector<Tensor<BDataType>> b_k_n;
+    std::vector<Tensor<CDataType>> c_m_n_host_results;
     std::vector<Tensor<CDataType>> c_m_n_device_results;
 
     for(std::size_t i = 0; i < group_count; i++)
@@ -74,6 +79,8 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
         b_k_n.push_back(
             Tensor<BDataType>(f_host_tensor_descriptor(Ks[i], Ns[i], StrideBs[i], BLayout{})));
 
+        c_m_n_host_results.push_back(
+            Tensor<CDataType>(f_host_tensor_descriptor(Ms[i], Ns[i], StrideCs[i], CLayout{})));
         c_m_n_device_results.push_back(
             Tensor<CDataType>(f_host_tensor_descriptor(Ms[i], Ns[i], StrideCs[i], CLayout{})));
 
@@ -154,14 +161,24 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
                                                                      BElementOp,
                                                                      CElementOp>;
 
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     if(op_ptrs.size() <= 0)
     {
         throw std::runtime_error("wrong! no device GEMM instance found");
     }
 
+    ProfilerResults profiler_results("grouped_gemm_fastgelu",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, BDataType, CDataType>()
+                                         .AddLayouts<ALayout, BLayout, CLayout>()
+                                         .Add("Ms", Ms)
+                                         .Add("Ns", Ns)
+                                         .Add("Ks", Ks)
+                                         .Add("StrideAs", StrideAs)
+                                         .Add("StrideBs", StrideBs)
+                                         .Add("StrideCs", StrideCs));
+
     std::string best_gemm_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -169,6 +186,39 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
 
     auto p_ds = std::vector<std::array<const void*, 0>>{};
 
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
+    if(do_verification)
+    {
+        verification.Submit([&] {
+            for(std::size_t i = 0; i < gemm_descs.size(); i++)
+            {
+                using ReferenceGemmInstance =
+                    ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                              BDataType,
+                                                              CDataType,
+                                                              AccDataType,
+                                                              AElementOp,
+                                                              BElementOp,
+                                                              CElementOp>;
+
+                auto ref_gemm     = ReferenceGemmInstance{};
+                auto ref_invoker  = ref_gemm.MakeInvoker();
+                auto ref_argument = ref_gemm.MakeArgument(a_m_k[i],
+                                                          b_k_n[i],
+                                                          c_m_n_host_results[i],
+                                                          a_element_op,
+                                                          b_element_op,
+                                                          c_element_op);
+
+                ref_invoker.Run(ref_argument);
+            }
+
+            return true;
+        });
+    }
+
     // profile device GEMM instances
     for(auto& gemm_ptr : op_ptrs)
     {
@@ -200,6 +250,8 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
                       << gb_per_sec << " GB/s, " << gemm_name << std::endl;
 
+            const auto result_id = profiler_results.Add(*gemm_ptr, ave_time, tflops, gb_per_sec);
+
             if(tflops > best_tflops)
             {
                 best_gemm_name  = gemm_name;
@@ -210,61 +262,74 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
 
             if(do_verification)
             {
+                // not Tensors, whose initialization would wait for the host thread pool
+                std::vector<std::vector<CDataType>> c_m_n_device_data;
+                std::size_t c_bytes = 0;
+
+                c_m_n_device_data.reserve(gemm_descs.size());
+
                 for(std::size_t i = 0; i < gemm_descs.size(); i++)
                 {
+                    c_m_n_device_data.emplace_back(
+                        c_m_n_device_results[i].mDesc.GetElementSpaceSize());
+
+                    c_device_buf[i]->FromDevice(c_m_n_device_data[i].data());
+
+                    c_bytes += sizeof(CDataType) * c_m_n_device_data[i].size();
+                }
 
-                    c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
-                    Tensor<CDataType> c_m_n_host_result(
-                        f_host_tensor_descriptor(Ms[i], Ns[i], StrideCs[i], CLayout{}));
-
-                    using ReferenceGemmInstance =
-                        ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                  BDataType,
-                                                                  CDataType,
-                                                                  AccDataType,
-                                                                  AElementOp,
-                                                                  BElementOp,
-                                                                  CElementOp>;
-
-                    auto ref_gemm     = ReferenceGemmInstance{};
-                    auto ref_invoker  = ref_gemm.MakeInvoker();
-                    auto ref_argument = ref_gemm.MakeArgument(a_m_k[i],
-                                                              b_k_n[i],
-                                                              c_m_n_host_result,
-                                                              a_element_op,
-                                                              b_element_op,
-                                                              c_element_op);
-
-                    ref_invoker.Run(ref_argument);
-
-                    bool group_pass =
-                        ck::utils::check_err(c_m_n_device_results[i], c_m_n_host_result);
-                    pass = pass && group_pass;
-
-                    std::cout << "group: " << i << " verification result: " << std::boolalpha
-                              << group_pass << std::endl;
-
-                    if(do_log)
+                auto compare = [&, gemm_name, c_m_n_device_data = std::move(c_m_n_device_data)] {
+                    bool instance_pass = true;
+
+                    for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     {
-                        LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
-                            << std::endl;
-                        LogRangeAsType<float>(std::cout << "b: ", b_k_n[i].mData, ",") << std::endl;
-                        LogRangeAsType<float>(
-                            std::cout << "c_device: ", c_m_n_device_results[i].mData, ",")
-                            << std::endl;
-                        LogRangeAsType<float>(
-                            std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
-                            << std::endl;
+                        const TensorView<const CDataType> c_m_n_device_result(
+                            c_m_n_device_data[i].data(), c_m_n_device_results[i].mDesc);
+
+                        bool group_pass = ck::utils::check_err(
+                            c_m_n_device_result,
+                            c_m_n_host_results[i],
+                            "Error: Incorrect results of " + gemm_name + "!");
+                        instance_pass = instance_pass && group_pass;
+
+                        std::cout << "group: " << i << " verification result: " << std::boolalpha
+                                  << group_pass << ", " << gemm_name << std::endl;
+
+                        if(do_log)
+                        {
+                            LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(std::cout << "b: ", b_k_n[i].mData, ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "c_device: ", c_m_n_device_data[i], ",")
+                                << std::endl;
+                            LogRangeAsType<float>(
+                                std::cout << "c_host  : ", c_m_n_host_results[i].mData, ",")
+                                << std::endl;
+                        }
                     }
-                }
+
+                    return instance_pass;
+                };
+
+                verification.Submit(
+                    [&, result_id, compare = std::move(compare)] {
+                        return profiler_results.RecordVerification(result_id, compare());
+                    },
+                    c_bytes);
             }
         }
         else
         {
+            profiler_results.AddUnsupported(*gemm_ptr);
+
             std::cout << "does not support this GEMM problem" << std::endl;
         }
     }
 
+    pass = verification.Wait() && pass;
+
     if(do_verification)
     {
         std::cout << "Verification: " << (pass ? "SUCCESS" : "FAILURE") << std::endl;
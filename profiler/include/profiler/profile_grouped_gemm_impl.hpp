@@ -16,12 +16,17 @@
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -161,14 +166,24 @@ bool profile_grouped_gemm_impl(int do_verification,
                                                                      BElementOp,
                                                                      CElementOp>;
 
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& op_ptrs = get_device_op_instances<DeviceOp>();
 
     if(op_ptrs.size() <= 0)
     {
         throw std::runtime_error("wrong! no device GEMM instance found");
     }
 
+    ProfilerResults profiler_results("grouped_gemm",
+                                     ProblemDescriptor{}
+                                         .AddTypes<ADataType, BDataType, CDataType>()
+                                         .AddLayouts<ALayout, BLayout, CLayout>()
+                                         .Add("Ms", Ms)
+                                         .Add("Ns", Ns)
+                                         .Add("Ks", Ks)
+                                         .Add("StrideAs", StrideAs)
+                                         .Add("StrideBs", StrideBs)
+                                         .Add("StrideCs", StrideCs));
+
     std::string best_gemm_name;
     float best_ave_time   = 0;
     float best_tflops     = 0;
@@ -177,30 +192,48 @@ bool profile_grouped_gemm_impl(int do_verification,
 
     auto p_ds = std::vector<std::array<const void*, 0>>{};
 
+    // reference and comparisons run in the background while the instances are timed
+    ck::utils::VerificationPipeline verification;
+
     if(do_verification)
     {
-        for(std::size_t i = 0; i < gemm_descs.size(); i++)
-        {
-            using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                                    BDataType,
-                                                                                    CDataType,
-                                                                                    AccDataType,
-                                                                                    AElementOp,
-                                                                                    BElementOp,
-                                                                                    CElementOp>;
-
-            auto ref_gemm    = ReferenceGemmInstance{};
-            auto ref_invoker = ref_gemm.MakeInvoker();
-
-            auto ref_argument = ref_gemm.MakeArgument(a_m_k[i],
-                                                      b_k_n[i],
-                                                      c_m_n_host_results[i],
-                                                      a_element_op,
-                                                      b_element_op,
-                                                      c_element_op);
-
-            ref_invoker.Run(ref_argument);
-        }
+        verification.Submit([&] {
+            for(std::size_t i = 0; i < gemm_descs.size(); i++)
+            {
+                using ReferenceGemmInstance =
+                    ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                              BDataType,
+                                                              CDataType,
+                                                              AccDataType,
+                                                              AElementOp,
+                                                              BElementOp,
+                                                              CElementOp>;
+
+                auto ref_gemm    = ReferenceGemmInstance{};
+                auto ref_invoker = ref_gemm.MakeInvoker();
+
+                auto ref_argument = ref_gemm.MakeArgument(a_m_k[i],
+                                                          b_k_n[i],
+                                                          c_m_n_host_results[i],
+                                                          a_element_op,
+                                                          b_element_op,
+                                                          c_element_op);
+
+                // one entry per group, so groups shared between problems hit as well
+                const auto key = ck::host_common::HostReferenceCacheKey("gemm")
+                                     .AddType<AccDataType>()
+                                     .AddObject(a_element_op)
+                                     .AddObject(b_element_op)
+                                     .AddObject(c_element_op)
+                                     .Add(a_m_k[i])
+                                     .Add(b_k_n[i]);
+
+                ck::host_common::compute_cached_host_reference(
+                    key, c_m_n_host_results[i], [&] { ref_invoker.Run(ref_argument); });
+            }
+
+            return true;
+        });
     }
 
     // profile device GEMM instances
@@ -253,6 +286,8 @@ bool profile_grouped_gemm_impl(int do_verification,
 
             auto kbatch_curr = kbatch_list[j];
 
+            const std::string parameters = "KBatch=" + std::to_string(kbatch_curr);
+
             dynamic_cast<DeviceOpSplitK*>(gemm_ptr.get())
                 ->SetKBatchSize(argument_ptr.get(), kbatch_curr);
 
@@ -263,53 +298,32 @@ bool profile_grouped_gemm_impl(int do_verification,
 
                 invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, false});
 
+                // read back before timing, split-K instances accumulate into C; not Tensors,
+                // whose initialization would wait for the host thread pool
+                std::vector<std::vector<CDataType>> c_m_n_device_data;
+                std::size_t c_bytes = 0;
+
                 if(do_verification)
                 {
-                    bool instance_pass = true;
+                    c_m_n_device_data.reserve(gemm_descs.size());
+
                     for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     {
+                        c_m_n_device_data.emplace_back(
+                            c_m_n_device_results[i].mDesc.GetElementSpaceSize());
 
-                        c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
-
-                        if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i],
-                                                                      "Error: Incorrect results!",
-                                                                      0.06);
-                        }
-                        else
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i]);
-                        }
+                        c_device_buf[i]->FromDevice(c_m_n_device_data[i].data());
 
-                        if(do_log)
-                        {
-                            LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
-                                << std::endl;
-                            LogRangeAsType<float>(std::cout << "b: ", b_k_n[i].mData, ",")
-                                << std::endl;
-                            LogRangeAsType<float>(
-                                std::cout << "c_device: ", c_m_n_device_results[i].mData, ",")
-                                << std::endl;
-                            LogRangeAsType<float>(
-                                std::cout << "c_host  : ", c_m_n_host_results[i].mData, ",")
-                                << std::endl;
-                        }
+                        c_bytes += sizeof(CDataType) * c_m_n_device_data[i].size();
                     }
-
-                    std::cout << "Instance: " << gemm_name << " verification "
-                              << (instance_pass ? "SUCCEED" : "FAILED") << std::endl;
-
-                    pass = pass && instance_pass;
                 }
 
                 float ave_time =
                     invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, time_kernel});
 
+                float tflops     = 0;
+                float gb_per_sec = 0;
+
                 if(time_kernel)
                 {
                     std::size_t flop = 0, num_btype = 0;
@@ -322,9 +336,9 @@ bool profile_grouped_gemm_impl(int do_verification,
                                      sizeof(CDataType) * Ms[i] * Ns[i];
                     }
 
-                    float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
+                    tflops = static_cast<float>(flop) / 1.E9 / ave_time;
 
-                    float gb_per_sec = num_btype / 1.E6 / ave_time;
+                    gb_per_sec = num_btype / 1.E6 / ave_time;
                     std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
                               << " TFlops, " << gb_per_sec << " GB/s, " << gemm_name << ", KBatch "
                               << kbatch_curr << std::endl;
@@ -338,15 +352,83 @@ bool profile_grouped_gemm_impl(int do_verification,
                         best_kbatch     = kbatch_curr;
                     }
                 }
+
+                const auto result_id =
+                    profiler_results.Add(*gemm_ptr, ave_time, tflops, gb_per_sec, parameters);
+
+                if(do_verification)
+                {
+                    auto compare = [&,
+                                    gemm_name,
+                                    kbatch_curr,
+                                    c_m_n_device_data = std::move(c_m_n_device_data)] {
+                        bool instance_pass = true;
+
+                        for(std::size_t i = 0; i < gemm_descs.size(); i++)
+                        {
+                            const TensorView<const CDataType> c_m_n_device_result(
+                                c_m_n_device_data[i].data(), c_m_n_device_results[i].mDesc);
+
+                            const std::string msg = "Error: Incorrect results of " + gemm_name +
+                                                    ", KBatch " + std::to_string(kbatch_curr) + "!";
+
+                            if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
+                            {
+                                instance_pass = instance_pass &&
+                                                ck::utils::check_err(c_m_n_device_result,
+                                                                     c_m_n_host_results[i],
+                                                                     msg,
+                                                                     0.06);
+                            }
+                            else
+                            {
+                                instance_pass =
+                                    instance_pass && ck::utils::check_err(c_m_n_device_result,
+                                                                          c_m_n_host_results[i],
+                                                                          msg);
+                            }
+
+                            if(do_log)
+                            {
+                                LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
+                                    << std::endl;
+                                LogRangeAsType<float>(std::cout << "b: ", b_k_n[i].mData, ",")
+                                    << std::endl;
+                                LogRangeAsType<float>(
+                                    std::cout << "c_device: ", c_m_n_device_data[i], ",")
+                                    << std::endl;
+                                LogRangeAsType<float>(
+                                    std::cout << "c_host  : ", c_m_n_host_results[i].mData, ",")
+                                    << std::endl;
+                            }
+                        }
+
+                        std::cout << "Instance: " << gemm_name << ", KBatch " << kbatch_curr
+                                  << " verification " << (instance_pass ? "SUCCEED" : "FAILED")
+                                  << std::endl;
+
+                        return instance_pass;
+                    };
+
+                    verification.Submit(
+                        [&, result_id, compare = std::move(compare)] {
+                            return profiler_results.RecordVerification(result_id, compare());
+                        },
+                        c_bytes);
+                }
             }
             else
             {
+                profiler_results.AddUnsupported(*gemm_ptr, parameters);
+
                 std::cout << "Instance: " << gemm_name << ", does not support this GEMM problem"
                           << std::endl;
             }
         }
     }
 
+    pass = verification.Wait() && pass;
+
     if(time_kernel)
     {
         std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
@@ -13,6 +13,9 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -93,12 +96,16 @@ bool profile_layernorm_impl(int do_verification,
                                                                        NumReduceDim>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "layernorm",
+        ProblemDescriptor{}
+            .AddTypes<XDataType, GammaDataType, BetaDataType, ComputeDataType, YDataType>()
+            .Add("length", length));
+
     std::string best_instance_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -146,6 +153,8 @@ bool profile_layernorm_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString() << " skipped due to unsupported argument: ";
@@ -174,6 +183,8 @@ bool profile_layernorm_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(avg_time < best_avg_time)
         {
             best_instance_name = inst_ptr->GetTypeString();
@@ -185,8 +196,8 @@ bool profile_layernorm_impl(int do_verification,
         {
             y_dev.FromDevice(y.mData.data());
 
-            bool pass =
-                ck::utils::check_err(y.mData, host_y.mData, "Error: Incorrect results", 1e-3, 1e-3);
+            bool pass = profiler_results.RecordVerification(ck::utils::check_err(
+                y.mData, host_y.mData, "Error: Incorrect results", 1e-3, 1e-3));
 
             if(do_log)
             {
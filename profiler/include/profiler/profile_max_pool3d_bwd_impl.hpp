@@ -16,6 +16,9 @@
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_maxpool_bwd.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -149,12 +152,21 @@ bool profile_max_pool3d_bwd_impl(int do_verification,
         ck::tensor_operation::device::DeviceMaxPoolBwd<DOutDataType, IndexDataType, DInDataType>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "max_pool3d_bwd",
+        ProblemDescriptor{}
+            .AddTypes<InDataType, OutDataType, IndexDataType, DOutDataType, DInDataType>()
+            .Add("in_lengths", in_length)
+            .Add("window", window_spatial_lengths)
+            .Add("strides", window_strides)
+            .Add("dilations", window_dilations)
+            .Add("left_pads", input_left_pads)
+            .Add("right_pads", input_right_pads));
+
     std::string best_instance_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -195,6 +207,8 @@ bool profile_max_pool3d_bwd_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString() << " skipped due to unsupported argument: ";
@@ -222,6 +236,8 @@ bool profile_max_pool3d_bwd_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(avg_time < best_avg_time)
         {
             best_instance_name = inst_ptr->GetTypeString();
@@ -233,11 +249,12 @@ bool profile_max_pool3d_bwd_impl(int do_verification,
         {
             din_device_buf.FromDevice(din_n_c_di_hi_wi_device.mData.data());
 
-            bool pass = ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
-                                             din_n_c_di_hi_wi_host.mData,
-                                             "Error: Incorrect results",
-                                             1e-3,
-                                             1e-3);
+            bool pass = profiler_results.RecordVerification(
+                ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
+                                     din_n_c_di_hi_wi_host.mData,
+                                     "Error: Incorrect results",
+                                     1e-3,
+                                     1e-3));
 
             if(do_log)
             {
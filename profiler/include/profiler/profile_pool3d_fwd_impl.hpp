@@ -14,6 +14,9 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -115,12 +118,24 @@ bool profile_pool3d_fwd_impl(int do_verification,
                                                                  OutputIndex>;
 
     // get device op instances
-    const auto instance_ptrs =
-        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-            DeviceOp>::GetInstances();
+    const auto& instance_ptrs = get_device_op_instances<DeviceOp>();
 
     std::cout << "found " << instance_ptrs.size() << " instances" << std::endl;
 
+    ProfilerResults profiler_results(
+        "pool3d_fwd",
+        ProblemDescriptor{}
+            .AddTypes<InDataType, OutDataType, ComputeDataType, IndexDataType>()
+            .AddLayouts<InLayout, OutLayout>()
+            .Add("reduce_op", static_cast<int>(ReduceOpId))
+            .Add("output_index", OutputIndex)
+            .Add("in_lengths", in_length)
+            .Add("window", window_spatial_lengths)
+            .Add("strides", window_strides)
+            .Add("dilations", window_dilations)
+            .Add("left_pads", input_left_pads)
+            .Add("right_pads", input_right_pads));
+
     std::string best_instance_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -176,6 +191,8 @@ bool profile_pool3d_fwd_impl(int do_verification,
         }
         else
         {
+            profiler_results.AddUnsupported(*inst_ptr);
+
             if(time_kernel)
             {
                 std::cout << inst_ptr->GetTypeString() << " skipped due to unsupported argument: ";
@@ -202,6 +219,8 @@ bool profile_pool3d_fwd_impl(int do_verification,
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
 
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(avg_time < best_avg_time)
         {
             best_instance_name = inst_ptr->GetTypeString();
@@ -227,6 +246,8 @@ bool profile_pool3d_fwd_impl(int do_verification,
                                                     out_indices_n_c_do_ho_wo_host);
             }
 
+            profiler_results.RecordVerification(pass);
+
             if(do_log)
             {
                 LogRangeAsType<float>(
@@ -14,6 +14,9 @@
 #include "ck/library/utility/host_common_util.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -265,6 +268,17 @@ bool profile_reduce_impl_impl(bool do_verification,
 
         DeviceMem out_indices_dev(indicesSizeInBytes);
 
+        ProfilerResults profiler_results("reduce",
+                                         ProblemDescriptor{}
+                                             .AddTypes<InDataType, AccDataType, OutDataType>()
+                                             .Add("reduce_op", static_cast<int>(ReduceOpId))
+                                             .Add("propagate_nan", PropagateNan)
+                                             .Add("use_index", UseIndex)
+                                             .Add("in_lengths", inLengths)
+                                             .Add("reduce_dims", reduceDims)
+                                             .Add("alpha", alpha)
+                                             .Add("beta", beta));
+
         float best_avg_time   = 0;
         float best_gb_per_sec = 0;
 
@@ -292,9 +306,7 @@ bool profile_reduce_impl_impl(bool do_verification,
                                                                     AccElementwiseOperation,
                                                                     PropagateNan,
                                                                     OutputIndex>;
-        const auto reduce_ptrs =
-            ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-                ReduceOp>::GetInstances();
+        const auto& reduce_ptrs = get_device_op_instances<ReduceOp>();
 
         if(reduce_ptrs.empty())
         {
@@ -371,7 +383,11 @@ bool profile_reduce_impl_impl(bool do_verification,
                                                                 acc_elementwise_op);
 
             if(!reduce_ptr->IsSupportedArgument(argument_ptr.get()))
+            {
+                profiler_results.AddUnsupported(*reduce_ptr);
+
                 continue;
+            }
             else
                 num_kernel++;
 
@@ -392,6 +408,8 @@ bool profile_reduce_impl_impl(bool do_verification,
                 std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
                           << reduce_name << std::endl;
 
+            profiler_results.Add(*reduce_ptr, avg_time, 0, gb_per_sec);
+
             if(gb_per_sec > best_gb_per_sec)
             {
                 best_avg_time   = avg_time;
@@ -411,6 +429,8 @@ bool profile_reduce_impl_impl(bool do_verification,
                     single_pass = single_pass && ck::utils::check_err(out_indices, out_indices_ref);
                 };
 
+                profiler_results.RecordVerification(single_pass);
+
                 if(!single_pass)
                 {
                     std::cout << "Fail Info: " << reduce_ptr->GetTypeString() << std::endl;
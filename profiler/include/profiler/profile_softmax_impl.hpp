@@ -20,6 +20,9 @@
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 #include "ck/utility/data_type.hpp"
 
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -111,8 +114,7 @@ bool profile_softmax_impl(int do_verification,
                                                              NumReduceDim>;
 
     // get device op instances
-    const auto instances = tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto& instances = get_device_op_instances<DeviceOp>();
     std::cout << "found " << instances.size() << " instances" << std::endl;
 
     if(instances.size() <= 0)
@@ -120,6 +122,15 @@ bool profile_softmax_impl(int do_verification,
         throw std::runtime_error("wrong! no device normalization instance found");
     }
 
+    ProfilerResults profiler_results("softmax",
+                                     ProblemDescriptor{}
+                                         .AddTypes<InDataType, AccDataType, OutDataType>()
+                                         .Add("in_lengths", in_length)
+                                         .Add("in_strides", in_strides)
+                                         .Add("reduce_dims", reduce_dims)
+                                         .Add("alpha", alpha)
+                                         .Add("beta", beta));
+
     std::string best_instance_name;
     float best_avg_time   = std::numeric_limits<float>::max();
     float best_gb_per_sec = 0;
@@ -144,6 +155,7 @@ bool profile_softmax_impl(int do_verification,
                 << "], "
                 << "scaler = [" << alpha << ", " << beta << "]";
             LogRange(std::cout << ", reduce dims = [", reduce_dims, ", ") << "]." << std::endl;
+            profiler_results.AddUnsupported(*inst_ptr);
             instance_pass.push_back(true);
             continue;
         }
@@ -152,13 +164,14 @@ bool profile_softmax_impl(int do_verification,
         auto invoker_ptr = inst_ptr->MakeInvokerPointer();
         float avg_time   = invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, time_kernel});
 
+        std::size_t num_bytes = in.GetElementSize() * sizeof(InDataType) +
+                                (beta == 0.0f ? 1 : 2) * out.GetElementSize() * sizeof(OutDataType);
+        float gb_per_sec = num_bytes / 1.E6 / avg_time;
+
+        profiler_results.Add(*inst_ptr, avg_time, 0, gb_per_sec);
+
         if(time_kernel)
         {
-            std::size_t num_bytes =
-                in.GetElementSize() * sizeof(InDataType) +
-                (beta == 0.0f ? 1 : 2) * out.GetElementSize() * sizeof(OutDataType);
-            float gb_per_sec = num_bytes / 1.E6 / avg_time;
-
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
                       << inst_ptr->GetTypeString() << std::endl;
 
@@ -205,7 +218,7 @@ bool profile_softmax_impl(int do_verification,
                     << "], "
                     << "scaler = [" << alpha << ", " << beta << "]." << std::endl;
             }
-            instance_pass.push_back(pass);
+            instance_pass.push_back(profiler_results.RecordVerification(pass));
         }
     }
     if(time_kernel)
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/utility/device_memory.hpp"
+
+namespace ck {
+namespace profiler {
+
+// The instances of DeviceOp, built by DeviceOperationInstanceFactory on first use and shared by
+// every later profiler run in the process, e.g. the problems of a suite
+template <typename DeviceOp>
+const std::vector<std::unique_ptr<DeviceOp>>& get_device_op_instances()
+{
+    static const auto op_ptrs = tensor_operation::device::instance::DeviceOperationInstanceFactory<
+        DeviceOp>::GetInstances();
+
+    return op_ptrs;
+}
+
+namespace detail {
+
+struct DeviceBufferPool
+{
+    static DeviceBufferPool& GetInstance()
+    {
+        static DeviceBufferPool pool;
+
+        return pool;
+    }
+
+    bool is_enabled = false;
+    std::vector<std::unique_ptr<DeviceMem>> buffers;
+};
+
+} // namespace detail
+
+// Keeps the device buffers of the profiler runs in its lifetime, e.g. of a suite, in a pool:
+// later runs take and grow them instead of allocating their own. Frees the pool on destruction.
+class DeviceBufferPoolScope
+{
+    public:
+    DeviceBufferPoolScope() { detail::DeviceBufferPool::GetInstance().is_enabled = true; }
+
+    DeviceBufferPoolScope(const DeviceBufferPoolScope&) = delete;
+    DeviceBufferPoolScope& operator=(const DeviceBufferPoolScope&) = delete;
+
+    ~DeviceBufferPoolScope()
+    {
+        auto& pool = detail::DeviceBufferPool::GetInstance();
+
+        pool.is_enabled = false;
+        pool.buffers.clear();
+    }
+};
+
+// Device buffers of one profiler run, taken from the pool of a DeviceBufferPoolScope if there is
+// one and handed back on destruction, allocated and freed as usual otherwise. A buffer may be
+// larger than asked for, so copies to and from it must give their size.
+class ProfilerDeviceBuffers
+{
+    public:
+    ProfilerDeviceBuffers() = default;
+
+    ProfilerDeviceBuffers(const ProfilerDeviceBuffers&) = delete;
+    ProfilerDeviceBuffers& operator=(const ProfilerDeviceBuffers&) = delete;
+
+    ~ProfilerDeviceBuffers()
+    {
+        auto& pool = detail::DeviceBufferPool::GetInstance();
+
+        if(pool.is_enabled)
+        {
+            for(auto& buffer : buffers_)
+                pool.buffers.push_back(std::move(buffer));
+        }
+    }
+
+    // a buffer of at least bytes bytes, its contents undefined
+    DeviceMem& Get(std::size_t bytes)
+    {
+        auto& pool = detail::DeviceBufferPool::GetInstance();
+
+        std::unique_ptr<DeviceMem> buffer;
+
+        if(pool.is_enabled && !pool.buffers.empty())
+        {
+            // the smallest one that fits, or else the largest one, grown
+            const auto best = std::min_element(
+                pool.buffers.begin(), pool.buffers.end(), [&](const auto& x, const auto& y) {
+                    const std::size_t x_size = x->GetBufferSize();
+                    const std::size_t y_size = y->GetBufferSize();
+
+                    if((x_size >= bytes) != (y_size >= bytes))
+                        return x_size >= bytes;
+
+                    return x_size >= bytes ? x_size < y_size : x_size > y_size;
+                });
+
+            buffer = std::move(*best);
+            pool.buffers.erase(best);
+
+            if(buffer->GetBufferSize() < bytes)
+                buffer->Realloc(bytes);
+        }
+        else
+        {
+            buffer = std::make_unique<DeviceMem>(bytes);
+        }
+
+        buffers_.push_back(std::move(buffer));
+
+        return *buffers_.back();
+    }
+
+    private:
+    std::vector<std::unique_ptr<DeviceMem>> buffers_;
+};
+
+} // namespace profiler
+} // namespace ck
@@ -0,0 +1,485 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+
+#include "ck/library/tensor_operation_instance/tuned_device_op_instance.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/tuning_database.hpp"
+
+namespace ck {
+namespace profiler {
+
+template <typename T>
+std::string get_data_type_name()
+{
+    if constexpr(std::is_same_v<T, double>)
+        return "f64";
+    else if constexpr(std::is_same_v<T, float>)
+        return "f32";
+    else if constexpr(std::is_same_v<T, half_t>)
+        return "f16";
+    else if constexpr(std::is_same_v<T, bhalf_t>)
+        return "bf16";
+#if defined CK_ENABLE_FP8
+    else if constexpr(std::is_same_v<T, f8_t>)
+        return "f8";
+#endif
+#if defined CK_ENABLE_BF8
+    else if constexpr(std::is_same_v<T, bf8_t>)
+        return "bf8";
+#endif
+#ifdef CK_EXPERIMENTAL_BIT_INT_EXTENSION_INT4
+    else if constexpr(std::is_same_v<T, int4_t>)
+        return "int4";
+#endif
+    else if constexpr(std::is_same_v<T, int8_t>)
+        return "int8";
+    else if constexpr(std::is_same_v<T, int32_t>)
+        return "int32";
+    else
+        return typeid(T).name();
+}
+
+// "key=value" pairs naming the problem a profiler run is timed on, e.g.
+// "types=f16,f16,f16 layouts=RowMajor,RowMajor,RowMajor M=3840 N=4096 K=4096"
+class ProblemDescriptor
+{
+    public:
+    template <typename... Ts>
+    ProblemDescriptor& AddTypes(const std::string& key = "types")
+    {
+        std::vector<std::string> names{get_data_type_name<Ts>()...};
+
+        return Add(key, names);
+    }
+
+    template <typename... Layouts>
+    ProblemDescriptor& AddLayouts(const std::string& key = "layouts")
+    {
+        std::vector<std::string> names{Layouts::name...};
+
+        return Add(key, names);
+    }
+
+    template <typename T>
+    ProblemDescriptor& Add(const std::string& key, const T& value)
+    {
+        os_ << (os_.tellp() == 0 ? "" : " ") << key << "=";
+
+        if constexpr(std::is_convertible_v<const T&, std::string> || !is_range<T>::value)
+        {
+            os_ << value;
+        }
+        else
+        {
+            // comma separated
+            bool is_first = true;
+
+            for(const auto& x : value)
+            {
+                os_ << (is_first ? "" : ",") << x;
+                is_first = false;
+            }
+        }
+
+        return *this;
+    }
+
+    ProblemDescriptor& Add(const utils::conv::ConvParam& param)
+    {
+        return Add("NDimSpatial", param.num_dim_spatial_)
+            .Add("G", param.G_)
+            .Add("N", param.N_)
+            .Add("K", param.K_)
+            .Add("C", param.C_)
+            .Add("filter", param.filter_spatial_lengths_)
+            .Add("input", param.input_spatial_lengths_)
+            .Add("strides", param.conv_filter_strides_)
+            .Add("dilations", param.conv_filter_dilations_)
+            .Add("left_pads", param.input_left_pads_)
+            .Add("right_pads", param.input_right_pads_);
+    }
+
+    std::string ToString() const { return os_.str(); }
+
+    private:
+    template <typename T, typename = void>
+    struct is_range : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_range<T, std::void_t<decltype(std::begin(std::declval<const T&>()))>>
+        : std::true_type
+    {
+    };
+
+    std::ostringstream os_;
+};
+
+enum struct VerificationOutcome
+{
+    NotRun,
+    Pass,
+    Fail,
+};
+
+inline const char* to_string(VerificationOutcome outcome)
+{
+    switch(outcome)
+    {
+    case VerificationOutcome::Pass: return "pass";
+    case VerificationOutcome::Fail: return "fail";
+    default: return "not_run";
+    }
+}
+
+// the outcome of profiling one instance on one problem
+struct InstanceResult
+{
+    std::string operation;
+    std::string problem;
+    std::string instance;
+    std::string type_id;
+    std::string parameters;
+    bool is_supported                = false;
+    float ave_time                   = 0;
+    float tflops                     = 0;
+    float gb_per_sec                 = 0;
+    VerificationOutcome verification = VerificationOutcome::NotRun;
+};
+
+inline std::string to_json_string(const std::string& s)
+{
+    std::ostringstream os;
+
+    os << '"';
+
+    for(const char c : s)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+        else
+            os << c;
+    }
+
+    os << '"';
+
+    return os.str();
+}
+
+inline std::string to_json(const InstanceResult& result)
+{
+    std::ostringstream os;
+
+    os << "{\"operation\": " << to_json_string(result.operation)
+       << ", \"problem\": " << to_json_string(result.problem)
+       << ", \"instance\": " << to_json_string(result.instance)
+       << ", \"type_id\": " << to_json_string(result.type_id)
+       << ", \"parameters\": " << to_json_string(result.parameters)
+       << ", \"supported\": " << (result.is_supported ? "true" : "false");
+
+    if(result.is_supported)
+    {
+        os << ", \"ave_time_ms\": " << result.ave_time << ", \"tflops\": " << result.tflops
+           << ", \"gb_per_sec\": " << result.gb_per_sec;
+    }
+
+    os << ", \"verification\": \"" << to_string(result.verification) << "\"}";
+
+    return os.str();
+}
+
+inline std::string to_csv_field(const std::string& s)
+{
+    if(s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+
+    std::string field = "\"";
+
+    for(const char c : s)
+        field += c == '"' ? std::string("\"\"") : std::string(1, c);
+
+    return field + "\"";
+}
+
+inline std::string to_csv(const InstanceResult& result)
+{
+    std::ostringstream os;
+
+    os << to_csv_field(result.operation) << "," << to_csv_field(result.problem) << ","
+       << to_csv_field(result.instance) << "," << to_csv_field(result.type_id) << ","
+       << to_csv_field(result.parameters) << "," << (result.is_supported ? 1 : 0) << ",";
+
+    if(result.is_supported)
+        os << result.ave_time << "," << result.tflops << "," << result.gb_per_sec;
+    else
+        os << ",,";
+
+    os << "," << to_string(result.verification);
+
+    return os.str();
+}
+
+enum struct ResultFormat
+{
+    JsonLines,
+    Csv,
+};
+
+// Where the per-instance results of the profiler runs go: a JSON Lines or CSV file, appended to,
+// and/or kept in memory for the caller, e.g. the report of a suite. Disabled by default.
+class ProfilerResultSink
+{
+    public:
+    static ProfilerResultSink& GetInstance()
+    {
+        static ProfilerResultSink sink;
+
+        return sink;
+    }
+
+    static constexpr const char* csv_header =
+        "operation,problem,instance,type_id,parameters,supported,ave_time_ms,tflops,gb_per_sec,"
+        "verification";
+
+    // CSV if path ends with ".csv", JSON Lines otherwise
+    void Open(const std::string& path)
+    {
+        const bool is_csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+
+        Open(path, is_csv ? ResultFormat::Csv : ResultFormat::JsonLines);
+    }
+
+    void Open(const std::string& path, ResultFormat format)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const bool is_empty = !std::ifstream(path) || std::ifstream(path).peek() == EOF;
+
+        file_.close();
+        file_.clear();
+        file_.open(path, std::ios::app);
+
+        if(!file_)
+            throw std::runtime_error("wrong! cannot open result file " + path);
+
+        format_ = format;
+
+        if(format_ == ResultFormat::Csv && is_empty)
+            file_ << csv_header << std::endl;
+    }
+
+    void SetCollecting(bool is_collecting)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        is_collecting_ = is_collecting;
+        collected_.clear();
+    }
+
+    bool IsEnabled() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return file_.is_open() || is_collecting_;
+    }
+
+    void Write(const std::vector<InstanceResult>& results)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(file_.is_open())
+        {
+            for(const auto& result : results)
+                file_ << (format_ == ResultFormat::Csv ? to_csv(result) : to_json(result)) << "\n";
+
+            file_.flush();
+        }
+
+        if(is_collecting_)
+            collected_.insert(collected_.end(), results.begin(), results.end());
+    }
+
+    // the results written since the last call, if collecting
+    std::vector<InstanceResult> TakeCollected()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return std::exchange(collected_, {});
+    }
+
+    private:
+    ProfilerResultSink() = default;
+
+    mutable std::mutex mutex_;
+    std::ofstream file_;
+    ResultFormat format_ = ResultFormat::JsonLines;
+    bool is_collecting_  = false;
+    std::vector<InstanceResult> collected_;
+};
+
+// The results of one profiler run, one per instance, written to the sink on destruction, and the
+// fastest instance to the tuning database if SetTuningShape() was called. Verification outcomes
+// may be recorded from another thread, e.g. a VerificationPipeline task.
+class ProfilerResults
+{
+    public:
+    ProfilerResults(std::string operation, const ProblemDescriptor& problem)
+        : operation_(std::move(operation)), problem_(problem.ToString())
+    {
+    }
+
+    ProfilerResults(const ProfilerResults&) = delete;
+    ProfilerResults& operator=(const ProfilerResults&) = delete;
+
+    ~ProfilerResults()
+    {
+        try
+        {
+            ProfilerResultSink::GetInstance().Write(results_);
+
+            if(tuning_key_.has_value())
+                RecordTuning();
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << "cannot write profiler results: " << e.what() << std::endl;
+        }
+    }
+
+    // the instances are those of DeviceOp and shape identifies the problem among those of the same
+    // signature, e.g. {M, N, K}; see get_tuned_device_op_instance()
+    template <typename DeviceOp>
+    void SetTuningShape(std::vector<int64_t> shape)
+    {
+        using tensor_operation::device::instance::get_device_op_signature;
+
+        tuning_key_ = utils::TuningKey{
+            get_device_op_signature<DeviceOp>(), get_device_name(), std::move(shape)};
+    }
+
+    // returns the index of the result, for RecordVerification(); parameters are those of the run
+    // besides the instance, e.g. "KBatch=4"
+    std::size_t AddUnsupported(const tensor_operation::device::BaseOperator& op,
+                               const std::string& parameters = {})
+    {
+        return Add(op, parameters, false, 0, 0, 0);
+    }
+
+    std::size_t Add(const tensor_operation::device::BaseOperator& op,
+                    float ave_time,
+                    float tflops,
+                    float gb_per_sec,
+                    const std::string& parameters = {})
+    {
+        return Add(op, parameters, true, ave_time, tflops, gb_per_sec);
+    }
+
+    // records the verification of the result at index, by default the last one added; returns pass
+    bool RecordVerification(bool pass)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(results_.empty())
+            throw std::runtime_error("wrong! no result to record the verification of");
+
+        return SetVerification(results_.size() - 1, pass);
+    }
+
+    bool RecordVerification(std::size_t index, bool pass)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return SetVerification(index, pass);
+    }
+
+    private:
+    // mutex_ must be held
+    bool SetVerification(std::size_t index, bool pass)
+    {
+        results_.at(index).verification =
+            pass ? VerificationOutcome::Pass : VerificationOutcome::Fail;
+
+        return pass;
+    }
+
+    std::size_t Add(const tensor_operation::device::BaseOperator& op,
+                    const std::string& parameters,
+                    bool is_supported,
+                    float ave_time,
+                    float tflops,
+                    float gb_per_sec)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        results_.push_back({operation_,
+                            problem_,
+                            op.GetTypeString(),
+                            op.GetTypeIdHashCode(),
+                            parameters,
+                            is_supported,
+                            ave_time,
+                            tflops,
+                            gb_per_sec,
+                            VerificationOutcome::NotRun});
+
+        return results_.size() - 1;
+    }
+
+    // the fastest timed instance that did not fail verification; instances with run parameters,
+    // e.g. KBatch, are left out, the tuning database has no place for them
+    void RecordTuning() const
+    {
+        const InstanceResult* best = nullptr;
+
+        for(const auto& result : results_)
+        {
+            if(result.is_supported && result.ave_time > 0 && result.parameters.empty() &&
+               result.verification != VerificationOutcome::Fail &&
+               (best == nullptr || result.ave_time < best->ave_time))
+            {
+                best = &result;
+            }
+        }
+
+        if(best != nullptr && !tuning_key_->arch.empty())
+        {
+            utils::TuningDatabase::GetInstance().Insert(
+                {*tuning_key_, best->type_id, best->instance, best->ave_time, best->tflops});
+        }
+    }
+
+    std::string operation_;
+    std::string problem_;
+    std::optional<utils::TuningKey> tuning_key_;
+
+    std::mutex mutex_;
+    std::vector<InstanceResult> results_;
+};
+
+} // namespace profiler
+} // namespace ck
@@ -126,7 +126,7 @@ int profile_batched_gemm_add_relu_gemm_add(int argc, char* argv[])
         printf("arg13 to 18: StrideA0, StrideB0, StrideD0, StrideB1, StrideD1, StrideE1\n");
         printf("arg19 to 24: BatchStrideA0, BatchStrideB0, BatchStrideD0, BatchStrideB1, "
                "BatchStrideD1, BatchStrideE1 \n");
-        exit(1);
+        return 1;
     }
 
     if(data_type == GemmDataType::F16_F16_F16_F16_F16_F16 &&
@@ -44,7 +44,7 @@ int profile_contraction_bilinear(int argc, char* argv[])
     if(argc != 32 && argc != 16)
     {
         print_helper_msg();
-        exit(1);
+        return 1;
     }
 
     const auto data_type          = static_cast<ContractionDataType>(std::stoi(argv[2]));
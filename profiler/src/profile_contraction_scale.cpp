@@ -44,7 +44,7 @@ int profile_contraction_scale(int argc, char* argv[])
     if(argc != 31 && argc != 15)
     {
         print_helper_msg();
-        exit(1);
+        return 1;
     }
 
     const auto data_type          = static_cast<ContractionDataType>(std::stoi(argv[2]));
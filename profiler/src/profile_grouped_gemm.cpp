@@ -70,7 +70,7 @@ int profile_grouped_gemm(int argc, char* argv[])
             << "arg15: kbatch value (default 4)\n"
             << std::endl;
 
-        exit(1);
+        return 1;
     }
 
     const auto data_type       = static_cast<GemmDataType>(std::stoi(argv[2]));
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ck/library/utility/host_random.hpp"
+
+#include "profiler/profiler_cache.hpp"
+#include "profiler/profiler_result_sink.hpp"
+#include "profiler_operation_registry.hpp"
+
+#define OP_NAME "suite"
+#define OP_DESC "Run a list of problems in one process"
+
+namespace {
+
+struct SuiteProblem
+{
+    std::size_t line;
+    std::vector<std::string> args;
+};
+
+struct SuiteResult
+{
+    const SuiteProblem* problem;
+    int status;
+    std::string error;
+    double seconds;
+    std::vector<ck::profiler::InstanceResult> instances;
+};
+
+void print_helper_msg()
+{
+    std::cout << "arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n"
+              << "arg2: problem list, one problem per line: <operation> <arguments...>,\n"
+              << "      the arguments being those of ckProfiler <operation>; empty lines and\n"
+              << "      lines starting with # are skipped\n"
+              << "arg3: report file, JSON (optional, default: stdout, the output of the\n"
+              << "      problems then going to stderr)\n"
+              << std::endl;
+}
+
+bool read_problems(const std::string& path, std::vector<SuiteProblem>& problems)
+{
+    std::ifstream file(path);
+
+    if(!file)
+    {
+        std::cerr << "cannot open problem list: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+
+    for(std::size_t line_number = 1; std::getline(file, line); ++line_number)
+    {
+        std::istringstream tokens(line);
+
+        SuiteProblem problem{line_number, {}};
+
+        for(std::string token; tokens >> token;)
+        {
+            if(problem.args.empty() && token[0] == '#')
+                break;
+
+            problem.args.push_back(token);
+        }
+
+        if(!problem.args.empty())
+            problems.push_back(std::move(problem));
+    }
+
+    return true;
+}
+
+// Sends what is written to stdout, by std::cout, printf or the device, to stderr until
+// destruction, so that the report alone goes to stdout.
+class StdoutToStderrScope
+{
+    public:
+    StdoutToStderrScope()
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+
+        stdout_fd_ = dup(STDOUT_FILENO);
+
+        if(stdout_fd_ < 0)
+            throw std::runtime_error("wrong! cannot redirect stdout to stderr");
+
+        if(dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+        {
+            close(stdout_fd_);
+            throw std::runtime_error("wrong! cannot redirect stdout to stderr");
+        }
+    }
+
+    StdoutToStderrScope(const StdoutToStderrScope&) = delete;
+    StdoutToStderrScope& operator=(const StdoutToStderrScope&) = delete;
+
+    ~StdoutToStderrScope()
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+
+        dup2(stdout_fd_, STDOUT_FILENO);
+        close(stdout_fd_);
+    }
+
+    private:
+    int stdout_fd_ = -1;
+};
+
+using ck::profiler::to_json_string;
+
+void write_report(std::ostream& os,
+                  const std::string& problem_list,
+                  const std::vector<SuiteResult>& results)
+{
+    std::size_t num_failed = 0;
+
+    for(const auto& result : results)
+        num_failed += result.status != 0;
+
+    os << "{\n"
+       << "  \"problem_list\": " << to_json_string(problem_list) << ",\n"
+       << "  \"num_problems\": " << results.size() << ",\n"
+       << "  \"num_failed\": " << num_failed << ",\n"
+       << "  \"problems\": [";
+
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+
+        std::string command;
+
+        for(const auto& arg : result.problem->args)
+            command += (command.empty() ? "" : " ") + arg;
+
+        os << (i == 0 ? "\n" : ",\n") << "    {\"line\": " << result.problem->line
+           << ", \"operation\": " << to_json_string(result.problem->args[0])
+           << ", \"command\": " << to_json_string(command) << ", \"status\": " << result.status
+           << ", \"pass\": " << (result.status == 0 ? "true" : "false");
+
+        if(!result.error.empty())
+            os << ", \"error\": " << to_json_string(result.error);
+
+        os << ", \"seconds\": " << result.seconds << ", \"instances\": [";
+
+        for(std::size_t j = 0; j < result.instances.size(); ++j)
+            os << (j == 0 ? "\n      " : ",\n      ") << to_json(result.instances[j]);
+
+        os << (result.instances.empty() ? "]}" : "\n    ]}");
+    }
+
+    os << "\n  ]\n}" << std::endl;
+}
+
+} // namespace
+
+int profile_suite(int argc, char* argv[])
+{
+    if(argc != 3 && argc != 4)
+    {
+        print_helper_msg();
+        return 1;
+    }
+
+    const std::string problem_list = argv[2];
+
+    std::vector<SuiteProblem> problems;
+
+    if(!read_problems(problem_list, problems))
+        return 1;
+
+    std::vector<SuiteResult> results;
+
+    results.reserve(problems.size());
+
+    {
+        // the report goes to stdout if there is no report file, the problems must not write there
+        std::optional<StdoutToStderrScope> stdout_to_stderr;
+
+        if(argc == 3)
+            stdout_to_stderr.emplace();
+
+        // device buffers are kept and grown across the problems, instance lists are built once
+        // per operation type by get_device_op_instances()
+        ck::profiler::DeviceBufferPoolScope buffer_pool;
+
+        // the results of every instance go into the report as well
+        auto& result_sink = ck::profiler::ProfilerResultSink::GetInstance();
+
+        result_sink.SetCollecting(true);
+
+        for(const auto& problem : problems)
+        {
+            SuiteResult result{&problem, 1, {}, 0, {}};
+
+            std::cout << "suite: line " << problem.line << ": " << problem.args[0] << std::endl;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            if(problem.args[0] == OP_NAME)
+            {
+                result.error = "nested suite";
+            }
+            else if(const auto operation =
+                        ProfilerOperationRegistry::GetInstance().Get(problem.args[0]);
+                    operation.has_value())
+            {
+                // argv as ckProfiler would see it, the operations may modify it
+                std::vector<std::string> args = problem.args;
+                std::vector<char*> op_argv{argv[0]};
+
+                for(auto& arg : args)
+                    op_argv.push_back(arg.data());
+
+                op_argv.push_back(nullptr);
+
+                // inputs as in a ckProfiler process of their own, whatever ran before
+                ck::host_common::reset_host_random_streams();
+
+                try
+                {
+                    result.status =
+                        (*operation)(static_cast<int>(op_argv.size()) - 1, op_argv.data());
+                }
+                catch(const std::exception& e)
+                {
+                    result.error = e.what();
+                }
+            }
+            else
+            {
+                result.error = "cannot find operation";
+            }
+
+            result.seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if(!result.error.empty())
+                std::cerr << "suite: line " << problem.line << ": " << result.error << std::endl;
+
+            result.instances = result_sink.TakeCollected();
+
+            results.push_back(std::move(result));
+        }
+
+        result_sink.SetCollecting(false);
+    }
+
+    if(argc == 4)
+    {
+        std::ofstream report(argv[3]);
+
+        if(!report)
+        {
+            std::cerr << "cannot open report file: " << argv[3] << std::endl;
+            return 1;
+        }
+
+        write_report(report, problem_list, results);
+    }
+    else
+    {
+        write_report(std::cout, problem_list, results);
+    }
+
+    for(const auto& result : results)
+    {
+        if(result.status != 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_suite);
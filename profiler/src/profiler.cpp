@@ -2,17 +2,92 @@
 // Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+
+#include "ck/library/utility/host_random.hpp"
+#include "ck/library/utility/tuning_database.hpp"
+
+#include "profiler/profiler_result_sink.hpp"
 
 #include "profiler_operation_registry.hpp"
 
 static void print_helper_message()
 {
-    std::cout << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl;
+    std::cout << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl
+              << "--seed N: seed of the host tensor initialization, anywhere on the command line "
+                 "(default: CK_HOST_RANDOM_SEED or a fixed value)"
+              << std::endl
+              << "--results FILE: append the results of every instance to FILE, CSV if it ends "
+                 "with .csv, JSON Lines otherwise"
+              << std::endl
+              << "--tuning-db FILE: record the fastest instance of each problem in the tuning "
+                 "database FILE, created or updated"
+              << std::endl;
+}
+
+// Consume "name value" from the command line, so that the operations only see their own
+// arguments. set_value throws on an invalid value.
+template <typename F>
+static bool parse_option(int& argc, char* argv[], const char* name, F set_value)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], name) != 0)
+            continue;
+
+        if(i + 1 >= argc)
+        {
+            std::cerr << "missing value of " << name << std::endl;
+            return false;
+        }
+
+        try
+        {
+            set_value(argv[i + 1]);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << "invalid value of " << name << ": " << argv[i + 1] << " (" << e.what()
+                      << ")" << std::endl;
+            return false;
+        }
+
+        for(int j = i + 2; j <= argc; ++j)
+            argv[j - 2] = argv[j];
+
+        argc -= 2;
+        --i;
+    }
+
+    return true;
 }
 
 int main(int argc, char* argv[])
 {
+    const auto set_seed = [](const char* value) {
+        ck::host_common::set_host_random_seed(std::stoull(value));
+    };
+
+    const auto open_results = [](const char* value) {
+        ck::profiler::ProfilerResultSink::GetInstance().Open(value);
+    };
+
+    std::string tuning_db_path;
+
+    const auto open_tuning_db = [&](const char* value) {
+        ck::utils::TuningDatabase::GetInstance().Load(value);
+        tuning_db_path = value;
+    };
+
+    if(!parse_option(argc, argv, "--seed", set_seed) ||
+       !parse_option(argc, argv, "--results", open_results) ||
+       !parse_option(argc, argv, "--tuning-db", open_tuning_db))
+    {
+        return EXIT_FAILURE;
+    }
+
     if(argc == 1)
     {
         print_helper_message();
@@ -20,7 +95,22 @@ int main(int argc, char* argv[])
     else if(const auto operation = ProfilerOperationRegistry::GetInstance().Get(argv[1]);
             operation.has_value())
     {
-        return (*operation)(argc, argv);
+        const int status = (*operation)(argc, argv);
+
+        if(!tuning_db_path.empty())
+        {
+            try
+            {
+                ck::utils::TuningDatabase::GetInstance().Save(tuning_db_path);
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << "cannot save tuning database: " << e.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        return status;
     }
     else
     {
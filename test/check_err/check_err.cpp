@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <limits>
+#include <list>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace {
+
+// the element-wise test of the serial check_err() implementation
+template <typename T>
+std::size_t naive_err_count(const std::vector<T>& out,
+                            const std::vector<T>& ref,
+                            double rtol,
+                            double atol)
+{
+    std::size_t err_count = 0;
+
+    for(std::size_t i = 0; i < out.size(); ++i)
+    {
+        const double o = ck::type_convert<float>(out[i]);
+        const double r = ck::type_convert<float>(ref[i]);
+
+        if(std::abs(o - r) > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
+            ++err_count;
+    }
+
+    return err_count;
+}
+
+template <typename T>
+void run_decision_test(double rtol, double atol)
+{
+    std::vector<float> ref_f32(100003);
+    std::vector<float> noise(ref_f32.size());
+
+    ck::utils::FillUniformDistribution<float>{-4.f, 4.f}(ref_f32);
+    ck::utils::FillUniformDistribution<float>{-3e-3f, 3e-3f}(noise);
+
+    std::vector<T> out(ref_f32.size());
+    std::vector<T> ref(ref_f32.size());
+
+    for(std::size_t i = 0; i < ref.size(); ++i)
+    {
+        ref[i] = ck::type_convert<T>(ref_f32[i]);
+        out[i] = ck::type_convert<T>(ref_f32[i] + noise[i]);
+    }
+
+    const std::size_t expected = naive_err_count(out, ref, rtol, atol);
+
+    ASSERT_GT(expected, 0);
+
+    const auto stats = ck::utils::check_err_stats(out, ref, rtol, atol);
+
+    EXPECT_EQ(stats.num_checked, out.size());
+    EXPECT_EQ(stats.err_count, expected);
+    EXPECT_FALSE(ck::utils::check_err(out, ref, "expected failure", rtol, atol));
+    EXPECT_TRUE(ck::utils::check_err(out, ref, "unexpected failure", rtol, 5e-2));
+}
+
+} // anonymous namespace
+
+TEST(CheckErr, DecisionMatchesElementwiseTest)
+{
+    run_decision_test<float>(1e-5, 1e-3);
+    run_decision_test<ck::half_t>(1e-3, 1e-3);
+    run_decision_test<ck::bhalf_t>(1e-3, 1e-3);
+}
+
+TEST(CheckErr, IndependentOfThreadCount)
+{
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    std::vector<float> ref(50000, 1.f);
+    std::vector<float> out(ref);
+
+    for(std::size_t i : {49999, 30000, 4096, 4095, 17, 3})
+        out[i] = 2.f;
+
+    out[100] = std::numeric_limits<float>::quiet_NaN();
+    out[200] = std::numeric_limits<float>::infinity();
+
+    for(std::size_t n : {1, 4})
+    {
+        ck::host_common::set_host_num_threads(n);
+
+        const auto stats = ck::utils::check_err_stats(out, ref, 1e-5, 1e-5);
+
+        EXPECT_EQ(stats.err_count, 8);
+        EXPECT_EQ(stats.nan_count, 1);
+        EXPECT_EQ(stats.inf_count, 1);
+        EXPECT_EQ(stats.max_err, std::numeric_limits<double>::infinity());
+        EXPECT_EQ(stats.max_abs_err, 1.);
+        EXPECT_EQ(stats.max_rel_err, 1.);
+
+        // the first mismatches in range order
+        ASSERT_EQ(stats.mismatches.size(), 4);
+        EXPECT_EQ(stats.mismatches[0].offset, 3);
+        EXPECT_EQ(stats.mismatches[1].offset, 17);
+        EXPECT_EQ(stats.mismatches[2].offset, 100);
+        EXPECT_EQ(stats.mismatches[3].offset, 200);
+        EXPECT_EQ(stats.mismatches[0].out, 2.);
+        EXPECT_EQ(stats.mismatches[0].ref, 1.);
+    }
+
+    ck::host_common::set_host_num_threads(num_thread);
+}
+
+TEST(CheckErr, UlpHistogram)
+{
+    const float one_ulp = std::ldexp(1.f, -10); // of half values in [1, 2)
+
+    std::vector<ck::half_t> ref(4, ck::half_t{1.f});
+    std::vector<ck::half_t> out{ck::half_t{1.f},
+                                ck::half_t{1.f + one_ulp},
+                                ck::half_t{1.f + 2 * one_ulp},
+                                ck::half_t{1.f + 7 * one_ulp}};
+
+    const auto stats = ck::utils::check_err_stats(out, ref, 0, 0);
+
+    EXPECT_EQ(stats.err_count, 3);
+    EXPECT_EQ(stats.ulp_histogram[0], 1);
+    EXPECT_EQ(stats.ulp_histogram[1], 1);
+    EXPECT_EQ(stats.ulp_histogram[2], 1);
+    EXPECT_EQ(stats.ulp_histogram[3], 1);
+}
+
+TEST(CheckErr, IntegerAndNonRandomAccessRanges)
+{
+    const std::list<int> ref{1, 2, 3, 4, 5};
+    const std::list<int> out{1, 2, 5, 4, 4};
+
+    const auto stats = ck::utils::check_err_stats(out, ref, 0, 1);
+
+    EXPECT_EQ(stats.err_count, 1);
+    EXPECT_EQ(stats.max_abs_err, 2.);
+    ASSERT_EQ(stats.mismatches.size(), 1);
+    EXPECT_EQ(stats.mismatches[0].offset, 2);
+
+    EXPECT_FALSE(ck::utils::check_err(out, ref, "expected failure"));
+    EXPECT_TRUE(ck::utils::check_err(out, ref, "unexpected failure", 0, 2));
+}
+
+TEST(CheckErr, StopAfterMaxFail)
+{
+    std::vector<float> ref(1 << 20, 0.f);
+    std::vector<float> out(ref.size(), 1.f);
+
+    const auto stats = ck::utils::check_err_stats(out, ref, 0, 0, 4, 100);
+
+    EXPECT_GE(stats.err_count, 100);
+    EXPECT_LT(stats.num_checked, out.size());
+    EXPECT_EQ(stats.err_count, stats.num_checked);
+}
+
+TEST(CheckErr, TensorMismatchIndex)
+{
+    // [2, 3, 4] lengths stored as [4, 2, 3]
+    Tensor<float> tensor(HostTensorDescriptor({2, 3, 4}, {3, 1, 6}));
+
+    const std::size_t offset = tensor.mDesc.GetOffsetFromMultiIndex(1, 2, 3);
+
+    EXPECT_EQ(ck::utils::detail::format_check_err_index(tensor, offset), "1, 2, 3");
+    EXPECT_EQ(ck::utils::detail::format_check_err_index(std::vector<float>(8), 5), "5");
+}
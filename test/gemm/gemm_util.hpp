@@ -7,6 +7,7 @@
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
@@ -45,7 +46,16 @@ void RunHostGEMM(const Tensor<ADataType>& A,
 
     auto ref_argument = ref_gemm.MakeArgument(A, B, C, a_element_op, b_element_op, c_element_op);
 
-    ref_invoker.Run(ref_argument);
+    const auto key = ck::host_common::HostReferenceCacheKey("gemm")
+                         .AddType<GemmInstance>()
+                         .AddObject(a_element_op)
+                         .AddObject(b_element_op)
+                         .AddObject(c_element_op)
+                         .Add(A)
+                         .Add(B);
+
+    ck::host_common::compute_cached_host_reference(
+        key, C, [&] { ref_invoker.Run(ref_argument); });
 }
 
 template <typename DeviceGemmPtr_,
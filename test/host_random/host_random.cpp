@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_random.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+using ck::host_common::Philox4x32;
+
+TEST(Philox4x32, KnownAnswer)
+{
+    // known answer values of the Random123 reference implementation
+    EXPECT_EQ(Philox4x32::Generate({0, 0, 0, 0}, {0, 0}),
+              (Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox4x32::Generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                   {0xffffffff, 0xffffffff}),
+              (Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+}
+
+TEST(HostRandom, FillIndependentOfThreadCount)
+{
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    std::vector<float> serial(1001);
+    std::vector<float> parallel(1001);
+
+    ck::host_common::set_host_num_threads(1);
+    ck::host_common::reset_host_random_streams();
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(serial);
+
+    ck::host_common::set_host_num_threads(4);
+    ck::host_common::reset_host_random_streams();
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(parallel);
+
+    ck::host_common::set_host_num_threads(num_thread);
+
+    EXPECT_EQ(serial, parallel);
+
+    for(float v : serial)
+    {
+        EXPECT_GE(v, -1.f);
+        EXPECT_LT(v, 1.f);
+    }
+}
+
+TEST(HostRandom, GeneratorIndependentOfThreadCount)
+{
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    Tensor<float> serial({17, 33, 5});
+    Tensor<float> parallel({17, 33, 5});
+
+    ck::host_common::reset_host_random_streams();
+    serial.GenerateTensorValue(GeneratorTensor_3<float>{-2.f, 2.f}, 1);
+
+    ck::host_common::set_host_num_threads(4);
+    ck::host_common::reset_host_random_streams();
+    parallel.GenerateTensorValue(GeneratorTensor_3<float>{-2.f, 2.f});
+
+    ck::host_common::set_host_num_threads(num_thread);
+
+    EXPECT_EQ(serial.mData, parallel.mData);
+}
+
+TEST(HostRandom, StreamsAndSeeds)
+{
+    const std::uint64_t seed = ck::host_common::get_host_random_seed();
+
+    Tensor<int> a({64, 64});
+    Tensor<int> b({64, 64});
+    Tensor<int> c({64, 64});
+
+    // consecutive generators draw from different streams
+    ck::host_common::reset_host_random_streams();
+    a.GenerateTensorValue(GeneratorTensor_2<int>{-1000, 1000});
+    b.GenerateTensorValue(GeneratorTensor_2<int>{-1000, 1000});
+
+    EXPECT_NE(a.mData, b.mData);
+
+    // the same seed repeats the sequence, another seed does not
+    ck::host_common::set_host_random_seed(seed);
+    c.GenerateTensorValue(GeneratorTensor_2<int>{-1000, 1000});
+
+    EXPECT_EQ(a.mData, c.mData);
+
+    ck::host_common::set_host_random_seed(seed + 1);
+    c.GenerateTensorValue(GeneratorTensor_2<int>{-1000, 1000});
+
+    EXPECT_NE(a.mData, c.mData);
+
+    ck::host_common::set_host_random_seed(seed);
+}
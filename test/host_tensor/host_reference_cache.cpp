@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+using ck::host_common::compute_cached_host_reference;
+using ck::host_common::HostReferenceCache;
+using ck::host_common::HostReferenceCacheKey;
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+std::string get_temp_directory(const std::string& name)
+{
+    const auto path =
+        std::filesystem::temp_directory_path() / ("ck_test_host_reference_cache_" + name);
+
+    std::filesystem::remove_all(path);
+
+    return path.string();
+}
+
+std::size_t count_entries(const std::string& directory)
+{
+    std::size_t count = 0;
+
+    for(const auto& item : std::filesystem::directory_iterator(directory))
+        count += item.path().extension() == ".ckt";
+
+    return count;
+}
+
+} // anonymous namespace
+
+TEST(HostReferenceCache, KeyDependsOnProblem)
+{
+    Tensor<float> a({4, 8});
+    Tensor<float> b({8, 4});
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(a);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(b);
+
+    const auto make_key = [&](const Tensor<float>& x) {
+        return HostReferenceCacheKey("gemm").AddObject(PassThrough{}).Add(x).Add(b).ToString();
+    };
+
+    const std::string key = make_key(a);
+
+    EXPECT_EQ(key.size(), 32);
+    EXPECT_EQ(make_key(a), key);
+
+    // contents
+    Tensor<float> a_changed = a;
+
+    a_changed(3, 7) += 1.f;
+
+    EXPECT_NE(make_key(a_changed), key);
+
+    // layout of the same elements
+    Tensor<float> a_padded(HostTensorDescriptor({4, 8}, {9, 1}));
+
+    a_padded.ForEach([&](auto& self, auto idx) { self(idx) = a(idx); });
+
+    EXPECT_NE(make_key(a_padded), key);
+
+    // element type, element-wise operation and its state
+    Tensor<double> a_double = a.CopyAsType<double>();
+
+    EXPECT_NE(
+        HostReferenceCacheKey("gemm").AddObject(PassThrough{}).Add(a_double).Add(b).ToString(),
+        key);
+    const Scale scale_1{1.f};
+    const Scale scale_2{2.f};
+
+    EXPECT_NE(
+        HostReferenceCacheKey("gemm").AddObject(scale_1, scale_1.scale_).Add(a).Add(b).ToString(),
+        key);
+    EXPECT_NE(HostReferenceCacheKey("gemm").AddObject(scale_1, scale_1.scale_).ToString(),
+              HostReferenceCacheKey("gemm").AddObject(scale_2, scale_2.scale_).ToString());
+    EXPECT_NE(HostReferenceCacheKey("conv_fwd").AddObject(PassThrough{}).Add(a).Add(b).ToString(),
+              key);
+}
+
+TEST(HostReferenceCache, KeyIgnoresPadding)
+{
+    struct Padded
+    {
+        char c;
+        double d;
+    };
+
+    Padded x;
+    Padded y;
+
+    std::memset(&x, 0x00, sizeof(x));
+    std::memset(&y, 0xff, sizeof(y));
+
+    x.c = y.c = 1;
+    x.d = y.d = 2.0;
+
+    EXPECT_EQ(HostReferenceCacheKey("op").AddObject(x, x.c, x.d).ToString(),
+              HostReferenceCacheKey("op").AddObject(y, y.c, y.d).ToString());
+}
+
+TEST(HostReferenceCache, MissThenHit)
+{
+    auto& cache = HostReferenceCache::GetInstance();
+
+    const std::string directory = get_temp_directory("hit");
+
+    cache.SetDirectory(directory);
+
+    Tensor<float> a({16, 16});
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(a);
+
+    const auto key = HostReferenceCacheKey("negate").Add(a);
+
+    int num_computed = 0;
+
+    const auto compute = [&](Tensor<float>& result) {
+        ++num_computed;
+        result.ForEach([&](auto& self, auto idx) { self(idx) = -a(idx); });
+    };
+
+    Tensor<float> first({16, 16});
+
+    EXPECT_FALSE(compute_cached_host_reference(key, first, [&] { compute(first); }));
+    EXPECT_EQ(count_entries(directory), 1);
+
+    Tensor<float> second({16, 16});
+
+    EXPECT_TRUE(compute_cached_host_reference(key, second, [&] { compute(second); }));
+    EXPECT_EQ(num_computed, 1);
+    EXPECT_EQ(second.mData, first.mData);
+
+    // a result of another layout is a different entry
+    Tensor<float> transposed(HostTensorDescriptor({16, 16}, {1, 16}));
+
+    EXPECT_FALSE(compute_cached_host_reference(key, transposed, [&] { compute(transposed); }));
+    EXPECT_EQ(num_computed, 2);
+
+    // a corrupted entry is dropped and recomputed
+    for(const auto& item : std::filesystem::directory_iterator(directory))
+    {
+        std::fstream file(item.path(), std::ios::binary | std::ios::in | std::ios::out);
+
+        file.seekp(4096);
+        file.put('\x7f');
+    }
+
+    Tensor<float> third({16, 16});
+
+    EXPECT_FALSE(compute_cached_host_reference(key, third, [&] { compute(third); }));
+    EXPECT_EQ(num_computed, 3);
+    EXPECT_EQ(third.mData, first.mData);
+
+    cache.SetDirectory("");
+
+    Tensor<float> uncached({16, 16});
+
+    EXPECT_FALSE(compute_cached_host_reference(key, uncached, [&] { compute(uncached); }));
+    EXPECT_EQ(num_computed, 4);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(HostReferenceCache, EvictsLeastRecentlyUsed)
+{
+    auto& cache = HostReferenceCache::GetInstance();
+
+    const std::string directory = get_temp_directory("evict");
+    const std::size_t capacity  = cache.GetCapacity();
+
+    cache.SetDirectory(directory);
+
+    // room for two entries of 4 KB header and 4 KB payload
+    cache.SetCapacity(20 << 10);
+
+    Tensor<float> result({1024});
+
+    const auto insert = [&](int i) {
+        return compute_cached_host_reference(
+            HostReferenceCacheKey("fill").Add(i), result, [&] { result.SetZero(); });
+    };
+
+    EXPECT_FALSE(insert(0));
+    EXPECT_FALSE(insert(1));
+    EXPECT_EQ(count_entries(directory), 2);
+
+    // entry 0 becomes the most recently used one, so entry 1 is evicted by entry 2
+    EXPECT_TRUE(insert(0));
+    EXPECT_FALSE(insert(2));
+    EXPECT_EQ(count_entries(directory), 2);
+    EXPECT_TRUE(insert(0));
+    EXPECT_TRUE(insert(2));
+    EXPECT_FALSE(insert(1));
+
+    cache.SetCapacity(capacity);
+    cache.SetDirectory("");
+
+    std::filesystem::remove_all(directory);
+}
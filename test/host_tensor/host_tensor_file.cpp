@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_file.hpp"
+
+namespace {
+
+std::string get_temp_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / ("ck_test_host_tensor_file_" + name))
+        .string();
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+TEST(HostTensorFile, NativeRoundTripKeepsLayout)
+{
+    const std::string path = get_temp_path("native.bin");
+
+    // padded and permuted
+    Tensor<float> tensor(HostTensorDescriptor({7, 5, 3}, {1, 64, 7}));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(tensor);
+
+    // small chunks for several checksums
+    tensor.Save(path, {ck::host_common::HostTensorFileFormat::Native, 256});
+
+    {
+        const auto mapped = Tensor<float>::LoadMapped(path);
+
+        EXPECT_EQ(mapped.GetLengths(), tensor.GetLengths());
+        EXPECT_EQ(mapped.GetStrides(), tensor.GetStrides());
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 4096, 0);
+        EXPECT_TRUE(mapped.mFile->HasChecksums());
+        EXPECT_TRUE(mapped.mFile->VerifyChecksums());
+        EXPECT_TRUE(ck::utils::check_err(mapped, tensor, "Error: mapped tensor", 0, 0));
+
+        // writes are private to the mapping
+        mapped(6, 4, 2) = 42.f;
+    }
+
+    const Tensor<float> loaded = Tensor<float>::Load(path);
+
+    EXPECT_EQ(loaded.mData, tensor.mData);
+
+    EXPECT_THROW(Tensor<ck::half_t>::LoadMapped(path), std::runtime_error);
+
+    // flip one payload byte
+    std::string bytes = read_file(path);
+
+    bytes[4096 + 1000] ^= 1;
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+    EXPECT_FALSE(Tensor<float>::LoadMapped(path).mFile->VerifyChecksums());
+    EXPECT_THROW(Tensor<float>::Load(path), std::runtime_error);
+
+    // truncated
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes.substr(0, 5000);
+
+    EXPECT_THROW(Tensor<float>::LoadMapped(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST(HostTensorFile, NpyIsPackedRowMajor)
+{
+    const std::string path = get_temp_path("tensor.npy");
+
+    Tensor<ck::half_t> tensor({3, 4, 5});
+
+    ck::utils::FillUniformDistribution<ck::half_t>{-1.f, 1.f}(tensor);
+
+    // saved from a transposed view, i.e. gathered
+    const auto view = TensorView(tensor).Transpose(std::vector<std::size_t>{2, 0, 1});
+
+    view.Save(path);
+
+    const std::string bytes = read_file(path);
+
+    EXPECT_EQ(bytes.substr(0, 6), "\x93NUMPY");
+    EXPECT_NE(bytes.find("{'descr': '<f2', 'fortran_order': False, 'shape': (5, 3, 4), }"),
+              std::string::npos);
+    EXPECT_EQ(bytes.size(), 4096 + tensor.GetElementSpaceSizeInBytes());
+
+    const auto mapped = Tensor<ck::half_t>::LoadMapped(path);
+
+    EXPECT_EQ(mapped.GetLengths(), (std::vector<std::size_t>{5, 3, 4}));
+    EXPECT_EQ(mapped.GetStrides(), (std::vector<std::size_t>{12, 4, 1}));
+    EXPECT_TRUE(ck::utils::check_err(mapped, view, "Error: npy tensor", 0, 0));
+
+    Tensor<int32_t> vector({6});
+
+    vector.Save(path);
+
+    EXPECT_NE(read_file(path).find("'shape': (6,)"), std::string::npos);
+    EXPECT_EQ(Tensor<int32_t>::Load(path).mData, vector.mData);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+TEST(HostTensorIndexOdometer, MatchesDivisionBasedDecode)
+{
+    const std::array<std::size_t, 4> lens{3, 1, 4, 5};
+    const std::array<std::size_t, 4> strides{1, 7, 3, 12};
+    const std::size_t size = 3 * 1 * 4 * 5;
+
+    HostTensorIndexOdometer<4> odometer(lens, strides);
+
+    // every sub-range has to produce the same sequence as a fresh decode per element
+    for(std::size_t begin = 0; begin < size; begin += 7)
+    {
+        std::size_t i = begin;
+
+        odometer.ForEachInRange(begin, size, [&](const auto& index, std::size_t offset) {
+            std::size_t rest = i;
+            std::array<std::size_t, 4> expected;
+
+            for(std::size_t idim = 4; idim-- > 0;)
+            {
+                expected[idim] = rest % lens[idim];
+                rest /= lens[idim];
+            }
+
+            EXPECT_EQ(index, expected) << "position " << i;
+            EXPECT_EQ(offset,
+                      expected[0] * strides[0] + expected[1] * strides[1] +
+                          expected[2] * strides[2] + expected[3] * strides[3]);
+            ++i;
+        });
+
+        EXPECT_EQ(i, size);
+    }
+}
+
+TEST(HostTensorIndexOdometer, CarriesEveryOffset)
+{
+    using ck::index_t;
+
+    const std::array<index_t, 3> lens{4, 3, 5};
+    const std::array<index_t, 3> strides_a{1, 4, 12};
+    const std::array<index_t, 3> strides_b{40, 10, 2};
+
+    const auto index_set = ck::host_common::get_index_set<3>(lens);
+    auto odometer = ck::host_common::make_host_index_odometer<3>(lens, strides_a, strides_b);
+
+    ASSERT_EQ(odometer.GetSize(), index_set.size());
+
+    for(std::size_t begin = 0; begin < index_set.size(); begin += 7)
+    {
+        std::size_t i = begin;
+
+        odometer.ForEachInRange(
+            begin, index_set.size(), [&](const auto& index, const auto& offsets) {
+                const auto& expected = index_set[i];
+
+                EXPECT_TRUE(std::equal(index.begin(), index.end(), expected.begin()));
+                EXPECT_EQ(offsets[0],
+                          ck::host_common::get_offset_from_index<3>(strides_a, expected));
+                EXPECT_EQ(offsets[1],
+                          ck::host_common::get_offset_from_index<3>(strides_b, expected));
+                ++i;
+            });
+
+        EXPECT_EQ(i, index_set.size());
+    }
+}
+
+TEST(ParallelTensorFunctorNd, OffsetFollowsDescriptor)
+{
+    // non-packed, transposed layout
+    Tensor<int> t(HostTensorDescriptor({4, 6, 5}, {1, 20, 4}));
+
+    auto f = [&](const auto& idx, std::size_t offset) {
+        EXPECT_EQ(offset, t.GetOffsetFromMultiIndex(idx[0], idx[1], idx[2]));
+        t.mData[offset] = static_cast<int>(idx[0] * 100 + idx[1] * 10 + idx[2]);
+    };
+
+    make_ParallelTensorFunctorNd<3>(f, t.mDesc)(std::thread::hardware_concurrency());
+
+    for(std::size_t i0 = 0; i0 < 4; ++i0)
+        for(std::size_t i1 = 0; i1 < 6; ++i1)
+            for(std::size_t i2 = 0; i2 < 5; ++i2)
+                EXPECT_EQ(t(i0, i1, i2), i0 * 100 + i1 * 10 + i2);
+}
+
+TEST(HostTensorDescriptor, TraversalOrderFollowsStrides)
+{
+    using Order = std::vector<std::size_t>;
+
+    EXPECT_EQ(HostTensorDescriptor({2, 3, 4}).GetTraversalOrder(), (Order{0, 1, 2}));
+
+    // GNKHW lengths stored as GNHWK
+    EXPECT_EQ(HostTensorDescriptor({1, 2, 8, 3, 5}, {240, 120, 1, 40, 8}).GetTraversalOrder(),
+              (Order{0, 1, 3, 4, 2}));
+
+    // length-1 dimensions go first whatever their stride, broadcast dimensions last
+    EXPECT_EQ(HostTensorDescriptor({3, 1, 4}, {0, 1, 3}).GetTraversalOrder(), (Order{1, 2, 0}));
+}
+
+TEST(HostTensorDescriptor, MultiIndexFromOffsetInvertsOffset)
+{
+    // packed, GNKHW lengths stored as GNHWK, and a padded row-major layout
+    const std::vector<HostTensorDescriptor> descs{
+        HostTensorDescriptor({2, 3, 4}),
+        HostTensorDescriptor({1, 2, 8, 3, 5}, {240, 120, 1, 40, 8}),
+        HostTensorDescriptor({3, 5}, {8, 1})};
+
+    for(const auto& desc : descs)
+    {
+        const auto& lens = desc.GetLengths();
+
+        std::vector<std::size_t> index(lens.size(), 0);
+
+        for(std::size_t n = 0; n < desc.GetElementSize(); ++n)
+        {
+            EXPECT_EQ(desc.GetMultiIndexFromOffset(desc.GetOffsetFromMultiIndex(index)), index);
+
+            for(std::size_t d = lens.size(); d-- > 0;)
+            {
+                if(++index[d] < lens[d])
+                    break;
+
+                index[d] = 0;
+            }
+        }
+    }
+}
+
+TEST(ParallelTensorFunctorNd, VisitsInMemoryOrder)
+{
+    // permuted packed layout, memory order is dim 1, dim 2, dim 0
+    const HostTensorDescriptor desc({4, 6, 5}, {1, 20, 4});
+
+    std::vector<std::size_t> offsets;
+
+    auto f = [&](const auto& idx, std::size_t offset) {
+        EXPECT_EQ(offset, desc.GetOffsetFromMultiIndex(idx[0], idx[1], idx[2]));
+        offsets.push_back(offset);
+    };
+
+    make_ParallelTensorFunctorNd<3>(f, desc)(1);
+
+    ASSERT_EQ(offsets.size(), 120);
+
+    for(std::size_t i = 0; i < offsets.size(); ++i)
+        EXPECT_EQ(offsets[i], i);
+}
+
+TEST(Tensor, ForEachVisitsInMemoryOrder)
+{
+    Tensor<int> t(HostTensorDescriptor({4, 1, 6, 5}, {1, 7, 20, 4}));
+
+    std::size_t count = 0;
+
+    t.ForEach([&](auto& self, auto idx) {
+        EXPECT_EQ(self.GetOffsetFromMultiIndex(idx), count);
+        self(idx) = static_cast<int>(idx[0] * 100 + idx[2] * 10 + idx[3]);
+        ++count;
+    });
+
+    EXPECT_EQ(count, 120);
+
+    for(std::size_t i0 = 0; i0 < 4; ++i0)
+        for(std::size_t i2 = 0; i2 < 6; ++i2)
+            for(std::size_t i3 = 0; i3 < 5; ++i3)
+                EXPECT_EQ(t(i0, 0, i2, i3), i0 * 100 + i2 * 10 + i3);
+}
+
+TEST(HostTensorTraversal, MergesContiguousDimensions)
+{
+    const HostTensorDescriptor packed({2, 3, 4, 5});
+    const HostTensorDescriptor padded({2, 3, 4, 5}, {180, 60, 15, 1});
+
+    EXPECT_EQ(make_host_tensor_traversal(packed).mLoops.size(), 1);
+    EXPECT_EQ(make_host_tensor_traversal(packed, packed).mLoops.size(), 1);
+    EXPECT_EQ(make_host_tensor_traversal(padded).mLoops.size(), 2);
+    EXPECT_EQ(make_host_tensor_traversal(packed, padded).mLoops.size(), 2);
+}
+
+TEST(HostTensorTraversal, TransposedCopy)
+{
+    // lengths not a multiple of the tile size, so the border tiles are partial
+    const std::vector<std::size_t> nchw{3, 37, 5, 45};
+
+    Tensor<int> a(nchw);
+    Tensor<int> b(std::vector<std::size_t>{3, 5, 45, 37});
+
+    for(std::size_t i = 0; i < a.mData.size(); ++i)
+        a.mData[i] = static_cast<int>(i);
+
+    const auto b_nchw_desc =
+        transpose_host_tensor_descriptor_given_new2old(b.mDesc, std::array<int, 4>{0, 3, 1, 2});
+
+    const auto traversal = make_host_tensor_traversal(b_nchw_desc, a.mDesc);
+
+    EXPECT_TRUE(std::any_of(traversal.mLoops.begin(),
+                            traversal.mLoops.end(),
+                            [](const auto& loop) { return loop.is_tile_inner; }));
+
+    std::vector<int> num_visit(b.mData.size(), 0);
+
+    traversal(
+        [&](const auto& offsets) {
+            b.mData[offsets[0]] = a.mData[offsets[1]];
+            ++num_visit[offsets[0]];
+        },
+        std::thread::hardware_concurrency());
+
+    for(std::size_t n = 0; n < nchw[0]; ++n)
+        for(std::size_t c = 0; c < nchw[1]; ++c)
+            for(std::size_t h = 0; h < nchw[2]; ++h)
+                for(std::size_t w = 0; w < nchw[3]; ++w)
+                    EXPECT_EQ(b(n, h, w, c), a(n, c, h, w));
+
+    EXPECT_TRUE(std::all_of(num_visit.begin(), num_visit.end(), [](int v) { return v == 1; }));
+}
+
+TEST(HostTensorTraversal, OverlappingWriteIsSerial)
+{
+    // sum a packed 64 x 8 tensor into a broadcast scalar and into overlapping diagonals
+    const HostTensorDescriptor src({64, 8});
+    const HostTensorDescriptor scalar({64, 8}, {0, 0});
+    const HostTensorDescriptor diagonal({64, 8}, {1, 1});
+
+    EXPECT_TRUE(make_host_tensor_traversal(src, src).IsOuterLoopDisjoint());
+    EXPECT_FALSE(make_host_tensor_traversal(scalar, src).IsOuterLoopDisjoint());
+    EXPECT_FALSE(make_host_tensor_traversal(diagonal, src).IsOuterLoopDisjoint());
+
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    ck::host_common::set_host_num_threads(4);
+
+    for(const auto* dst : {&scalar, &diagonal})
+    {
+        std::vector<long> sums(dst->GetElementSpaceSize(), 0);
+        std::vector<long> expected(sums.size(), 0);
+
+        for(std::size_t i = 0; i < 64; ++i)
+            for(std::size_t j = 0; j < 8; ++j)
+                expected[dst->GetOffsetFromMultiIndex(i, j)] += static_cast<long>(i * 8 + j);
+
+        make_host_tensor_traversal(*dst, src)(
+            [&](const auto& offsets) { sums[offsets[0]] += static_cast<long>(offsets[1]); }, 4);
+
+        EXPECT_EQ(sums, expected);
+    }
+
+    ck::host_common::set_host_num_threads(num_thread);
+}
+
+TEST(HostTensorTraversal, CopyAsTypeNonPacked)
+{
+    Tensor<int> a(HostTensorDescriptor({3, 4, 5}, {1, 3, 16}));
+
+    a.ForEach([](auto& self, auto idx) {
+        self(idx) = static_cast<int>(idx[0] * 100 + idx[1] * 10 + idx[2]);
+    });
+
+    const Tensor<float> b = a.CopyAsType<float>();
+
+    EXPECT_EQ(b.mDesc.GetStrides(), a.mDesc.GetStrides());
+
+    for(std::size_t i0 = 0; i0 < 3; ++i0)
+        for(std::size_t i1 = 0; i1 < 4; ++i1)
+            for(std::size_t i2 = 0; i2 < 5; ++i2)
+                EXPECT_EQ(b(i0, i1, i2), static_cast<float>(a(i0, i1, i2)));
+}
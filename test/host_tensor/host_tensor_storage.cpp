@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+
+using ck::host_common::HostHugePageSize;
+using ck::host_common::HostUninitializedAllocator;
+
+namespace {
+
+std::uintptr_t address_of(const void* p) { return reinterpret_cast<std::uintptr_t>(p); }
+
+} // anonymous namespace
+
+TEST(HostAllocator, Alignment)
+{
+    Tensor<float> small({3, 5});
+    Tensor<float> large({1024, 1024});
+
+    EXPECT_EQ(address_of(small.data()) % 64, 0);
+    EXPECT_EQ(address_of(large.data()) % HostHugePageSize, 0);
+}
+
+TEST(HostAllocator, DefaultTensorIsZeroed)
+{
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    ck::host_common::set_host_num_threads(4);
+
+    // reuse freed blocks of the same size, so that stale values would show up
+    for(int i = 0; i < 3; ++i)
+    {
+        Tensor<float> small({7, 11});
+        Tensor<float> large({3, 512, 1024});
+
+        EXPECT_TRUE(std::all_of(small.begin(), small.end(), [](float x) { return x == 0; }));
+        EXPECT_TRUE(std::all_of(large.begin(), large.end(), [](float x) { return x == 0; }));
+
+        std::fill(small.begin(), small.end(), 1.f);
+        std::fill(large.begin(), large.end(), 1.f);
+    }
+
+    ck::host_common::set_host_num_threads(num_thread);
+}
+
+TEST(HostAllocator, UninitializedTensor)
+{
+    Tensor<int, HostUninitializedAllocator<int>> x({64, 1000});
+    Tensor<int> y({64, 1000});
+
+    EXPECT_EQ(x.size(), 64000);
+
+    x.GenerateTensorValue(GeneratorTensor_1<int>{3});
+    y.GenerateTensorValue(GeneratorTensor_1<int>{3});
+
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin(), y.end()));
+
+    // copies keep the storage policy and the values
+    auto x_copy = x;
+
+    EXPECT_EQ(x_copy.mData, x.mData);
+}
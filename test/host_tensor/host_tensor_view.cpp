@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+Tensor<float> make_iota_tensor(const std::vector<std::size_t>& lens)
+{
+    Tensor<float> tensor(lens);
+
+    std::iota(tensor.begin(), tensor.end(), 0.f);
+
+    return tensor;
+}
+
+} // anonymous namespace
+
+TEST(TensorView, SliceSubViewSelect)
+{
+    Tensor<float> tensor = make_iota_tensor({4, 5, 6});
+    TensorView<float> view(tensor);
+
+    const auto slice = view.Slice(1, 2, 4);
+
+    EXPECT_EQ(slice.GetLengths(), (std::vector<std::size_t>{4, 2, 6}));
+    EXPECT_EQ(slice.GetStrides(), tensor.GetStrides());
+    EXPECT_EQ(slice(3, 1, 5), tensor(3, 3, 5));
+
+    const auto sub = view.SubView({1, 2, 3}, {2, 2, 3});
+
+    EXPECT_EQ(sub.GetElementSize(), 12);
+    EXPECT_EQ(sub(0, 0, 0), tensor(1, 2, 3));
+    EXPECT_EQ(sub(1, 1, 2), tensor(2, 3, 5));
+    EXPECT_EQ(sub.GetElementSpaceSize(), tensor.GetOffsetFromMultiIndex(1, 1, 2) + 1);
+
+    const auto matrix = view.Select(0, 2);
+
+    EXPECT_EQ(matrix.GetLengths(), (std::vector<std::size_t>{5, 6}));
+    EXPECT_EQ(matrix(4, 1), tensor(2, 4, 1));
+
+    // views write through to the tensor
+    sub(1, 0, 1) = -1.f;
+
+    EXPECT_EQ(tensor(2, 2, 4), -1.f);
+
+    EXPECT_THROW(view.Slice(1, 3, 6), std::runtime_error);
+    EXPECT_THROW(view.SubView({3, 0, 0}, {2, 1, 1}), std::runtime_error);
+}
+
+TEST(TensorView, TransposeIsZeroCopy)
+{
+    const Tensor<float> tensor = make_iota_tensor({3, 4, 5});
+    TensorView view(tensor);
+
+    static_assert(std::is_same_v<decltype(view), TensorView<const float>>);
+
+    const auto transposed = view.Transpose(std::vector<std::size_t>{2, 0, 1});
+
+    EXPECT_EQ(transposed.data(), tensor.data());
+    EXPECT_EQ(transposed.GetLengths(), (std::vector<std::size_t>{5, 3, 4}));
+
+    for(std::size_t i = 0; i < 5; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            for(std::size_t k = 0; k < 4; ++k)
+                EXPECT_EQ(transposed(i, j, k), tensor(j, k, i));
+
+    // materialized as a packed tensor of the transposed lengths
+    const Tensor<float> copy = transposed.CopyAsType();
+
+    EXPECT_EQ(copy.GetStrides(), (std::vector<std::size_t>{12, 4, 1}));
+    EXPECT_EQ(copy(4, 2, 3), tensor(2, 3, 4));
+}
+
+TEST(TensorView, CheckErrAcrossLayouts)
+{
+    // the same [6, 70, 9] values, stored row-major and as [9, 6, 70]
+    Tensor<float> ref({6, 70, 9});
+    Tensor<float> out(HostTensorDescriptor({6, 70, 9}, {70, 1, 420}));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(ref);
+
+    ref.ForEach([&](auto& self, const auto& idx) { out(idx) = self(idx); });
+
+    EXPECT_TRUE(ck::utils::check_err(out, ref));
+    EXPECT_TRUE(ck::utils::check_err(TensorView(out).Slice(1, 10, 30),
+                                     TensorView(ref).Slice(1, 10, 30)));
+
+    out(5, 40, 7) += 1.f;
+
+    const auto stats = ck::utils::check_err_stats(out, ref, 1e-5, 1e-5);
+
+    EXPECT_EQ(stats.num_checked, ref.GetElementSize());
+    EXPECT_EQ(stats.err_count, 1);
+    ASSERT_EQ(stats.mismatches.size(), 1);
+    EXPECT_EQ(ck::utils::detail::format_check_err_index(out, stats.mismatches[0].offset),
+              "5, 40, 7");
+
+    // slices that leave out the error pass
+    EXPECT_TRUE(ck::utils::check_err(TensorView(out).Slice(1, 0, 40),
+                                     TensorView(ref).Slice(1, 0, 40)));
+    EXPECT_FALSE(ck::utils::check_err(out, TensorView(ref).Slice(0, 0, 5)));
+}
+
+TEST(TensorView, ReferenceGemmOnViews)
+{
+    using ReferenceGemm = ck::tensor_operation::host::
+        ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    // A given as a [K, M] tensor, B as a batch of [K, N] matrices
+    Tensor<float> a_k_m({24, 16});
+    Tensor<float> b_g_k_n({3, 24, 20});
+    Tensor<float> c_m_n({16, 20});
+    Tensor<float> c_m_n_ref({16, 20});
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(a_k_m);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(b_g_k_n);
+
+    const auto a_m_k = TensorView(a_k_m).Transpose(std::vector<std::size_t>{1, 0});
+    const auto b_k_n = TensorView(b_g_k_n).Select(0, 1);
+
+    auto ref_gemm = ReferenceGemm{};
+
+    ref_gemm.MakeInvoker().Run(
+        ref_gemm.MakeArgument(a_m_k, b_k_n, c_m_n, PassThrough{}, PassThrough{}, PassThrough{}));
+
+    const Tensor<float> a_m_k_copy = a_m_k.CopyAsType();
+    const Tensor<float> b_k_n_copy = b_k_n.CopyAsType();
+
+    ref_gemm.MakeInvoker().Run(ref_gemm.MakeArgument(
+        a_m_k_copy, b_k_n_copy, c_m_n_ref, PassThrough{}, PassThrough{}, PassThrough{}));
+
+    EXPECT_TRUE(ck::utils::check_err(c_m_n, c_m_n_ref, "Error: view gemm", 0, 0));
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+using ck::host_common::HostThreadPool;
+
+class TestHostThreadPool : public ::testing::Test
+{
+    protected:
+    void SetUp() override { num_thread_ = HostThreadPool::GetInstance().GetNumThreads(); }
+
+    void TearDown() override { HostThreadPool::GetInstance().SetNumThreads(num_thread_); }
+
+    std::size_t num_thread_;
+};
+
+TEST_F(TestHostThreadPool, CoversRangeExactlyOnce)
+{
+    for(std::size_t num_thread : {1, 2, 3, 8})
+    {
+        HostThreadPool::GetInstance().SetNumThreads(num_thread);
+
+        for(std::size_t size : {1, 7, 1000, 12345})
+        {
+            std::vector<std::atomic<int>> visits(size);
+
+            HostThreadPool::GetInstance().ParallelFor(
+                size, [&](std::size_t begin, std::size_t end) {
+                    for(std::size_t i = begin; i < end; ++i)
+                        visits[i]++;
+                });
+
+            for(std::size_t i = 0; i < size; ++i)
+                EXPECT_EQ(visits[i].load(), 1) << "size " << size << ", index " << i;
+        }
+    }
+}
+
+TEST_F(TestHostThreadPool, SkewedWork)
+{
+    HostThreadPool::GetInstance().SetNumThreads(4);
+
+    const std::size_t size = 256;
+    std::vector<std::size_t> result(size, 0);
+
+    // the last few items are orders of magnitude more expensive than the rest
+    ck::host_common::host_parallel_for(size, [&](std::size_t i) {
+        const std::size_t work = i >= size - 4 ? 1000000 : 10;
+        std::size_t acc        = 0;
+
+        for(std::size_t j = 0; j < work; ++j)
+            acc += j % 7;
+
+        result[i] = acc;
+    });
+
+    EXPECT_EQ(result[0], 24);
+    EXPECT_EQ(result[size - 1], 2999997);
+}
+
+TEST_F(TestHostThreadPool, NestedParallelForRunsInline)
+{
+    HostThreadPool::GetInstance().SetNumThreads(4);
+
+    std::atomic<std::size_t> sum{0};
+
+    ck::host_common::host_parallel_for(16, [&](std::size_t i) {
+        EXPECT_TRUE(HostThreadPool::InParallelRegion());
+
+        ck::host_common::host_parallel_for(16, [&](std::size_t j) { sum += i * 16 + j; });
+    });
+
+    EXPECT_FALSE(HostThreadPool::InParallelRegion());
+    EXPECT_EQ(sum.load(), 256 * 255 / 2);
+}
+
+TEST_F(TestHostThreadPool, PropagatesException)
+{
+    HostThreadPool::GetInstance().SetNumThreads(3);
+
+    EXPECT_THROW(ck::host_common::host_parallel_for(100,
+                                                     [&](std::size_t i) {
+                                                         if(i == 42)
+                                                             throw std::runtime_error("42");
+                                                     }),
+                 std::runtime_error);
+
+    // the pool is still usable afterwards
+    std::atomic<std::size_t> count{0};
+    ck::host_common::host_parallel_for(100, [&](std::size_t) { count++; });
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(TestHostThreadPool, SetNumThreadsInParallelRegionThrows)
+{
+    HostThreadPool::GetInstance().SetNumThreads(4);
+
+    EXPECT_THROW(ck::host_common::host_parallel_for(
+                     16, [&](std::size_t) { HostThreadPool::GetInstance().SetNumThreads(2); }),
+                 std::runtime_error);
+
+    EXPECT_EQ(HostThreadPool::GetInstance().GetNumThreads(), 4);
+
+    std::atomic<std::size_t> count{0};
+    ck::host_common::host_parallel_for(100, [&](std::size_t) { count++; });
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(TestHostThreadPool, ParallelTensorFunctor)
+{
+    HostThreadPool::GetInstance().SetNumThreads(4);
+
+    Tensor<int> t({5, 6, 7});
+
+    auto f = [&](auto i0, auto i1, auto i2) { t(i0, i1, i2) = i0 * 100 + i1 * 10 + i2; };
+
+    make_ParallelTensorFunctor(f, 5, 6, 7)(std::thread::hardware_concurrency());
+
+    for(std::size_t i0 = 0; i0 < 5; ++i0)
+        for(std::size_t i1 = 0; i1 < 6; ++i1)
+            for(std::size_t i2 = 0; i2 < 7; ++i2)
+                EXPECT_EQ(t(i0, i1, i2), i0 * 100 + i1 * 10 + i2);
+}
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm_softmax_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+
+namespace {
+
+using F16 = ck::half_t;
+using F32 = float;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+using Add         = ck::tensor_operation::element_wise::Add;
+
+using ck::tensor_operation::device::MaskingSpecialization;
+
+// unfused GEMM -> mask/bias -> softmax -> GEMM chain on [G, M, K], [G, K, N], [G, N, O] tensors
+void chained_attention(const Tensor<F16>& a_g_m_k,
+                       const Tensor<F16>& b0_g_k_n,
+                       const Tensor<F16>& b1_g_n_o,
+                       const Tensor<F16>* p_d0_g_m_n,
+                       Tensor<F32>& c_g_m_o,
+                       float alpha,
+                       bool mask_out_upper_triangle)
+{
+    const std::size_t G = a_g_m_k.mDesc.GetLengths()[0];
+    const std::size_t M = a_g_m_k.mDesc.GetLengths()[1];
+    const std::size_t N = b0_g_k_n.mDesc.GetLengths()[2];
+
+    Tensor<F32> acc0_g_m_n({G, M, N});
+    Tensor<F16> a1_g_m_n({G, M, N});
+
+    using ReferenceGemm0Instance = ck::tensor_operation::host::
+        ReferenceBatchedGemm<F16, F16, F32, F32, PassThrough, PassThrough, Scale>;
+    using ReferenceSoftmaxInstance = ck::tensor_operation::host::ReferenceSoftmax<F32, F16, F32>;
+    using ReferenceGemm1Instance   = ck::tensor_operation::host::
+        ReferenceBatchedGemm<F16, F16, F32, F32, PassThrough, PassThrough, PassThrough>;
+
+    auto ref_gemm0          = ReferenceGemm0Instance{};
+    auto ref_gemm0_argument = ref_gemm0.MakeArgument(
+        a_g_m_k, b0_g_k_n, acc0_g_m_n, PassThrough{}, PassThrough{}, Scale{alpha});
+
+    ref_gemm0.MakeInvoker().Run(ref_gemm0_argument);
+
+    acc0_g_m_n.ForEach([&](auto& self, auto idx) {
+        if(p_d0_g_m_n != nullptr)
+            Add{}(self(idx), self(idx), (*p_d0_g_m_n)(idx));
+
+        if(mask_out_upper_triangle && idx[1] < idx[2])
+            self(idx) = -std::numeric_limits<F32>::infinity();
+    });
+
+    auto ref_softmax          = ReferenceSoftmaxInstance{};
+    auto ref_softmax_argument = ref_softmax.MakeArgument(acc0_g_m_n, a1_g_m_n, 1, 0, {2});
+
+    ref_softmax.MakeInvoker().Run(ref_softmax_argument);
+
+    auto ref_gemm1          = ReferenceGemm1Instance{};
+    auto ref_gemm1_argument = ref_gemm1.MakeArgument(
+        a1_g_m_n, b1_g_n_o, c_g_m_o, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ref_gemm1.MakeInvoker().Run(ref_gemm1_argument);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceBatchedGemmSoftmaxGemm, F16MatchesChain)
+{
+    // N and M are not multiples of the N and M tiles
+    const std::size_t G = 3;
+    const std::size_t M = 100;
+    const std::size_t N = 300;
+    const std::size_t K = 40;
+    const std::size_t O = 50;
+
+    const float alpha = 0.125f;
+
+    Tensor<F16> a_g_m_k({G, M, K});
+    Tensor<F16> b0_g_k_n({G, K, N});
+    Tensor<F16> b1_g_n_o({G, N, O});
+    Tensor<F32> c_g_m_o({G, M, O});
+    Tensor<F32> c_g_m_o_chain({G, M, O});
+
+    ck::utils::FillUniformDistribution<F16>{-2.f, 2.f}(a_g_m_k);
+    ck::utils::FillUniformDistribution<F16>{-2.f, 2.f}(b0_g_k_n);
+    ck::utils::FillUniformDistribution<F16>{-1.f, 1.f}(b1_g_n_o);
+
+    using ReferenceInstance = ck::tensor_operation::host::ReferenceBatchedGemmSoftmaxGemm<
+        F16,
+        F16,
+        F16,
+        F32,
+        F32,
+        PassThrough,
+        PassThrough,
+        Scale,
+        PassThrough,
+        PassThrough>;
+
+    auto ref          = ReferenceInstance{};
+    auto ref_argument = ref.MakeArgument(a_g_m_k,
+                                         b0_g_k_n,
+                                         b1_g_n_o,
+                                         c_g_m_o,
+                                         PassThrough{},
+                                         PassThrough{},
+                                         Scale{alpha},
+                                         PassThrough{},
+                                         PassThrough{});
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&ref_argument));
+
+    ref.MakeInvoker().Run(ref_argument);
+
+    chained_attention(a_g_m_k, b0_g_k_n, b1_g_n_o, nullptr, c_g_m_o_chain, alpha, false);
+
+    EXPECT_TRUE(
+        ck::utils::check_err(c_g_m_o, c_g_m_o_chain, "Error: incorrect results!", 1e-3, 1e-3));
+}
+
+TEST(ReferenceBatchedGemmSoftmaxGemm, F16PermutedMaskedBias)
+{
+    // A, D0 and C are stored as [G0, M, G1, *], B0 as [G0, G1, N, K] and B1 as [G0, G1, O, N]
+    const std::size_t G0 = 2;
+    const std::size_t G1 = 3;
+    const std::size_t M  = 150;
+    const std::size_t N  = 280;
+    const std::size_t K  = 32;
+    const std::size_t O  = 24;
+    const std::size_t I1 = 1;
+
+    const float alpha = 0.25f;
+
+    Tensor<F16> a_gs_ms_ks({G0, G1, M, K}, {M * G1 * K, K, G1 * K, I1});
+    Tensor<F16> b0_gs_ks_ns({G0, G1, K, N}, {G1 * N * K, N * K, I1, K});
+    Tensor<F16> b1_gs_ns_os({G0, G1, N, O}, {G1 * O * N, O * N, I1, N});
+    Tensor<F16> d0_gs_ms_ns({G0, G1, M, N}, {M * G1 * N, N, G1 * N, I1});
+    Tensor<F32> c_gs_ms_os({G0, G1, M, O}, {M * G1 * O, O, G1 * O, I1});
+
+    ck::utils::FillUniformDistribution<F16>{-2.f, 2.f}(a_gs_ms_ks);
+    ck::utils::FillUniformDistribution<F16>{-2.f, 2.f}(b0_gs_ks_ns);
+    ck::utils::FillUniformDistribution<F16>{-1.f, 1.f}(b1_gs_ns_os);
+    ck::utils::FillUniformDistribution<F16>{-1.f, 1.f}(d0_gs_ms_ns);
+
+    using ReferenceInstance = ck::tensor_operation::host::ReferenceBatchedGemmSoftmaxGemm<
+        F16,
+        F16,
+        F16,
+        F32,
+        F32,
+        PassThrough,
+        PassThrough,
+        Scale,
+        PassThrough,
+        PassThrough,
+        MaskingSpecialization::MaskOutUpperTriangle,
+        F16>;
+
+    auto ref          = ReferenceInstance{};
+    auto ref_argument = ref.MakeArgument(a_gs_ms_ks,
+                                         b0_gs_ks_ns,
+                                         b1_gs_ns_os,
+                                         c_gs_ms_os,
+                                         d0_gs_ms_ns,
+                                         PassThrough{},
+                                         PassThrough{},
+                                         Scale{alpha},
+                                         Add{},
+                                         PassThrough{},
+                                         PassThrough{});
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&ref_argument));
+
+    ref.MakeInvoker().Run(ref_argument);
+
+    // packed [G0 * G1, ...] copies for the chain
+    const std::size_t G = G0 * G1;
+
+    Tensor<F16> a_g_m_k({G, M, K});
+    Tensor<F16> b0_g_k_n({G, K, N});
+    Tensor<F16> b1_g_n_o({G, N, O});
+    Tensor<F16> d0_g_m_n({G, M, N});
+    Tensor<F32> c_g_m_o({G, M, O});
+    Tensor<F32> c_g_m_o_chain({G, M, O});
+
+    auto to_packed = [&](const auto& src, auto& dst) {
+        src.ForEach([&](auto& self, auto idx) {
+            dst(idx[0] * G1 + idx[1], idx[2], idx[3]) = self(idx);
+        });
+    };
+
+    to_packed(a_gs_ms_ks, a_g_m_k);
+    to_packed(b0_gs_ks_ns, b0_g_k_n);
+    to_packed(b1_gs_ns_os, b1_g_n_o);
+    to_packed(d0_gs_ms_ns, d0_g_m_n);
+    to_packed(c_gs_ms_os, c_g_m_o);
+
+    chained_attention(a_g_m_k, b0_g_k_n, b1_g_n_o, &d0_g_m_n, c_g_m_o_chain, alpha, true);
+
+    EXPECT_TRUE(
+        ck::utils::check_err(c_g_m_o, c_g_m_o_chain, "Error: incorrect results!", 1e-3, 1e-3));
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// Run() decomposes the problem by stride phase onto the packed GEMM engine. It accumulates in the
+// order of the direct loop nest of ComputeElement(), so the two must agree bit by bit on finite
+// data
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool run_reference_conv_bwd_data_against_direct(const ck::utils::conv::ConvParam& conv_param)
+{
+    using ReferenceConv = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
+                                                                           float,
+                                                                           float,
+                                                                           float,
+                                                                           PassThrough,
+                                                                           PassThrough,
+                                                                           PassThrough>;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> weight(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+            conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weight);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+    // every input gradient element must be written
+    ck::utils::FillConstant<float>{1e6f}(input);
+
+    const auto argument = ReferenceConv::MakeArgument(input,
+                                                      weight,
+                                                      output,
+                                                      conv_param.conv_filter_strides_,
+                                                      conv_param.conv_filter_dilations_,
+                                                      conv_param.input_left_pads_,
+                                                      conv_param.input_right_pads_,
+                                                      PassThrough{},
+                                                      PassThrough{},
+                                                      PassThrough{});
+
+    ReferenceConv::MakeInvoker().Run(argument);
+
+    Tensor<float> direct_input(input.mDesc);
+
+    direct_input.ForEach([&](auto& self, const auto& idx) {
+        self(idx) = ReferenceConv::Invoker::ComputeElement(argument, idx);
+    });
+
+    return ck::utils::check_err(input, direct_input, "Error: incorrect results!", 0, 0);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceConvBwdData, PackedAgainstDirect)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    // stride 1, a single phase
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 2, 3, 9, 6, {3, 3}, {10, 13}, {1, 1}, {1, 1}, {1, 1}, {1, 1}})));
+
+    // strides with and without common factors with the dilations, pads on both sides
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<1, GNWC, GKXC, GNWK>(
+        {1, 3, 2, 5, 7, {3}, {19}, {2}, {2}, {2}, {1}})));
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<1, GNWC, GKXC, GNWK>(
+        {1, 1, 2, 4, 3, {5}, {23}, {3}, {2}, {3}, {0}})));
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<2, GNCHW, GKCYX, GNKHW>(
+        {2, 2, 3, 9, 6, {3, 2}, {11, 9}, {2, 3}, {1, 2}, {1, 0}, {2, 1}})));
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<3, NDHWGC, GKZYXC, NDHWGK>(
+        {3, 2, 2, 4, 5, {3, 1, 2}, {7, 6, 8}, {2, 1, 3}, {1, 1, 2}, {1, 0, 1}, {1, 0, 2}})));
+
+    // strides larger than the filter, some input pixels receive no gradient
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 1, 2, 3, 4, {2, 1}, {9, 10}, {3, 4}, {1, 1}, {0, 1}, {0, 0}})));
+
+    // enough channels and pixels for several panels per phase
+    EXPECT_TRUE((run_reference_conv_bwd_data_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 2, 3, 40, 20, {3, 3}, {40, 36}, {2, 2}, {1, 1}, {1, 1}, {1, 1}})));
+}
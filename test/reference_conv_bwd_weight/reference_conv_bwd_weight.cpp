@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+template <ck::index_t NDimSpatial, typename AccDataType>
+using ReferenceConv = ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
+                                                                         float,
+                                                                         float,
+                                                                         float,
+                                                                         PassThrough,
+                                                                         PassThrough,
+                                                                         PassThrough,
+                                                                         float,
+                                                                         float,
+                                                                         AccDataType>;
+
+template <ck::index_t NDimSpatial,
+          typename InLayout,
+          typename WeiLayout,
+          typename OutLayout,
+          typename AccDataType = float>
+struct ReferenceConvBwdWeightTest
+{
+    explicit ReferenceConvBwdWeightTest(const ck::utils::conv::ConvParam& conv_param)
+        : param_(conv_param),
+          input_(ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(
+              conv_param)),
+          output_(ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+              conv_param)),
+          wei_desc_(ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+              conv_param))
+    {
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input_);
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output_);
+    }
+
+    template <typename Conv>
+    auto MakeArgument(Tensor<float>& weight) const
+    {
+        return Conv::MakeArgument(input_,
+                                  weight,
+                                  output_,
+                                  param_.conv_filter_strides_,
+                                  param_.conv_filter_dilations_,
+                                  param_.input_left_pads_,
+                                  param_.input_right_pads_,
+                                  PassThrough{},
+                                  PassThrough{},
+                                  PassThrough{});
+    }
+
+    Tensor<float> Run() const
+    {
+        using Conv = ReferenceConv<NDimSpatial, AccDataType>;
+
+        Tensor<float> weight(wei_desc_);
+
+        Conv::MakeInvoker().Run(MakeArgument<Conv>(weight));
+
+        return weight;
+    }
+
+    // the direct loop nest, one weight gradient element at a time, accumulating in double so
+    // that it is the more accurate of the two
+    Tensor<float> RunDirect() const
+    {
+        using Conv = ReferenceConv<NDimSpatial, double>;
+
+        Tensor<float> weight(wei_desc_);
+
+        const auto argument = MakeArgument<Conv>(weight);
+
+        weight.ForEach([&](auto& self, const auto& idx) {
+            self(idx) = Conv::Invoker::ComputeElement(argument, idx);
+        });
+
+        return weight;
+    }
+
+    ck::utils::conv::ConvParam param_;
+    Tensor<float> input_;
+    Tensor<float> output_;
+    HostTensorDescriptor wei_desc_;
+};
+
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool run_reference_conv_bwd_weight_against_direct(const ck::utils::conv::ConvParam& conv_param)
+{
+    const ReferenceConvBwdWeightTest<NDimSpatial, InLayout, WeiLayout, OutLayout> test(conv_param);
+
+    return ck::utils::check_err(
+        test.Run(), test.RunDirect(), "Error: incorrect results!", 1e-4, 1e-4);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceConvBwdWeight, PackedAgainstDirect)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    // grouped, with strides, dilations and pads on both sides
+    EXPECT_TRUE((run_reference_conv_bwd_weight_against_direct<1, GNWC, GKXC, GNWK>(
+        {1, 3, 2, 5, 7, {3}, {19}, {2}, {2}, {2}, {1}})));
+    EXPECT_TRUE((run_reference_conv_bwd_weight_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 2, 3, 9, 6, {3, 2}, {11, 9}, {1, 2}, {2, 1}, {1, 0}, {2, 1}})));
+    EXPECT_TRUE((run_reference_conv_bwd_weight_against_direct<2, GNCHW, GKCYX, GNKHW>(
+        {2, 2, 3, 9, 6, {3, 3}, {10, 13}, {2, 2}, {1, 1}, {1, 1}, {1, 1}})));
+    EXPECT_TRUE((run_reference_conv_bwd_weight_against_direct<3, NDHWGC, GKZYXC, NDHWGK>(
+        {3, 2, 2, 4, 5, {3, 1, 2}, {7, 6, 8}, {2, 1, 3}, {1, 1, 2}, {1, 0, 1}, {1, 0, 2}})));
+
+    // depthwise with a long reduction, split across many ranges
+    EXPECT_TRUE((run_reference_conv_bwd_weight_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 4, 8, 1, 1, {3, 3}, {96, 80}, {1, 1}, {1, 1}, {1, 1}, {1, 1}})));
+}
+
+TEST(ReferenceConvBwdWeight, IndependentOfThreadCount)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    const std::size_t num_thread = ck::host_common::get_host_num_threads();
+
+    const ReferenceConvBwdWeightTest<2, NHWGC, GKYXC, NHWGK> test(
+        {2, 1, 4, 3, 2, {3, 3}, {64, 64}, {1, 1}, {1, 1}, {1, 1}, {1, 1}});
+
+    ck::host_common::set_host_num_threads(1);
+
+    const auto serial = test.Run();
+
+    ck::host_common::set_host_num_threads(4);
+
+    const auto parallel = test.Run();
+
+    ck::host_common::set_host_num_threads(num_thread);
+
+    EXPECT_EQ(serial.mData, parallel.mData);
+}
+
+TEST(ReferenceConvBwdWeight, DoubleAccumulation)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    const ReferenceConvBwdWeightTest<1, GNWC, GKXC, GNWK, double> test(
+        {1, 1, 16, 4, 3, {3}, {4096}, {1}, {1}, {1}, {1}});
+
+    EXPECT_TRUE(ck::utils::check_err(test.Run(), test.RunDirect(), "Error: incorrect results!"));
+}
@@ -80,8 +80,75 @@ run_reference_convolution_forward(const ck::utils::conv::ConvParam& conv_param,
     return host_output;
 }
 
+// Run() lowers the convolution onto im2col panels and the packed GEMM engine. It accumulates in
+// the order of the direct loop nest of ComputeElement(), so the two must agree bit by bit on
+// finite data
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool run_reference_convolution_forward_against_direct(
+    const ck::utils::conv::ConvParam& conv_param)
+{
+    using ReferenceConv = ck::tensor_operation::host::
+        ReferenceConvFwd<NDimSpatial, float, float, float, InElementOp, WeiElementOp, OutElementOp>;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> weights(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+            conv_param));
+    Tensor<float> host_output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+
+    auto ref_conv     = ReferenceConv{};
+    auto ref_invoker  = ref_conv.MakeInvoker();
+    auto ref_argument = ref_conv.MakeArgument(input,
+                                              weights,
+                                              host_output,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_,
+                                              InElementOp{},
+                                              WeiElementOp{},
+                                              OutElementOp{});
+
+    ref_invoker.Run(ref_argument);
+
+    Tensor<float> direct_output(host_output.mDesc);
+
+    direct_output.ForEach([&](auto& self, const auto& idx) {
+        self(idx) = ReferenceConv::Invoker::ComputeElement(ref_argument, idx);
+    });
+
+    return ck::utils::check_err(host_output, direct_output, "Error: incorrect results!", 0, 0);
+}
+
 } // anonymous namespace
 
+TEST(ReferenceConvolutionFWD, PackedAgainstDirect)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    // grouped, with strides, dilations and pads on both sides
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<1, GNWC, GKXC, GNWK>(
+        {1, 3, 2, 5, 7, {3}, {19}, {2}, {2}, {2}, {1}})));
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 2, 3, 9, 6, {3, 2}, {11, 9}, {1, 2}, {2, 1}, {1, 0}, {2, 1}})));
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<2, GNCHW, GKCYX, GNKHW>(
+        {2, 2, 3, 9, 6, {3, 3}, {10, 13}, {2, 2}, {1, 1}, {1, 1}, {1, 1}})));
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<3, NDHWGC, GKZYXC, NDHWGK>(
+        {3, 2, 2, 4, 5, {3, 1, 2}, {7, 6, 8}, {2, 1, 3}, {1, 1, 2}, {1, 0, 1}, {1, 0, 2}})));
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<3, GNCDHW, GKCZYX, GNKDHW>(
+        {3, 1, 1, 3, 4, {1, 1, 1}, {5, 4, 6}, {1, 1, 1}, {1, 1, 1}, {0, 0, 0}, {0, 0, 0}})));
+
+    // enough channels and output pixels for several panels per group
+    EXPECT_TRUE((run_reference_convolution_forward_against_direct<2, NHWGC, GKYXC, NHWGK>(
+        {2, 2, 3, 20, 40, {3, 3}, {20, 18}, {1, 1}, {1, 1}, {1, 1}, {1, 1}})));
+}
+
 // Eeference convolution assume dimensions of tensor descriptors are in GNCDHW/GKCZYX/GNKDHW order,
 // regardless of physical tensor layouts in  memory.
 // Some tests below assume dimensions of tensor descriptors can be in other order, and therefore
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_gemm.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+HostTensorDescriptor make_matrix_descriptor(std::size_t rows, std::size_t cols, bool row_major)
+{
+    if(row_major)
+        return HostTensorDescriptor({rows, cols}, {cols, std::size_t{1}});
+    else
+        return HostTensorDescriptor({rows, cols}, {std::size_t{1}, rows});
+}
+
+// straightforward K loop, the packed engine must reproduce it bit by bit
+template <typename AccDataType, typename ADataType, typename BDataType, typename CDataType>
+void naive_gemm(const Tensor<ADataType>& a_m_k,
+                const Tensor<BDataType>& b_k_n,
+                Tensor<CDataType>& c_m_n)
+{
+    const std::size_t M = c_m_n.mDesc.GetLengths()[0];
+    const std::size_t N = c_m_n.mDesc.GetLengths()[1];
+    const std::size_t K = a_m_k.mDesc.GetLengths()[1];
+
+    for(std::size_t m = 0; m < M; ++m)
+        for(std::size_t n = 0; n < N; ++n)
+        {
+            AccDataType v_acc = 0;
+
+            for(std::size_t k = 0; k < K; ++k)
+                v_acc += ck::type_convert<AccDataType>(a_m_k(m, k)) *
+                         ck::type_convert<AccDataType>(b_k_n(k, n));
+
+            c_m_n(m, n) = ck::type_convert<CDataType>(v_acc);
+        }
+}
+
+// integer_data keeps every partial sum exact, so that only a wrong product or a missed term shows;
+// non-integer data also checks that the K loop runs in the naive order
+template <typename ADataType, typename BDataType, typename CDataType, typename AccDataType>
+bool run_reference_gemm_test(std::size_t M,
+                             std::size_t N,
+                             std::size_t K,
+                             bool a_row_major,
+                             bool b_row_major,
+                             bool integer_data = true)
+{
+    Tensor<ADataType> a_m_k(make_matrix_descriptor(M, K, a_row_major));
+    Tensor<BDataType> b_k_n(make_matrix_descriptor(K, N, b_row_major));
+    Tensor<CDataType> c_m_n_host(make_matrix_descriptor(M, N, true));
+    Tensor<CDataType> c_m_n_naive(make_matrix_descriptor(M, N, true));
+
+    if(integer_data)
+    {
+        ck::utils::FillUniformDistributionIntegerValue<ADataType>{-5.f, 5.f}(a_m_k);
+        ck::utils::FillUniformDistributionIntegerValue<BDataType>{-5.f, 5.f}(b_k_n);
+    }
+    else
+    {
+        ck::utils::FillUniformDistribution<ADataType>{-1.f, 1.f}(a_m_k);
+        ck::utils::FillUniformDistribution<BDataType>{-1.f, 1.f}(b_k_n);
+    }
+
+    auto ref_gemm     = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                              BDataType,
+                                                              CDataType,
+                                                              AccDataType,
+                                                              PassThrough,
+                                                              PassThrough,
+                                                              PassThrough>{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a_m_k, b_k_n, c_m_n_host, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    naive_gemm<AccDataType>(a_m_k, b_k_n, c_m_n_naive);
+
+    return ck::utils::check_err(c_m_n_host, c_m_n_naive, "Error: incorrect results!", 0, 0);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceGemm, F32AllLayouts)
+{
+    for(bool a_row_major : {true, false})
+        for(bool b_row_major : {true, false})
+        {
+            EXPECT_TRUE((run_reference_gemm_test<float, float, float, float>(
+                67, 133, 300, a_row_major, b_row_major)));
+        }
+}
+
+TEST(ReferenceGemm, F16BlockBoundaries)
+{
+    EXPECT_TRUE((run_reference_gemm_test<ck::half_t, ck::half_t, ck::half_t, float>(
+        129, 257, 513, true, false)));
+    EXPECT_TRUE((run_reference_gemm_test<ck::half_t, ck::half_t, ck::half_t, float>(
+        1, 1, 1, true, true)));
+}
+
+TEST(ReferenceGemm, F32NonIntegerDataMatchesKOrder)
+{
+    for(bool a_row_major : {true, false})
+        for(bool b_row_major : {true, false})
+        {
+            EXPECT_TRUE((run_reference_gemm_test<float, float, float, float>(
+                67, 133, 300, a_row_major, b_row_major, false)));
+        }
+
+    EXPECT_TRUE((run_reference_gemm_test<ck::half_t, ck::half_t, ck::half_t, float>(
+        129, 257, 513, true, false, false)));
+}
+
+TEST(ReferenceGemm, I8I32Accumulation)
+{
+    EXPECT_TRUE((run_reference_gemm_test<int8_t, int8_t, int32_t, int32_t>(
+        64, 48, 1000, false, true)));
+}
+
+TEST(ReferenceGemm, EmptyReduction)
+{
+    EXPECT_TRUE((run_reference_gemm_test<float, float, float, float>(5, 7, 0, true, true)));
+}
+
+// few blocks and a long K: the K ranges run in parallel and their sums are added in range order,
+// the same for any number of threads
+TEST(HostGemmPacked, SplitsLongReduction)
+{
+    const std::size_t M = 40;
+    const std::size_t N = 24;
+    const std::size_t K = 20000;
+
+    Tensor<float> a_m_k({M, K});
+    Tensor<float> b_k_n(HostTensorDescriptor({K, N}, {std::size_t{1}, K}));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(a_m_k);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(b_k_n);
+
+    auto run = [&](std::size_t num_thread) {
+        Tensor<float> c_m_n({M, N});
+
+        ck::host_common::host_gemm_packed<float>(
+            1,
+            M,
+            N,
+            K,
+            a_m_k.data(),
+            {0, K, 1},
+            b_k_n.data(),
+            {0, 1, K},
+            [](float v) { return v; },
+            [](float v) { return v; },
+            [&](auto, std::size_t m, std::size_t n, float v_acc) { c_m_n(m, n) = v_acc; },
+            num_thread);
+
+        return c_m_n;
+    };
+
+    const auto c_serial = run(1);
+    const auto c_split  = run(2);
+
+    EXPECT_TRUE(ck::utils::check_err(c_split, run(7), "Error: thread count dependent!", 0, 0));
+
+    for(std::size_t m = 0; m < M; ++m)
+        for(std::size_t n = 0; n < N; ++n)
+        {
+            double v_acc = 0;
+
+            for(std::size_t k = 0; k < K; ++k)
+                v_acc += static_cast<double>(a_m_k(m, k)) * b_k_n(k, n);
+
+            EXPECT_NEAR(c_split(m, n), v_acc, 1e-3);
+            EXPECT_NEAR(c_serial(m, n), v_acc, 1e-3);
+        }
+}
+
+TEST(ReferenceBatchedGemm, F32StridedBatch)
+{
+    const std::size_t G = 3;
+    const std::size_t M = 40;
+    const std::size_t N = 50;
+    const std::size_t K = 70;
+
+    Tensor<float> a_g_m_k({G, M, K});
+    Tensor<float> b_g_k_n(HostTensorDescriptor({G, K, N}, {N * K, std::size_t{1}, K}));
+    Tensor<float> c_g_m_n({G, M, N});
+    Tensor<float> c_g_m_n_naive({G, M, N});
+
+    ck::utils::FillUniformDistributionIntegerValue<float>{-5.f, 5.f}(a_g_m_k);
+    ck::utils::FillUniformDistributionIntegerValue<float>{-5.f, 5.f}(b_g_k_n);
+
+    auto ref_gemm = ck::tensor_operation::host::
+        ReferenceBatchedGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a_g_m_k, b_g_k_n, c_g_m_n, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    for(std::size_t g = 0; g < G; ++g)
+        for(std::size_t m = 0; m < M; ++m)
+            for(std::size_t n = 0; n < N; ++n)
+            {
+                float v_acc = 0;
+
+                for(std::size_t k = 0; k < K; ++k)
+                    v_acc += a_g_m_k(g, m, k) * b_g_k_n(g, k, n);
+
+                c_g_m_n_naive(g, m, n) = v_acc;
+            }
+
+    EXPECT_TRUE(ck::utils::check_err(c_g_m_n, c_g_m_n_naive, "Error: incorrect results!", 0, 0));
+}
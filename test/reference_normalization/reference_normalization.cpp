@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_normalization.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_groupnorm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// two-pass mean/variance in double over reduce_dims, gamma and beta are indexed by the reduce
+// dimensions in the order of reduce_dims
+void naive_layernorm(const Tensor<float>& x,
+                     const Tensor<float>& gamma,
+                     const Tensor<float>& beta,
+                     Tensor<float>& y,
+                     const std::vector<ck::index_t>& reduce_dims,
+                     double epsilon)
+{
+    const std::size_t rank = x.mDesc.GetNumOfDimension();
+
+    std::vector<bool> is_reduce_dim(rank, false);
+
+    for(auto dim : reduce_dims)
+        is_reduce_dim[dim] = true;
+
+    // every row is identified by its first element, which has all reduce indices at 0
+    auto row_of = [&](std::vector<std::size_t> idx) {
+        for(std::size_t d = 0; d < rank; ++d)
+            if(is_reduce_dim[d])
+                idx[d] = 0;
+
+        return x.mDesc.GetOffsetFromMultiIndex(idx);
+    };
+
+    std::vector<double> mean(x.mDesc.GetElementSpaceSize(), 0);
+    std::vector<double> var(x.mDesc.GetElementSpaceSize(), 0);
+    std::vector<double> count(x.mDesc.GetElementSpaceSize(), 0);
+
+    x.ForEach([&](auto& self, auto idx) {
+        mean[row_of(idx)] += self(idx);
+        count[row_of(idx)] += 1;
+    });
+
+    x.ForEach([&](auto& self, auto idx) {
+        const double m = mean[row_of(idx)] / count[row_of(idx)];
+
+        var[row_of(idx)] += (self(idx) - m) * (self(idx) - m);
+    });
+
+    y.ForEach([&](auto& self, auto idx) {
+        const std::size_t row = row_of(idx);
+        const double m        = mean[row] / count[row];
+        const double v        = var[row] / count[row];
+
+        std::vector<std::size_t> affine_idx;
+
+        for(auto dim : reduce_dims)
+            affine_idx.push_back(idx[dim]);
+
+        self(idx) = static_cast<float>((x(idx) - m) / std::sqrt(v + epsilon) * gamma(affine_idx) +
+                                       beta(affine_idx));
+    });
+}
+
+template <ck::index_t Rank, ck::index_t NumReduceDim>
+bool run_reference_layernorm_test(const std::vector<std::size_t>& lengths,
+                                  const std::vector<ck::index_t>& reduce_dims,
+                                  float x_offset)
+{
+    std::vector<std::size_t> affine_lengths;
+
+    for(auto dim : reduce_dims)
+        affine_lengths.push_back(lengths[dim]);
+
+    Tensor<float> x(lengths);
+    Tensor<float> gamma(affine_lengths);
+    Tensor<float> beta(affine_lengths);
+    Tensor<float> y(lengths);
+    Tensor<float> y_naive(lengths);
+
+    ck::utils::FillUniformDistribution<float>{x_offset - 1.f, x_offset + 1.f}(x);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(gamma);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(beta);
+
+    using ReferenceInstance = ck::tensor_operation::host::
+        ReferenceLayernorm<float, float, float, float, float, PassThrough, Rank, NumReduceDim>;
+
+    ReferenceInstance ref;
+    auto ref_argument = ref.MakeArgument(x,
+                                         gamma,
+                                         beta,
+                                         y,
+                                         PassThrough{},
+                                         std::vector<ck::index_t>(lengths.begin(), lengths.end()),
+                                         reduce_dims,
+                                         1e-4f);
+
+    if(!ref.IsSupportedArgument(&ref_argument))
+        return false;
+
+    ref.MakeInvoker().Run(ref_argument);
+
+    naive_layernorm(x, gamma, beta, y_naive, reduce_dims, 1e-4);
+
+    return ck::utils::check_err(y, y_naive, "Error: incorrect results!", 1e-4, 1e-4);
+}
+
+} // anonymous namespace
+
+TEST(HostWelford, MergeMatchesSequentialUpdate)
+{
+    std::vector<float> values(1000);
+
+    ck::utils::FillUniformDistribution<float>{99.f, 101.f}(values);
+
+    ck::host_common::HostWelford<float> sequential;
+    ck::host_common::HostWelford<float> merged;
+
+    for(float v : values)
+        sequential.Update(v);
+
+    for(std::size_t begin = 0; begin < values.size(); begin += 300)
+    {
+        ck::host_common::HostWelford<float> partial;
+
+        for(std::size_t i = begin; i < std::min(begin + 300, values.size()); ++i)
+            partial.Update(values[i]);
+
+        merged.Merge(partial);
+    }
+
+    EXPECT_EQ(merged.count_, sequential.count_);
+    EXPECT_NEAR(merged.mean_, sequential.mean_, 1e-4);
+    EXPECT_NEAR(merged.GetVariance(), sequential.GetVariance(), 1e-4);
+}
+
+TEST(ReferenceLayernorm, F32LastDim)
+{
+    EXPECT_TRUE((run_reference_layernorm_test<2, 1>({37, 300}, {1}, 0.f)));
+}
+
+TEST(ReferenceLayernorm, F32LongRowsLargeMean)
+{
+    // rows split into several blocks, mean far away from 0
+    EXPECT_TRUE((run_reference_layernorm_test<2, 1>({3, 20000}, {1}, 10.f)));
+}
+
+TEST(ReferenceLayernorm, F32ArbitraryReduceDims)
+{
+    EXPECT_TRUE((run_reference_layernorm_test<4, 2>({3, 5, 7, 11}, {1, 3}, 0.f)));
+    EXPECT_TRUE((run_reference_layernorm_test<4, 3>({3, 5, 7, 11}, {3, 1, 2}, 0.f)));
+    EXPECT_TRUE((run_reference_layernorm_test<3, 3>({5, 7, 30}, {0, 1, 2}, 0.f)));
+}
+
+TEST(ReferenceGroupnorm, F32MatchesTwoPass)
+{
+    const std::size_t N = 2;
+    const std::size_t H = 5;
+    const std::size_t W = 7;
+    const std::size_t G = 3;
+    const std::size_t C = 4;
+
+    Tensor<float> x({N, H, W, G, C});
+    Tensor<float> gamma({G, C});
+    Tensor<float> beta({G, C});
+    Tensor<float> y({N, H, W, G, C});
+    Tensor<float> y_naive({N, H, W, G, C});
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(x);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(gamma);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(beta);
+
+    auto ref = ck::tensor_operation::host::
+        ReferenceGroupnorm<float, float, float, float, float, PassThrough>{};
+    auto ref_argument = ref.MakeArgument(x,
+                                         gamma,
+                                         beta,
+                                         y,
+                                         PassThrough{},
+                                         {static_cast<ck::index_t>(N),
+                                          static_cast<ck::index_t>(H),
+                                          static_cast<ck::index_t>(W),
+                                          static_cast<ck::index_t>(G),
+                                          static_cast<ck::index_t>(C)},
+                                         1e-5f);
+
+    ref.MakeInvoker().Run(ref_argument);
+
+    // every group is a layernorm over [H, W, C] with the affine parameters of that group
+    for(std::size_t g = 0; g < G; ++g)
+    {
+        Tensor<float> x_g({N, H, W, C});
+        Tensor<float> y_g({N, H, W, C});
+        Tensor<float> gamma_g({H, W, C});
+        Tensor<float> beta_g({H, W, C});
+
+        x_g.ForEach(
+            [&](auto& self, auto idx) { self(idx) = x(idx[0], idx[1], idx[2], g, idx[3]); });
+        gamma_g.ForEach([&](auto& self, auto idx) { self(idx) = gamma(g, idx[2]); });
+        beta_g.ForEach([&](auto& self, auto idx) { self(idx) = beta(g, idx[2]); });
+
+        naive_layernorm(x_g, gamma_g, beta_g, y_g, {1, 2, 3}, 1e-5);
+
+        y_g.ForEach([&](auto& self, auto idx) {
+            y_naive(idx[0], idx[1], idx[2], g, idx[3]) = self(idx);
+        });
+    }
+
+    EXPECT_TRUE(ck::utils::check_err(y, y_naive, "Error: incorrect results!", 1e-4, 1e-4));
+}
@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
+
+namespace {
+
+struct PoolParam
+{
+    std::vector<std::size_t> in_lengths;
+    std::vector<ck::index_t> window_lengths;
+    std::vector<ck::index_t> strides;
+    std::vector<ck::index_t> dilations;
+    std::vector<ck::index_t> left_pads;
+    std::vector<ck::index_t> right_pads;
+
+    // [N, C, Do, Ho, Wo]
+    std::vector<std::size_t> GetOutLengths() const
+    {
+        std::vector<std::size_t> lengths{in_lengths[0], in_lengths[1]};
+
+        for(std::size_t d = 0; d < window_lengths.size(); ++d)
+        {
+            const ck::index_t x_eff = (window_lengths[d] - 1) * dilations[d] + 1;
+
+            lengths.push_back((static_cast<ck::index_t>(in_lengths[d + 2]) + left_pads[d] +
+                               right_pads[d] - x_eff) /
+                                  strides[d] +
+                              1);
+        }
+
+        return lengths;
+    }
+};
+
+// odometer increment of idx over lengths, last dimension fastest; false once it wraps around
+template <typename Index, typename Lengths>
+bool next_index(Index& idx, const Lengths& lengths)
+{
+    for(std::size_t d = idx.size(); d > 0; --d)
+    {
+        if(++idx[d - 1] < static_cast<std::size_t>(lengths[d - 1]))
+            return true;
+
+        idx[d - 1] = 0;
+    }
+
+    return false;
+}
+
+// the loop nest the reference used to run: every window folded in (z, y, x) order
+template <ck::ReduceTensorOp ReduceOpId, bool PropagateNan>
+void pool_fwd_direct(const Tensor<float>& in,
+                     Tensor<float>& out,
+                     Tensor<ck::index_t>& out_indices,
+                     const PoolParam& param)
+{
+    using ReduceOperation = typename ck::reduce_binary_operator<ReduceOpId>::opType;
+
+    const std::size_t NDimSpatial = param.window_lengths.size();
+
+    std::vector<std::size_t> out_idx(NDimSpatial + 2, 0);
+
+    do
+    {
+        float acc         = ReduceOperation::template GetIdentityValue<float>();
+        ck::index_t index = 0;
+
+        std::vector<std::size_t> tap(NDimSpatial, 0);
+
+        do
+        {
+            std::vector<std::size_t> in_idx{out_idx[0], out_idx[1]};
+            bool is_valid = true;
+
+            for(std::size_t d = 0; d < NDimSpatial; ++d)
+            {
+                const ck::long_index_t i =
+                    static_cast<ck::long_index_t>(out_idx[d + 2]) * param.strides[d] +
+                    static_cast<ck::long_index_t>(tap[d]) * param.dilations[d] -
+                    param.left_pads[d];
+
+                is_valid = is_valid && i >= 0 && i < static_cast<ck::long_index_t>(
+                                                         param.in_lengths[d + 2]);
+                in_idx.push_back(static_cast<std::size_t>(i));
+            }
+
+            if(is_valid)
+            {
+                float v = in(in_idx);
+
+                if constexpr(ReduceOpId == ck::ReduceTensorOp::AMAX)
+                    v = std::abs(v);
+
+                if constexpr(ReduceOpId == ck::ReduceTensorOp::ADD)
+                {
+                    ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, float>::
+                        Calculate(acc, v);
+                }
+                else
+                {
+                    ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
+                                                               ReduceOperation,
+                                                               float,
+                                                               ck::index_t>::
+                        Calculate(acc, v, index, in.GetOffsetFromMultiIndex(in_idx));
+                }
+            }
+        } while(next_index(tap, param.window_lengths));
+
+        out(out_idx)         = acc;
+        out_indices(out_idx) = index;
+    } while(next_index(out_idx, out.GetLengths()));
+}
+
+template <ck::index_t NDimSpatial, ck::ReduceTensorOp ReduceOpId, bool PropagateNan>
+bool run_reference_max_pool_fwd_against_direct(const PoolParam& param, bool with_nan = false)
+{
+    using ReferencePool = ck::tensor_operation::host::ReferencePoolingFwd<NDimSpatial + 2,
+                                                                          NDimSpatial,
+                                                                          float,
+                                                                          float,
+                                                                          float,
+                                                                          ck::index_t,
+                                                                          ReduceOpId,
+                                                                          PropagateNan,
+                                                                          true>;
+
+    Tensor<float> in(param.in_lengths);
+    Tensor<float> out(param.GetOutLengths());
+    Tensor<ck::index_t> out_indices(param.GetOutLengths());
+
+    // few distinct values, so that windows hold ties
+    ck::utils::FillUniformDistributionIntegerValue<float>{-4.f, 4.f}(in);
+
+    if(with_nan)
+    {
+        for(std::size_t i = 0; i < in.mData.size(); i += 7)
+            in.mData[i] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    auto ref_pool       = ReferencePool{};
+    const auto argument = ref_pool.MakeArgument(in,
+                                                out,
+                                                out_indices,
+                                                param.window_lengths,
+                                                param.strides,
+                                                param.dilations,
+                                                param.left_pads,
+                                                param.right_pads);
+
+    ref_pool.MakeInvoker().Run(argument);
+
+    Tensor<float> direct_out(out.mDesc);
+    Tensor<ck::index_t> direct_out_indices(out_indices.mDesc);
+
+    pool_fwd_direct<ReduceOpId, PropagateNan>(in, direct_out, direct_out_indices, param);
+
+    for(std::size_t i = 0; i < out.mData.size(); ++i)
+    {
+        const float x = out.mData[i];
+        const float y = direct_out.mData[i];
+
+        if(!(x == y || (std::isnan(x) && std::isnan(y))) ||
+           out_indices.mData[i] != direct_out_indices.mData[i])
+            return false;
+    }
+
+    return true;
+}
+
+template <ck::index_t NDimSpatial>
+bool run_reference_avg_pool_fwd_against_direct(const PoolParam& param)
+{
+    using ReferencePool = ck::tensor_operation::host::ReferencePoolingFwd<NDimSpatial + 2,
+                                                                          NDimSpatial,
+                                                                          float,
+                                                                          float,
+                                                                          float,
+                                                                          ck::index_t,
+                                                                          ck::ReduceTensorOp::AVG,
+                                                                          false,
+                                                                          false>;
+
+    Tensor<float> in(param.in_lengths);
+    Tensor<float> out(param.GetOutLengths());
+    Tensor<ck::index_t> out_indices(param.GetOutLengths());
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(in);
+
+    auto ref_pool       = ReferencePool{};
+    const auto argument = ref_pool.MakeArgument(in,
+                                                out,
+                                                out_indices,
+                                                param.window_lengths,
+                                                param.strides,
+                                                param.dilations,
+                                                param.left_pads,
+                                                param.right_pads);
+
+    ref_pool.MakeInvoker().Run(argument);
+
+    Tensor<float> direct_out(out.mDesc);
+    Tensor<ck::index_t> direct_out_indices(out_indices.mDesc);
+
+    // the sum of the window, from which the average follows
+    pool_fwd_direct<ck::ReduceTensorOp::ADD, false>(in, direct_out, direct_out_indices, param);
+
+    float window_size = 1;
+
+    for(const auto x : param.window_lengths)
+        window_size *= x;
+
+    direct_out.ForEach([&](auto& self, const auto& idx) { self(idx) /= window_size; });
+
+    return ck::utils::check_err(out, direct_out, "Error: incorrect results!", 1e-5, 1e-5);
+}
+
+template <ck::index_t NDimSpatial>
+bool run_reference_avg_pool_bwd_against_direct(const PoolParam& param)
+{
+    using ReferencePoolBwd =
+        ck::tensor_operation::host::ReferenceAvgPoolBwd<NDimSpatial, float, float>;
+
+    const auto out_lengths = param.GetOutLengths();
+
+    Tensor<float> din(param.in_lengths);
+    Tensor<float> dout(out_lengths);
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(dout);
+
+    auto ref_pool_bwd   = ReferencePoolBwd{};
+    const auto argument = ref_pool_bwd.MakeArgument(din,
+                                                    dout,
+                                                    param.window_lengths,
+                                                    param.strides,
+                                                    param.dilations,
+                                                    param.left_pads,
+                                                    param.right_pads);
+
+    ref_pool_bwd.MakeInvoker().Run(argument);
+
+    // the transpose of the window sum, scattered from every output
+    Tensor<float> direct_din(din.mDesc);
+
+    direct_din.SetZero();
+
+    std::vector<std::size_t> out_idx(NDimSpatial + 2, 0);
+
+    do
+    {
+        std::vector<std::size_t> tap(NDimSpatial, 0);
+
+        do
+        {
+            std::vector<std::size_t> in_idx{out_idx[0], out_idx[1]};
+            bool is_valid = true;
+
+            for(std::size_t d = 0; d < NDimSpatial; ++d)
+            {
+                const ck::long_index_t i =
+                    static_cast<ck::long_index_t>(out_idx[d + 2]) * param.strides[d] +
+                    static_cast<ck::long_index_t>(tap[d]) * param.dilations[d] -
+                    param.left_pads[d];
+
+                is_valid = is_valid && i >= 0 && i < static_cast<ck::long_index_t>(
+                                                         param.in_lengths[d + 2]);
+                in_idx.push_back(static_cast<std::size_t>(i));
+            }
+
+            if(is_valid)
+                direct_din(in_idx) += dout(out_idx);
+        } while(next_index(tap, param.window_lengths));
+    } while(next_index(out_idx, out_lengths));
+
+    float window_size = 1;
+
+    for(const auto x : param.window_lengths)
+        window_size *= x;
+
+    direct_din.ForEach([&](auto& self, const auto& idx) { self(idx) /= window_size; });
+
+    return ck::utils::check_err(din, direct_din, "Error: incorrect results!", 1e-5, 1e-5);
+}
+
+// {in_lengths, window, strides, dilations, left pads, right pads}
+const std::vector<PoolParam> params_2d{
+    {{2, 3, 11, 13}, {3, 3}, {1, 1}, {1, 1}, {1, 1}, {1, 1}},
+    {{1, 2, 16, 9}, {4, 2}, {2, 3}, {1, 1}, {0, 1}, {2, 1}},
+    // dilations, and windows overlapping at a stride below the dilation
+    {{2, 2, 23, 17}, {3, 4}, {2, 1}, {3, 2}, {2, 3}, {1, 2}},
+    // strides above the window, some inputs are left out
+    {{1, 3, 14, 15}, {2, 2}, {5, 4}, {1, 2}, {0, 0}, {0, 1}},
+    // global pooling
+    {{2, 4, 7, 9}, {7, 9}, {1, 1}, {1, 1}, {0, 0}, {0, 0}},
+};
+
+const std::vector<PoolParam> params_3d{
+    {{2, 3, 6, 7, 8}, {3, 3, 3}, {1, 2, 1}, {1, 1, 2}, {1, 0, 1}, {1, 1, 2}},
+    {{1, 2, 9, 10, 11}, {7, 7, 7}, {2, 2, 2}, {1, 1, 1}, {3, 3, 3}, {3, 3, 3}},
+    {{1, 2, 12, 5, 7}, {2, 3, 2}, {3, 1, 2}, {4, 2, 3}, {2, 1, 0}, {0, 2, 2}},
+};
+
+} // anonymous namespace
+
+TEST(ReferencePool, MaxPoolFwdAgainstDirect)
+{
+    using ck::ReduceTensorOp;
+
+    for(const auto& param : params_2d)
+    {
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<2, ReduceTensorOp::MAX, false>(
+            param)));
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<2, ReduceTensorOp::MIN, false>(
+            param)));
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<2, ReduceTensorOp::AMAX, false>(
+            param)));
+    }
+
+    for(const auto& param : params_3d)
+    {
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<3, ReduceTensorOp::MAX, false>(
+            param)));
+    }
+}
+
+TEST(ReferencePool, MaxPoolFwdNan)
+{
+    using ck::ReduceTensorOp;
+
+    // the last NaN of a window wins when NaNs propagate, NaNs are skipped otherwise
+    for(const auto& param : params_3d)
+    {
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<3, ReduceTensorOp::MAX, true>(
+            param, true)));
+        EXPECT_TRUE((run_reference_max_pool_fwd_against_direct<3, ReduceTensorOp::MAX, false>(
+            param, true)));
+    }
+}
+
+TEST(ReferencePool, AvgPoolFwdAgainstDirect)
+{
+    for(const auto& param : params_2d)
+        EXPECT_TRUE(run_reference_avg_pool_fwd_against_direct<2>(param));
+
+    for(const auto& param : params_3d)
+        EXPECT_TRUE(run_reference_avg_pool_fwd_against_direct<3>(param));
+}
+
+TEST(ReferencePool, AvgPoolBwdAgainstDirect)
+{
+    EXPECT_TRUE(run_reference_avg_pool_bwd_against_direct<1>(
+        {{2, 3, 10}, {5}, {1}, {1}, {0}, {0}}));
+    EXPECT_TRUE(run_reference_avg_pool_bwd_against_direct<1>(
+        {{1, 2, 31}, {4}, {3}, {2}, {2}, {1}}));
+
+    for(const auto& param : params_2d)
+        EXPECT_TRUE(run_reference_avg_pool_bwd_against_direct<2>(param));
+
+    for(const auto& param : params_3d)
+        EXPECT_TRUE(run_reference_avg_pool_bwd_against_direct<3>(param));
+}
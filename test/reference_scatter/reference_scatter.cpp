@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_column_to_image.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_maxpool_bwd.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// odometer increment of idx, last dimension fastest; false once it wraps around
+bool advance(std::vector<std::size_t>& idx, const std::vector<ck::index_t>& lengths)
+{
+    for(std::size_t d = idx.size(); d > 0; --d)
+    {
+        if(++idx[d - 1] < static_cast<std::size_t>(lengths[d - 1]))
+            return true;
+
+        idx[d - 1] = 0;
+    }
+
+    return false;
+}
+
+// the serial loop nest the reference used to run: rows, then columns in [Z, Y, X, C] order
+template <ck::index_t NDimSpatial>
+void column_to_image_serial(const Tensor<float>& input,
+                            Tensor<float>& output,
+                            const ck::utils::conv::ConvParam& conv_param)
+{
+    const std::size_t N = conv_param.N_;
+    const std::size_t C = conv_param.C_;
+
+    std::vector<std::size_t> o(NDimSpatial, 0);
+    std::size_t row = 0;
+
+    for(std::size_t n = 0; n < N; ++n)
+    {
+        do
+        {
+            std::vector<std::size_t> t(NDimSpatial, 0);
+            std::size_t column = 0;
+
+            do
+            {
+                std::vector<std::size_t> idx{0, n, 0};
+                bool is_valid = true;
+
+                for(std::size_t d = 0; d < NDimSpatial; ++d)
+                {
+                    const ck::long_index_t i =
+                        static_cast<ck::long_index_t>(o[d] * conv_param.conv_filter_strides_[d]) +
+                        static_cast<ck::long_index_t>(t[d] * conv_param.conv_filter_dilations_[d]) -
+                        conv_param.input_left_pads_[d];
+
+                    is_valid = is_valid && i >= 0 && i < conv_param.input_spatial_lengths_[d];
+                    idx.push_back(static_cast<std::size_t>(i));
+                }
+
+                for(std::size_t c = 0; c < C; ++c, ++column)
+                {
+                    if(is_valid)
+                    {
+                        idx[2] = c;
+                        output(idx) += input(row, column);
+                    }
+                }
+            } while(advance(t, conv_param.filter_spatial_lengths_));
+
+            ++row;
+        } while(advance(o, conv_param.output_spatial_lengths_));
+    }
+}
+
+template <ck::index_t NDimSpatial, typename ImageLayout>
+bool run_reference_column_to_image_against_serial(const ck::utils::conv::ConvParam& conv_param)
+{
+    using ReferenceColumnToImage =
+        ck::tensor_operation::host::ReferenceColumnToImage<NDimSpatial, ImageLayout, float, float>;
+
+    std::size_t num_row = conv_param.N_;
+    std::size_t num_col = conv_param.C_;
+
+    for(std::size_t d = 0; d < NDimSpatial; ++d)
+    {
+        num_row *= conv_param.output_spatial_lengths_[d];
+        num_col *= conv_param.filter_spatial_lengths_[d];
+    }
+
+    Tensor<float> input(HostTensorDescriptor({num_row, num_col}));
+    Tensor<float> output(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<ImageLayout>(
+            conv_param));
+
+    // magnitudes far apart, so that the order of the additions shows in the result
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    input.ForEach([](auto& self, const auto& idx) { self(idx) *= idx[0] % 3 == 0 ? 1e4f : 1.f; });
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+
+    Tensor<float> serial_output(output);
+
+    auto ref_op         = ReferenceColumnToImage{};
+    const auto argument = ref_op.MakeArgument(input,
+                                              output,
+                                              conv_param.filter_spatial_lengths_,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_);
+
+    if(!ref_op.IsSupportedArgument(&argument))
+        return false;
+
+    ref_op.MakeInvoker().Run(argument);
+
+    column_to_image_serial<NDimSpatial>(input, serial_output, conv_param);
+
+    return ck::utils::check_err(output, serial_output, "Error: incorrect results!", 0, 0);
+}
+
+template <typename ComputeDataType, typename DInDataType>
+bool run_reference_maxpool_bwd_against_serial(std::size_t dout_length, std::size_t din_length)
+{
+    using ReferenceMaxPoolBwd = ck::tensor_operation::host::
+        ReferenceMaxPoolBwd<float, ck::index_t, ComputeDataType, DInDataType, PassThrough>;
+
+    Tensor<float> dout(HostTensorDescriptor({dout_length}));
+    Tensor<ck::index_t> indices(HostTensorDescriptor({dout_length}));
+    Tensor<DInDataType> din(HostTensorDescriptor({din_length}));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(dout);
+    dout.ForEach([](auto& self, const auto& idx) { self(idx) *= idx[0] % 5 == 0 ? 1e3f : 1.f; });
+
+    // many gradients per element, and indices out of range that must be skipped
+    std::mt19937 gen(11939);
+    std::uniform_int_distribution<ck::index_t> dis(-3, static_cast<ck::index_t>(din_length) + 3);
+
+    for(auto& index : indices.mData)
+        index = dis(gen);
+
+    auto ref_op         = ReferenceMaxPoolBwd{};
+    const auto argument = ref_op.MakeArgument(dout, indices, din, PassThrough{});
+
+    ref_op.MakeInvoker().Run(argument);
+
+    std::vector<float> buf(din_length, 0);
+
+    for(std::size_t i = 0; i < dout_length; ++i)
+    {
+        const ck::index_t index = indices.mData[i];
+
+        if(index >= 0 && static_cast<std::size_t>(index) < din_length)
+        {
+            buf[index] = ck::type_convert<float>(ck::type_convert<ComputeDataType>(
+                buf[index] + ck::type_convert<float>(dout.mData[i])));
+        }
+    }
+
+    Tensor<DInDataType> serial_din(din.mDesc);
+
+    for(std::size_t i = 0; i < din_length; ++i)
+        serial_din.mData[i] = ck::type_convert<DInDataType>(buf[i]);
+
+    return ck::utils::check_err(din, serial_din, "Error: incorrect results!", 0, 0);
+}
+
+class ReferenceScatter : public ::testing::Test
+{
+    protected:
+    void SetUp() override { num_thread_ = ck::host_common::get_host_num_threads(); }
+
+    void TearDown() override { ck::host_common::set_host_num_threads(num_thread_); }
+
+    std::size_t num_thread_;
+};
+
+} // anonymous namespace
+
+TEST_F(ReferenceScatter, ColumnToImageAgainstSerial)
+{
+    using namespace ck::tensor_layout::convolution;
+
+    for(std::size_t num_thread : {1, 4})
+    {
+        ck::host_common::set_host_num_threads(num_thread);
+
+        EXPECT_TRUE((run_reference_column_to_image_against_serial<1, GNWC>(
+            {1, 1, 3, 1, 5, {3}, {37}, {2}, {1}, {1}, {1}})));
+        // overlapping windows, a single image split into bands
+        EXPECT_TRUE((run_reference_column_to_image_against_serial<2, GNHWC>(
+            {2, 1, 1, 1, 4, {3, 3}, {29, 17}, {1, 1}, {2, 1}, {2, 1}, {1, 2}})));
+        // windows larger than the stride and dilations past the padding
+        EXPECT_TRUE((run_reference_column_to_image_against_serial<2, GNHWC>(
+            {2, 1, 3, 1, 2, {5, 2}, {16, 9}, {2, 3}, {3, 1}, {4, 0}, {3, 2}})));
+        // strides larger than the windows leave pixels untouched
+        EXPECT_TRUE((run_reference_column_to_image_against_serial<2, GNHWC>(
+            {2, 1, 2, 1, 3, {2, 2}, {13, 11}, {3, 4}, {1, 1}, {0, 0}, {0, 0}})));
+        EXPECT_TRUE((run_reference_column_to_image_against_serial<3, GNDHWC>(
+            {3, 1, 2, 1, 3, {3, 2, 3}, {7, 9, 6}, {2, 1, 2}, {1, 2, 1}, {1, 0, 1}, {1, 1, 2}})));
+    }
+}
+
+TEST_F(ReferenceScatter, MaxPoolBwdAgainstSerial)
+{
+    for(std::size_t num_thread : {1, 4})
+    {
+        ck::host_common::set_host_num_threads(num_thread);
+
+        EXPECT_TRUE((run_reference_maxpool_bwd_against_serial<float, float>(37, 11)));
+        // several chunks of gradients and tiles of elements
+        EXPECT_TRUE((run_reference_maxpool_bwd_against_serial<float, float>(300000, 20000)));
+        EXPECT_TRUE((run_reference_maxpool_bwd_against_serial<float, ck::half_t>(200000, 9000)));
+        EXPECT_TRUE(
+            (run_reference_maxpool_bwd_against_serial<ck::bhalf_t, ck::bhalf_t>(200000, 9000)));
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+
+namespace {
+
+// out = alpha * softmax(in) + beta * out with max and sum taken in separate passes
+void naive_softmax(const Tensor<float>& in,
+                   Tensor<float>& out,
+                   double alpha,
+                   double beta,
+                   const std::vector<ck::index_t>& reduce_dims)
+{
+    auto row_of = [&](std::vector<std::size_t> idx) {
+        for(auto dim : reduce_dims)
+            idx[dim] = 0;
+
+        return in.mDesc.GetOffsetFromMultiIndex(idx);
+    };
+
+    std::vector<double> max(in.mDesc.GetElementSpaceSize(), -INFINITY);
+    std::vector<double> sum(in.mDesc.GetElementSpaceSize(), 0);
+
+    in.ForEach([&](auto& self, auto idx) {
+        max[row_of(idx)] = std::max<double>(max[row_of(idx)], self(idx));
+    });
+
+    in.ForEach([&](auto& self, auto idx) {
+        sum[row_of(idx)] += std::exp(self(idx) - max[row_of(idx)]);
+    });
+
+    out.ForEach([&](auto& self, auto idx) {
+        self(idx) = static_cast<float>(
+            alpha * std::exp(in(idx) - max[row_of(idx)]) / sum[row_of(idx)] + beta * self(idx));
+    });
+}
+
+bool run_reference_softmax_test(const HostTensorDescriptor& in_desc,
+                                const HostTensorDescriptor& out_desc,
+                                double alpha,
+                                double beta,
+                                const std::vector<ck::index_t>& reduce_dims)
+{
+    Tensor<float> in(in_desc);
+    Tensor<float> out(out_desc);
+
+    ck::utils::FillUniformDistribution<float>{-5.f, 5.f}(in);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(out);
+
+    Tensor<float> out_naive(out);
+
+    auto ref          = ck::tensor_operation::host::ReferenceSoftmax<float, float, float>{};
+    auto ref_argument = ref.MakeArgument(in, out, alpha, beta, reduce_dims);
+
+    ref.MakeInvoker().Run(ref_argument);
+
+    naive_softmax(in, out_naive, alpha, beta, reduce_dims);
+
+    return ck::utils::check_err(out, out_naive, "Error: incorrect results!", 1e-5, 1e-6);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceSoftmax, F32LastDim)
+{
+    EXPECT_TRUE(run_reference_softmax_test(
+        HostTensorDescriptor({8, 64, 512}), HostTensorDescriptor({8, 64, 512}), 1, 0, {2}));
+}
+
+TEST(ReferenceSoftmax, F32StridedReduceDims)
+{
+    // input in column-major order, output row-major, reduce over two non-adjacent dims
+    const HostTensorDescriptor in_desc({4, 5, 6, 7}, {1, 4, 20, 120});
+    const HostTensorDescriptor out_desc({4, 5, 6, 7});
+
+    EXPECT_TRUE(run_reference_softmax_test(in_desc, out_desc, 0.5, 0.5, {1, 3}));
+    EXPECT_TRUE(run_reference_softmax_test(in_desc, out_desc, 1, 0, {0, 1, 2, 3}));
+}
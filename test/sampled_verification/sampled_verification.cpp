@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+using ck::utils::SampledVerificationConfig;
+using ck::utils::SampledVerificationTiling;
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// ComputeElement() must reproduce Run() at every element of result
+template <typename T, typename Invoker, typename Argument>
+void expect_point_wise_equal(const Tensor<T>& result,
+                             const Invoker& invoker,
+                             const Argument& argument)
+{
+    std::size_t num_mismatch = 0;
+
+    result.ForEach([&](auto& self, auto idx) {
+        num_mismatch += invoker.ComputeElement(argument, idx) != self(idx);
+    });
+
+    EXPECT_EQ(num_mismatch, 0);
+}
+
+} // anonymous namespace
+
+TEST(SampledVerification, PointWiseEvaluatorsMatchReferences)
+{
+    ck::utils::FillUniformDistributionIntegerValue<float> fill{-3.f, 3.f};
+
+    {
+        Tensor<float> a({37, 19});
+        Tensor<float> b(HostTensorDescriptor({19, 23}, {1, 19}));
+        Tensor<float> c({37, 23});
+
+        fill(a);
+        fill(b);
+
+        using Gemm = ck::tensor_operation::host::
+            ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+        const auto argument = Gemm::MakeArgument(a, b, c, {}, {}, {});
+        auto invoker        = Gemm::MakeInvoker();
+
+        invoker.Run(argument);
+        expect_point_wise_equal(c, invoker, argument);
+    }
+
+    {
+        Tensor<float> a({3, 17, 9});
+        Tensor<float> b({3, 9, 11});
+        Tensor<float> c({3, 17, 11});
+
+        fill(a);
+        fill(b);
+
+        using BatchedGemm = ck::tensor_operation::host::
+            ReferenceBatchedGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+        const auto argument = BatchedGemm::MakeArgument(a, b, c, {}, {}, {});
+        auto invoker        = BatchedGemm::MakeInvoker();
+
+        invoker.Run(argument);
+        expect_point_wise_equal(c, invoker, argument);
+    }
+
+    {
+        // G, N, C, Hi, Wi = 2, 3, 4, 9, 8; K = 5; 3x2 filter, strides 2, 1, dilations 1, 2, pads 1
+        Tensor<float> in({2, 3, 4, 9, 8});
+        Tensor<float> wei({2, 5, 4, 3, 2});
+        Tensor<float> out({2, 3, 5, 5, 8});
+
+        fill(in);
+        fill(wei);
+        fill(out);
+
+        const std::vector<ck::index_t> strides{2, 1};
+        const std::vector<ck::index_t> dilations{1, 2};
+        const std::vector<ck::index_t> pads{1, 1};
+
+        using ConvFwd = ck::tensor_operation::host::
+            ReferenceConvFwd<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+        Tensor<float> out_ref(out.mDesc);
+
+        const auto fwd_argument =
+            ConvFwd::MakeArgument(in, wei, out_ref, strides, dilations, pads, pads, {}, {}, {});
+        auto fwd_invoker = ConvFwd::MakeInvoker();
+
+        fwd_invoker.Run(fwd_argument);
+        expect_point_wise_equal(out_ref, fwd_invoker, fwd_argument);
+
+        using ConvBwdData = ck::tensor_operation::host::
+            ReferenceConvBwdData<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+        Tensor<float> in_ref(in.mDesc);
+
+        const auto bwd_data_argument =
+            ConvBwdData::MakeArgument(in_ref, wei, out, strides, dilations, pads, pads, {}, {}, {});
+        auto bwd_data_invoker = ConvBwdData::MakeInvoker();
+
+        bwd_data_invoker.Run(bwd_data_argument);
+        expect_point_wise_equal(in_ref, bwd_data_invoker, bwd_data_argument);
+
+        using ConvBwdWeight = ck::tensor_operation::host::
+            ReferenceConvBwdWeight<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+        Tensor<float> wei_ref(wei.mDesc);
+
+        const auto bwd_weight_argument = ConvBwdWeight::MakeArgument(
+            in, wei_ref, out, strides, dilations, pads, pads, {}, {}, {});
+        auto bwd_weight_invoker = ConvBwdWeight::MakeInvoker();
+
+        bwd_weight_invoker.Run(bwd_weight_argument);
+        expect_point_wise_equal(wei_ref, bwd_weight_invoker, bwd_weight_argument);
+    }
+
+    {
+        Tensor<float> a({3, 4, 5, 2});
+        Tensor<float> b({2, 6, 5, 2});
+        Tensor<float> c({3, 4, 2, 6});
+
+        fill(a);
+        fill(b);
+
+        using Contraction = ck::tensor_operation::host::ReferenceContraction_M2_N2_K2<2,
+                                                                                      2,
+                                                                                      2,
+                                                                                      float,
+                                                                                      float,
+                                                                                      float,
+                                                                                      float,
+                                                                                      PassThrough,
+                                                                                      PassThrough>;
+
+        const auto argument = Contraction::MakeArgument(a, b, c, {}, {});
+        auto invoker        = Contraction::MakeInvoker();
+
+        invoker.Run(argument);
+        expect_point_wise_equal(c, invoker, argument);
+    }
+}
+
+TEST(SampledVerification, SamplesCoverTileBoundaries)
+{
+    // batch, M = 2 x 50, N = 70
+    const std::vector<std::size_t> lengths{3, 2, 50, 70};
+
+    const SampledVerificationTiling tiling{{1, 2}, {3}, 32, 64};
+
+    SampledVerificationConfig config;
+
+    config.num_samples          = 100;
+    config.num_boundary_samples = 0;
+    config.seed                 = 42;
+
+    const auto samples = ck::utils::make_sampled_indices(lengths, tiling, config);
+
+    // rows 0, 31, 32, 63, 64, 95, 96 and 99 in full, columns 0, 63, 64 and 69 in full
+    EXPECT_EQ(samples.num_random, 100);
+    EXPECT_EQ(samples.indices.size(), 100 + 8 * 70 + 4 * 100);
+
+    std::set<std::vector<std::size_t>> boundary(samples.indices.begin() + samples.num_random,
+                                                samples.indices.end());
+
+    for(std::size_t m : {0, 31, 32, 63, 64, 95, 96, 99})
+        for(std::size_t n = 0; n < 70; ++n)
+            EXPECT_TRUE(std::any_of(boundary.begin(), boundary.end(), [&](const auto& idx) {
+                return idx[1] * 50 + idx[2] == m && idx[3] == n;
+            }));
+
+    for(std::size_t n : {0, 63, 64, 69})
+        for(std::size_t m = 0; m < 100; ++m)
+            EXPECT_TRUE(std::any_of(boundary.begin(), boundary.end(), [&](const auto& idx) {
+                return idx[1] * 50 + idx[2] == m && idx[3] == n;
+            }));
+
+    for(const auto& idx : samples.indices)
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+            EXPECT_LT(idx[d], lengths[d]);
+
+    // reproducible for a seed
+    EXPECT_EQ(ck::utils::make_sampled_indices(lengths, tiling, config).indices, samples.indices);
+
+    config.seed = 43;
+
+    EXPECT_NE(ck::utils::make_sampled_indices(lengths, tiling, config).indices, samples.indices);
+
+    config.num_boundary_samples = 5;
+
+    EXPECT_EQ(ck::utils::make_sampled_indices(lengths, tiling, config).indices.size(),
+              100 + 8 * 5 + 4 * 5);
+}
+
+TEST(SampledVerification, DetectsTileBoundaryErrors)
+{
+    Tensor<float> a({300, 40});
+    Tensor<float> b({40, 200});
+    Tensor<float> c({300, 200});
+
+    ck::utils::FillUniformDistributionIntegerValue<float>{-3.f, 3.f}(a);
+    ck::utils::FillUniformDistributionIntegerValue<float>{-3.f, 3.f}(b);
+
+    using Gemm = ck::tensor_operation::host::
+        ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    const auto argument = Gemm::MakeArgument(a, b, c, {}, {}, {});
+    auto invoker        = Gemm::MakeInvoker();
+
+    invoker.Run(argument);
+
+    SampledVerificationConfig config;
+
+    config.num_samples          = 2000;
+    config.num_boundary_samples = 0;
+
+    const auto ref = ck::utils::compute_sampled_reference<float>(
+        c.GetLengths(),
+        {{0}, {1}, 128, 128},
+        [&](const auto& idx) { return invoker.ComputeElement(argument, idx); },
+        config);
+
+    const auto stats = ck::utils::check_err_sampled_stats(c, ref, 1e-5, 3e-6);
+
+    EXPECT_EQ(stats.random.err_count + stats.boundary.err_count, 0);
+    EXPECT_EQ(stats.random.num_checked, 2000);
+    EXPECT_EQ(stats.err_rate_lower, 0);
+    EXPECT_LT(stats.err_rate_upper, 0.002);
+    EXPECT_TRUE(ck::utils::check_err_sampled(c, ref));
+
+    // a wrong last row of the first tile
+    for(std::size_t n = 0; n < 200; ++n)
+        c(127, n) += 1.f;
+
+    const auto bad_stats = ck::utils::check_err_sampled_stats(c, ref, 1e-5, 3e-6);
+
+    EXPECT_EQ(bad_stats.boundary.err_count, 200 + 4);
+    EXPECT_FALSE(ck::utils::check_err_sampled(c, ref, "Error: expected mismatch"));
+}
+
+TEST(SampledVerification, ErrorRateBounds)
+{
+    // no failures: the upper bound is z^2 / (n + z^2)
+    const auto [lower, upper] = ck::utils::get_error_rate_bounds(0, 100, 0.95);
+
+    EXPECT_EQ(lower, 0);
+    EXPECT_NEAR(upper, 1.959964 * 1.959964 / (100 + 1.959964 * 1.959964), 1e-6);
+
+    const auto [half_lower, half_upper] = ck::utils::get_error_rate_bounds(50, 100, 0.95);
+
+    EXPECT_NEAR(half_lower + half_upper, 1., 1e-12);
+    EXPECT_NEAR(half_upper, 0.596, 1e-3);
+
+    EXPECT_EQ(ck::utils::get_error_rate_bounds(0, 0, 0.95), std::make_pair(0., 1.));
+}
+
+TEST(SampledVerification, BlockTileLengthsFromTypeString)
+{
+    EXPECT_EQ(ck::utils::get_block_tile_lengths(
+                  "DeviceGemm_Xdl_CShuffle<256, 128, 64, 32, 8, 8, Default, 32, 32, 2, 2>"),
+              (std::array<std::size_t, 2>{128, 64}));
+    EXPECT_EQ(ck::utils::get_block_tile_lengths("DeviceGemmDl<64, 32>"),
+              (std::array<std::size_t, 2>{0, 0}));
+    EXPECT_EQ(ck::utils::get_block_tile_lengths("DeviceGemm<Default, 128, 64>"),
+              (std::array<std::size_t, 2>{0, 0}));
+    EXPECT_EQ(ck::utils::get_block_tile_lengths("ReferenceGemm"),
+              (std::array<std::size_t, 2>{0, 0}));
+}
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/streaming_verification.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+using ck::utils::StreamingVerificationConfig;
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using Gemm = ck::tensor_operation::host::
+    ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+// streaming verification of a GEMM result held in out, which stands in for the device buffer
+void expect_streaming_equal_to_full(const HostTensorDescriptor& c_desc,
+                                    const StreamingVerificationConfig& config)
+{
+    ck::utils::FillUniformDistributionIntegerValue<float> fill{-3.f, 3.f};
+
+    const std::size_t M = c_desc.GetLengths()[0];
+    const std::size_t N = c_desc.GetLengths()[1];
+
+    Tensor<float> a({M, std::size_t{13}});
+    Tensor<float> b({std::size_t{13}, N});
+    Tensor<float> out(c_desc);
+
+    fill(a);
+    fill(b);
+
+    const auto argument = Gemm::MakeArgument(a, b, out, {}, {}, {});
+
+    Gemm::MakeInvoker().Run(argument);
+
+    const Tensor<float> ref = out;
+
+    // wrong elements in the first and the last row and column
+    out(0, N - 1) += 1.f;
+    out(M - 1, 0) += 1.f;
+    out(M / 2, N / 2) += 1.f;
+
+    const auto slicing = ck::utils::make_streaming_slicing(c_desc, sizeof(float), config);
+
+    const auto copy = [&](float* p, std::size_t offset, std::size_t size) {
+        ASSERT_LE(offset + size, out.mData.size());
+
+        std::memcpy(p, out.mData.data() + offset, size * sizeof(float));
+    };
+
+    std::size_t num_fetched = 0;
+
+    const auto fetch = [&](float* p, std::size_t offset, std::size_t size) {
+        EXPECT_LE(size, slicing.slice_space_size);
+
+        copy(p, offset, size);
+
+        num_fetched += size;
+    };
+
+    // the packed GEMM of the rows of A or the columns of B of a slice
+    const auto compute_slice =
+        [&](const TensorView<float>& c_slice, std::size_t dim, std::size_t begin) {
+            const std::size_t end = begin + c_slice.GetLengths()[dim];
+
+            const auto a_slice = dim == 0 ? TensorView(a).Slice(0, begin, end) : TensorView(a);
+            const auto b_slice = dim == 1 ? TensorView(b).Slice(1, begin, end) : TensorView(b);
+
+            Gemm::MakeInvoker().Run(Gemm::MakeArgument(a_slice, b_slice, c_slice, {}, {}, {}));
+        };
+
+    // element by element, as the fallback
+    const auto compute_slice_elementwise =
+        [&](const TensorView<float>& c_slice, std::size_t dim, std::size_t begin) {
+            ck::utils::compute_streaming_slice_elementwise(
+                c_slice, dim, begin, [&](const auto& idx) {
+                    return Gemm::Invoker::ComputeElement(argument, idx);
+                });
+        };
+
+    const auto full_stats = ck::utils::check_err_stats(out, ref, 1e-5, 3e-6);
+
+    const auto expect_equal_to_full = [&](const auto& compute) {
+        num_fetched = 0;
+
+        const auto stats = ck::utils::check_err_streaming_stats<float>(
+            c_desc, compute, fetch, 1e-5, 3e-6, config);
+
+        EXPECT_GE(num_fetched, c_desc.GetElementSize());
+        EXPECT_EQ(stats.num_checked, M * N);
+        EXPECT_EQ(stats.err_count, 3);
+        EXPECT_EQ(stats.ulp_histogram, full_stats.ulp_histogram);
+        ASSERT_EQ(stats.mismatches.size(), full_stats.mismatches.size());
+
+        for(std::size_t i = 0; i < stats.mismatches.size(); ++i)
+            EXPECT_EQ(stats.mismatches[i].offset, full_stats.mismatches[i].offset);
+
+        EXPECT_FALSE(ck::utils::check_err_streaming<float>(
+            c_desc, compute, copy, "Error: expected mismatch"));
+    };
+
+    expect_equal_to_full(compute_slice);
+    expect_equal_to_full(compute_slice_elementwise);
+}
+
+} // anonymous namespace
+
+TEST(StreamingVerification, SlicesAlongTheOutermostDimension)
+{
+    StreamingVerificationConfig config;
+
+    config.max_slice_bytes = 1000;
+
+    // 40 x 4 bytes per row, 6 rows per slice
+    const auto row_major = ck::utils::make_streaming_slicing(
+        HostTensorDescriptor({64, 32}, {40, 1}), sizeof(float), config);
+
+    EXPECT_EQ(row_major.dim, 0);
+    EXPECT_EQ(row_major.length, 6);
+    EXPECT_EQ(row_major.stride, 40);
+    EXPECT_EQ(row_major.slice_space_size, 5 * 40 + 32);
+
+    const auto column_major = ck::utils::make_streaming_slicing(
+        HostTensorDescriptor({64, 32}, {1, 64}), sizeof(float), config);
+
+    EXPECT_EQ(column_major.dim, 1);
+    EXPECT_EQ(column_major.length, 3);
+    EXPECT_EQ(column_major.slice_space_size, 2 * 64 + 64);
+
+    // a leading dimension of length 1 is not sliced
+    const auto batch = ck::utils::make_streaming_slicing(
+        HostTensorDescriptor({1, 64, 32}, {2048, 32, 1}), sizeof(float), config);
+
+    EXPECT_EQ(batch.dim, 1);
+
+    config.slice_length = 100;
+
+    EXPECT_EQ(ck::utils::make_streaming_slicing(
+                  HostTensorDescriptor({64, 32}, {32, 1}), sizeof(float), config)
+                  .length,
+              64);
+}
+
+TEST(StreamingVerification, MatchesFullComparison)
+{
+    StreamingVerificationConfig config;
+
+    config.slice_length = 8;
+
+    expect_streaming_equal_to_full(HostTensorDescriptor({67, 45}, {45, 1}), config);
+    expect_streaming_equal_to_full(HostTensorDescriptor({67, 45}, {1, 70}), config);
+
+    // a few rows per slice, the last one partial
+    config.slice_length    = 0;
+    config.max_slice_bytes = 3 * 48 * sizeof(float);
+
+    expect_streaming_equal_to_full(HostTensorDescriptor({67, 45}, {48, 1}), config);
+}
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/tensor_operation_instance/tuned_device_op_instance.hpp"
+#include "ck/library/utility/tuning_database.hpp"
+
+using ck::utils::TuningDatabase;
+using ck::utils::TuningRecord;
+
+namespace {
+
+// instances of a fake device operation, told apart by their types
+struct FakeDeviceOp : ck::tensor_operation::device::BaseOperator
+{
+    virtual int GetMinK() const = 0;
+};
+
+template <int MinK>
+struct FakeInstance : FakeDeviceOp
+{
+    int GetMinK() const override { return MinK; }
+
+    std::string GetTypeString() const override
+    {
+        return "FakeInstance<" + std::to_string(MinK) + ">";
+    }
+};
+
+TuningRecord make_record(const std::string& arch, std::vector<int64_t> shape, int min_k)
+{
+    const std::string signature =
+        ck::tensor_operation::device::instance::get_device_op_signature<FakeDeviceOp>();
+
+    std::unique_ptr<FakeDeviceOp> op;
+
+    if(min_k == 1)
+        op = std::make_unique<FakeInstance<1>>();
+    else if(min_k == 64)
+        op = std::make_unique<FakeInstance<64>>();
+    else
+        op = std::make_unique<FakeInstance<256>>();
+
+    return {{signature, arch, std::move(shape)},
+            op->GetTypeIdHashCode(),
+            op->GetTypeString(),
+            1.5,
+            100};
+}
+
+} // namespace
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+template <>
+struct DeviceOperationInstanceFactory<FakeDeviceOp>
+{
+    static auto GetInstances()
+    {
+        std::vector<std::unique_ptr<FakeDeviceOp>> op_ptrs;
+
+        op_ptrs.push_back(std::make_unique<FakeInstance<1>>());
+        op_ptrs.push_back(std::make_unique<FakeInstance<64>>());
+        op_ptrs.push_back(std::make_unique<FakeInstance<256>>());
+
+        return op_ptrs;
+    }
+};
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+
+TEST(TuningDatabase, FindsExactThenNearestShape)
+{
+    TuningDatabase db;
+
+    db.Insert(make_record("gfx90a", {1024, 1024, 1024}, 64));
+    db.Insert(make_record("gfx90a", {4096, 4096, 4096}, 256));
+    db.Insert(make_record("gfx942", {1024, 1024, 1024}, 1));
+
+    const auto signature = make_record("gfx90a", {}, 1).key.signature;
+
+    const auto* exact = db.Find({signature, "gfx90a", {4096, 4096, 4096}});
+
+    ASSERT_NE(exact, nullptr);
+    EXPECT_EQ(exact->instance_name, "FakeInstance<256>");
+
+    // nearer to 1024^3 than to 4096^3 in log scale
+    const auto* nearest = db.Find({signature, "gfx90a", {1536, 1024, 2048}});
+
+    ASSERT_NE(nearest, nullptr);
+    EXPECT_EQ(nearest->instance_name, "FakeInstance<64>");
+
+    const auto candidates = db.FindCandidates({signature, "gfx90a", {3000, 3000, 3000}});
+
+    ASSERT_EQ(candidates.size(), 2);
+    EXPECT_EQ(candidates[0]->instance_name, "FakeInstance<256>");
+    EXPECT_EQ(candidates[1]->instance_name, "FakeInstance<64>");
+
+    // no match across signatures, archs and ranks
+    EXPECT_EQ(db.Find({"other", "gfx90a", {1024, 1024, 1024}}), nullptr);
+    EXPECT_EQ(db.Find({signature, "gfx908", {1024, 1024, 1024}}), nullptr);
+    EXPECT_EQ(db.Find({signature, "gfx90a", {1024, 1024}}), nullptr);
+
+    // the latest record of a key wins
+    db.Insert(make_record("gfx942", {1024, 1024, 1024}, 256));
+
+    EXPECT_EQ(db.GetSize(), 3);
+    EXPECT_EQ(db.Find({signature, "gfx942", {1024, 1024, 1024}})->instance_name,
+              "FakeInstance<256>");
+}
+
+TEST(TuningDatabase, SavesAndLoads)
+{
+    const std::string path = "test_tuning_database.txt";
+
+    TuningDatabase db;
+
+    auto record = make_record("gfx90a", {128, 256, 64}, 64);
+
+    record.instance_name = "FakeInstance<64> with, commas and spaces";
+
+    db.Insert(record);
+    db.Insert(make_record("gfx90a", {0, 1, 2, 3}, 1));
+    db.Save(path);
+
+    TuningDatabase loaded;
+
+    loaded.Load(path);
+
+    ASSERT_EQ(loaded.GetSize(), 2);
+
+    const auto* found = loaded.Find(record.key);
+
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->key.shape, record.key.shape);
+    EXPECT_EQ(found->instance_type_id, record.instance_type_id);
+    EXPECT_EQ(found->instance_name, record.instance_name);
+    EXPECT_FLOAT_EQ(found->ave_time, record.ave_time);
+    EXPECT_FLOAT_EQ(found->tflops, record.tflops);
+
+    std::remove(path.c_str());
+}
+
+TEST(TuningDatabase, RejectsBadFiles)
+{
+    const std::string path = "test_tuning_database_bad.txt";
+
+    TuningDatabase db;
+
+    // a missing file is an empty database
+    db.Load("no_such_tuning_database.txt");
+
+    EXPECT_EQ(db.GetSize(), 0);
+
+    std::ofstream(path) << "ck_tuning_db " << TuningDatabase::Version + 1 << "\n";
+
+    EXPECT_THROW(db.Load(path), std::runtime_error);
+
+    std::ofstream(path) << "ck_tuning_db " << TuningDatabase::Version << "\n"
+                        << "sig\tgfx90a\t1,2,3\tid\t1.0\t2.0\tname\n"
+                        << "sig\tgfx90a\t1,x,3\tid\t1.0\t2.0\tname\n";
+
+    EXPECT_THROW(db.Load(path), std::runtime_error);
+
+    // nothing of a bad file is loaded
+    EXPECT_EQ(db.GetSize(), 0);
+
+    EXPECT_THROW(db.Insert({{"sig\t", "gfx90a", {1}}, "id", "name", 1, 1}), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(TuningDatabase, ReturnsTunedInstance)
+{
+    using ck::tensor_operation::device::instance::get_tuned_device_op_instance;
+
+    TuningDatabase db;
+
+    db.Insert(make_record("gfx90a", {1024, 1024, 64}, 64));
+    db.Insert(make_record("gfx90a", {1024, 1024, 4096}, 256));
+
+    const auto any = [](const FakeDeviceOp&) { return true; };
+
+    auto op_ptr =
+        get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 3000}, "gfx90a", any, db);
+
+    ASSERT_NE(op_ptr, nullptr);
+    EXPECT_EQ(op_ptr->GetMinK(), 256);
+
+    // the nearest shape's instance does not support the problem, the next one does
+    const auto small_k = [](const FakeDeviceOp& op) { return op.GetMinK() <= 64; };
+
+    op_ptr = get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 3000}, "gfx90a", small_k, db);
+
+    ASSERT_NE(op_ptr, nullptr);
+    EXPECT_EQ(op_ptr->GetMinK(), 64);
+
+    const auto none = [](const FakeDeviceOp&) { return false; };
+
+    EXPECT_EQ(get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 3000}, "gfx90a", none, db),
+              nullptr);
+    EXPECT_EQ(get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 3000}, "gfx942", any, db),
+              nullptr);
+}
+
+TEST(TuningDatabase, MatchesInstanceNameOfOtherToolchain)
+{
+    using ck::tensor_operation::device::instance::get_device_op_signature;
+    using ck::tensor_operation::device::instance::get_tuned_device_op_instance;
+
+    // the demangled name, not the ABI-specific mangled one
+    EXPECT_NE(get_device_op_signature<FakeDeviceOp>().find("FakeDeviceOp"), std::string::npos);
+    EXPECT_EQ(get_device_op_signature<FakeDeviceOp>().find("12FakeDeviceOp"), std::string::npos);
+
+    // as written by a toolchain with type id hashes of its own
+    auto record             = make_record("gfx90a", {1024, 1024, 64}, 64);
+    record.instance_type_id = "0";
+
+    TuningDatabase db;
+
+    db.Insert(record);
+
+    const auto any = [](const FakeDeviceOp&) { return true; };
+
+    auto op_ptr = get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 64}, "gfx90a", any, db);
+
+    ASSERT_NE(op_ptr, nullptr);
+    EXPECT_EQ(op_ptr->GetMinK(), 64);
+
+    record.instance_name = "FakeInstance<32>";
+
+    db.Insert(record);
+
+    EXPECT_EQ(get_tuned_device_op_instance<FakeDeviceOp>({1024, 1024, 64}, "gfx90a", any, db),
+              nullptr);
+}
+
+TEST(TuningDatabase, ConvShape)
+{
+    const ck::utils::conv::ConvParam param{
+        2, 1, 128, 256, 192, {3, 3}, {71, 71}, {2, 2}, {1, 1}, {1, 1}, {1, 1}};
+
+    EXPECT_EQ(ck::utils::get_tuning_shape(param),
+              (std::vector<int64_t>{1, 128, 256, 192, 3, 3, 71, 71, 2, 2, 1, 1, 1, 1, 1, 1}));
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/verification_pipeline.hpp"
+
+using ck::utils::VerificationPipeline;
+
+TEST(VerificationPipeline, RunsTasksInOrderInTheBackground)
+{
+    VerificationPipeline pipeline;
+
+    std::atomic<bool> release{false};
+    std::vector<int> order;
+
+    // the "reference" blocks until the submitting thread has queued everything
+    pipeline.Submit([&] {
+        while(!release)
+            std::this_thread::yield();
+
+        order.push_back(0);
+
+        return true;
+    });
+
+    for(int i = 1; i <= 4; ++i)
+    {
+        pipeline.Submit([&, i] {
+            // the host thread pool is available to the tasks
+            std::atomic<std::size_t> sum{0};
+
+            ck::host_common::host_parallel_for(1000, [&](std::size_t j) { sum += j; });
+
+            order.push_back(i);
+
+            return sum == 999 * 1000 / 2;
+        });
+    }
+
+    release = true;
+
+    EXPECT_TRUE(pipeline.Wait());
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+
+    pipeline.Submit([] { return false; });
+    pipeline.Submit([] { return true; });
+
+    EXPECT_FALSE(pipeline.Wait());
+}
+
+TEST(VerificationPipeline, BoundsThePendingBytes)
+{
+    VerificationPipeline pipeline(100);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> num_submitted{0};
+
+    pipeline.Submit(
+        [&] {
+            while(!release)
+                std::this_thread::yield();
+
+            return true;
+        },
+        60);
+
+    std::thread submitter([&] {
+        pipeline.Submit([] { return true; }, 60);
+        ++num_submitted;
+
+        // larger than the bound, goes through once the queue is empty
+        pipeline.Submit([] { return true; }, 1000);
+        ++num_submitted;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_EQ(num_submitted, 0);
+
+    release = true;
+
+    submitter.join();
+
+    EXPECT_EQ(num_submitted, 2);
+    EXPECT_TRUE(pipeline.Wait());
+}
+
+TEST(VerificationPipeline, ExceptionCancelsLaterTasks)
+{
+    VerificationPipeline pipeline;
+
+    bool is_run = false;
+
+    pipeline.Submit([]() -> bool { throw std::runtime_error("reference failed"); });
+    pipeline.Submit([&] {
+        is_run = true;
+        return true;
+    });
+
+    EXPECT_THROW(pipeline.Wait(), std::runtime_error);
+    EXPECT_FALSE(is_run);
+
+    // usable again afterwards
+    pipeline.Submit([&] {
+        is_run = true;
+        return true;
+    });
+
+    EXPECT_TRUE(pipeline.Wait());
+    EXPECT_TRUE(is_run);
+}